@@ -46,6 +46,8 @@ pqImageCompressorWidget::pqImageCompressorWidget(
   this->connect(
     ui.compressionType, SIGNAL(currentIndexChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.squirtColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(ui.squirtBands, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(ui.squirtThreads, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibLevel, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibStripAlpha, SIGNAL(stateChanged(int)), SIGNAL(compressorConfigChanged()));
@@ -72,10 +74,12 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
   // Need to fix it.
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
   QRegExp squirtRegExp("^vtkSquirtCompressor"
-                       "\\s+"     // space
-                       "0"        // 0
-                       "\\s+"     // space
-                       "([0-9]+)" // num-of-bits.
+                       "\\s+"                // space
+                       "0"                   // 0
+                       "\\s+"                // space
+                       "([0-9]+)"            // num-of-bits.
+                       "(?:\\s+([0-9]+)"     // optional number of bands,
+                       "(?:\\s+([0-9]+))?)?" // optionally followed by the number of threads.
                        "$");
   QRegExp zlibRegExp("^vtkZlibImageCompressor"
                      "\\s+"
@@ -109,8 +113,13 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
   else if (squirtRegExp.exactMatch(value))
   {
     int numBits = squirtRegExp.cap(1).toInt();
+    // configurations without a number of bands use the single-stream format.
+    int numBands = squirtRegExp.cap(2).isEmpty() ? 1 : squirtRegExp.cap(2).toInt();
+    int numThreads = squirtRegExp.cap(3).toInt();
     ui.compressionType->setCurrentIndex(SQUIRT_COMPRESSION);
     ui.squirtColorSpace->setValue(numBits);
+    ui.squirtBands->setValue(numBands);
+    ui.squirtThreads->setValue(numThreads);
   }
   else if (zlibRegExp.exactMatch(value))
   {
@@ -144,7 +153,14 @@ QString pqImageCompressorWidget::compressorConfig() const
       return QString("vtkLZ4Compressor 0 %1").arg(ui.squirtColorSpace->value());
 
     case SQUIRT_COMPRESSION: // squirt
-      return QString("vtkSquirtCompressor 0 %1").arg(ui.squirtColorSpace->value());
+      if (ui.squirtBands->value() == 1 && ui.squirtThreads->value() == 0)
+      {
+        return QString("vtkSquirtCompressor 0 %1").arg(ui.squirtColorSpace->value());
+      }
+      return QString("vtkSquirtCompressor 0 %1 %2 %3")
+        .arg(ui.squirtColorSpace->value())
+        .arg(ui.squirtBands->value())
+        .arg(ui.squirtThreads->value());
 
     case ZLIB_COMPRESSION: // zlib
       return QString("vtkZlibImageCompressor 0 %1 %2 %3")
@@ -165,6 +181,7 @@ void pqImageCompressorWidget::currentIndexChanged(int index)
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
   ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
   ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  ui.squirtThreading->setVisible(index == SQUIRT_COMPRESSION);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
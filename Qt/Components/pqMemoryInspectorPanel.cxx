@@ -12,20 +12,28 @@
 #include "pqActiveObjects.h"
 #include "pqApplicationCore.h"
 #include "pqCoreUtilities.h"
+#include "pqPipelineSource.h"
 #include "pqRenderView.h"
+#include "pqServer.h"
 #include "pqServerManagerModel.h"
 #include "pqView.h"
 #include "vtkSMRenderViewProxy.h"
 
 #include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkPVAlgorithmMemoryInformation.h"
 #include "vtkPVDisableStackTraceSignalHandler.h"
 #include "vtkPVEnableStackTraceSignalHandler.h"
 #include "vtkPVInformation.h"
 #include "vtkPVMemoryUseInformation.h"
 #include "vtkPVSystemConfigInformation.h"
 #include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
 #include "vtkSMSession.h"
 #include "vtkSMSessionClient.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
 
 #include <QDebug>
 #include <QFont>
@@ -638,6 +646,10 @@ pqMemoryInspectorPanel::pqMemoryInspectorPanel(QWidget* pWidget, Qt::WindowFlags
   // listen for enable/disable auto update
   QObject::connect(this->Ui->autoUpdate, SIGNAL(toggled(bool)), this, SLOT(SetAutoUpdate(bool)));
 
+  // listen for enable/disable pipeline memory accounting
+  QObject::connect(this->Ui->pipelineMemory, SIGNAL(toggled(bool)), this,
+    SLOT(SetPipelineMemoryAccounting(bool)));
+
   // listen for manual update request
   QObject::connect(this->Ui->updateMemUse, SIGNAL(released()), this, SLOT(Update()));
 
@@ -756,6 +768,29 @@ void pqMemoryInspectorPanel::ServerConnected()
 #endif
 
   this->Initialize();
+  if (this->Ui->pipelineMemory->isChecked())
+  {
+    this->SetPipelineMemoryAccounting(true);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::SetPipelineMemoryAccounting(bool state)
+{
+  pqServer* server = pqActiveObjects::instance().activeServer();
+  if (!server)
+  {
+    return;
+  }
+
+  // the setting is static on each process, the proxy is not needed afterwards.
+  vtkSmartPointer<vtkSMProxy> proxy;
+  proxy.TakeReference(server->proxyManager()->NewProxy("misc", "MemoryAccounting"));
+  if (proxy)
+  {
+    vtkSMPropertyHelper(proxy, "Enabled").Set(state ? 1 : 0);
+    proxy->UpdateVTKObjects();
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -958,6 +993,7 @@ void pqMemoryInspectorPanel::Clear()
   this->StackTraceOnRenderServer = 0;
 
   this->Ui->configView->clear();
+  this->Ui->pipelineView->clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -1188,6 +1224,7 @@ void pqMemoryInspectorPanel::Update()
 
   this->UpdateRanks();
   this->UpdateHosts();
+  this->UpdatePipeline();
 
   this->PendingUpdate = false;
   this->UpdateEnabled = false;
@@ -1332,6 +1369,63 @@ void pqMemoryInspectorPanel::UpdateHosts(map<string, HostData*>& hosts)
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::UpdatePipeline()
+{
+#if defined pqMemoryInspectorPanelDEBUG
+  cerr << ":::::pqMemoryInspectorPanel::UpdatePipeline" << endl;
+#endif
+
+  this->Ui->pipelineView->clear();
+
+  pqServer* server = pqActiveObjects::instance().activeServer();
+  if (!server)
+  {
+    return;
+  }
+
+  // gather the accounting recorded by the executive for each pipeline source.
+  vector<pair<vtkTypeInt64, QTreeWidgetItem*>> items;
+  pqServerManagerModel* smm = pqApplicationCore::instance()->getServerManagerModel();
+  Q_FOREACH (pqPipelineSource* source, smm->findItems<pqPipelineSource*>(server))
+  {
+    vtkSMSourceProxy* proxy = vtkSMSourceProxy::SafeDownCast(source->getProxy());
+    if (!proxy || !proxy->GetObjectsCreated())
+    {
+      continue;
+    }
+    vtkNew<vtkPVAlgorithmMemoryInformation> info;
+    proxy->GatherInformation(info);
+    if (info->GetNumberOfProcesses() == 0)
+    {
+      // not executed yet.
+      continue;
+    }
+
+    QTreeWidgetItem* item = new QTreeWidgetItem();
+    item->setText(0, source->getSMName());
+    item->setText(1, pqCoreUtilities::formatMemoryFromKiBValue(info->GetOutputSize()));
+    item->setText(2, pqCoreUtilities::formatMemoryFromKiBValue(info->GetMaximumOutputSize()));
+    item->setText(3, pqCoreUtilities::formatMemoryFromKiBValue(info->GetAllocationDelta()));
+    item->setText(4, pqCoreUtilities::formatMemoryFromKiBValue(info->GetPeakMemory()));
+    item->setText(5, QString::number(info->GetPeakMemoryRank()));
+    items.push_back(std::make_pair(info->GetOutputSize(), item));
+  }
+
+  // largest outputs first.
+  std::stable_sort(items.begin(), items.end(),
+    [](const pair<vtkTypeInt64, QTreeWidgetItem*>& lhs,
+      const pair<vtkTypeInt64, QTreeWidgetItem*>& rhs) { return lhs.first > rhs.first; });
+  for (const auto& item : items)
+  {
+    this->Ui->pipelineView->addTopLevelItem(item.second);
+  }
+  for (int cc = 0; cc < this->Ui->pipelineView->columnCount(); ++cc)
+  {
+    this->Ui->pipelineView->resizeColumnToContents(cc);
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqMemoryInspectorPanel::EnableStackTraceOnClient(bool enable)
 {
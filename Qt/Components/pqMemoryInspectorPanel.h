@@ -70,6 +70,11 @@ protected Q_SLOTS: // NOLINT(readability-redundant-access-specifiers)
   // Enable auto update.
   void SetAutoUpdate(bool state) { this->AutoUpdate = state; }
 
+  // Description:
+  // Enable/disable the memory accounting of pipeline executions on all
+  // processes of the active server. It is disabled by default.
+  void SetPipelineMemoryAccounting(bool state);
+
   // Description:
   // enable/disable stack trace.
   void EnableStackTraceOnClient(bool enable);
@@ -104,6 +109,7 @@ private:
   void UpdateRanks();
   void UpdateHosts();
   void UpdateHosts(map<string, HostData*>& hosts);
+  void UpdatePipeline();
 
   void InitializeServerGroup(long long clientPid, vtkPVSystemConfigInformation* configs,
     int validProcessType, QTreeWidgetItem* group, string groupName, map<string, HostData*>& hosts,
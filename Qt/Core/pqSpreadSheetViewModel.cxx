@@ -39,6 +39,7 @@
 #include "pqPipelineSource.h"
 #include "pqTimer.h"
 
+#include <algorithm>
 #include <cassert>
 
 static uint qHash(pqSpreadSheetViewModel::vtkIndex index)
@@ -67,6 +68,7 @@ public:
   QItemSelectionModel SelectionModel;
   pqTimer Timer;
   pqTimer SelectionTimer;
+  pqTimer PrefetchTimer;
   int DecimalPrecision;
   bool FixedRepresentation;
   vtkIdType LastRowCount;
@@ -99,6 +101,11 @@ pqSpreadSheetViewModel::pqSpreadSheetViewModel(vtkSMProxy* view, QObject* parent
   this->Internal->Timer.setInterval(500); // milliseconds.
   QObject::connect(&this->Internal->Timer, SIGNAL(timeout()), this, SLOT(delayedUpdate()));
 
+  // blocks are prefetched one at a time, between user interactions.
+  this->Internal->PrefetchTimer.setSingleShot(true);
+  this->Internal->PrefetchTimer.setInterval(50); // milliseconds.
+  QObject::connect(&this->Internal->PrefetchTimer, SIGNAL(timeout()), this, SLOT(prefetchBlock()));
+
   this->Internal->SelectionTimer.setSingleShot(true);
   this->Internal->SelectionTimer.setInterval(100); // milliseconds.
   QObject::connect(
@@ -179,6 +186,7 @@ void pqSpreadSheetViewModel::forceUpdate()
   this->Internal->SelectionModel.clear();
   this->Internal->Timer.stop();
   this->Internal->SelectionTimer.stop();
+  this->Internal->PrefetchTimer.stop();
 
   vtkIdType& rows = this->Internal->LastRowCount;
   vtkIdType& columns = this->Internal->LastColumnCount;
@@ -215,6 +223,15 @@ void pqSpreadSheetViewModel::delayedUpdate()
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::prefetchBlock()
+{
+  if (this->Internal->ActiveRegion[0] >= 0 && this->Internal->VTKView->PrefetchBlock())
+  {
+    this->Internal->PrefetchTimer.start();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqSpreadSheetViewModel::triggerSelectionChanged()
 {
@@ -226,6 +243,16 @@ void pqSpreadSheetViewModel::setActiveRegion(int row_top, int row_bottom)
 {
   this->Internal->ActiveRegion[0] = row_top;
   this->Internal->ActiveRegion[1] = row_bottom;
+  if (row_top >= 0)
+  {
+    this->Internal->VTKView->SetViewedRows(row_top, std::max(row_top, row_bottom));
+    // prefetching does not wait for the blocks, it goes on while the user
+    // scrolls: a pending timer is not restarted.
+    if (!this->Internal->PrefetchTimer.isActive())
+    {
+      this->Internal->PrefetchTimer.start();
+    }
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -165,6 +165,11 @@ private Q_SLOTS:
    */
   void delayedUpdate();
 
+  /**
+   * called to prefetch the next block likely to be viewed.
+   */
+  void prefetchBlock();
+
   void triggerSelectionChanged();
 
   /**
@@ -18,6 +18,7 @@
 #include "vtkProcessModule.h"
 #include "vtkProcessModuleConfiguration.h"
 #include "vtkRemotingCoreConfiguration.h"
+#include "vtkSIProxyDefinitionManager.h"
 #include "vtkSMMessage.h"
 #include "vtkSMProperty.h"
 #include "vtkSMProxyManager.h"
@@ -471,6 +472,23 @@ bool vtkInitializationHelper::InitializeSettings(int type, bool defaultCoreConfi
 bool vtkInitializationHelper::InitializeOthers()
 {
   auto coreConfig = vtkRemotingCoreConfiguration::GetInstance();
+
+  // Cache the parsed core proxy definitions next to the user settings, unless
+  // the registry is disabled e.g. when testing. PARAVIEW_PROXY_DEFINITION_CACHE_DIRECTORY
+  // overrides that directory, setting it to an empty string disables the cache.
+  const char* cacheDirectory =
+    vtksys::SystemTools::GetEnv("PARAVIEW_PROXY_DEFINITION_CACHE_DIRECTORY");
+  if (cacheDirectory)
+  {
+    vtkSIProxyDefinitionManager::SetDefinitionCacheDirectory(cacheDirectory);
+  }
+  else if (!coreConfig->GetDisableRegistry() &&
+    !vtkInitializationHelper::GetUserSettingsDirectory().empty())
+  {
+    vtkSIProxyDefinitionManager::SetDefinitionCacheDirectory(
+      vtkInitializationHelper::GetUserSettingsDirectory() + "cache");
+  }
+
   // this has to happen after process module is initialized and options have
   // been set.
   paraview_initialize();
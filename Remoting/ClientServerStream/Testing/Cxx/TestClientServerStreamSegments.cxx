@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that arrays inserted with vtkClientServerStream::ReferenceArray are
+// not copied into the stream: GetSegments must return the caller's memory as
+// is, and the segments must add up to the same bytes as a stream built with
+// InsertArray.
+
+#include "vtkClientServerStream.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+int TestClientServerStreamSegments(int, char*[])
+{
+  const int numValues = 8 * 1024 * 1024;
+  std::vector<double> values(numValues);
+  std::vector<int> ids(16);
+  for (int cc = 0; cc < numValues; ++cc)
+  {
+    values[cc] = 0.5 * cc;
+  }
+  for (int cc = 0; cc < 16; ++cc)
+  {
+    ids[cc] = cc;
+  }
+
+  vtkClientServerStream referenced;
+  referenced << vtkClientServerStream::Reply << "Values"
+             << vtkClientServerStream::ReferenceArray(values.data(), numValues)
+             << vtkClientServerStream::ReferenceArray(ids.data(), 16) << 42
+             << vtkClientServerStream::End;
+  vtkClientServerStream copied;
+  copied << vtkClientServerStream::Reply << "Values"
+         << vtkClientServerStream::InsertArray(values.data(), numValues)
+         << vtkClientServerStream::InsertArray(ids.data(), 16) << 42
+         << vtkClientServerStream::End;
+
+  // The referenced arrays must show up as segments pointing to the
+  // caller's memory, everything else is small.
+  std::vector<vtkClientServerStream::Segment> segments;
+  if (!referenced.GetSegments(segments))
+  {
+    cerr << "GetSegments failed on a valid stream." << endl;
+    return EXIT_FAILURE;
+  }
+  bool foundValues = false;
+  bool foundIds = false;
+  size_t ownedBytes = 0;
+  std::vector<unsigned char> sent;
+  for (const auto& segment : segments)
+  {
+    if (segment.Data == reinterpret_cast<const unsigned char*>(values.data()))
+    {
+      foundValues = segment.Length == numValues * sizeof(double);
+    }
+    else if (segment.Data == reinterpret_cast<const unsigned char*>(ids.data()))
+    {
+      foundIds = segment.Length == 16 * sizeof(int);
+    }
+    else
+    {
+      ownedBytes += segment.Length;
+    }
+    // "Send" the segment one after the other.
+    sent.insert(sent.end(), segment.Data, segment.Data + segment.Length);
+  }
+  if (!foundValues || !foundIds)
+  {
+    cerr << "Arrays inserted by reference were copied into the stream." << endl;
+    return EXIT_FAILURE;
+  }
+  if (ownedBytes > 1024)
+  {
+    cerr << "Stream holds " << ownedBytes << " bytes, expected only the message headers." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The receiving side must get the same bytes as with InsertArray.
+  const unsigned char* data;
+  size_t length;
+  copied.GetData(&data, &length);
+  if (sent.size() != length || memcmp(sent.data(), data, length) != 0)
+  {
+    cerr << "Segments do not match the stream data." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkClientServerStream received;
+  if (!received.SetData(std::move(sent)))
+  {
+    cerr << "Could not parse the sent segments." << endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<double> result(numValues);
+  int answer = 0;
+  if (!received.GetArgument(0, 1, result.data(), numValues) || result != values ||
+    !received.GetArgument(0, 3, &answer) || answer != 42)
+  {
+    cerr << "Unexpected values in the received stream." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Reading the stream itself makes it contiguous.
+  if (!referenced.GetArgument(0, 1, result.data(), numValues) || result != values ||
+    !referenced.GetSegments(segments) || segments.size() != 1 || segments[0].Length != length)
+  {
+    cerr << "Reading a stream with referenced arrays failed." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Micro-benchmark for the serialization of large array arguments in a
+// vtkClientServerStream. For payloads from 1 KB up to `--max-size` bytes
+// (64 MB by default, use 1073741824 for 1 GB) it reports the throughput of
+// writing the array into a stream and of reconstructing a stream on the
+// receiving side, either by copying the received buffer (SetData(data, length))
+// or by handing it over to the stream (SetData(std::vector&&)). It also checks
+// that arrays added with ReferenceArray produce the same stream, are copied
+// by stream copies and can be read from several threads.
+
+#include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <vtksys/CommandLineArguments.hxx>
+
+namespace
+{
+double Throughput(size_t bytes, double seconds)
+{
+  return static_cast<double>(bytes) / (1024.0 * 1024.0) / std::max(seconds, 1e-9);
+}
+}
+
+int TestClientServerStreamThroughput(int argc, char* argv[])
+{
+  double maxSize = 64 * 1024 * 1024;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--max-size", argT::EQUAL_ARGUMENT, &maxSize, "Largest payload to benchmark in bytes.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  for (size_t size = 1024; size <= static_cast<size_t>(maxSize); size *= 8)
+  {
+    const size_t numValues = size / sizeof(double);
+    std::vector<double> values(numValues);
+    for (size_t cc = 0; cc < numValues; ++cc)
+    {
+      values[cc] = static_cast<double>(cc);
+    }
+
+    // Sending side: serialize the array.
+    vtkClientServerStream stream;
+    timer->StartTimer();
+    stream << vtkClientServerStream::Reply
+           << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(numValues))
+           << vtkClientServerStream::End;
+    timer->StopTimer();
+    const double writeTime = timer->GetElapsedTime();
+
+    const unsigned char* data;
+    size_t length;
+    if (!stream.GetData(&data, &length))
+    {
+      cerr << "Invalid stream." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // Receiving side, copying the received buffer.
+    std::vector<unsigned char> received(data, data + length);
+    vtkClientServerStream copied;
+    timer->StartTimer();
+    copied.SetData(received.data(), received.size());
+    timer->StopTimer();
+    const double copyTime = timer->GetElapsedTime();
+
+    // Receiving side, handing the received buffer over to the stream.
+    vtkClientServerStream adopted;
+    timer->StartTimer();
+    adopted.SetData(std::move(received));
+    timer->StopTimer();
+    const double adoptTime = timer->GetElapsedTime();
+
+    vtkTypeUInt32 argLength = 0;
+    if (!adopted.GetArgumentLength(0, 0, &argLength) || argLength != numValues ||
+      !copied.GetArgumentLength(0, 0, &argLength) || argLength != numValues)
+    {
+      cerr << "Unexpected array length for payload of " << size << " bytes." << endl;
+      return EXIT_FAILURE;
+    }
+    std::vector<double> result(numValues);
+    if (!adopted.GetArgument(0, 0, result.data(), argLength) || result != values)
+    {
+      cerr << "Unexpected array values for payload of " << size << " bytes." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // Sending side, referencing the array.
+    vtkClientServerStream referenced;
+    timer->StartTimer();
+    referenced << vtkClientServerStream::Reply
+               << vtkClientServerStream::ReferenceArray(values.data(), static_cast<int>(numValues))
+               << vtkClientServerStream::End;
+    timer->StopTimer();
+    const double referenceTime = timer->GetElapsedTime();
+    if (referenced.GetDataLength() != length)
+    {
+      cerr << "Unexpected referenced stream length for payload of " << size << " bytes." << endl;
+      return EXIT_FAILURE;
+    }
+    std::vector<vtkClientServerStream::Segment> segments;
+    std::vector<unsigned char> gathered;
+    referenced.GetSegments(segments);
+    for (const auto& segment : segments)
+    {
+      gathered.insert(gathered.end(), segment.Data, segment.Data + segment.Length);
+    }
+    if (gathered.size() != length || memcmp(gathered.data(), data, length) != 0)
+    {
+      cerr << "Referenced stream segments differ for payload of " << size << " bytes." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // A copy holds the values, not a reference to them.
+    vtkClientServerStream referencedCopy(referenced);
+    values[0] = -1;
+    if (!referencedCopy.GetArgument(0, 0, result.data(), argLength) || result[0] != 0)
+    {
+      cerr << "Copy of a referenced stream aliases the array for payload of " << size
+           << " bytes." << endl;
+      return EXIT_FAILURE;
+    }
+    values[0] = 0;
+
+    // Concurrent readers of a referenced stream.
+    bool valid[2] = { false, false };
+    std::vector<double> results[2] = { std::vector<double>(numValues),
+      std::vector<double>(numValues) };
+    std::thread readers[2];
+    for (int cc = 0; cc < 2; ++cc)
+    {
+      readers[cc] = std::thread([&, cc]() {
+        valid[cc] = referenced.GetArgument(0, 0, results[cc].data(), argLength) &&
+          results[cc] == values;
+      });
+    }
+    readers[0].join();
+    readers[1].join();
+    if (!valid[0] || !valid[1])
+    {
+      cerr << "Concurrent reads of a referenced stream failed for payload of " << size
+           << " bytes." << endl;
+      return EXIT_FAILURE;
+    }
+
+    cout << "payload: " << size << " bytes"
+         << " write: " << Throughput(size, writeTime) << " MB/s"
+         << " reference: " << Throughput(size, referenceTime) << " MB/s"
+         << " SetData(copy): " << Throughput(size, copyTime) << " MB/s"
+         << " SetData(move): " << Throughput(size, adoptTime) << " MB/s" << endl;
+  }
+  return EXIT_SUCCESS;
+}
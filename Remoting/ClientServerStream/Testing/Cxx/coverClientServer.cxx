@@ -6,6 +6,9 @@
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
+#include <utility>
+#include <vector>
+
 static double dblIni[] = { 904., 906., 917. };
 static const char* strIni[] = { "901", "Turbo", "Targa" };
 
@@ -318,6 +321,18 @@ bool do_test()
       return false;
     }
   }
+  vtkClientServerStream css6;
+  {
+    const unsigned char* data;
+    size_t length;
+    css5.GetData(&data, &length);
+    std::vector<unsigned char> buffer(data, data + length);
+    if (!css6.SetData(std::move(buffer)) || !buffer.empty())
+    {
+      cerr << "FAILED: SetData with buffer ownership failed." << endl;
+      return false;
+    }
+  }
 
   if (!do_check(css1))
   {
@@ -344,6 +359,11 @@ bool do_test()
     cerr << "FAILED: (Get/Set)Data did not copy stream properly." << endl;
     return false;
   }
+  if (!do_check(css6))
+  {
+    cerr << "FAILED: SetData did not adopt the stream buffer properly." << endl;
+    return false;
+  }
   return true;
 }
 
@@ -13,6 +13,8 @@
 #include "vtkVariantExtract.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -126,8 +128,10 @@ public:
     : Objects(owner)
   {
   }
+  // Copies get the values of the arrays inserted by reference, so that they
+  // do not depend on caller-owned memory.
   vtkClientServerStreamInternals(const vtkClientServerStreamInternals& r, vtkObjectBase* owner)
-    : Data(r.Data)
+    : Data(r.GetFlattenedData())
     , ValueOffsets(r.ValueOffsets)
     , MessageIndexes(r.MessageIndexes)
     , Objects(r.Objects, owner)
@@ -136,6 +140,23 @@ public:
     , String(r.String)
   {
   }
+  vtkClientServerStreamInternals& operator=(const vtkClientServerStreamInternals& r)
+  {
+    if (this != &r)
+    {
+      this->Data = r.GetFlattenedData();
+      this->ValueOffsets = r.ValueOffsets;
+      this->MessageIndexes = r.MessageIndexes;
+      this->References.clear();
+      this->ReferencedLength = 0;
+      this->HasReferences = false;
+      this->Objects = r.Objects;
+      this->StartIndex = r.StartIndex;
+      this->Invalid = r.Invalid;
+      this->String = r.String;
+    }
+    return *this;
+  }
 
   // Actual binary data in the stream.
   typedef std::vector<unsigned char> DataType;
@@ -150,6 +171,79 @@ public:
   typedef std::vector<ValueOffsetsType::size_type> MessageIndexesType;
   MessageIndexesType MessageIndexes;
 
+  // Arrays inserted by reference.  Their bytes belong at Offset in the
+  // stream but stay in caller-owned memory until the stream is read.
+  struct ReferenceType
+  {
+    DataType::difference_type Offset;
+    const unsigned char* Data;
+    size_t Length;
+  };
+  std::vector<ReferenceType> References;
+  size_t ReferencedLength = 0;
+
+  // Whether References is not empty.  Reading a stream is const but copies
+  // the arrays inserted by reference into Data first, see Flatten(); the
+  // flag and the mutex make this safe when several threads read the same
+  // stream.
+  std::atomic<bool> HasReferences{ false };
+  mutable std::mutex FlattenMutex;
+
+  // Size of the stream including the arrays inserted by reference.
+  DataType::difference_type GetSize() const
+  {
+    return static_cast<DataType::difference_type>(this->Data.size() + this->ReferencedLength);
+  }
+
+  // Copy the arrays inserted by reference into Data.
+  void Flatten()
+  {
+    if (!this->HasReferences.load(std::memory_order_acquire))
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(this->FlattenMutex);
+    if (this->References.empty())
+    {
+      // flattened by another thread in the meantime.
+      return;
+    }
+    DataType data = this->BuildFlattenedData();
+    this->Data.swap(data);
+    this->References.clear();
+    this->ReferencedLength = 0;
+    this->HasReferences.store(false, std::memory_order_release);
+  }
+
+  // Data with the arrays inserted by reference copied in place, leaving this
+  // stream unchanged.
+  DataType GetFlattenedData() const
+  {
+    std::lock_guard<std::mutex> lock(this->FlattenMutex);
+    return this->BuildFlattenedData();
+  }
+
+  DataType BuildFlattenedData() const
+  {
+    if (this->References.empty())
+    {
+      return this->Data;
+    }
+    DataType data;
+    data.reserve(this->Data.size() + this->ReferencedLength);
+    DataType::const_iterator next = this->Data.begin();
+    for (const ReferenceType& ref : this->References)
+    {
+      DataType::difference_type count =
+        ref.Offset - static_cast<DataType::difference_type>(data.size());
+      data.insert(data.end(), next, next + count);
+      next += count;
+      data.insert(data.end(), ref.Data, ref.Data + ref.Length);
+    }
+    data.insert(data.end(), next, this->Data.cend());
+    return data;
+  }
+
   // Hold references to vtkObjectBase instances stored in the stream.
   // The object that owns this stream is passed as the argument to
   // Register/UnRegister for objects stored in the stream because the
@@ -290,9 +384,10 @@ vtkClientServerStream& vtkClientServerStream::Write(const void* data, size_t len
     return *this;
   }
 
-  // Copy the value into the data.
-  this->Internal->Data.resize(this->Internal->Data.size() + length);
-  memcpy(&*(this->Internal->Data.end() - length), data, length);
+  // Copy the value into the data. Inserting the range (rather than
+  // resizing and then copying) avoids zero-filling large arrays first.
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  this->Internal->Data.insert(this->Internal->Data.end(), bytes, bytes + length);
   return *this;
 }
 
@@ -312,6 +407,9 @@ void vtkClientServerStream::Reset()
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
   this->Internal->MessageIndexes.erase(
     this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
+  this->Internal->References.clear();
+  this->Internal->ReferencedLength = 0;
+  this->Internal->HasReferences = false;
   this->Internal->Objects.Clear();
 
   // No message has yet been started.
@@ -343,7 +441,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   this->Internal->StartIndex = this->Internal->ValueOffsets.size();
 
   // The command counts as the first value in the message.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  this->Internal->ValueOffsets.push_back(this->Internal->GetSize());
 
   // Store the command in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
@@ -374,7 +472,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
 
   // All values write their type first.  Mark the start of this type
   // and optional value.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  this->Internal->ValueOffsets.push_back(this->Internal->GetSize());
 
   // Store the type in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
@@ -387,8 +485,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   if (a.Data && a.Size)
   {
     // Mark the start of this type and optional value.
-    this->Internal->ValueOffsets.push_back(
-      this->Internal->Data.end() - this->Internal->Data.begin());
+    this->Internal->ValueOffsets.push_back(this->Internal->GetSize());
 
     // If the argument is a vtk_object_pointer, we need to store a
     // reference to the object.
@@ -424,6 +521,31 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   return *this;
 }
 
+//----------------------------------------------------------------------------
+vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::ArrayReference r)
+{
+  // Store the array type and length, then reference the data.
+  const vtkClientServerStream::Array& a = r.Value;
+  *this << a.Type;
+  this->Write(&a.Length, sizeof(a.Length));
+  if (a.Size == 0)
+  {
+    return *this;
+  }
+  else if (!a.Data)
+  {
+    vtkGenericWarningMacro(
+      "vtkClientServerStream::ReferenceArray given NULL pointer and non-zero length.");
+    return *this;
+  }
+  vtkClientServerStreamInternals::ReferenceType ref = { this->Internal->GetSize(),
+    static_cast<const unsigned char*>(a.Data), a.Size };
+  this->Internal->References.push_back(ref);
+  this->Internal->ReferencedLength += a.Size;
+  this->Internal->HasReferences = true;
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator<<(const vtkClientServerStream& css)
 {
@@ -626,6 +748,28 @@ VTK_CLIENT_SERVER_INSERT_ARRAY(float)
 VTK_CLIENT_SERVER_INSERT_ARRAY(double)
 #undef VTK_CLIENT_SERVER_INSERT_ARRAY
 
+#define VTK_CLIENT_SERVER_REFERENCE_ARRAY(type)                                                    \
+  vtkClientServerStream::ArrayReference vtkClientServerStream::ReferenceArray(                     \
+    const type* data, int length)                                                                  \
+  {                                                                                                \
+    vtkClientServerStream::ArrayReference r = { vtkClientServerStreamInsertArray(data, length) };  \
+    return r;                                                                                      \
+  }
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(char)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(short)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(int)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(long)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(signed char)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(unsigned char)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(unsigned short)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(unsigned int)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(unsigned long)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(long long)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(unsigned long long)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(float)
+VTK_CLIENT_SERVER_REFERENCE_ARRAY(double)
+#undef VTK_CLIENT_SERVER_REFERENCE_ARRAY
+
 //----------------------------------------------------------------------------
 // Template to implement each type conversion in the lookup tables below.
 // The "long, long, long" arguments are used to convince VS6 to select
@@ -1452,6 +1596,9 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   // Do not return data unless stream is valid.
   if (!this->Internal->Invalid)
   {
+    // The data must be contiguous.
+    this->Internal->Flatten();
+
     if (data)
     {
       *data = &*this->Internal->Data.begin();
@@ -1478,6 +1625,45 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   }
 }
 
+//----------------------------------------------------------------------------
+size_t vtkClientServerStream::GetDataLength() const
+{
+  return this->Internal->Invalid ? 0 : static_cast<size_t>(this->Internal->GetSize());
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetSegments(std::vector<vtkClientServerStream::Segment>& segments) const
+{
+  segments.clear();
+
+  // Do not return data unless stream is valid.
+  if (this->Internal->Invalid)
+  {
+    return 0;
+  }
+
+  // Interleave the pieces of Data with the arrays inserted by reference.
+  const unsigned char* next = this->Internal->Data.data();
+  size_t offset = 0;
+  for (const auto& ref : this->Internal->References)
+  {
+    const size_t count = static_cast<size_t>(ref.Offset) - offset;
+    if (count > 0)
+    {
+      segments.push_back({ next, count });
+      next += count;
+    }
+    segments.push_back({ ref.Data, ref.Length });
+    offset = static_cast<size_t>(ref.Offset) + ref.Length;
+  }
+  const unsigned char* end = this->Internal->Data.data() + this->Internal->Data.size();
+  if (next != end)
+  {
+    segments.push_back({ next, static_cast<size_t>(end - next) });
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
 {
@@ -1491,6 +1677,22 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
     this->Internal->Data.insert(this->Internal->Data.begin(), data, data + length);
   }
 
+  return this->FinalizeSetData();
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::SetData(std::vector<unsigned char>&& data)
+{
+  // Reset and take over the given buffer, replacing the byte order entry.
+  this->Reset();
+  this->Internal->Data.swap(data);
+  vtkClientServerStreamInternals::DataType().swap(data);
+  return this->FinalizeSetData();
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::FinalizeSetData()
+{
   // Parse the stream to fill in ValueOffsets and MessageIndexes and
   // to perform byte-swapping if necessary.
   if (this->ParseData())
@@ -1840,6 +2042,7 @@ const unsigned char* vtkClientServerStream::GetValue(int message, int value) con
       this->Internal->MessageIndexes[message];
 
     // Return a pointer to the value-th value in the message.
+    this->Internal->Flatten();
     const unsigned char* data = &*this->Internal->Data.begin();
     return data + this->Internal->ValueOffsets[index + value];
   }
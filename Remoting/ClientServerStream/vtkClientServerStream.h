@@ -18,6 +18,8 @@
 #include "vtkClientServerID.h" // for vtkClientServerID
 #include "vtkVariant.h"        // for vtkVariant
 
+#include <vector> // for std::vector
+
 class vtkClientServerStreamInternals;
 
 class VTKREMOTINGCLIENTSERVERSTREAM_EXPORT vtkClientServerStream
@@ -225,9 +227,45 @@ public:
    * suitable for passing to another stream's SetData method, but are
    * invalidated when any further writing to the stream is done.
    * Returns whether the stream is currently valid.
+   *
+   * Although const, this and the other reading methods (GetValue,
+   * GetArgument, ...) first copy arrays added with ReferenceArray into
+   * the stream, once.  This is safe when several threads read the same
+   * stream, but not concurrently with writing to it or with GetSegments.
    */
   int GetData(const unsigned char** data, size_t* length) const;
 
+  /**
+   * Get the length of the data returned by GetData, without copying the
+   * arrays added with ReferenceArray into the stream.  Returns 0 when the
+   * stream is not valid.
+   */
+  size_t GetDataLength() const;
+
+  ///@{
+  /**
+   * A contiguous piece of the stream data.  Segments either point into
+   * the stream itself or into caller-owned memory added with
+   * ReferenceArray.
+   */
+  struct Segment
+  {
+    const unsigned char* Data;
+    size_t Length;
+  };
+  ///@}
+
+  /**
+   * Get the stream data as a list of segments whose concatenation is
+   * the data returned by GetData.  Unlike GetData, this does not copy
+   * arrays added with ReferenceArray into the stream, so the segments
+   * can be sent one after the other (scatter-gather) without
+   * assembling the whole stream first.  The segments are invalidated
+   * when any further writing to, or reading from, the stream is done.
+   * Returns whether the stream is currently valid.
+   */
+  int GetSegments(std::vector<vtkClientServerStream::Segment>& segments) const;
+
   //--------------------------------------------------------------------------
   // Stream writing methods:
 
@@ -245,6 +283,17 @@ public:
   };
   ///@}
 
+  ///@{
+  /**
+   * Proxy-object returned by ReferenceArray and used to insert array
+   * data into the stream without copying it.
+   */
+  struct ArrayReference
+  {
+    Array Value;
+  };
+  ///@}
+
   ///@{
   /**
    * Stream operators for special types.
@@ -253,6 +302,7 @@ public:
   vtkClientServerStream& operator<<(vtkClientServerStream::Types);
   vtkClientServerStream& operator<<(vtkClientServerStream::Argument);
   vtkClientServerStream& operator<<(vtkClientServerStream::Array);
+  vtkClientServerStream& operator<<(vtkClientServerStream::ArrayReference);
   vtkClientServerStream& operator<<(const vtkClientServerStream&);
   vtkClientServerStream& operator<<(vtkClientServerID);
   vtkClientServerStream& operator<<(vtkObjectBase*);
@@ -300,6 +350,32 @@ public:
   static vtkClientServerStream::Array InsertArray(const double*, int);
   ///@}
 
+  ///@{
+  /**
+   * Allow arrays to be passed into the stream by reference.  The values
+   * are not copied when the array is inserted: GetSegments returns them
+   * as a segment pointing to the given memory, which must therefore
+   * stay valid and unchanged until the stream has been sent or reset.
+   * Reading the stream (GetData, GetArgument, ...) copies the values
+   * into the stream first.  Copies of the stream (copy constructor,
+   * assignment, Copy) get the values as well and do not reference the
+   * given memory.
+   */
+  static vtkClientServerStream::ArrayReference ReferenceArray(const char*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const short*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const int*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const long*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const signed char*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const unsigned char*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const unsigned short*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const unsigned int*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const unsigned long*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const long long*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const unsigned long long*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const float*, int);
+  static vtkClientServerStream::ArrayReference ReferenceArray(const double*, int);
+  ///@}
+
   /**
    * Construct the entire stream from the given data.  This destroys
    * any data already in the stream.  Returns whether the stream is
@@ -307,6 +383,18 @@ public:
    */
   int SetData(const unsigned char* data, size_t length);
 
+  /**
+   * Construct the entire stream by taking ownership of the given buffer.
+   * This is the same as SetData(const unsigned char*, size_t) except that the
+   * data is not copied: the buffer is moved into the stream, which parses
+   * (and if needed byte-swaps) it in place. Use this when receiving large
+   * streams to avoid an extra copy of the payload, e.g. by receiving directly
+   * into a `std::vector<unsigned char>`. The given vector is left empty.
+   * Returns whether the stream is deemed valid.  In the case of 0, the stream
+   * will have been reset.
+   */
+  int SetData(std::vector<unsigned char>&& data);
+
   //--------------------------------------------------------------------------
   // Utility methods:
 
@@ -375,6 +463,7 @@ protected:
 
   // Data parsing utilities for SetData.
   int ParseData();
+  int FinalizeSetData();
   unsigned char* ParseCommand(
     int order, unsigned char* data, unsigned char* begin, unsigned char* end);
   void ParseEnd();
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetBlock(double value)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("values");
+  array->SetNumberOfTuples(pd->GetNumberOfPoints());
+  array->FillComponent(0, value);
+  pd->GetPointData()->AddArray(array);
+  return pd;
+}
+
+bool CheckRange(vtkPVDataInformation* info, double min, double max, const char* label)
+{
+  auto ainfo = info->GetArrayInformation("values", vtkDataObject::POINT);
+  if (!ainfo)
+  {
+    cerr << "ERROR: (" << label << ") missing `values`." << endl;
+    return false;
+  }
+  auto range = ainfo->GetComponentRange(0);
+  if (range[0] != min || range[1] != max)
+  {
+    cerr << "ERROR: (" << label << ") unexpected range [" << range[0] << ", " << range[1]
+         << "], expected [" << min << ", " << max << "]." << endl;
+    return false;
+  }
+  return true;
+}
+
+// Summaries cached for the blocks, kept alive so that a new summary can not
+// reuse the address of a released one. Stale summaries are nullptr.
+std::vector<vtkSmartPointer<vtkPVDataInformation>> GetCachedSummaries(vtkPartitionedDataSet* data)
+{
+  std::vector<vtkSmartPointer<vtkPVDataInformation>> summaries;
+  for (unsigned int cc = 0; cc < data->GetNumberOfPartitions(); ++cc)
+  {
+    summaries.emplace_back(
+      vtkPVDataInformation::GetCachedBlockInformation(data->GetPartition(cc)));
+  }
+  return summaries;
+}
+
+// Checks that the blocks were summarized again by the last gather if and only
+// if they are listed in `misses`.
+bool CheckCacheHits(vtkPartitionedDataSet* data,
+  const std::vector<vtkSmartPointer<vtkPVDataInformation>>& previous, std::vector<unsigned int> misses,
+  const char* label)
+{
+  const auto current = GetCachedSummaries(data);
+  unsigned int numHits = 0, numMisses = 0;
+  for (unsigned int cc = 0; cc < current.size(); ++cc)
+  {
+    if (current[cc] == nullptr)
+    {
+      cerr << "ERROR: (" << label << ") block " << cc << " has no cached summary." << endl;
+      return false;
+    }
+    const bool hit = current[cc] == previous[cc];
+    const bool expectMiss = std::find(misses.begin(), misses.end(), cc) != misses.end();
+    if (hit == expectMiss)
+    {
+      cerr << "ERROR: (" << label << ") block " << cc << " was "
+           << (hit ? "reused" : "summarized again") << "." << endl;
+      return false;
+    }
+    (hit ? numHits : numMisses)++;
+  }
+  if (numMisses != misses.size() || numHits + numMisses != current.size())
+  {
+    cerr << "ERROR: (" << label << ") " << numHits << " hits and " << numMisses
+         << " misses, expected " << misses.size() << " misses." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+// Checks that summaries cached for blocks between successive gathers are only
+// reused for blocks that were not modified in between.
+int TestDataInformationBlockCache(int, char*[])
+{
+  const unsigned int numBlocks = 16;
+  vtkNew<vtkPartitionedDataSet> data;
+  for (unsigned int cc = 0; cc < numBlocks; ++cc)
+  {
+    data->SetPartition(cc, GetBlock(cc));
+  }
+
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(data);
+  if (!CheckRange(info, 0, numBlocks - 1, "initial"))
+  {
+    return EXIT_FAILURE;
+  }
+  const auto numPoints = info->GetNumberOfPoints();
+
+  // unchanged data must produce the same information, from the cache only.
+  auto summaries = GetCachedSummaries(data);
+  vtkNew<vtkPVDataInformation> info2;
+  info2->CopyFromObject(data);
+  if (!CheckRange(info2, 0, numBlocks - 1, "unchanged") ||
+    info2->GetNumberOfPoints() != numPoints ||
+    info2->GetNumberOfDataSets() != static_cast<vtkTypeInt64>(numBlocks) ||
+    !CheckCacheHits(data, summaries, {}, "unchanged"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // modify a single block in place; the new values must be picked up.
+  auto block = vtkPolyData::SafeDownCast(data->GetPartition(3));
+  auto array = vtkDoubleArray::SafeDownCast(block->GetPointData()->GetArray("values"));
+  array->SetValue(0, 100.0);
+  array->Modified();
+
+  summaries = GetCachedSummaries(data);
+  info2->CopyFromObject(data);
+  if (!CheckRange(info2, 0, 100, "modified array") ||
+    !CheckCacheHits(data, summaries, { 3 }, "modified array"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // field data is not covered by the block MTime but must be picked up too.
+  vtkNew<vtkDoubleArray> fieldArray;
+  fieldArray->SetName("field");
+  fieldArray->SetNumberOfTuples(1);
+  fieldArray->SetValue(0, 1.0);
+  data->GetPartition(7)->GetFieldData()->AddArray(fieldArray);
+  summaries = GetCachedSummaries(data);
+  info2->CopyFromObject(data);
+  if (!info2->GetArrayInformation("field", vtkDataObject::FIELD) ||
+    !CheckCacheHits(data, summaries, { 7 }, "modified field data"))
+  {
+    cerr << "ERROR: field data added to a block was not picked up." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // replace a block; the new block must be summarized.
+  data->SetPartition(5, GetBlock(-1));
+  summaries = GetCachedSummaries(data);
+  info2->CopyFromObject(data);
+  if (!CheckRange(info2, -1, 100, "replaced block") ||
+    !CheckCacheHits(data, summaries, { 5 }, "replaced block"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // remove an array from a block; it must now be reported as partial.
+  block->GetPointData()->RemoveArray("values");
+  info2->CopyFromObject(data);
+  if (!info2->GetArrayInformation("values", vtkDataObject::POINT)->GetIsPartial())
+  {
+    cerr << "ERROR: `values` should be flagged as partial." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
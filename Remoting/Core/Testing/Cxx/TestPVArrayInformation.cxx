@@ -1,13 +1,16 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkLogger.h"
+#include "vtkMath.h"
 #include "vtkMathUtilities.h"
 #include "vtkNew.h"
 #include "vtkPVArrayInformation.h"
 #include "vtkSmartPointer.h"
 
+#include <array>
 #include <cstdlib>
 
 vtkSmartPointer<vtkFloatArray> GetPolyData()
@@ -53,8 +56,88 @@ bool AreArrayInformationsEqual(vtkPVArrayInformation* lhs, vtkPVArrayInformation
   return equal;
 }
 
+// Compares the single pass ranges against the ones reported by vtkDataArray
+// for a wide array with non-finite values.
+bool TestMultiComponentRanges()
+{
+  const int numComps = 9;
+  const vtkIdType numTuples = 100000;
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("tensor");
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType tt = 0; tt < numTuples; ++tt)
+  {
+    for (int cc = 0; cc < numComps; ++cc)
+    {
+      array->SetTypedComponent(tt, cc, (tt % 997) * (cc + 1) - 500.0 * cc);
+    }
+  }
+  array->SetTypedComponent(17, 2, vtkMath::Nan());
+  array->SetTypedComponent(42, 4, vtkMath::Inf());
+  array->SetTypedComponent(4242, 7, vtkMath::NegInf());
+
+  vtkNew<vtkPVArrayInformation> info;
+  info->CopyFromArray(array);
+  for (int cc = -1; cc < numComps; ++cc)
+  {
+    std::array<double, 2> expected, expectedFinite;
+    array->GetRange(expected.data(), cc);
+    array->GetFiniteRange(expectedFinite.data(), cc);
+    auto range = info->GetComponentRange(cc);
+    auto finiteRange = info->GetComponentFiniteRange(cc);
+    if (!vtkMathUtilities::FuzzyCompare(range[0], expected[0]) ||
+      !vtkMathUtilities::FuzzyCompare(range[1], expected[1]) ||
+      !vtkMathUtilities::FuzzyCompare(finiteRange[0], expectedFinite[0]) ||
+      !vtkMathUtilities::FuzzyCompare(finiteRange[1], expectedFinite[1]))
+    {
+      vtkLogF(ERROR, "Mismatched ranges for component %d: [%g, %g] / [%g, %g] instead of "
+                     "[%g, %g] / [%g, %g]",
+        cc, range[0], range[1], finiteRange[0], finiteRange[1], expected[0], expected[1],
+        expectedFinite[0], expectedFinite[1]);
+      return false;
+    }
+  }
+
+  // unchanged arrays reuse the cached ranges: a value written without
+  // modifying the array is not seen.
+  array->GetPointer(0)[0] = -1e5;
+  info->CopyFromArray(array);
+  if (info->GetComponentRange(0)[0] == -1e5)
+  {
+    vtkLogF(ERROR, "Ranges were computed again for an unchanged array.");
+    return false;
+  }
+
+  // the cached ranges must be dropped once the array is modified.
+  array->SetTypedComponent(0, 0, -1e6);
+  array->Modified();
+  info->CopyFromArray(array);
+  if (info->GetComponentRange(0)[0] != -1e6)
+  {
+    vtkLogF(ERROR, "Stale cached range after modifying the array.");
+    return false;
+  }
+
+  // the cache is kept by ParaView, not in the array's own information.
+  vtkNew<vtkDoubleArray> other;
+  other->SetNumberOfTuples(10);
+  other->FillValue(1.0);
+  info->CopyFromArray(other);
+  if (other->HasInformation())
+  {
+    vtkLogF(ERROR, "Ranges must not be cached on the array's information.");
+    return false;
+  }
+  return true;
+}
+
 int TestPVArrayInformation(int, char*[])
 {
+  if (!TestMultiComponentRanges())
+  {
+    return EXIT_FAILURE;
+  }
 
   vtkSmartPointer<vtkFloatArray> array = GetPolyData();
   vtkNew<vtkFieldData> fd;
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVProfiler.h"
+#include "vtkPVProfilerInformation.h"
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+int TestPVProfilerInformation(int, char*[])
+{
+  // nothing is recorded while disabled.
+  vtkPVProfiler::ClearEvents();
+  {
+    vtkPVProfiler::Scope scope("pipeline", "disabled");
+    if (scope.IsActive())
+    {
+      vtkLogF(ERROR, "Scope is active while the profiler is disabled.");
+      return EXIT_FAILURE;
+    }
+  }
+  if (!vtkPVProfiler::GetEvents().empty())
+  {
+    vtkLogF(ERROR, "Events were recorded while the profiler is disabled.");
+    return EXIT_FAILURE;
+  }
+
+  vtkPVProfiler::SetEnabled(true);
+  {
+    vtkPVProfiler::Scope outer("pipeline", "RequestData \"outer\"", "Sphere1");
+    {
+      vtkPVProfiler::Scope inner("delivery", "Deliver");
+      inner.AddBytes(1024);
+    }
+    std::thread([]() { vtkPVProfiler::Scope scope("compositing", "thread"); }).join();
+  }
+  vtkPVProfiler::SetEnabled(false);
+
+  auto events = vtkPVProfiler::GetEvents();
+  if (events.size() != 3)
+  {
+    vtkLogF(ERROR, "Expected 3 events, got %d.", static_cast<int>(events.size()));
+    return EXIT_FAILURE;
+  }
+  // events are stored as they end, innermost first.
+  if (events[0].Name != "Deliver" || events[0].Bytes != 1024 || events[2].ProxyName != "Sphere1")
+  {
+    vtkLogF(ERROR, "Unexpected event names, proxy or bytes.");
+    return EXIT_FAILURE;
+  }
+  if (events[2].Start > events[0].Start || events[2].Duration < events[0].Duration)
+  {
+    vtkLogF(ERROR, "The outer event does not enclose the inner one.");
+    return EXIT_FAILURE;
+  }
+  if (events[1].ThreadId == events[2].ThreadId)
+  {
+    vtkLogF(ERROR, "Events of different threads have the same thread id.");
+    return EXIT_FAILURE;
+  }
+
+  // serialize two process blocks and read them back.
+  vtkNew<vtkPVProfilerInformation> local;
+  local->ClearEventsOn();
+  local->CopyFromObject(nullptr);
+  if (!vtkPVProfiler::GetEvents().empty())
+  {
+    vtkLogF(ERROR, "ClearEvents did not clear the events.");
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPVProfilerInformation> merged;
+  merged->AddInformation(local);
+  merged->AddInformation(local);
+
+  vtkClientServerStream css;
+  merged->CopyToStream(&css);
+  vtkNew<vtkPVProfilerInformation> result;
+  result->CopyFromStream(&css);
+  if (result->GetNumberOfProcesses() != 2 || result->GetEvents(1).size() != 3)
+  {
+    vtkLogF(ERROR, "Expected 2 processes with 3 events, got %d processes.",
+      result->GetNumberOfProcesses());
+    return EXIT_FAILURE;
+  }
+  const auto& received = result->GetEvents(1);
+  if (received[2].Name != events[2].Name || received[0].Bytes != 1024 ||
+    received[1].ThreadId != events[1].ThreadId)
+  {
+    vtkLogF(ERROR, "Events were not serialized correctly.");
+    return EXIT_FAILURE;
+  }
+
+  const std::string trace = result->GetChromeTrace();
+  for (const char* expected : { "\"traceEvents\"", "RequestData \\\"outer\\\"",
+         "\"proxy\":\"Sphere1\"", "\"bytes\":1024", "\"pid\":1" })
+  {
+    if (trace.find(expected) == std::string::npos)
+    {
+      vtkLogF(ERROR, "Missing '%s' in the Chrome trace.", expected);
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Opens many simultaneous client connections to a vtkTCPNetworkAccessManager
+// and measures the latency between a client triggering an RMI and the server
+// dispatching it from ProcessEvents(), for every available event loop backend.
+// It also checks that ProcessEvents(0) blocks until an event arrives.
+// Use `--connections=N` and `--rounds=N` to change the load.
+
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkTCPNetworkAccessManager.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int STRESS_RMI_TAG = 98765;
+
+void RecordLatency(void* localArg, void* remoteArg, int remoteArgLength, int)
+{
+  auto* latencies = static_cast<std::vector<double>*>(localArg);
+  double sent;
+  if (remoteArgLength == static_cast<int>(sizeof(sent)))
+  {
+    memcpy(&sent, remoteArg, sizeof(sent));
+    latencies->push_back(vtkTimerLog::GetUniversalTime() - sent);
+  }
+}
+
+bool RunStress(int backend, bool edgeTriggered, int numConnections, int numRounds)
+{
+  // Find an available port.
+  int port = 0;
+  {
+    vtkNew<vtkServerSocket> probe;
+    if (probe->CreateServer(0) != 0)
+    {
+      cerr << "Failed to find an available port." << endl;
+      return false;
+    }
+    port = probe->GetServerPort();
+    probe->CloseSocket();
+  }
+
+  vtkNew<vtkTCPNetworkAccessManager> server;
+  server->SetEventLoopBackend(backend);
+  server->SetEdgeTriggered(edgeTriggered);
+
+  std::ostringstream listenURL;
+  listenURL << "tcp://localhost:" << port << "?listen=true&multiple=true&nonblocking=true";
+  vtkNetworkAccessManager::ConnectionResult result;
+  // Opens the server socket, no client is connecting yet.
+  server->NewConnection(listenURL.str().c_str(), result);
+
+  // The server thread signals the client thread through these flags.
+  std::mutex mutex;
+  std::condition_variable signal;
+  bool sendDelayedRMI = false;
+  bool done = false;
+  auto notify = [&](bool& flag) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      flag = true;
+    }
+    signal.notify_all();
+  };
+  std::atomic<bool> clientFailed(false);
+  std::thread clients([&]() {
+    vtkNew<vtkTCPNetworkAccessManager> clientManager;
+    std::ostringstream connectURL;
+    connectURL << "tcp://localhost:" << port << "?timeout=10";
+    std::vector<vtkSmartPointer<vtkMultiProcessController>> controllers;
+    for (int cc = 0; cc < numConnections; ++cc)
+    {
+      vtkNetworkAccessManager::ConnectionResult clientResult;
+      auto controller = vtk::TakeSmartPointer(
+        clientManager->NewConnection(connectURL.str().c_str(), clientResult));
+      if (!controller)
+      {
+        clientFailed = true;
+        return;
+      }
+      controllers.push_back(controller);
+    }
+
+    for (int round = 0; round < numRounds; ++round)
+    {
+      for (auto& controller : controllers)
+      {
+        double now = vtkTimerLog::GetUniversalTime();
+        controller->TriggerRMI(1, &now, static_cast<int>(sizeof(now)), STRESS_RMI_TAG);
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    signal.wait(lock, [&]() { return sendDelayedRMI || done; });
+    // Send one more RMI a while after the server starts waiting for it, unless
+    // the server gives up in the meantime. This is the only timed wait, it
+    // lets the server block in ProcessEvents(0).
+    if (!done && !signal.wait_for(lock, std::chrono::milliseconds(200), [&]() { return done; }))
+    {
+      double now = vtkTimerLog::GetUniversalTime();
+      controllers[0]->TriggerRMI(1, &now, static_cast<int>(sizeof(now)), STRESS_RMI_TAG);
+    }
+
+    // Keep the connections open until the server is done.
+    signal.wait(lock, [&]() { return done; });
+  });
+
+  std::vector<double> latencies;
+  std::vector<vtkSmartPointer<vtkMultiProcessController>> serverControllers;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  bool success = true;
+  while (static_cast<int>(serverControllers.size()) < numConnections && !clientFailed)
+  {
+    auto controller = vtk::TakeSmartPointer(server->NewConnection(listenURL.str().c_str(), result));
+    if (controller)
+    {
+      controller->AddRMICallback(&RecordLatency, &latencies, STRESS_RMI_TAG);
+      serverControllers.push_back(controller);
+    }
+    timer->StopTimer();
+    if (timer->GetElapsedTime() > 60)
+    {
+      break;
+    }
+  }
+  if (static_cast<int>(serverControllers.size()) != numConnections)
+  {
+    cerr << "Only " << serverControllers.size() << " of " << numConnections
+         << " connections were established." << endl;
+    success = false;
+  }
+
+  const size_t expected = static_cast<size_t>(numConnections) * numRounds;
+  timer->StartTimer();
+  while (success && latencies.size() < expected)
+  {
+    if (server->ProcessEvents(100) < 0)
+    {
+      cerr << "ProcessEvents failed." << endl;
+      success = false;
+    }
+    timer->StopTimer();
+    if (timer->GetElapsedTime() > 60)
+    {
+      cerr << "Timed out, received " << latencies.size() << " of " << expected << " RMIs."
+           << endl;
+      success = false;
+    }
+  }
+  timer->StopTimer();
+  const double dispatchTime = timer->GetElapsedTime();
+
+  // ProcessEvents(0) must block until the delayed RMI arrives rather than
+  // return right away, which would make the server spin.
+  int numberOfWaits = 0;
+  if (success)
+  {
+    notify(sendDelayedRMI);
+    while (success && latencies.size() == expected)
+    {
+      if (server->ProcessEvents(0) < 0)
+      {
+        cerr << "Blocking ProcessEvents failed." << endl;
+        success = false;
+      }
+      ++numberOfWaits;
+    }
+    if (numberOfWaits > 10)
+    {
+      cerr << "ProcessEvents(0) returned " << numberOfWaits
+           << " times before an event arrived, it does not block." << endl;
+      success = false;
+    }
+  }
+
+  notify(done);
+  clients.join();
+  serverControllers.clear();
+
+  if (success && !latencies.empty())
+  {
+    const double mean =
+      std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    std::sort(latencies.begin(), latencies.end());
+    cout << (backend == vtkTCPNetworkAccessManager::EPOLL ? "epoll" : "select")
+         << (edgeTriggered ? " (edge-triggered)" : "") << ": " << numConnections
+         << " connections, " << latencies.size() << " RMIs dispatched in " << dispatchTime
+         << " s, latency mean: " << mean * 1000.0
+         << " ms, p99: " << latencies[latencies.size() * 99 / 100] * 1000.0
+         << " ms, max: " << latencies.back() * 1000.0 << " ms" << endl;
+  }
+  return success && !clientFailed;
+}
+}
+
+int TestTCPNetworkAccessManagerStress(int argc, char* argv[])
+{
+  int numConnections = 200;
+  int numRounds = 5;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--connections", argT::EQUAL_ARGUMENT, &numConnections, "Number of client connections.");
+  arg.AddArgument("--rounds", argT::EQUAL_ARGUMENT, &numRounds, "Number of RMIs per connection.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!RunStress(vtkTCPNetworkAccessManager::SELECT, false, numConnections, numRounds))
+  {
+    return EXIT_FAILURE;
+  }
+  if (vtkTCPNetworkAccessManager::IsEPollSupported())
+  {
+    if (!RunStress(vtkTCPNetworkAccessManager::EPOLL, false, numConnections, numRounds) ||
+      !RunStress(vtkTCPNetworkAccessManager::EPOLL, true, numConnections, numRounds))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVAlgorithmMemoryInformation.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkInformation.h"
+#include "vtkInformationIdTypeKey.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataPipeline.h"
+#include "vtkProcessModule.h"
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkPVAlgorithmMemoryInformation);
+//----------------------------------------------------------------------------
+vtkPVAlgorithmMemoryInformation::vtkPVAlgorithmMemoryInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVAlgorithmMemoryInformation::~vtkPVAlgorithmMemoryInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVAlgorithmMemoryInformation::CopyFromObject(vtkObject* obj)
+{
+  auto algorithm = vtkAlgorithm::SafeDownCast(obj);
+  vtkInformation* info = algorithm ? algorithm->GetInformation() : nullptr;
+  if (!info || !info->Has(vtkPVCompositeDataPipeline::MEMORY_OUTPUT_SIZE()))
+  {
+    // not an algorithm, or it has not executed on this process.
+    return;
+  }
+
+  auto pm = vtkProcessModule::GetProcessModule();
+  this->NumberOfProcesses = 1;
+  this->OutputSize = this->MaximumOutputSize =
+    info->Get(vtkPVCompositeDataPipeline::MEMORY_OUTPUT_SIZE());
+  this->AllocationDelta = this->MaximumAllocationDelta =
+    info->Get(vtkPVCompositeDataPipeline::MEMORY_ALLOCATION_DELTA());
+  this->PeakMemory = info->Get(vtkPVCompositeDataPipeline::MEMORY_PEAK());
+  this->PeakMemoryRank = pm ? pm->GetPartitionId() : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAlgorithmMemoryInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  auto other = vtkPVAlgorithmMemoryInformation::SafeDownCast(pvinfo);
+  if (!other || other->NumberOfProcesses == 0)
+  {
+    return;
+  }
+  if (this->NumberOfProcesses == 0)
+  {
+    this->MaximumOutputSize = other->MaximumOutputSize;
+    this->MaximumAllocationDelta = other->MaximumAllocationDelta;
+  }
+  else
+  {
+    this->MaximumOutputSize = std::max(this->MaximumOutputSize, other->MaximumOutputSize);
+    this->MaximumAllocationDelta =
+      std::max(this->MaximumAllocationDelta, other->MaximumAllocationDelta);
+  }
+  if (this->NumberOfProcesses == 0 || other->PeakMemory > this->PeakMemory)
+  {
+    this->PeakMemory = other->PeakMemory;
+    this->PeakMemoryRank = other->PeakMemoryRank;
+  }
+  this->NumberOfProcesses += other->NumberOfProcesses;
+  this->OutputSize += other->OutputSize;
+  this->AllocationDelta += other->AllocationDelta;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAlgorithmMemoryInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->NumberOfProcesses << this->OutputSize
+       << this->MaximumOutputSize << this->AllocationDelta << this->MaximumAllocationDelta
+       << this->PeakMemory << this->PeakMemoryRank << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAlgorithmMemoryInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  if (!css->GetArgument(0, 0, &this->NumberOfProcesses) ||
+    !css->GetArgument(0, 1, &this->OutputSize) ||
+    !css->GetArgument(0, 2, &this->MaximumOutputSize) ||
+    !css->GetArgument(0, 3, &this->AllocationDelta) ||
+    !css->GetArgument(0, 4, &this->MaximumAllocationDelta) ||
+    !css->GetArgument(0, 5, &this->PeakMemory) || !css->GetArgument(0, 6, &this->PeakMemoryRank))
+  {
+    vtkErrorMacro("Error parsing algorithm memory information.");
+    this->NumberOfProcesses = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAlgorithmMemoryInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfProcesses: " << this->NumberOfProcesses << endl;
+  os << indent << "OutputSize: " << this->OutputSize << endl;
+  os << indent << "MaximumOutputSize: " << this->MaximumOutputSize << endl;
+  os << indent << "AllocationDelta: " << this->AllocationDelta << endl;
+  os << indent << "MaximumAllocationDelta: " << this->MaximumAllocationDelta << endl;
+  os << indent << "PeakMemory: " << this->PeakMemory << endl;
+  os << indent << "PeakMemoryRank: " << this->PeakMemoryRank << endl;
+}
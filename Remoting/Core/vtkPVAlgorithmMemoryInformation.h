@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVAlgorithmMemoryInformation
+ * @brief memory used by the last execution of an algorithm
+ *
+ * vtkPVAlgorithmMemoryInformation gathers the memory accounting that
+ * vtkPVCompositeDataPipeline records for the last execution of an algorithm:
+ * the size of its outputs, the change in process memory and the peak process
+ * memory during the execution. When gathered across ranks, totals and the
+ * largest value on any rank are kept, along with the rank that had the largest
+ * peak. Gather it from a source proxy, e.g. with
+ * vtkSMSourceProxy::GatherInformation(). All values are in KiB.
+ */
+
+#ifndef vtkPVAlgorithmMemoryInformation_h
+#define vtkPVAlgorithmMemoryInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingCoreModule.h" // needed for exports
+
+class vtkClientServerStream;
+
+class VTKREMOTINGCORE_EXPORT vtkPVAlgorithmMemoryInformation : public vtkPVInformation
+{
+public:
+  static vtkPVAlgorithmMemoryInformation* New();
+  vtkTypeMacro(vtkPVAlgorithmMemoryInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer information about a single algorithm into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  /**
+   * Number of processes on which the algorithm has executed.
+   */
+  vtkGetMacro(NumberOfProcesses, int);
+
+  ///@{
+  /**
+   * Actual memory size of the outputs, summed over processes and largest on a
+   * process.
+   */
+  vtkGetMacro(OutputSize, vtkTypeInt64);
+  vtkGetMacro(MaximumOutputSize, vtkTypeInt64);
+  ///@}
+
+  ///@{
+  /**
+   * Change in process memory during the execution, summed over processes and
+   * largest on a process.
+   */
+  vtkGetMacro(AllocationDelta, vtkTypeInt64);
+  vtkGetMacro(MaximumAllocationDelta, vtkTypeInt64);
+  ///@}
+
+  ///@{
+  /**
+   * Largest peak process memory during the execution, and the rank it was
+   * reached on. The peak is an estimate, see
+   * vtkPVCompositeDataPipeline::MEMORY_PEAK().
+   */
+  vtkGetMacro(PeakMemory, vtkTypeInt64);
+  vtkGetMacro(PeakMemoryRank, int);
+  ///@}
+
+protected:
+  vtkPVAlgorithmMemoryInformation();
+  ~vtkPVAlgorithmMemoryInformation() override;
+
+private:
+  vtkPVAlgorithmMemoryInformation(const vtkPVAlgorithmMemoryInformation&) = delete;
+  void operator=(const vtkPVAlgorithmMemoryInformation&) = delete;
+
+  int NumberOfProcesses = 0;
+  vtkTypeInt64 OutputSize = 0;
+  vtkTypeInt64 MaximumOutputSize = 0;
+  vtkTypeInt64 AllocationDelta = 0;
+  vtkTypeInt64 MaximumAllocationDelta = 0;
+  vtkTypeInt64 PeakMemory = 0;
+  int PeakMemoryRank = -1;
+};
+
+#endif
@@ -3,26 +3,37 @@
 #include "vtkPVArrayInformation.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellAttribute.h"
 #include "vtkCellGrid.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkFieldData.h"
 #include "vtkGenericAttribute.h"
 #include "vtkInformation.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKey.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkNumberToString.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPostFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -42,6 +53,214 @@ vtkTuple<double, 2> MergeRanges(const vtkTuple<double, 2>& r1, const vtkTuple<do
   return vtkTuple<double, 2>({ std::min(r1[0], r2[0]), std::max(r1[1], r2[1]) });
 }
 
+// Number of values stored per entry (magnitude or component) in the ranges
+// buffer: range min/max followed by finite range min/max.
+static constexpr int VALUES_PER_COMPONENT = 4;
+
+
+//----------------------------------------------------------------------------
+// Computes the range and finite range of every component as well as of the
+// L2 norm in a single pass over the array. Ranges are laid out as in
+// vtkPVArrayInformation::Components i.e. magnitude first. NaNs are ignored by
+// the range; the finite range also ignores infinities and, for the magnitude,
+// tuples with any non-finite component. Tuples flagged in `Ghosts` with any of
+// the `GhostsToSkip` bits are skipped.
+template <typename ArrayT>
+class ComputeRangesFunctor
+{
+public:
+  ComputeRangesFunctor(ArrayT* array, const unsigned char* ghosts, unsigned char ghostsToSkip)
+    : Array(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , Ghosts(ghosts)
+    , GhostsToSkip(ghostsToSkip)
+  {
+  }
+
+  void Initialize()
+  {
+    auto& ranges = this->LocalRanges.Local();
+    ranges.resize(VALUES_PER_COMPONENT * (this->NumberOfComponents + 1));
+    for (size_t cc = 0; cc < ranges.size(); cc += 2)
+    {
+      ranges[cc] = VTK_DOUBLE_MAX;
+      ranges[cc + 1] = -VTK_DOUBLE_MAX;
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& ranges = this->LocalRanges.Local();
+    const int numComps = this->NumberOfComponents;
+    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
+    vtkIdType tupleIdx = begin;
+    for (const auto tuple : tuples)
+    {
+      if (this->Ghosts && (this->Ghosts[tupleIdx++] & this->GhostsToSkip))
+      {
+        continue;
+      }
+
+      double squaredNorm = 0.0;
+      bool hasNaN = false;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        const double value = static_cast<double>(tuple[comp]);
+        if (vtkMath::IsNan(value))
+        {
+          hasNaN = true;
+          continue;
+        }
+        double* compRanges = &ranges[VALUES_PER_COMPONENT * (comp + 1)];
+        compRanges[0] = std::min(compRanges[0], value);
+        compRanges[1] = std::max(compRanges[1], value);
+        if (vtkMath::IsFinite(value))
+        {
+          compRanges[2] = std::min(compRanges[2], value);
+          compRanges[3] = std::max(compRanges[3], value);
+        }
+        squaredNorm += value * value;
+      }
+
+      if (!hasNaN)
+      {
+        ranges[0] = std::min(ranges[0], squaredNorm);
+        ranges[1] = std::max(ranges[1], squaredNorm);
+        if (vtkMath::IsFinite(squaredNorm))
+        {
+          ranges[2] = std::min(ranges[2], squaredNorm);
+          ranges[3] = std::max(ranges[3], squaredNorm);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->Ranges.clear();
+    for (const auto& local : this->LocalRanges)
+    {
+      if (this->Ranges.empty())
+      {
+        this->Ranges = local;
+        continue;
+      }
+      for (size_t cc = 0; cc < local.size(); cc += 2)
+      {
+        this->Ranges[cc] = std::min(this->Ranges[cc], local[cc]);
+        this->Ranges[cc + 1] = std::max(this->Ranges[cc + 1], local[cc + 1]);
+      }
+    }
+
+    // magnitude was accumulated as squared norms.
+    for (int cc = 0; cc < VALUES_PER_COMPONENT && !this->Ranges.empty(); cc += 2)
+    {
+      if (this->Ranges[cc] <= this->Ranges[cc + 1])
+      {
+        this->Ranges[cc] = std::sqrt(this->Ranges[cc]);
+        this->Ranges[cc + 1] = std::sqrt(this->Ranges[cc + 1]);
+      }
+    }
+  }
+
+  std::vector<double> Ranges;
+
+private:
+  ArrayT* Array;
+  const int NumberOfComponents;
+  const unsigned char* Ghosts;
+  const unsigned char GhostsToSkip;
+  vtkSMPThreadLocal<std::vector<double>> LocalRanges;
+};
+
+struct ComputeRangesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const unsigned char* ghosts, unsigned char ghostsToSkip,
+    std::vector<double>& ranges)
+  {
+    ComputeRangesFunctor<ArrayT> functor(array, ghosts, ghostsToSkip);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+    ranges = std::move(functor.Ranges);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Ranges computed for an array, reused for as long as neither the array nor
+// the ghost array they were computed with is modified. Arrays are only
+// referenced weakly so that the cache never keeps data alive nor writes into
+// the array's own vtkInformation.
+struct RangeCacheEntry
+{
+  vtkWeakPointer<vtkDataArray> Array;
+  vtkMTimeType ArrayMTime = 0;
+  vtkWeakPointer<vtkUnsignedCharArray> Ghosts;
+  vtkMTimeType GhostsMTime = 0;
+  unsigned char GhostsToSkip = 0;
+  std::vector<double> Ranges;
+};
+
+class RangeCache
+{
+public:
+  bool Find(vtkDataArray* array, vtkUnsignedCharArray* ghosts, unsigned char ghostsToSkip,
+    std::vector<double>& ranges)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Entries.find(array);
+    if (iter == this->Entries.end())
+    {
+      return false;
+    }
+    const RangeCacheEntry& entry = iter->second;
+    // a dead weak pointer means a new array was allocated at the same address.
+    if (entry.Array.GetPointer() != array || entry.ArrayMTime != array->GetMTime() ||
+      entry.Ghosts.GetPointer() != ghosts || (ghosts && entry.GhostsMTime != ghosts->GetMTime()) ||
+      entry.GhostsToSkip != ghostsToSkip)
+    {
+      return false;
+    }
+    ranges = entry.Ranges;
+    return true;
+  }
+
+  void Store(vtkDataArray* array, vtkUnsignedCharArray* ghosts, unsigned char ghostsToSkip,
+    const std::vector<double>& ranges)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    // drop the entries of arrays that were deleted, once the cache doubled in
+    // size since the last time, to keep the cost of storing amortized.
+    if (this->Entries.size() >= 2 * this->PrunedSize)
+    {
+      for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+      {
+        iter = iter->second.Array.GetPointer() == nullptr ? this->Entries.erase(iter)
+                                                          : std::next(iter);
+      }
+      this->PrunedSize = std::max<size_t>(this->Entries.size(), 64);
+    }
+
+    RangeCacheEntry& entry = this->Entries[array];
+    entry.Array = array;
+    entry.ArrayMTime = array->GetMTime();
+    entry.Ghosts = ghosts;
+    entry.GhostsMTime = ghosts ? ghosts->GetMTime() : 0;
+    entry.GhostsToSkip = ghostsToSkip;
+    entry.Ranges = ranges;
+  }
+
+private:
+  std::mutex Mutex;
+  std::unordered_map<vtkDataArray*, RangeCacheEntry> Entries;
+  size_t PrunedSize = 64;
+};
+
+RangeCache& GetRangeCache()
+{
+  static RangeCache cache;
+  return cache;
+}
+
 } // end of namespace
 
 vtkStandardNewMacro(vtkPVArrayInformation);
@@ -253,27 +472,62 @@ void vtkPVArrayInformation::DeepCopy(vtkPVArrayInformation* other)
 //----------------------------------------------------------------------------
 struct vtkPVArrayInformation::GetRangeFunctor
 {
-  // Compute ranges using the appropriate method: if the containing field data is available, use its
-  // method which can handle caching ghost values. Fallback to the array's method.
-  void operator()(vtkDataArray* dataArray, int componentIdx, ComponentInfo& compInfo)
-  {
-    bool rangeFound = false, finiteRangeFound = false;
+  // Compute the ranges and finite ranges of all components and of the
+  // magnitude at once. If the containing field data is available, ghost values
+  // it flags are skipped. Results are cached by ParaView, outside of the array,
+  // and reused for as long as neither the array nor the ghost array is
+  // modified.
+  void operator()(vtkDataArray* dataArray, std::vector<ComponentInfo>& components)
+  {
+    vtkUnsignedCharArray* ghostArray = nullptr;
+    const unsigned char* ghosts = nullptr;
+    unsigned char ghostsToSkip = 0;
     if (this->FieldData != nullptr && this->ArrayIdx >= 0)
     {
-      rangeFound =
-        this->FieldData->GetRange(this->ArrayIdx, compInfo.Range.GetData(), componentIdx);
-      finiteRangeFound = this->FieldData->GetFiniteRange(
-        this->ArrayIdx, compInfo.FiniteRange.GetData(), componentIdx);
+      ghostArray = this->FieldData->GetGhostArray();
+      ghostsToSkip = this->FieldData->GetGhostsToSkip();
+      if (ghostArray && ghostsToSkip && ghostArray != dataArray &&
+        ghostArray->GetNumberOfTuples() >= dataArray->GetNumberOfTuples())
+      {
+        ghosts = ghostArray->GetPointer(0);
+      }
+      else
+      {
+        ghostArray = nullptr;
+        ghostsToSkip = 0;
+      }
     }
 
-    if (!rangeFound)
+    const int numComps = dataArray->GetNumberOfComponents();
+    std::vector<double> ranges;
+    if (!::GetRangeCache().Find(dataArray, ghostArray, ghostsToSkip, ranges))
     {
-      dataArray->GetRange(compInfo.Range.GetData(), componentIdx);
+      ComputeRangesWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(dataArray, worker, ghosts, ghostsToSkip, ranges))
+      {
+        worker(dataArray, ghosts, ghostsToSkip, ranges);
+      }
+      if (ranges.empty())
+      {
+        // no tuples to process, leave all ranges invalid.
+        return;
+      }
+
+      // for single component arrays, the magnitude is the component itself
+      // (matches vtkDataArray::GetRange).
+      if (numComps == 1)
+      {
+        std::copy_n(&ranges[VALUES_PER_COMPONENT], VALUES_PER_COMPONENT, ranges.begin());
+      }
+
+      ::GetRangeCache().Store(dataArray, ghostArray, ghostsToSkip, ranges);
     }
 
-    if (!finiteRangeFound)
+    for (int cc = 0; cc <= numComps; ++cc)
     {
-      dataArray->GetFiniteRange(compInfo.FiniteRange.GetData(), componentIdx);
+      const double* compRanges = &ranges[VALUES_PER_COMPONENT * cc];
+      components[cc].Range = vtkTuple<double, 2>({ compRanges[0], compRanges[1] });
+      components[cc].FiniteRange = vtkTuple<double, 2>({ compRanges[2], compRanges[3] });
     }
   };
 
@@ -317,11 +571,7 @@ void vtkPVArrayInformation::CopyFromArrayInternal(
   auto dataArray = vtkDataArray::SafeDownCast(array);
   if (dataArray && dataArray->IsNumeric())
   {
-    for (int comp = -1; comp < numComponents; ++comp)
-    {
-      auto& compInfo = this->Components.at(comp + 1);
-      getRangeFn(dataArray, comp, compInfo);
-    }
+    getRangeFn(dataArray, this->Components);
   }
   else if (auto sarray = vtkStringArray::SafeDownCast(array))
   {
@@ -25,6 +25,7 @@
 #include "vtkExecutive.h"
 #include "vtkExplicitStructuredGrid.h"
 #include "vtkExtractBlockUsingDataAssembly.h"
+#include "vtkFieldData.h"
 #include "vtkGraph.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkImageData.h"
@@ -52,17 +53,114 @@
 #include "vtkTable.h"
 #include "vtkUniformGrid.h"
 #include "vtkUniformGridAMR.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+namespace
+{
+// MTime of a block including all of its attributes. vtkDataObject::GetMTime()
+// does not account for the field data, nor do all subclasses account for
+// their attributes.
+vtkMTimeType GetBlockMTime(vtkDataObject* dobj)
+{
+  vtkMTimeType mtime = dobj->GetMTime();
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+  {
+    if (vtkFieldData* fd = dobj->GetAttributesAsFieldData(type))
+    {
+      mtime = std::max(mtime, fd->GetMTime());
+    }
+  }
+  return mtime;
+}
+
+//----------------------------------------------------------------------------
+// Summaries of non-composite blocks, reused between gathers for as long as the
+// block is not modified. Blocks are only referenced weakly so that the cache
+// never keeps data alive nor writes into the pipeline data; summaries of
+// deleted blocks are dropped once the cache doubled in size.
+class vtkPVDataInformationBlockCache
+{
+public:
+  vtkSmartPointer<vtkPVDataInformation> Find(vtkDataObject* dobj)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Entries.find(dobj);
+    // a dead weak pointer means a new block was allocated at the same address.
+    if (iter == this->Entries.end() || iter->second.Block.GetPointer() != dobj ||
+      iter->second.MTime != ::GetBlockMTime(dobj))
+    {
+      return nullptr;
+    }
+    return iter->second.Information;
+  }
+
+  void Store(vtkDataObject* dobj, vtkPVDataInformation* info)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->Entries.size() >= 2 * this->PrunedSize)
+    {
+      for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+      {
+        iter = iter->second.Block.GetPointer() == nullptr ? this->Entries.erase(iter)
+                                                          : std::next(iter);
+      }
+      this->PrunedSize = std::max<size_t>(this->Entries.size(), 64);
+    }
+
+    Entry& entry = this->Entries[dobj];
+    entry.Block = dobj;
+    entry.MTime = ::GetBlockMTime(dobj);
+    entry.Information = info;
+  }
+
+private:
+  struct Entry
+  {
+    vtkWeakPointer<vtkDataObject> Block;
+    vtkMTimeType MTime = 0;
+    vtkSmartPointer<vtkPVDataInformation> Information;
+  };
+
+  std::mutex Mutex;
+  std::unordered_map<vtkDataObject*, Entry> Entries;
+  size_t PrunedSize = 64;
+};
+
+vtkPVDataInformationBlockCache& GetBlockCache()
+{
+  static vtkPVDataInformationBlockCache cache;
+  return cache;
+}
+}
+
 class vtkPVDataInformationAccumulator
 {
+  // Returns the summary for a non-composite block, reusing the cached one if
+  // the block hasn't been modified since.
+  vtkSmartPointer<vtkPVDataInformation> GetBlockInformation(vtkDataObject* dobj)
+  {
+    if (auto cached = ::GetBlockCache().Find(dobj))
+    {
+      return cached;
+    }
+
+    vtkNew<vtkPVDataInformation> blockInfo;
+    blockInfo->CopyFromDataObject(dobj);
+    ::GetBlockCache().Store(dobj, blockInfo);
+    return blockInfo;
+  }
+
   vtkNew<vtkPVDataInformation> Current;
 
 public:
@@ -75,13 +173,12 @@ public:
     }
     assert(vtkCompositeDataSet::SafeDownCast(dobj) == nullptr);
 
-    this->Current->Initialize();
-    this->Current->CopyFromDataObject(dobj);
-    if (this->Current->GetDataSetType() != -1)
+    auto current = this->GetBlockInformation(dobj);
+    if (current->GetDataSetType() != -1)
     {
-      assert(this->Current->GetCompositeDataSetType() == -1);
-      this->UniqueBlockTypes.insert(this->Current->GetDataSetType());
-      info->AddInformation(this->Current);
+      assert(current->GetCompositeDataSetType() == -1);
+      this->UniqueBlockTypes.insert(current->GetDataSetType());
+      info->AddInformation(current);
     }
     return info;
   }
@@ -150,10 +247,18 @@ void MergeRange(double range[2], const double orange[2])
 }
 
 vtkStandardNewMacro(vtkPVDataInformation);
+//----------------------------------------------------------------------------
+vtkPVDataInformation* vtkPVDataInformation::GetCachedBlockInformation(vtkDataObject* dobj)
+{
+  return dobj ? ::GetBlockCache().Find(dobj).GetPointer() : nullptr;
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
   this->Initialize();
+  // AddInformation() only sums, takes extrema of or unions the merged values.
+  this->TreeReduction = true;
 }
 
 //----------------------------------------------------------------------------
@@ -462,6 +462,16 @@ public:
    */
   unsigned int ComputeCompositeIndexForAMR(unsigned int level, unsigned int index) const;
 
+  /**
+   * Summaries of non-composite blocks are cached between gathers, outside of
+   * the blocks, and reused as long as neither the block nor its attributes are
+   * modified, so that only blocks that changed since the last gather are
+   * summarized again. Returns the summary cached for `dobj`, or nullptr if
+   * there is none or it is stale. The returned object is owned by the cache.
+   * This is mainly intended for testing.
+   */
+  static vtkPVDataInformation* GetCachedBlockInformation(vtkDataObject* dobj);
+
 protected:
   vtkPVDataInformation();
   ~vtkPVDataInformation() override;
@@ -58,6 +58,19 @@ public:
   vtkGetMacro(RootOnly, int);
   ///@}
 
+  ///@{
+  /**
+   * Get whether information gathered from MPI ranks can be merged along a
+   * binomial tree instead of one rank at a time on the root. Ranks are merged
+   * in increasing order either way, but the tree groups the merges
+   * differently, e.g. (r0 + r1) + (r2 + r3) instead of ((r0 + r1) + r2) + r3,
+   * so subclasses may only enable it if AddInformation() is associative and
+   * CopyToStream()/CopyFromStream() round-trip merged information. False by
+   * default.
+   */
+  vtkGetMacro(TreeReduction, bool);
+  ///@}
+
 protected:
   vtkPVInformation();
   ~vtkPVInformation() override;
@@ -65,6 +78,9 @@ protected:
   int RootOnly;
   vtkSetMacro(RootOnly, int);
 
+  bool TreeReduction;
+  vtkSetMacro(TreeReduction, bool);
+
   vtkPVInformation(const vtkPVInformation&) = delete;
   void operator=(const vtkPVInformation&) = delete;
 };
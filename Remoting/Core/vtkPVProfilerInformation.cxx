@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVProfilerInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#define vtkVerifyParseMacro(_call, _field)                                                         \
+  if (!(_call))                                                                                    \
+  {                                                                                                \
+    vtkErrorMacro("Error parsing " _field ".");                                                    \
+    this->Processes.clear();                                                                       \
+    return;                                                                                        \
+  }
+
+namespace
+{
+const char* GetProcessTypeName(int type)
+{
+  switch (type)
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      return "client";
+    case vtkProcessModule::PROCESS_SERVER:
+      return "server";
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+      return "dataserver";
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      return "renderserver";
+    case vtkProcessModule::PROCESS_BATCH:
+      return "batch";
+    default:
+      return "unknown";
+  }
+}
+
+void WriteJSONString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (const char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+          os << buffer;
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+}
+
+vtkStandardNewMacro(vtkPVProfilerInformation);
+//----------------------------------------------------------------------------
+vtkPVProfilerInformation::vtkPVProfilerInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVProfilerInformation::~vtkPVProfilerInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::CopyFromObject(vtkObject*)
+{
+  this->Processes.clear();
+
+  ProcessEvents process;
+  process.ProcessType = vtkProcessModule::GetProcessType();
+  auto pm = vtkProcessModule::GetProcessModule();
+  process.Rank = pm ? pm->GetPartitionId() : 0;
+  process.Events = vtkPVProfiler::GetEvents();
+  process.NumberOfDroppedEvents = vtkPVProfiler::GetNumberOfDroppedEvents();
+  if (this->ClearEvents)
+  {
+    vtkPVProfiler::ClearEvents();
+  }
+  this->Processes.push_back(std::move(process));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  auto info = vtkPVProfilerInformation::SafeDownCast(pvinfo);
+  if (!info)
+  {
+    return;
+  }
+  this->Processes.insert(this->Processes.end(), info->Processes.begin(), info->Processes.end());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<int>(this->Processes.size());
+  for (const auto& process : this->Processes)
+  {
+    *css << process.ProcessType << process.Rank
+         << static_cast<vtkTypeInt64>(process.NumberOfDroppedEvents)
+         << static_cast<vtkTypeInt64>(process.Events.size());
+    for (const auto& event : process.Events)
+    {
+      *css << event.Category << event.Name << event.ProxyName << event.Start << event.Duration
+           << event.ThreadId << event.Bytes << event.MemoryDelta;
+    }
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  this->Processes.clear();
+
+  int offset = 0;
+  int numberOfProcesses = 0;
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &numberOfProcesses), "number of processes");
+  this->Processes.resize(numberOfProcesses);
+  for (auto& process : this->Processes)
+  {
+    vtkTypeInt64 dropped = 0, count = 0;
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &process.ProcessType), "ProcessType");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &process.Rank), "Rank");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &dropped), "NumberOfDroppedEvents");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &count), "number of events");
+    process.NumberOfDroppedEvents = static_cast<vtkIdType>(dropped);
+    process.Events.resize(static_cast<size_t>(count));
+    for (auto& event : process.Events)
+    {
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Category), "Category");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Name), "Name");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.ProxyName), "ProxyName");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Start), "Start");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Duration), "Duration");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.ThreadId), "ThreadId");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Bytes), "Bytes");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.MemoryDelta), "MemoryDelta");
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  str << 839271 << (this->ClearEvents ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  int magic_number, clearEvents;
+  str >> magic_number >> clearEvents;
+  if (magic_number != 839271)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+  }
+  this->ClearEvents = (clearEvents != 0);
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVProfilerInformation::GetChromeTrace() const
+{
+  double origin = std::numeric_limits<double>::max();
+  for (const auto& process : this->Processes)
+  {
+    for (const auto& event : process.Events)
+    {
+      origin = std::min(origin, event.Start);
+    }
+  }
+
+  std::ostringstream os;
+  os.precision(15);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&]() -> std::ostream& {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    return os;
+  };
+
+  for (size_t pid = 0; pid < this->Processes.size(); ++pid)
+  {
+    const auto& process = this->Processes[pid];
+    std::ostringstream processName;
+    processName << GetProcessTypeName(process.ProcessType) << " " << process.Rank;
+    separator() << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid
+                << ",\"tid\":0,\"args\":{\"name\":";
+    WriteJSONString(os, processName.str());
+    os << "}}";
+    separator() << "{\"ph\":\"M\",\"name\":\"process_sort_index\",\"pid\":" << pid
+                << ",\"tid\":0,\"args\":{\"sort_index\":" << pid << "}}";
+
+    // thread ids are hashes, map them to small numbers in order of appearance.
+    std::map<vtkTypeUInt64, int> tids;
+    for (const auto& event : process.Events)
+    {
+      const int tid = tids.insert(std::make_pair(event.ThreadId, static_cast<int>(tids.size())))
+                        .first->second;
+      separator() << "{\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"cat\":";
+      WriteJSONString(os, event.Category);
+      os << ",\"name\":";
+      WriteJSONString(os, event.Name);
+      os << ",\"ts\":" << (event.Start - origin) * 1e6 << ",\"dur\":" << event.Duration * 1e6
+         << ",\"args\":{\"rank\":" << process.Rank;
+      if (!event.ProxyName.empty())
+      {
+        os << ",\"proxy\":";
+        WriteJSONString(os, event.ProxyName);
+      }
+      if (event.Bytes != 0)
+      {
+        os << ",\"bytes\":" << event.Bytes;
+      }
+      os << ",\"memory_delta\":" << event.MemoryDelta << "}}";
+    }
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVProfilerInformation::WriteChromeTrace(const char* filename) const
+{
+  if (!filename || !*filename)
+  {
+    vtkErrorMacro("Invalid filename.");
+    return false;
+  }
+  vtksys::ofstream ofs(filename, std::ios::out | std::ios::binary);
+  if (!ofs)
+  {
+    vtkErrorMacro("Failed to open '" << filename << "' for writing.");
+    return false;
+  }
+  ofs << this->GetChromeTrace();
+  return static_cast<bool>(ofs);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfilerInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ClearEvents: " << this->ClearEvents << endl;
+  for (const auto& process : this->Processes)
+  {
+    os << indent << GetProcessTypeName(process.ProcessType) << " " << process.Rank << ": "
+       << process.Events.size() << " events (" << process.NumberOfDroppedEvents << " dropped)"
+       << endl;
+  }
+}
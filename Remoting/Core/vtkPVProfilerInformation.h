@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVProfilerInformation
+ * @brief gathers the events recorded by vtkPVProfiler
+ *
+ * vtkPVProfilerInformation collects the events recorded by vtkPVProfiler on
+ * every process it is gathered from, tagged with the process type and rank,
+ * and can export them as a Chrome trace (the JSON format read by
+ * chrome://tracing and https://ui.perfetto.dev) in which each process is a
+ * row and each thread a track.
+ *
+ * @code{cpp}
+ * vtkNew<vtkPVProfilerInformation> info;
+ * session->GatherInformation(vtkPVSession::CLIENT_AND_SERVERS, info, 0);
+ * info->WriteChromeTrace("trace.json");
+ * @endcode
+ */
+
+#ifndef vtkPVProfilerInformation_h
+#define vtkPVProfilerInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkPVProfiler.h"         // for vtkPVProfiler::Event
+#include "vtkRemotingCoreModule.h" // needed for exports
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkClientServerStream;
+
+class VTKREMOTINGCORE_EXPORT vtkPVProfilerInformation : public vtkPVInformation
+{
+public:
+  static vtkPVProfilerInformation* New();
+  vtkTypeMacro(vtkPVProfilerInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer the events recorded on this process into this object. The object
+   * is ignored.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  ///@{
+  /**
+   * Serialize/Deserialize the parameters that control how/what information is
+   * gathered.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  ///@}
+
+  ///@{
+  /**
+   * When set, each process clears its recorded events once they have been
+   * gathered. Default is false.
+   */
+  vtkSetMacro(ClearEvents, bool);
+  vtkGetMacro(ClearEvents, bool);
+  vtkBooleanMacro(ClearEvents, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Access the gathered events, one block per process.
+   */
+  int GetNumberOfProcesses() const { return static_cast<int>(this->Processes.size()); }
+  int GetProcessType(int index) const { return this->Processes[index].ProcessType; }
+  int GetRank(int index) const { return this->Processes[index].Rank; }
+  vtkIdType GetNumberOfDroppedEvents(int index) const
+  {
+    return this->Processes[index].NumberOfDroppedEvents;
+  }
+  const std::vector<vtkPVProfiler::Event>& GetEvents(int index) const
+  {
+    return this->Processes[index].Events;
+  }
+  ///@}
+
+  /**
+   * Returns the gathered events as a Chrome trace JSON document. Timestamps
+   * are in microseconds since the earliest gathered event.
+   */
+  std::string GetChromeTrace() const;
+
+  /**
+   * Writes GetChromeTrace() to a file. Returns false on failure.
+   */
+  bool WriteChromeTrace(const char* filename) const;
+
+protected:
+  vtkPVProfilerInformation();
+  ~vtkPVProfilerInformation() override;
+
+private:
+  vtkPVProfilerInformation(const vtkPVProfilerInformation&) = delete;
+  void operator=(const vtkPVProfilerInformation&) = delete;
+
+  struct ProcessEvents
+  {
+    int ProcessType = -1;
+    int Rank = 0;
+    vtkIdType NumberOfDroppedEvents = 0;
+    std::vector<vtkPVProfiler::Event> Events;
+  };
+
+  std::vector<ProcessEvents> Processes;
+  bool ClearEvents = false;
+};
+
+#endif
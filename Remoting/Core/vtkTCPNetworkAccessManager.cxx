@@ -17,18 +17,35 @@
 #include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define VTK_TCP_NAM_HAS_EPOLL 1
+#else
+#define VTK_TCP_NAM_HAS_EPOLL 0
+#endif
+
+#if defined(_WIN32)
+#include <winsock2.h> // for FD_SETSIZE
+#else
+#include <sys/select.h> // for FD_SETSIZE
+#endif
+
 // set this to 1 if you want to generate a log file with all the raw socket
 // communication.
 #define GENERATE_DEBUG_LOG 0
 
-#define MAX_SOCKETS 256
-
 class vtkTCPNetworkAccessManager::vtkInternals
 {
 public:
@@ -36,8 +53,284 @@ public:
   VectorOfControllers Controllers;
   typedef std::map<int, vtkSmartPointer<vtkServerSocket>> MapToServerSockets;
   MapToServerSockets ServerSockets;
+
+  // Descriptors of the connected sockets and the controller or server socket
+  // they belong to, connections first. Only rebuilt by UpdateSockets() once a
+  // connection or server socket was added or removed, see Register() and
+  // Unregister(), or closed or deleted behind our back.
+  std::vector<int> Sockets;
+  std::vector<vtkWeakPointer<vtkObject>> ControllerOrServerSocket;
+  size_t NumberOfConnections = 0;
+  bool SocketsModified = true;
+
+  void UpdateSockets()
+  {
+    this->Sockets.clear();
+    this->ControllerOrServerSocket.clear();
+    for (const auto& controller : this->Controllers)
+    {
+      const int fd = vtkInternals::GetSocketDescriptor(controller);
+      if (fd >= 0)
+      {
+        this->Sockets.push_back(fd);
+        this->ControllerOrServerSocket.emplace_back(controller.GetPointer());
+      }
+    }
+    this->NumberOfConnections = this->Sockets.size();
+    for (const auto& item : this->ServerSockets)
+    {
+      const int fd = vtkInternals::GetSocketDescriptor(item.second);
+      if (fd >= 0)
+      {
+        this->Sockets.push_back(fd);
+        this->ControllerOrServerSocket.emplace_back(item.second.GetPointer());
+      }
+    }
+    this->SocketsModified = false;
+  }
+
+  // Returns false if a connection or server socket of the cached list was
+  // deleted or closed.
+  bool AreSocketsValid() const
+  {
+    for (size_t cc = 0; cc < this->Sockets.size(); ++cc)
+    {
+      vtkObject* owner = this->ControllerOrServerSocket[cc].GetPointer();
+      if (!owner || vtkInternals::GetSocketDescriptor(owner) != this->Sockets[cc])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+#if VTK_TCP_NAM_HAS_EPOLL
+  struct RegisteredSocket
+  {
+    vtkWeakPointer<vtkObject> Owner;
+    bool EdgeTriggered;
+  };
+
+  int EPollDescriptor = -1;
+  // Whether connections were registered edge-triggered when the interest set
+  // was filled.
+  bool EdgeTriggered = false;
+  // Descriptors currently in the epoll interest set. Closed descriptors are
+  // removed from the kernel's set automatically, their entries are replaced
+  // when the descriptor is reused.
+  std::unordered_map<int, RegisteredSocket> Registered;
+  // Descriptors reported ready by epoll_wait() but not dispatched yet.
+  std::deque<int> Ready;
+
+  ~vtkInternals() { this->CloseEPoll(); }
+
+  void CloseEPoll()
+  {
+    if (this->EPollDescriptor >= 0)
+    {
+      close(this->EPollDescriptor);
+      this->EPollDescriptor = -1;
+    }
+    this->Registered.clear();
+    this->Ready.clear();
+  }
+
+  // Opens the epoll descriptor and registers all the connections and server
+  // sockets, unless this was already done with the same edge-triggered mode.
+  // Later changes are applied with Register() and Unregister().
+  bool PrepareEPoll(bool edgeTriggered)
+  {
+    if (this->EPollDescriptor >= 0 && this->EdgeTriggered == edgeTriggered)
+    {
+      return true;
+    }
+    this->CloseEPoll();
+    this->EPollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (this->EPollDescriptor < 0)
+    {
+      return false;
+    }
+    this->EdgeTriggered = edgeTriggered;
+    for (const auto& controller : this->Controllers)
+    {
+      this->Register(controller);
+    }
+    for (const auto& item : this->ServerSockets)
+    {
+      this->Register(item.second);
+    }
+    return true;
+  }
+#endif
+
+  // Add a connection or server socket to the epoll interest set, if the epoll
+  // backend is in use.
+  void Register(vtkObject* owner)
+  {
+    this->SocketsModified = true;
+#if VTK_TCP_NAM_HAS_EPOLL
+    const int fd = vtkInternals::GetSocketDescriptor(owner);
+    if (this->EPollDescriptor < 0 || fd < 0)
+    {
+      return;
+    }
+    const bool et = this->EdgeTriggered && !owner->IsA("vtkServerSocket");
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLRDHUP | (et ? EPOLLET : 0);
+    event.data.fd = fd;
+    if (epoll_ctl(this->EPollDescriptor, EPOLL_CTL_ADD, fd, &event) != 0 && errno == EEXIST)
+    {
+      epoll_ctl(this->EPollDescriptor, EPOLL_CTL_MOD, fd, &event);
+    }
+    this->Registered[fd] = RegisteredSocket{ owner, et };
+    if (et)
+    {
+      // Data that arrived before the registration will not produce an edge,
+      // make sure it gets looked at.
+      this->Ready.push_back(fd);
+    }
+#else
+    (void)owner;
+#endif
+  }
+
+  // Remove a connection or server socket from the epoll interest set. This
+  // must be called before its socket is closed.
+  void Unregister(vtkObject* owner)
+  {
+    this->SocketsModified = true;
+#if VTK_TCP_NAM_HAS_EPOLL
+    const int fd = vtkInternals::GetSocketDescriptor(owner);
+    if (this->EPollDescriptor >= 0 && fd >= 0)
+    {
+      epoll_ctl(this->EPollDescriptor, EPOLL_CTL_DEL, fd, nullptr);
+      this->Registered.erase(fd);
+    }
+#else
+    (void)owner;
+#endif
+  }
+
+  // Returns the descriptor of a connection or server socket, -1 if it is not
+  // connected.
+  static int GetSocketDescriptor(vtkObject* owner)
+  {
+    vtkSocket* socket = vtkSocket::SafeDownCast(owner);
+    if (auto controller = vtkSocketController::SafeDownCast(owner))
+    {
+      auto comm = vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+      socket = comm ? comm->GetSocket() : nullptr;
+    }
+    return (socket && socket->GetConnected()) ? socket->GetSocketDescriptor() : -1;
+  }
+
+#if VTK_TCP_NAM_HAS_EPOLL
+  // Returns true if reading from the socket will not block, i.e. data is
+  // available, or the connection was closed or is in error.
+  static bool HasPendingInput(int fd)
+  {
+    char c;
+    const ssize_t result = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return result >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+  }
+
+  // Same return values as vtkSocket::SelectSockets(), the selected connection
+  // or server socket is returned in `selected`. It stays at the front of
+  // this->Ready until ConsumeReady() is called.
+  int WaitEPoll(unsigned long timeout_msecs, bool edgeTriggered, vtkObject** selected)
+  {
+    if (!this->PrepareEPoll(edgeTriggered))
+    {
+      return -1;
+    }
+
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+      // Dispatch events left over from a previous epoll_wait() first, dropping
+      // the ones that are no longer valid.
+      while (!this->Ready.empty())
+      {
+        const int fd = this->Ready.front();
+        auto riter = this->Registered.find(fd);
+        vtkObject* owner =
+          riter != this->Registered.end() ? riter->second.Owner.GetPointer() : nullptr;
+        if (!owner || vtkInternals::GetSocketDescriptor(owner) != fd)
+        {
+          // the connection was deleted or closed.
+          if (riter != this->Registered.end())
+          {
+            epoll_ctl(this->EPollDescriptor, EPOLL_CTL_DEL, fd, nullptr);
+            this->Registered.erase(riter);
+          }
+          this->Ready.pop_front();
+          continue;
+        }
+        if (!owner->IsA("vtkServerSocket") && !vtkInternals::HasPendingInput(fd))
+        {
+          this->Ready.pop_front();
+          continue;
+        }
+        *selected = owner;
+        return 1;
+      }
+
+      if (attempt == 1)
+      {
+        break;
+      }
+
+      const int maxEvents = 64;
+      epoll_event events[maxEvents];
+      // like vtkSocket::SelectSockets(), a timeout of 0 waits until an event
+      // arrives.
+      const int timeout = (timeout_msecs == 0)
+        ? -1
+        : static_cast<int>(std::min<unsigned long>(timeout_msecs, VTK_INT_MAX));
+      const int count = epoll_wait(this->EPollDescriptor, events, maxEvents, timeout);
+      if (count < 0)
+      {
+        return errno == EINTR ? 0 : -1;
+      }
+      for (int cc = 0; cc < count; ++cc)
+      {
+        this->Ready.push_back(events[cc].data.fd);
+      }
+    }
+    return 0;
+  }
+
+  // Called once the socket returned by WaitEPoll() is being processed.
+  void ConsumeReady(bool edgeTriggered)
+  {
+    if (!this->Ready.empty())
+    {
+      const int fd = this->Ready.front();
+      this->Ready.pop_front();
+      if (edgeTriggered)
+      {
+        // No new edge will be reported for data already buffered, check this
+        // socket again on the next call.
+        this->Ready.push_back(fd);
+      }
+    }
+  }
+#endif
 };
 
+namespace
+{
+// select() cannot wait on more than FD_SETSIZE sockets on Windows, nor on
+// descriptors greater than or equal to FD_SETSIZE elsewhere.
+bool ExceedsSelectLimit(const std::vector<int>& sockets)
+{
+#if defined(_WIN32)
+  return sockets.size() > static_cast<size_t>(FD_SETSIZE);
+#else
+  return std::any_of(sockets.begin(), sockets.end(), [](int fd) { return fd >= FD_SETSIZE; });
+#endif
+}
+}
+
 vtkStandardNewMacro(vtkTCPNetworkAccessManager);
 //----------------------------------------------------------------------------
 vtkTCPNetworkAccessManager::vtkTCPNetworkAccessManager()
@@ -45,6 +338,15 @@ vtkTCPNetworkAccessManager::vtkTCPNetworkAccessManager()
   this->Internals = new vtkInternals();
   this->AbortPendingConnectionFlag = false;
   this->WrongConnectID = false;
+  this->EventLoopBackend = SELECT;
+  this->EdgeTriggered = false;
+
+  std::string backend;
+  if (vtksys::SystemTools::GetEnv("PARAVIEW_NAM_EVENT_LOOP", backend) &&
+    vtksys::SystemTools::LowerCase(backend) == "epoll")
+  {
+    this->SetEventLoopBackend(EPOLL);
+  }
 
   // It's essential to initialize the socket controller to initialize sockets on
   // Windows.
@@ -139,6 +441,7 @@ void vtkTCPNetworkAccessManager::DisableFurtherConnections(int port, bool disabl
   {
     if (this->Internals->ServerSockets.find(port) != this->Internals->ServerSockets.end())
     {
+      this->Internals->Unregister(this->Internals->ServerSockets.at(port));
       this->Internals->ServerSockets.at(port)->CloseSocket();
       this->Internals->ServerSockets.erase(port);
     }
@@ -153,10 +456,40 @@ void vtkTCPNetworkAccessManager::DisableFurtherConnections(int port, bool disabl
       return;
     }
     this->Internals->ServerSockets[port] = server_socket;
+    this->Internals->Register(server_socket);
     server_socket->FastDelete();
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkTCPNetworkAccessManager::IsEPollSupported()
+{
+  return VTK_TCP_NAM_HAS_EPOLL == 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkTCPNetworkAccessManager::SetEventLoopBackend(int backend)
+{
+  if (backend == EPOLL && !vtkTCPNetworkAccessManager::IsEPollSupported())
+  {
+    vtkWarningMacro("EPOLL event loop is not supported on this platform, using SELECT.");
+    backend = SELECT;
+  }
+  if (backend != SELECT && backend != EPOLL)
+  {
+    vtkErrorMacro("Unknown event loop backend: " << backend);
+    return;
+  }
+  if (this->EventLoopBackend != backend)
+  {
+    this->EventLoopBackend = backend;
+#if VTK_TCP_NAM_HAS_EPOLL
+    this->Internals->CloseEPoll();
+#endif
+    this->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkTCPNetworkAccessManager::GetWrongConnectID()
 {
@@ -179,59 +512,36 @@ int vtkTCPNetworkAccessManager::ProcessEvents(unsigned long timeout_msecs)
 int vtkTCPNetworkAccessManager::ProcessEventsInternal(
   unsigned long timeout_msecs, bool do_processing)
 {
-  int sockets_to_select[MAX_SOCKETS];
-  vtkObject* controller_or_server_socket[MAX_SOCKETS];
+  vtkInternals& internals = *this->Internals;
+  if (internals.SocketsModified || !internals.AreSocketsValid())
+  {
+    internals.UpdateSockets();
+  }
+  const std::vector<int>& sockets_to_select = internals.Sockets;
 
   vtkSocketController* ctrlWithBufferToEmpty = nullptr;
-  int size = 0;
-  vtkInternals::VectorOfControllers::iterator iter1;
-  for (iter1 = this->Internals->Controllers.begin(); iter1 != this->Internals->Controllers.end();
-       ++iter1)
+  for (size_t cc = 0; cc < internals.NumberOfConnections; ++cc)
   {
-    vtkSocketController* controller = iter1->GetPointer();
-    if (!controller)
-    {
-      // skip nullptr controllers.
-      continue;
-    }
+    vtkSocketController* controller =
+      static_cast<vtkSocketController*>(internals.ControllerOrServerSocket[cc].GetPointer());
     vtkSocketCommunicator* comm =
       vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
-    vtkSocket* socket = comm->GetSocket();
-    if (socket && socket->GetConnected())
+    if (comm->HasBufferredMessages())
     {
-      sockets_to_select[size] = socket->GetSocketDescriptor();
-      controller_or_server_socket[size] = controller;
-      if (comm->HasBufferredMessages())
+      ctrlWithBufferToEmpty = controller;
+      if (!do_processing)
       {
-        ctrlWithBufferToEmpty = controller;
-        if (!do_processing)
-        {
-          // we do have events to process, but we were told not to process them,
-          // so just return and say we have something to process here.
-          return 1;
-        }
+        // we do have events to process, but we were told not to process them,
+        // so just return and say we have something to process here.
+        return 1;
       }
-      size++;
     }
   }
 
   // Only one client connected, so if it fails, just quit...
-  bool can_quit_if_error = (size == 1);
+  bool can_quit_if_error = (internals.NumberOfConnections == 1);
 
-  // Now add server sockets.
-  vtkInternals::MapToServerSockets::iterator iter2;
-  for (iter2 = this->Internals->ServerSockets.begin();
-       iter2 != this->Internals->ServerSockets.end(); ++iter2)
-  {
-    if (iter2->second.GetPointer() && iter2->second.GetPointer()->GetConnected())
-    {
-      sockets_to_select[size] = iter2->second.GetPointer()->GetSocketDescriptor();
-      controller_or_server_socket[size] = iter2->second.GetPointer();
-      size++;
-    }
-  }
-
-  if (size == 0 || this->AbortPendingConnectionFlag)
+  if (sockets_to_select.empty() || this->AbortPendingConnectionFlag)
   {
     // Connection failed / aborted.
     return -1;
@@ -244,8 +554,36 @@ int vtkTCPNetworkAccessManager::ProcessEventsInternal(
     return 1;
   }
 
-  int selected_index = -1;
-  int result = vtkSocket::SelectSockets(sockets_to_select, size, timeout_msecs, &selected_index);
+  if (this->EventLoopBackend == SELECT && ::ExceedsSelectLimit(sockets_to_select))
+  {
+    if (!vtkTCPNetworkAccessManager::IsEPollSupported())
+    {
+      vtkErrorMacro("Too many sockets to wait on with select(), at most "
+        << FD_SETSIZE << " are supported on this platform.");
+      return -1;
+    }
+    vtkWarningMacro("Too many sockets to wait on with select(), switching to the EPOLL backend.");
+    this->SetEventLoopBackend(EPOLL);
+  }
+
+  vtkObject* selected = nullptr;
+  int result;
+#if VTK_TCP_NAM_HAS_EPOLL
+  if (this->EventLoopBackend == EPOLL)
+  {
+    result = internals.WaitEPoll(timeout_msecs, this->EdgeTriggered, &selected);
+  }
+  else
+#endif
+  {
+    int selected_index = -1;
+    result = vtkSocket::SelectSockets(sockets_to_select.data(),
+      static_cast<int>(sockets_to_select.size()), timeout_msecs, &selected_index);
+    if (result > 0)
+    {
+      selected = internals.ControllerOrServerSocket[selected_index].GetPointer();
+    }
+  }
   if (result <= 0)
   {
     return result;
@@ -257,10 +595,17 @@ int vtkTCPNetworkAccessManager::ProcessEventsInternal(
     return 1;
   }
 
-  if (controller_or_server_socket[selected_index]->IsA("vtkServerSocket"))
+  const bool is_server_socket = selected->IsA("vtkServerSocket");
+#if VTK_TCP_NAM_HAS_EPOLL
+  if (this->EventLoopBackend == EPOLL)
+  {
+    internals.ConsumeReady(this->EdgeTriggered && !is_server_socket);
+  }
+#endif
+
+  if (is_server_socket)
   {
-    vtkServerSocket* ss =
-      static_cast<vtkServerSocket*>(controller_or_server_socket[selected_index]);
+    vtkServerSocket* ss = static_cast<vtkServerSocket*>(selected);
     int port = ss->GetServerPort();
     this->InvokeEvent(vtkCommand::ConnectionCreatedEvent, &port);
     return 1;
@@ -271,7 +616,7 @@ int vtkTCPNetworkAccessManager::ProcessEventsInternal(
     // during the whole ProcessRMIs call. As that call can release
     // the controller while executing.
     vtkSmartPointer<vtkMultiProcessController> controller =
-      vtkMultiProcessController::SafeDownCast(controller_or_server_socket[selected_index]);
+      vtkMultiProcessController::SafeDownCast(selected);
     result = controller->ProcessRMIs(0, 1);
     if (result == vtkMultiProcessController::RMI_NO_ERROR)
     {
@@ -287,6 +632,7 @@ int vtkTCPNetworkAccessManager::ProcessEventsInternal(
     // Close cleanly the socket in error
     vtkSocketCommunicator* comm =
       vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+    this->Internals->Unregister(controller);
     comm->CloseConnection();
 
     // Fire an event letting the world know that the connection was closed.
@@ -421,6 +767,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(const cha
     return nullptr;
   }
   this->Internals->Controllers.push_back(controller);
+  this->Internals->Register(controller);
   result = vtkNetworkAccessManager::ConnectionResult::CONNECTION_SUCCESS;
   return controller;
 }
@@ -446,6 +793,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(int por
       return nullptr;
     }
     this->Internals->ServerSockets[port] = server_socket;
+    this->Internals->Register(server_socket);
     server_socket->FastDelete();
   }
 
@@ -505,6 +853,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(int por
   if (controller)
   {
     this->Internals->Controllers.push_back(controller);
+    this->Internals->Register(controller);
     result = vtkNetworkAccessManager::ConnectionResult::CONNECTION_SUCCESS;
   }
   else if (this->AbortPendingConnectionFlag)
@@ -514,6 +863,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(int por
 
   if (once)
   {
+    this->Internals->Unregister(server_socket);
     server_socket->CloseSocket();
     this->Internals->ServerSockets.erase(port);
   }
@@ -620,4 +970,7 @@ int vtkTCPNetworkAccessManager::ParaViewHandshake(
 void vtkTCPNetworkAccessManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "EventLoopBackend: " << (this->EventLoopBackend == EPOLL ? "EPOLL" : "SELECT")
+     << endl;
+  os << indent << "EdgeTriggered: " << this->EdgeTriggered << endl;
 }
@@ -6,6 +6,14 @@
  * vtkTCPNetworkAccessManager is a concrete implementation of
  * vtkNetworkAccessManager that uses tcp/ip sockets for communication between
  * processes. It supports urls that use "tcp" as their protocol specifier.
+ *
+ * ProcessEvents() waits for activity on all the connections and server sockets
+ * using one of two backends, see SetEventLoopBackend(). The default SELECT
+ * backend rebuilds the set of watched sockets and calls select() on every
+ * call. On Linux, the EPOLL backend keeps a persistent interest set in the
+ * kernel, updated as connections and server sockets are added and removed,
+ * which scales much better with many simultaneous connections (collaboration,
+ * Catalyst Live) and is not limited to FD_SETSIZE descriptors.
  */
 
 #ifndef vtkTCPNetworkAccessManager_h
@@ -100,6 +108,45 @@ public:
    */
   bool GetWrongConnectID() override;
 
+  /**
+   * Backends available to wait for network activity in ProcessEvents().
+   */
+  enum EventLoopBackends
+  {
+    SELECT = 0,
+    EPOLL = 1
+  };
+
+  ///@{
+  /**
+   * Get/Set the backend used to wait for network activity. EPOLL is only
+   * available on Linux, requesting it elsewhere falls back to SELECT with a
+   * warning. The default is SELECT, unless the `PARAVIEW_NAM_EVENT_LOOP`
+   * environment variable is set to `epoll`. When there are more sockets than
+   * select() supports (FD_SETSIZE), ProcessEvents() switches to EPOLL if
+   * available and fails otherwise.
+   */
+  void SetEventLoopBackend(int backend);
+  vtkGetMacro(EventLoopBackend, int);
+  ///@}
+
+  /**
+   * Returns true if the EPOLL backend is available on this platform.
+   */
+  static bool IsEPollSupported();
+
+  ///@{
+  /**
+   * When using the EPOLL backend, register connections as edge-triggered.
+   * Connections reported ready are then re-checked with a non-blocking peek
+   * after each dispatch instead of being reported again by the kernel.
+   * Server sockets are always level-triggered. Default is false.
+   */
+  vtkSetMacro(EdgeTriggered, bool);
+  vtkGetMacro(EdgeTriggered, bool);
+  vtkBooleanMacro(EdgeTriggered, bool);
+  ///@}
+
 protected:
   vtkTCPNetworkAccessManager();
   ~vtkTCPNetworkAccessManager() override;
@@ -136,6 +183,8 @@ protected:
 
   bool AbortPendingConnectionFlag;
   bool WrongConnectID;
+  int EventLoopBackend;
+  bool EdgeTriggered;
 
 private:
   vtkTCPNetworkAccessManager(const vtkTCPNetworkAccessManager&) = delete;
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+int TestGatherInformationAsync(int vtkNotUsed(argc), char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  int exitCode = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMSession> session;
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    // issue several requests before waiting on any of them.
+    std::vector<vtkSmartPointer<vtkSMSourceProxy>> spheres;
+    std::vector<vtkSmartPointer<vtkPVDataInformation>> informations;
+    std::vector<vtkTypeUInt32> requests;
+    int replies = 0;
+    for (int cc = 0; cc < 4; ++cc)
+    {
+      vtkSmartPointer<vtkSMSourceProxy> sphere;
+      sphere.TakeReference(
+        vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+      vtkSMPropertyHelper(sphere, "ThetaResolution").Set(8 + cc);
+      sphere->UpdateVTKObjects();
+      sphere->UpdatePipeline();
+      spheres.push_back(sphere);
+
+      vtkNew<vtkPVDataInformation> info;
+      informations.push_back(info.Get());
+      requests.push_back(sphere->GatherInformationAsync(
+        info, [&replies](vtkPVInformation*, bool success) { replies += success ? 1 : 0; }));
+    }
+
+    for (size_t cc = 0; cc < requests.size(); ++cc)
+    {
+      if (requests[cc] == 0 || !session->WaitForInformation(requests[cc]) ||
+        session->IsInformationRequestPending(requests[cc]))
+      {
+        cerr << "ERROR: request " << cc << " did not complete." << endl;
+        exitCode = EXIT_FAILURE;
+      }
+
+      vtkNew<vtkPVDataInformation> expected;
+      spheres[cc]->GatherInformation(expected);
+      if (informations[cc]->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+        informations[cc]->GetNumberOfPoints() == 0)
+      {
+        cerr << "ERROR: mismatched information for request " << cc << "." << endl;
+        exitCode = EXIT_FAILURE;
+      }
+    }
+    if (replies != static_cast<int>(requests.size()) || requests[0] == requests[1])
+    {
+      cerr << "ERROR: unexpected callbacks or request ids." << endl;
+      exitCode = EXIT_FAILURE;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return exitCode;
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// Client for smTestDriver, in client / data server / render server mode.
+// Checks that the replies to asynchronous information requests are processed
+// when they are received while the client is blocked on a synchronous request
+// to the same server, in particular the render server.
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVServerInformation.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkRemotingCoreConfiguration.h"
+#include "vtkSMSessionClient.h"
+#include "vtkSmartPointer.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+int TestAsyncRequests(vtkSMSessionClient* session)
+{
+  int exitCode = EXIT_SUCCESS;
+
+  // Issue requests to both servers without processing their replies.
+  const vtkTypeUInt32 locations[2] = { vtkPVSession::RENDER_SERVER_ROOT,
+    vtkPVSession::DATA_SERVER_ROOT };
+  std::vector<vtkSmartPointer<vtkPVServerInformation>> informations;
+  std::vector<vtkTypeUInt32> requests;
+  int replies = 0;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    auto info = vtkSmartPointer<vtkPVServerInformation>::New();
+    informations.push_back(info);
+    requests.push_back(session->GatherInformationAsync(locations[cc % 2], info, 0,
+      [&replies](vtkPVInformation*, bool success) { replies += success ? 1 : 0; }));
+  }
+
+  // The replies are received while these wait for their own reply, they must
+  // be buffered on the connection they arrived on.
+  vtkNew<vtkPVServerInformation> expected[2];
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    if (!session->GatherInformation(locations[cc], expected[cc], 0))
+    {
+      std::cerr << "ERROR: synchronous request to " << locations[cc] << " failed." << std::endl;
+      exitCode = EXIT_FAILURE;
+    }
+  }
+
+  for (size_t cc = 0; cc < requests.size(); ++cc)
+  {
+    if (requests[cc] == 0 || !session->WaitForInformation(requests[cc]) ||
+      session->IsInformationRequestPending(requests[cc]))
+    {
+      std::cerr << "ERROR: request " << cc << " did not complete." << std::endl;
+      exitCode = EXIT_FAILURE;
+    }
+    else if (informations[cc]->GetNumberOfProcesses() !=
+      expected[cc % 2]->GetNumberOfProcesses())
+    {
+      std::cerr << "ERROR: mismatched information for request " << cc << "." << std::endl;
+      exitCode = EXIT_FAILURE;
+    }
+  }
+  if (replies != static_cast<int>(requests.size()))
+  {
+    std::cerr << "ERROR: expected " << requests.size() << " callbacks, got " << replies << "."
+              << std::endl;
+    exitCode = EXIT_FAILURE;
+  }
+  return exitCode;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  // smTestDriver waits for this before considering the client started.
+  std::cout << "Process started" << std::endl;
+
+  if (!vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT))
+  {
+    return EXIT_FAILURE;
+  }
+
+  int exitCode = EXIT_FAILURE;
+  {
+    const std::string url = vtkRemotingCoreConfiguration::GetInstance()->GetServerURL();
+    vtkNew<vtkSMSessionClient> session;
+    if (session->Connect(url.c_str()) &&
+      session->GetRenderClientMode() == vtkSMSession::RENDERING_SPLIT)
+    {
+      vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+      const vtkIdType sid = pm->RegisterSession(session);
+      exitCode = TestAsyncRequests(session);
+      pm->UnRegisterSession(sid);
+    }
+    else
+    {
+      std::cerr << "ERROR: could not connect to separate data and render servers at `" << url
+                << "`." << std::endl;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return exitCode;
+}
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// Client for smTestDriver, in client / server mode.
+// Checks that the messages queued while vtkSMSessionClient::BatchRequests is
+// enabled reach the server, in order, before the requests that wait for a
+// reply from the server, and that asynchronous requests do not stay queued.
+#include "vtkInitializationHelper.h"
+#include "vtkNetworkAccessManager.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVServerInformation.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkRemotingCoreConfiguration.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSessionClient.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int NumberOfProxies = 100;
+
+// vtkSphereSource with the default PhiResolution of 8.
+vtkIdType GetNumberOfSpherePoints(int thetaResolution)
+{
+  return 6 * thetaResolution + 2;
+}
+
+bool CheckNumberOfPoints(vtkSMSourceProxy* proxy, int thetaResolution, const char* when)
+{
+  // UpdatePipeline() is queued too, GetDataInformation() waits for a reply.
+  proxy->UpdatePipeline();
+  const vtkIdType numPoints = proxy->GetDataInformation()->GetNumberOfPoints();
+  if (numPoints != GetNumberOfSpherePoints(thetaResolution))
+  {
+    std::cerr << "ERROR: " << when << ", expected " << GetNumberOfSpherePoints(thetaResolution)
+              << " points, got " << numPoints << "." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int TestBatchRequests(vtkSMSessionClient* session)
+{
+  int exitCode = EXIT_SUCCESS;
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  session->SetBatchRequests(true);
+
+  // Many small pushes, interleaved with blocking requests that must see all
+  // the pushes that came before them.
+  std::vector<vtkSmartPointer<vtkSMSourceProxy>> spheres;
+  for (int cc = 0; cc < NumberOfProxies; ++cc)
+  {
+    vtkSmartPointer<vtkSMSourceProxy> sphere;
+    sphere.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    for (int resolution = 3; resolution <= 3 + cc % 4; ++resolution)
+    {
+      vtkSMPropertyHelper(sphere, "ThetaResolution").Set(resolution);
+      sphere->UpdateVTKObjects();
+    }
+    spheres.push_back(sphere);
+    if (cc % 10 == 9 && !CheckNumberOfPoints(sphere, 3 + cc % 4, "with pending pushes"))
+    {
+      exitCode = EXIT_FAILURE;
+    }
+  }
+  if (!session->GetBatchRequests())
+  {
+    std::cerr << "ERROR: blocking requests must not disable batching." << std::endl;
+    exitCode = EXIT_FAILURE;
+  }
+
+  // An asynchronous request queued behind pending pushes is replied to by only
+  // processing the network events, without flushing the batch.
+  for (int cc = 0; cc < NumberOfProxies; ++cc)
+  {
+    vtkSMPropertyHelper(spheres[cc], "ThetaResolution").Set(5);
+    spheres[cc]->UpdateVTKObjects();
+  }
+  vtkNew<vtkPVServerInformation> serverInfo;
+  bool replied = false;
+  session->GatherInformationAsync(vtkPVSession::DATA_SERVER_ROOT, serverInfo, 0,
+    [&replied](vtkPVInformation*, bool success) { replied = success; });
+  vtkNetworkAccessManager* nam = vtkProcessModule::GetProcessModule()->GetNetworkAccessManager();
+  for (int cc = 0; cc < 100 && !replied; ++cc)
+  {
+    if (nam->ProcessEvents(100) == -1)
+    {
+      break;
+    }
+  }
+  if (!replied)
+  {
+    std::cerr << "ERROR: no reply to an asynchronous request while batching." << std::endl;
+    exitCode = EXIT_FAILURE;
+  }
+
+  // Pushes queued after the blocking requests override the earlier ones.
+  for (int cc = 0; cc < NumberOfProxies; ++cc)
+  {
+    vtkSMPropertyHelper(spheres[cc], "ThetaResolution").Set(10 + cc);
+    spheres[cc]->UpdateVTKObjects();
+    spheres[cc]->UpdatePipeline();
+  }
+  session->SetBatchRequests(false);
+  for (int cc = 0; cc < NumberOfProxies; ++cc)
+  {
+    if (!CheckNumberOfPoints(spheres[cc], 10 + cc, "after disabling batching"))
+    {
+      exitCode = EXIT_FAILURE;
+      break;
+    }
+  }
+  return exitCode;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  // smTestDriver waits for this before considering the client started.
+  std::cout << "Process started" << std::endl;
+
+  if (!vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT))
+  {
+    return EXIT_FAILURE;
+  }
+
+  int exitCode = EXIT_FAILURE;
+  {
+    const std::string url = vtkRemotingCoreConfiguration::GetInstance()->GetServerURL();
+    vtkNew<vtkSMSessionClient> session;
+    if (session->Connect(url.c_str()))
+    {
+      vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+      const vtkIdType sid = pm->RegisterSession(session);
+      exitCode = TestBatchRequests(session);
+      pm->UnRegisterSession(sid);
+    }
+    else
+    {
+      std::cerr << "ERROR: could not connect to the server at `" << url << "`." << std::endl;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return exitCode;
+}
@@ -30,6 +30,7 @@ vtkPVSessionBase::vtkPVSessionBase(vtkPVSessionCore* coreToUse)
 void vtkPVSessionBase::InitSessionBase(vtkPVSessionCore* coreToUse)
 {
   this->ProcessingRemoteNotification = false;
+  this->LastInformationRequestId = 0;
   this->SessionCore = coreToUse;
   if (this->SessionCore)
   {
@@ -231,6 +232,19 @@ bool vtkPVSessionBase::GatherInformation(
   return this->SessionCore->GatherInformation(location, information, globalid);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkPVSessionBase::GatherInformationAsync(vtkTypeUInt32 location,
+  vtkPVInformation* information, vtkTypeUInt32 globalid, InformationCallback callback)
+{
+  const vtkTypeUInt32 requestId = ++this->LastInformationRequestId;
+  const bool success = this->GatherInformation(location, information, globalid);
+  if (callback)
+  {
+    callback(information, success);
+  }
+  return requestId;
+}
+
 //----------------------------------------------------------------------------
 vtkObject* vtkPVSessionBase::GetRemoteObject(vtkTypeUInt32 globalid)
 {
@@ -16,6 +16,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMMessageMinimal.h"            // needed for vtkSMMessage
 
+#include <functional> // for std::function
+
 class vtkClientServerStream;
 class vtkCollection;
 class vtkSIObject;
@@ -103,6 +105,44 @@ public:
   virtual bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  /**
+   * Callback invoked when the information requested with
+   * GatherInformationAsync() is available. \c success is false if the
+   * information could not be gathered.
+   */
+  using InformationCallback = std::function<void(vtkPVInformation* information, bool success)>;
+
+  /**
+   * Asynchronous variant of GatherInformation(). Instead of blocking until the
+   * information has been gathered, \c callback is invoked with \c information
+   * once the reply is received. Returns an identifier for the request that can
+   * be passed to WaitForInformation() or CancelInformationRequest(). Any
+   * number of requests may be outstanding at the same time.
+   * The default implementation gathers the information and invokes the
+   * callback before returning, vtkSMSessionClient overrides it to not wait on
+   * the server.
+   */
+  virtual vtkTypeUInt32 GatherInformationAsync(vtkTypeUInt32 location,
+    vtkPVInformation* information, vtkTypeUInt32 globalid, InformationCallback callback);
+
+  /**
+   * Returns true if the request identified by \c requestId is still waiting
+   * for a reply.
+   */
+  virtual bool IsInformationRequestPending(vtkTypeUInt32 vtkNotUsed(requestId)) { return false; }
+
+  /**
+   * Blocks until the reply for the request identified by \c requestId has
+   * been received and its callback invoked. Returns false if the connection to
+   * the server was lost while waiting.
+   */
+  virtual bool WaitForInformation(vtkTypeUInt32 vtkNotUsed(requestId)) { return true; }
+
+  /**
+   * Cancels a pending request. Its callback will not be invoked.
+   */
+  virtual void CancelInformationRequest(vtkTypeUInt32 vtkNotUsed(requestId)) {}
+
   //---------------------------------------------------------------------------
   // Remote communication API. This API is used for communication in the
   // SERVER -> CLIENT direction. Since satellite nodes cannot communicate with
@@ -249,6 +289,9 @@ protected:
 
   vtkPVSessionCore* SessionCore;
 
+  // Identifier of the last request issued by GatherInformationAsync().
+  vtkTypeUInt32 LastInformationRequestId;
+
 private:
   vtkPVSessionBase(const vtkPVSessionBase&) = delete;
   void operator=(const vtkPVSessionBase&) = delete;
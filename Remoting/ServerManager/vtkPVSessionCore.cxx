@@ -14,6 +14,7 @@
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInformation.h"
+#include "vtkPVProfiler.h"
 #include "vtkPVSession.h"
 #include "vtkPVSessionCoreInterpreterHelper.h"
 #include "vtkProcessModule.h"
@@ -30,6 +31,8 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -583,13 +586,12 @@ void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
 {
   int byte_size[2] = { 0, 0 };
   this->ParallelController->Broadcast(byte_size, 2, 0);
-  unsigned char* raw_data = new unsigned char[byte_size[0] + 1];
-  this->ParallelController->Broadcast(raw_data, byte_size[0], 0);
+  std::vector<unsigned char> raw_data(byte_size[0]);
+  this->ParallelController->Broadcast(raw_data.data(), byte_size[0], 0);
 
   vtkClientServerStream stream;
-  stream.SetData(raw_data, byte_size[0]);
+  stream.SetData(std::move(raw_data));
   this->ExecuteStreamInternal(stream, byte_size[1] != 0);
-  delete[] raw_data;
 }
 
 //----------------------------------------------------------------------------
@@ -601,6 +603,12 @@ void vtkPVSessionCore::ExecuteStreamInternal(
       << stream.StreamToString()
       << "----------------------------------------------------------------\n");
 
+  vtkPVProfiler::Scope scope("clientserver", "ExecuteStream");
+  if (scope.IsActive())
+  {
+    scope.AddBytes(static_cast<vtkTypeInt64>(stream.GetDataLength()));
+  }
+
   this->Interpreter->ClearLastResult();
 
   int temp = this->Interpreter->GetGlobalWarningDisplay();
@@ -815,7 +823,7 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
 
     vtkMultiProcessStream stream;
-    stream << information->GetClassName() << globalid;
+    stream << information->GetClassName() << globalid << information->GetTreeReduction();
 
     // serialize information parameters so all processes have the same ivars.
     information->CopyParametersToStream(stream);
@@ -826,7 +834,9 @@ bool vtkPVSessionCore::GatherInformation(
   // Now collect local information.
   const bool status = this->GatherInformationInternal(information, globalid);
 
-  return (skip_satellites || this->CollectInformation(information)) && status;
+  return (skip_satellites ||
+           this->CollectInformation(information, information->GetTreeReduction())) &&
+    status;
 }
 
 //----------------------------------------------------------------------------
@@ -837,7 +847,8 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 
   std::string classname;
   vtkTypeUInt32 globalid;
-  stream >> classname >> globalid;
+  bool treeReduction;
+  stream >> classname >> globalid >> treeReduction;
 
   vtkSmartPointer<vtkObjectBase> o;
   o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname.c_str()));
@@ -846,116 +857,112 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
   {
     info->CopyParametersFromStream(stream);
     this->GatherInformationInternal(info, globalid);
-    this->CollectInformation(info);
+    this->CollectInformation(info, treeReduction);
   }
   else
   {
     vtkErrorMacro("Could not gather information on Satellite.");
     // let the parent know, otherwise root will hang.
-    this->CollectInformation(nullptr);
+    this->CollectInformation(nullptr, treeReduction);
   }
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if ((array_ptr) != nullptr)                                                                    \
-    {                                                                                              \
-      delete[](array_ptr);                                                                         \
-      (array_ptr) = nullptr;                                                                       \
-    }                                                                                              \
-  }
-
-bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
+bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info, bool treeReduction)
 {
-  // Sanity checks
-  assert("pre: nullptr PV information!" && (info != nullptr));
-
-  // STEP 0: temporary variables
   int rank = this->ParallelController->GetLocalProcessId();
   int nranks = this->ParallelController->GetNumberOfProcesses();
 
+  // Sanity checks: only satellites that failed to create the information
+  // object pass nullptr, see GatherInformationStatelliteCallback().
+  assert("pre: nullptr PV information!" && (info != nullptr || rank != 0));
+
   if (nranks == 1)
   {
     /* short-circuit */
     return true;
   }
 
-  vtkIdType* rcvcounts = nullptr;     /* significant only at rank 0 */
-  vtkIdType* offSet = nullptr;        /* significant only at rank 0 */
-  int rbufsize = 0;                   /* significant only at rank 0 */
-  unsigned char* rcvbuffer = nullptr; /* significant only at rank 0 */
-
-  // STEP 1: Initialize data-structures at rank 0
-  if (rank == 0)
-  {
-    rcvcounts = new vtkIdType[nranks];
-    offSet = new vtkIdType[nranks];
-  } // END if rank == 0
-
-  // STEP 2: Serialize the vtkPVInformation object
-  vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
-
-  // STEP 4: Allocate temporary arrays at rank 0
-  if (rank == 0)
-  {
-    // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-    rbufsize = rcvcounts[0];
-    for (int i = 1; i < nranks; ++i)
+  // Sends what `info` accumulated so far to `parent`. `info` may be nullptr
+  // when the information object could not be created on this rank; in that
+  // case an empty message is sent so that the parent does not hang.
+  auto sendTo = [&](int parent) {
+    vtkClientServerStream stream;
+    if (info)
     {
-      rbufsize += rcvcounts[i];
+      info->CopyToStream(&stream);
     }
-    rcvbuffer = new unsigned char[rbufsize];
 
-    // STEP 4.2: populate offset array
-    offSet[0] = 0;
-    for (int i = 1; i < nranks; ++i)
+    const unsigned char* data = nullptr;
+    size_t length = 0;
+    stream.GetData(&data, &length);
+    vtkIdType sendLength = info ? static_cast<vtkIdType>(length) : 0;
+    this->ParallelController->Send(&sendLength, 1, parent, ROOT_SATELLITE_INFO_TAG);
+    if (sendLength > 0)
     {
-      offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+      this->ParallelController->Send(data, sendLength, parent, ROOT_SATELLITE_INFO_TAG);
     }
-  } // END if rank==0
+  };
 
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
+  // Merges what `child` accumulated into `info`.
+  auto receiveFrom = [&](int child) {
+    vtkIdType rcvLength = 0;
+    this->ParallelController->Receive(&rcvLength, 1, child, ROOT_SATELLITE_INFO_TAG);
+    if (rcvLength <= 0)
+    {
+      return;
+    }
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
+    std::vector<unsigned char> rcvBuffer(static_cast<size_t>(rcvLength));
+    this->ParallelController->Receive(rcvBuffer.data(), rcvLength, child, ROOT_SATELLITE_INFO_TAG);
+    if (info)
     {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
+      vtkClientServerStream rcvStream;
+      rcvStream.SetData(std::move(rcvBuffer));
+      vtkSmartPointer<vtkPVInformation> tempInfo;
+      tempInfo.TakeReference(info->NewInstance());
       tempInfo->CopyFromStream(&rcvStream);
       info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  }   // END if rank == 0
-
-  // STEP 7: De-allocate temporary arrays at rank 0
-  SafeDeleteArray(rcvcounts);
-  SafeDeleteArray(offSet);
-  SafeDeleteArray(rcvbuffer);
+    }
+  };
 
-  // Sanity checks -- ensure we return all dynamically allocated memory
-  assert("post: rcvcounts should be nullptr" && (rcvcounts == nullptr));
-  assert("post: offSet should be nullptr" && (offSet == nullptr));
-  assert("post: rcvbuffer should be nullptr" && (rcvbuffer == nullptr));
+  if (!treeReduction)
+  {
+    // Merge every rank on the root, in increasing order.
+    if (rank == 0)
+    {
+      for (int child = 1; child < nranks; ++child)
+      {
+        receiveFrom(child);
+      }
+    }
+    else
+    {
+      sendTo(0);
+    }
+  }
+  else
+  {
+    // Reduce along a binomial tree rooted at rank 0: at each stage, ranks with
+    // the `step` bit set hand over what they have accumulated so far to
+    // `rank - step` and drop out. This keeps the amount of data received by
+    // any rank logarithmic in the number of ranks while still merging ranks in
+    // increasing order; only the grouping of the merges changes, which is why
+    // information objects have to opt in.
+    for (int step = 1; step < nranks; step <<= 1)
+    {
+      if ((rank & step) != 0)
+      {
+        sendTo(rank - step);
+        break;
+      }
+      else if (rank + step < nranks)
+      {
+        receiveFrom(rank + step);
+      }
+    }
+  }
 
-  // STEP 8: Barrier synchronization
   this->ParallelController->Barrier();
   return true;
 }
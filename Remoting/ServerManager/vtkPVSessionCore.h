@@ -199,9 +199,13 @@ protected:
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
   /**
-   * Gather information across MPI satellites.
+   * Gather information across MPI satellites. When `treeReduction` is true
+   * (see vtkPVInformation::GetTreeReduction()), information is reduced along a
+   * binomial tree so that each rank merges at most log2(N) partial results,
+   * otherwise it is merged on the root, one rank at a time. All ranks must
+   * pass the same value.
    */
-  bool CollectInformation(vtkPVInformation*);
+  bool CollectInformation(vtkPVInformation*, bool treeReduction);
 
   /**
    * Increment reference count of a local vtkSIObject.
@@ -28,6 +28,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
 
@@ -505,6 +506,12 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
 {
   vtkMultiProcessStream stream;
   stream.SetRawData(reinterpret_cast<const unsigned char*>(message), message_length);
+  this->ProcessClientServerMessage(stream, false);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::ProcessClientServerMessage(vtkMultiProcessStream& stream, bool batched)
+{
   int type;
   stream >> type;
   switch (type)
@@ -572,15 +579,37 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
 
     case vtkPVSessionServer::EXECUTE_STREAM:
     {
-      int ignore_errors, size;
-      stream >> ignore_errors >> size;
-      unsigned char* css_data = new unsigned char[size + 1];
-      this->Internal->GetActiveController()->Receive(
-        css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      int ignore_errors, size, num_segments;
+      stream >> ignore_errors >> size >> num_segments;
+      std::vector<int> segment_lengths(num_segments);
+      for (int cc = 0; cc < num_segments; ++cc)
+      {
+        stream >> segment_lengths[cc];
+      }
+      // Receive directly in a buffer handed over to the stream to avoid
+      // copying the payload again.
+      std::vector<unsigned char> css_data(size);
+      if (batched)
+      {
+        // batched streams are inlined in the message.
+        unsigned char* data = css_data.data();
+        unsigned int data_size = static_cast<unsigned int>(size);
+        stream.Pop(data, data_size);
+      }
+      else
+      {
+        // the client sends the stream as consecutive segments, gather them.
+        int offset = 0;
+        for (int length : segment_lengths)
+        {
+          this->Internal->GetActiveController()->Receive(
+            css_data.data() + offset, length, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+          offset += length;
+        }
+      }
       vtkClientServerStream cssStream;
-      cssStream.SetData(css_data, size);
+      cssStream.SetData(std::move(css_data));
       this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
-      delete[] css_data;
     }
     break;
 
@@ -598,6 +627,27 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       this->GatherInformationInternal(location, classname.c_str(), globalid, stream);
     }
     break;
+
+    case vtkPVSessionServer::GATHER_INFORMATION_ASYNC:
+    {
+      std::string classname;
+      vtkTypeUInt32 requestId, location, globalid;
+      stream >> requestId >> location >> classname >> globalid;
+      this->GatherInformationAsyncInternal(
+        requestId, location, classname.c_str(), globalid, stream);
+    }
+    break;
+
+    case vtkPVSessionServer::BATCH:
+    {
+      // The client queued several messages that do not expect a reply,
+      // process them in the order they were issued.
+      while (!stream.Empty())
+      {
+        this->ProcessClientServerMessage(stream, true);
+      }
+    }
+    break;
   }
 }
 
@@ -655,6 +705,46 @@ void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::GatherInformationAsyncInternal(vtkTypeUInt32 requestId,
+  vtkTypeUInt32 location, const char* classname, vtkTypeUInt32 globalid,
+  vtkMultiProcessStream& stream)
+{
+  vtkSmartPointer<vtkObjectBase> o;
+  o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname));
+
+  vtkMultiProcessStream reply;
+  reply << requestId;
+  vtkPVInformation* info = vtkPVInformation::SafeDownCast(o);
+  if (info)
+  {
+    info->CopyParametersFromStream(stream);
+    this->GatherInformation(location, info, globalid);
+
+    vtkClientServerStream css;
+    info->CopyToStream(&css);
+    size_t length;
+    const unsigned char* data;
+    css.GetData(&data, &length);
+    reply << static_cast<int>(length);
+    reply.Push(const_cast<unsigned char*>(data), static_cast<unsigned int>(length));
+  }
+  else
+  {
+    vtkErrorMacro(
+      "Could not create information object: `" << (classname ? classname : "(nullptr)") << "`.");
+    // let client know that gather failed.
+    reply << 0;
+  }
+
+  // The client does not wait on this reply, send it as a RMI that it processes
+  // along with other network events.
+  std::vector<unsigned char> raw_message;
+  reply.GetRawData(raw_message);
+  this->Internal->GetActiveController()->TriggerRMI(1, raw_message.data(),
+    static_cast<int>(raw_message.size()), vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::OnCloseSessionRMI()
 {
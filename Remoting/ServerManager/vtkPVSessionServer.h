@@ -71,13 +71,16 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    BATCH = 19,
+    GATHER_INFORMATION_ASYNC = 20,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
     REPLY_GATHER_INFORMATION_TAG = 55627,
     REPLY_PULL = 55628,
     REPLY_LAST_RESULT = 55629,
-    EXECUTE_STREAM_TAG = 55630
+    EXECUTE_STREAM_TAG = 55630,
+    REPLY_GATHER_INFORMATION_RMI = 55631
   };
 
   ///@{
@@ -134,11 +137,26 @@ protected:
   void GatherInformationInternal(
     vtkTypeUInt32 location, const char* classname, vtkTypeUInt32 globalid, vtkMultiProcessStream&);
 
+  /**
+   * Called when client triggers GatherInformationAsync(). The reply is sent
+   * back with a REPLY_GATHER_INFORMATION_RMI tagged with \c requestId.
+   */
+  void GatherInformationAsyncInternal(vtkTypeUInt32 requestId, vtkTypeUInt32 location,
+    const char* classname, vtkTypeUInt32 globalid, vtkMultiProcessStream&);
+
   /**
    * Sends the last result to client.
    */
   void SendLastResultToClient();
 
+  /**
+   * Processes a single message read from the stream. When `batched` is true,
+   * the message is part of a BATCH sent by the client and any payload
+   * (e.g. the vtkClientServerStream of an EXECUTE_STREAM) is read from the
+   * stream instead of being received separately.
+   */
+  void ProcessClientServerMessage(vtkMultiProcessStream& stream, bool batched);
+
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
 
   bool MultipleConnection;
@@ -9,9 +9,13 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVXMLElement.h"
+#include "vtkSIProperty.h"
+#include "vtkSMMessage.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <cstring>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include <cassert>
@@ -64,6 +68,57 @@ bool vtkSIMetaReaderProxy::ReadXMLAttributes(vtkPVXMLElement* element)
   return ret;
 }
 
+//----------------------------------------------------------------------------
+void vtkSIMetaReaderProxy::UpdatePipelineInformation()
+{
+  this->UpdateReaderSettings();
+  this->Superclass::UpdatePipelineInformation();
+}
+
+//----------------------------------------------------------------------------
+void vtkSIMetaReaderProxy::UpdatePipeline(int port, double time, bool doTime)
+{
+  this->UpdateReaderSettings();
+  this->Superclass::UpdatePipeline(port, time, doTime);
+}
+
+//----------------------------------------------------------------------------
+void vtkSIMetaReaderProxy::UpdateReaderSettings()
+{
+  vtkSIProxy* readerSI = this->GetSubSIProxy("Reader");
+  vtkObjectBase* object = this->GetVTKObject();
+  if (!readerSI || !object || !object->IsA("vtkFileSeriesReader"))
+  {
+    return;
+  }
+
+  // with req_def, only the cached values of the pushed properties are
+  // returned, sorted by name.
+  vtkSMMessage message;
+  message.set_global_id(readerSI->GetGlobalID());
+  message.set_location(0);
+  message.set_req_def(true);
+  readerSI->Pull(&message);
+
+  std::string settings;
+  for (int cc = 0, max = message.ExtensionSize(ProxyState::property); cc < max; ++cc)
+  {
+    const ProxyState_Property& property = message.GetExtension(ProxyState::property, cc);
+    vtkSIProperty* siProperty = readerSI->GetSIProperty(property.name().c_str());
+    const char* command = siProperty ? siProperty->GetCommand() : nullptr;
+    if (command && this->FileNameMethod && strcmp(command, this->FileNameMethod) == 0)
+    {
+      continue;
+    }
+    settings += property.DebugString();
+  }
+
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << object << "SetReaderSettings" << settings.c_str()
+         << vtkClientServerStream::End;
+  this->Interpreter->ProcessStream(stream);
+}
+
 //----------------------------------------------------------------------------
 void vtkSIMetaReaderProxy::PrintSelf(ostream& os, vtkIndent indent)
 {
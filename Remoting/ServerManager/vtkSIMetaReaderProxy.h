@@ -25,6 +25,16 @@ public:
   vtkTypeMacro(vtkSIMetaReaderProxy, vtkSISourceProxy);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * Overridden to pass the current property values of the internal reader to
+   * the meta-reader, see vtkFileSeriesReader::SetReaderSettings(), before
+   * the pipeline is updated.
+   */
+  void UpdatePipelineInformation() override;
+  void UpdatePipeline(int port, double time, bool doTime) override;
+  ///@}
+
 protected:
   vtkSIMetaReaderProxy();
   ~vtkSIMetaReaderProxy() override;
@@ -36,6 +46,12 @@ protected:
    */
   bool ReadXMLAttributes(vtkPVXMLElement* element) override;
 
+  /**
+   * Serialize the property values last pushed to the "Reader" subproxy, except
+   * for the file name, and pass them to a vtkFileSeriesReader.
+   */
+  void UpdateReaderSettings();
+
   // This is the name of the method used to set the file name on the
   // internal reader. See vtkFileSeriesReader for details.
   vtkSetStringMacro(FileNameMethod);
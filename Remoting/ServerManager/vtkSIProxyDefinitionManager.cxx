@@ -12,7 +12,9 @@
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVServerManagerPluginInterface.h"
 #include "vtkPVSession.h"
+#include "vtkPVVersion.h" // for PARAVIEW_VERSION_FULL
 #include "vtkPVXMLElement.h"
+#include "vtkPVXMLElementDatabase.h"
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
 #include "vtkReservedRemoteObjectIds.h"
@@ -21,14 +23,20 @@
 #include "vtkStringList.h"
 #include "vtkTimerLog.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <iomanip>
 #include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <vtksys/Directory.hxx>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -37,6 +45,81 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+std::string& DefinitionCacheDirectory()
+{
+  static std::string directory;
+  return directory;
+}
+
+// The definition cache is keyed by the ParaView version, which includes the
+// build commit, and a FNV-1a hash of the core XMLs.
+std::string ComputeDefinitionCacheKey(const std::vector<std::string>& xmls)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (const auto& xml : xmls)
+  {
+    // hash the terminating null too, so that the XMLs boundaries matter.
+    for (size_t cc = 0; cc <= xml.size(); ++cc)
+    {
+      hash = (hash ^ static_cast<unsigned char>(xml.c_str()[cc])) * 1099511628211ull;
+    }
+  }
+  std::ostringstream key;
+  key << PARAVIEW_VERSION_FULL << "-" << xmls.size() << "-" << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+// Number of definition cache files kept in the cache directory, so that a few
+// builds can share it without writing their file again on every start.
+const size_t MaxDefinitionCacheFiles = 4;
+
+// Removes the definition cache files of `directory` but the most recently
+// written ones. Files of running processes may still be mapped, removing them
+// fails on some platforms, which is fine.
+void PruneDefinitionCache(const std::string& directory)
+{
+  vtksys::Directory dir;
+  if (!dir.Load(directory))
+  {
+    return;
+  }
+  std::vector<std::pair<long, std::string>> files;
+  for (unsigned long cc = 0; cc < dir.GetNumberOfFiles(); ++cc)
+  {
+    const std::string name = dir.GetFile(cc);
+    if (name.compare(0, 17, "ProxyDefinitions-") == 0 &&
+      vtksys::SystemTools::GetFilenameLastExtension(name) == ".pvdb")
+    {
+      const std::string path = directory + "/" + name;
+      files.emplace_back(vtksys::SystemTools::ModifiedTime(path), path);
+    }
+  }
+  if (files.size() <= MaxDefinitionCacheFiles)
+  {
+    return;
+  }
+  std::sort(files.begin(), files.end(), std::greater<std::pair<long, std::string>>());
+  for (size_t cc = MaxDefinitionCacheFiles; cc < files.size(); ++cc)
+  {
+    vtksys::SystemTools::RemoveFile(files[cc].second);
+  }
+}
+
+// Core definitions mapped from the definition cache are null until they are
+// decoded, the first time they are requested.
+vtkPVXMLElement* GetCachedDefinition(
+  vtkPVXMLElementDatabase* cache, const char* groupName, StrToXmlMap::value_type& item)
+{
+  if (!item.second && cache)
+  {
+    item.second = cache->GetElement(groupName, item.first.c_str());
+  }
+  return item.second.GetPointer();
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
@@ -48,6 +131,8 @@ public:
   StrToStrToXmlMap CoreDefinitions;
   // Keep track of custom definition
   StrToStrToXmlMap CustomsDefinitions;
+  // Definition cache the null core definitions are decoded from
+  vtkSmartPointer<vtkPVXMLElementDatabase> CoreDefinitionCache;
   //-------------------------------------------------------------------------
   vtkInternals()
     : EnableXMLProxyDefinitionUpdate(true)
@@ -59,11 +144,18 @@ public:
   {
     this->CoreDefinitions.clear();
     this->CustomsDefinitions.clear();
+    this->CoreDefinitionCache = nullptr;
   }
   //-------------------------------------------------------------------------
   bool HasCoreDefinition(const char* groupName, const char* proxyName)
   {
-    return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != nullptr;
+    // don't decode cached definitions just to check that they exist.
+    if (!groupName || !proxyName)
+    {
+      return false;
+    }
+    StrToStrToXmlMap::const_iterator it = this->CoreDefinitions.find(groupName);
+    return it != this->CoreDefinitions.end() && it->second.find(proxyName) != it->second.end();
   }
   //-------------------------------------------------------------------------
   bool HasCustomDefinition(const char* groupName, const char* proxyName)
@@ -99,7 +191,7 @@ public:
   }
   //-------------------------------------------------------------------------
   vtkPVXMLElement* GetProxyElement(
-    const StrToStrToXmlMap& map, const char* firstStr, const char* secondStr)
+    StrToStrToXmlMap& map, const char* firstStr, const char* secondStr)
   {
     vtkPVXMLElement* elementToReturn = nullptr;
 
@@ -107,15 +199,17 @@ public:
     if (firstStr && secondStr)
     {
       // Find the value based on both keys
-      StrToStrToXmlMap::const_iterator it = map.find(firstStr);
+      StrToStrToXmlMap::iterator it = map.find(firstStr);
       if (it != map.end())
       {
         // We found a match for the first key
-        StrToXmlMap::const_iterator it2 = it->second.find(secondStr);
+        StrToXmlMap::iterator it2 = it->second.find(secondStr);
         if (it2 != it->second.end())
         {
           // We found a match for the second key
-          elementToReturn = it2->second.GetPointer();
+          elementToReturn = GetCachedDefinition(
+            &map == &this->CoreDefinitions ? this->CoreDefinitionCache.GetPointer() : nullptr,
+            firstStr, *it2);
         }
       }
     }
@@ -123,6 +217,14 @@ public:
     // The result might be nullptr if the value was not found
     return elementToReturn;
   }
+  //-------------------------------------------------------------------------
+  void DecodeCoreDefinitions(const char* groupName)
+  {
+    for (auto& item : this->CoreDefinitions[groupName])
+    {
+      GetCachedDefinition(this->CoreDefinitionCache, groupName, item);
+    }
+  }
 
   static void ExtractMetaInformation(vtkPVXMLElement* proxy,
     std::map<std::string, vtkSmartPointer<vtkPVXMLElement>>& subProxyMap,
@@ -256,7 +358,8 @@ public:
     }
     else
     {
-      return this->CoreProxyIterator->second.GetPointer();
+      return GetCachedDefinition(
+        this->CoreDefinitionCache, this->CurrentGroupName.c_str(), *this->CoreProxyIterator);
     }
   }
   //-------------------------------------------------------------------------
@@ -275,9 +378,10 @@ public:
     this->GroupNames.insert(std::string(groupName));
   }
   //-------------------------------------------------------------------------
-  void RegisterCoreDefinitionMap(StrToStrToXmlMap* map)
+  void RegisterCoreDefinitionMap(StrToStrToXmlMap* map, vtkPVXMLElementDatabase* cache)
   {
     this->CoreDefinitionMap = map;
+    this->CoreDefinitionCache = cache;
     this->InvalidCoreIterator = true;
   }
   //-------------------------------------------------------------------------
@@ -398,6 +502,7 @@ private:
   StrToXmlMap::iterator CustomProxyIteratorEnd;
   StrToStrToXmlMap* CoreDefinitionMap;
   StrToStrToXmlMap* CustomDefinitionMap;
+  vtkSmartPointer<vtkPVXMLElementDatabase> CoreDefinitionCache;
   std::set<std::string> GroupNames;
   std::set<std::string>::iterator GroupNameIterator;
   bool InvalidCoreIterator;
@@ -892,13 +997,15 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope
   switch (scope)
   {
     case vtkSIProxyDefinitionManager::CORE_DEFINITIONS: // Core only
-      iterator->RegisterCoreDefinitionMap(&this->Internals->CoreDefinitions);
+      iterator->RegisterCoreDefinitionMap(
+        &this->Internals->CoreDefinitions, this->Internals->CoreDefinitionCache);
       break;
     case vtkSIProxyDefinitionManager::CUSTOM_DEFINITIONS: // Custom only
       iterator->RegisterCustomDefinitionMap(&this->Internals->CustomsDefinitions);
       break;
     default: // Both
-      iterator->RegisterCoreDefinitionMap(&this->Internals->CoreDefinitions);
+      iterator->RegisterCoreDefinitionMap(
+        &this->Internals->CoreDefinitions, this->Internals->CoreDefinitionCache);
       iterator->RegisterCustomDefinitionMap(&this->Internals->CustomsDefinitions);
       break;
   }
@@ -1176,6 +1283,8 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
   // proxy definitions on the client side when a server's definitions are
   // loaded. Ideally, we save all proxies that are "client" only. We will do
   // that when we convert this class to use pugixml.
+  this->Internals->DecodeCoreDefinitions("animation_writers");
+  this->Internals->DecodeCoreDefinitions("screenshot_writers");
   const auto animationWriters = this->Internals->CoreDefinitions["animation_writers"];
   const auto screenshotWriters = this->Internals->CoreDefinitions["screenshot_writers"];
 
@@ -1259,10 +1368,17 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
     {
       bool tmpReplaceOverrideInParent = this->Internals->ReplaceOverrideInParent;
       this->Internals->ReplaceOverrideInParent = false;
-      for (size_t cc = 0; cc < xmls.size(); cc++)
+      if (core)
       {
-        this->LoadConfigurationXMLFromString(xmls[cc].c_str(), !core, false,
-          smplugin->GetEnsurePluginLoaded() ? plugin->GetPluginName() : "");
+        this->LoadCoreDefinitions(xmls);
+      }
+      else
+      {
+        for (size_t cc = 0; cc < xmls.size(); cc++)
+        {
+          this->LoadConfigurationXMLFromString(xmls[cc].c_str(), true, false,
+            smplugin->GetEnsurePluginLoaded() ? plugin->GetPluginName() : "");
+        }
       }
 
       // Make sure we invalidate any cached flatten version of our proxy definition
@@ -1273,6 +1389,81 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
   }
 }
 
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::LoadCoreDefinitions(const std::vector<std::string>& xmls)
+{
+  const std::string directory = vtkSIProxyDefinitionManager::GetDefinitionCacheDirectory();
+  if (directory.empty())
+  {
+    for (const auto& xml : xmls)
+    {
+      this->LoadConfigurationXMLFromString(xml.c_str(), false, false);
+    }
+    return;
+  }
+
+  // builds sharing a cache directory each get their own file instead of
+  // overwriting each other's.
+  const std::string key = ::ComputeDefinitionCacheKey(xmls);
+  const std::string filename = directory + "/ProxyDefinitions-" + key + ".pvdb";
+  vtkNew<vtkPVXMLElementDatabase> cache;
+  if (cache->Open(filename.c_str(), key.c_str()))
+  {
+    vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Map Definition Cache");
+    for (unsigned int cc = 0; cc < cache->GetNumberOfElements(); ++cc)
+    {
+      const char* groupName = cache->GetGroup(cc);
+      const char* proxyName = cache->GetName(cc);
+      if (groupName && proxyName)
+      {
+        this->Internals->CoreDefinitions[groupName][proxyName] = nullptr;
+        RegisteredDefinitionInformation info(groupName, proxyName, false);
+        this->InvokeEvent(vtkCommand::RegisterEvent, &info);
+      }
+    }
+    this->Internals->CoreDefinitionCache = cache;
+    vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Map Definition Cache");
+    return;
+  }
+
+  for (const auto& xml : xmls)
+  {
+    this->LoadConfigurationXMLFromString(xml.c_str(), false, false);
+  }
+
+  // all ranks parse the XMLs the first time, only one saves them.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if ((pm && pm->GetPartitionId() != 0) || !vtksys::SystemTools::MakeDirectory(directory) ||
+    !vtksys::SystemTools::TestFileAccess(directory, vtksys::TEST_FILE_WRITE))
+  {
+    return;
+  }
+  for (auto& group : this->Internals->CoreDefinitions)
+  {
+    for (auto& item : group.second)
+    {
+      cache->AddElement(group.first.c_str(), item.first.c_str(), item.second);
+    }
+  }
+  if (cache->Write(filename.c_str(), key.c_str()))
+  {
+    // files of older XMLs are never read again.
+    ::PruneDefinitionCache(directory);
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SetDefinitionCacheDirectory(const std::string& directory)
+{
+  ::DefinitionCacheDirectory() = directory;
+}
+
+//---------------------------------------------------------------------------
+std::string vtkSIProxyDefinitionManager::GetDefinitionCacheDirectory()
+{
+  return ::DefinitionCacheDirectory();
+}
+
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::HasDefinition(const char* groupName, const char* proxyName)
 {
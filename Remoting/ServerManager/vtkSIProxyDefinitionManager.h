@@ -25,6 +25,13 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * When a definition cache directory is set, see SetDefinitionCacheDirectory(),
+ * the core definitions are saved to a vtkPVXMLElementDatabase the first time
+ * they are parsed, and later runs map that file instead of parsing the core
+ * XMLs. Each cached definition is then only decoded the first time it is
+ * requested. Writing a new cache file removes all but the few most recently
+ * written ones from the directory.
  */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -33,6 +40,9 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSIObject.h"
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
 class vtkPVPlugin;
 class vtkPVProxyDefinitionIterator;
 class vtkPVXMLElement;
@@ -57,6 +67,17 @@ public:
    */
   static void PatchXMLProperty(vtkPVXMLElement* propElement);
 
+  ///@{
+  /**
+   * Set/Get the directory in which the core proxy definitions are cached
+   * between runs. The cache is rebuilt whenever the core XMLs change. Empty by
+   * default, which disables the cache. This only affects proxy definition
+   * managers created afterwards.
+   */
+  static void SetDefinitionCacheDirectory(const std::string& directory);
+  static std::string GetDefinitionCacheDirectory();
+  ///@}
+
   ///@{
   /**
    * Returns a registered proxy definition or return a nullptr otherwise.
@@ -278,6 +299,13 @@ protected:
   void HandlePlugin(vtkPVPlugin*);
   ///@}
 
+  /**
+   * Loads the core XMLs, or maps the definition cache instead if it was built
+   * from the same XMLs. On the first partition, the cache is rebuilt after the
+   * XMLs are parsed.
+   */
+  void LoadCoreDefinitions(const std::vector<std::string>& xmls);
+
   /**
    * Called by the XML parser to add an element from which a proxy
    * can be created. Called during parsing.
@@ -10,11 +10,13 @@
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkInformation.h"
+#include "vtkInformationStringKey.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPostFilter.h"
+#include "vtkPVProfiler.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -114,6 +116,9 @@ void vtkSISourceProxy::OnCreateVTKObjects()
       }
     }
   }
+
+  // Let vtkPVCompositeDataPipeline report which proxy an execution belongs to.
+  algorithm->GetInformation()->Set(vtkPVProfiler::PROXY_NAME(), this->GetLogNameOrDefault());
 }
 
 //----------------------------------------------------------------------------
@@ -259,6 +264,8 @@ void vtkSISourceProxy::UpdatePipelineInformation()
     vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(this->GetVTKObject());
     if (algo)
     {
+      // the log name may have been changed since the VTK object was created.
+      algo->GetInformation()->Set(vtkPVProfiler::PROXY_NAME(), this->GetLogNameOrDefault());
       algo->UpdateInformation();
     }
   }
@@ -38,6 +38,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
@@ -880,6 +881,26 @@ bool vtkSMProxy::GatherInformation(vtkPVInformation* information, vtkTypeUInt32
   return false;
 }
 
+//---------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMProxy::GatherInformationAsync(
+  vtkPVInformation* information, std::function<void(vtkPVInformation*, bool)> callback)
+{
+  assert(information);
+
+  vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "%s: gather information (async) %s",
+    this->GetLogNameOrDefault(), information->GetClassName());
+
+  if (this->GetSession() && this->Location != 0)
+  {
+    // ensure that the proxy is created.
+    this->CreateVTKObjects();
+
+    return this->GetSession()->GatherInformationAsync(
+      this->Location, information, this->GetGlobalID(), std::move(callback));
+  }
+  return 0;
+}
+
 //---------------------------------------------------------------------------
 bool vtkSMProxy::WarnIfDeprecated()
 {
@@ -122,6 +122,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMRemoteObject.h"
 
+#include <functional> // for std::function
+
 struct vtkSMProxyInternals;
 
 class vtkClientServerStream;
@@ -481,6 +483,15 @@ public:
   bool GatherInformation(vtkPVInformation* information, vtkTypeUInt32 location);
   ///@}
 
+  /**
+   * Asynchronous variant of GatherInformation(). \c callback is invoked with
+   * \c information once it has been gathered, see
+   * vtkPVSessionBase::GatherInformationAsync(). Returns the identifier of the
+   * request or 0 if no request could be issued.
+   */
+  vtkTypeUInt32 GatherInformationAsync(
+    vtkPVInformation* information, std::function<void(vtkPVInformation*, bool)> callback);
+
   /**
    * Saves the state of the proxy. This state can be reloaded
    * to create a new proxy that is identical the present state of this proxy.
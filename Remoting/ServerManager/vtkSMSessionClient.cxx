@@ -10,6 +10,7 @@
 #include "vtkNetworkAccessManager.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVInformation.h"
 #include "vtkPVMultiClientsInformation.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVServerInformation.h"
@@ -28,14 +29,18 @@
 #include "vtkSMServerStateLocator.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSettings.h"
+#include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkTimerLog.h"
 
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 #include <cassert>
+#include <map>
 #include <set>
 
 //****************************************************************************/
@@ -49,7 +54,44 @@ void RMICallback(
   vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
+
+void InformationReplyRMICallback(
+  void* localArg, void* remoteArg, int remoteArgLength, int vtkNotUsed(remoteProcessId))
+{
+  vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
+  self->OnGatherInformationReplyRMI(remoteArg, remoteArgLength);
+}
+
+// Batches are flushed once they grow beyond this size, larger messages are
+// never batched.
+constexpr size_t MAX_BATCH_SIZE = 1 << 20;
 };
+
+//****************************************************************************/
+class vtkSMSessionClient::vtkRequestBatch
+{
+public:
+  struct Queue
+  {
+    vtkMultiProcessStream Messages;
+    size_t Size = 0;
+  };
+  std::map<vtkMultiProcessController*, Queue> Queues;
+};
+
+//****************************************************************************/
+class vtkSMSessionClient::vtkInformationRequests
+{
+public:
+  struct Request
+  {
+    vtkSmartPointer<vtkPVInformation> Information;
+    bool AddLocalInformation;
+    InformationCallback Callback;
+  };
+  std::map<vtkTypeUInt32, Request> Pending;
+};
+
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
 vtkCxxSetObjectMacro(vtkSMSessionClient, RenderServerController, vtkMultiProcessController);
@@ -81,6 +123,9 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->BatchRequests = false;
+  this->RequestBatch = new vtkRequestBatch();
+  this->InformationRequests = new vtkInformationRequests();
 }
 
 //----------------------------------------------------------------------------
@@ -90,6 +135,13 @@ vtkSMSessionClient::~vtkSMSessionClient()
   {
     this->DataServerController->RemoveAllRMICallbacks(
       vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+    this->DataServerController->RemoveAllRMICallbacks(
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
+  }
+  if (this->RenderServerController)
+  {
+    this->RenderServerController->RemoveAllRMICallbacks(
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
   }
   if (this->GetIsAlive())
   {
@@ -109,11 +161,21 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = nullptr;
+
+  delete this->RequestBatch;
+  this->RequestBatch = nullptr;
+
+  delete this->InformationRequests;
+  this->InformationRequests = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkMultiProcessController* vtkSMSessionClient::GetController(ServerFlags processType)
 {
+  // callers may communicate directly with the servers, make sure they see the
+  // effect of all messages sent so far.
+  this->Flush();
+
   switch (processType)
   {
     case CLIENT:
@@ -334,6 +396,8 @@ bool vtkSMSessionClient::Connect(const char* url, int timeout, bool (*callback)(
       vtkCommand::ErrorEvent, this, &vtkSMSessionClient::OnConnectionLost);
     dcontroller->AddRMICallback(
       &RMICallback, this, vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+    dcontroller->AddRMICallback(
+      &InformationReplyRMICallback, this, vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
     dcontroller->Delete();
   }
   if (rcontroller)
@@ -343,6 +407,8 @@ bool vtkSMSessionClient::Connect(const char* url, int timeout, bool (*callback)(
       vtkCommand::WrongTagEvent, this, &vtkSMSessionClient::OnWrongTagEvent);
     rcontroller->GetCommunicator()->AddObserver(
       vtkCommand::ErrorEvent, this, &vtkSMSessionClient::OnConnectionLost);
+    rcontroller->AddRMICallback(
+      &InformationReplyRMICallback, this, vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
     rcontroller->Delete();
   }
 
@@ -522,6 +588,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->Flush();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -587,15 +654,10 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::PUSH);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string state = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->SendStateMessage(controllers[cc], vtkPVSessionServer::PUSH, state);
     }
   }
 
@@ -627,13 +689,8 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendStateMessage(
+          this->DataServerController, vtkPVSessionServer::PUSH, msg.SerializeAsString());
       }
       else if (!remoteObject)
       {
@@ -658,6 +715,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->Flush();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -729,22 +787,47 @@ void vtkSMSessionClient::ExecuteStream(
 
   if (num_controllers > 0)
   {
-    const unsigned char* data;
-    size_t size;
-    cssstream.GetData(&data, &size);
+    // Send the stream as a list of segments so that arrays inserted with
+    // vtkClientServerStream::ReferenceArray are not copied before sending.
+    std::vector<vtkClientServerStream::Segment> segments;
+    cssstream.GetSegments(segments);
+    size_t size = 0;
+    for (const auto& segment : segments)
+    {
+      size += segment.Length;
+    }
 
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
-           << static_cast<int>(ignore_errors) << static_cast<int>(size);
+           << static_cast<int>(ignore_errors) << static_cast<int>(size)
+           << static_cast<int>(segments.size());
+    for (const auto& segment : segments)
+    {
+      stream << static_cast<int>(segment.Length);
+    }
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
 
     for (int cc = 0; cc < num_controllers; cc++)
     {
+      if (vtkMultiProcessStream* batch = this->GetBatch(controllers[cc], size))
+      {
+        // batched streams are inlined in the message. Whether to batch only
+        // depends on the size, so the segments are never needed afterwards.
+        const unsigned char* data;
+        cssstream.GetData(&data, &size);
+        *batch << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
+               << static_cast<int>(ignore_errors) << static_cast<int>(size) << 0;
+        batch->Push(const_cast<unsigned char*>(data), static_cast<unsigned int>(size));
+        continue;
+      }
       controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
         static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      controllers[cc]->Send(
-        data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      for (const auto& segment : segments)
+      {
+        controllers[cc]->Send(segment.Data, static_cast<int>(segment.Length), 1,
+          vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      }
     }
   }
 
@@ -757,6 +840,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->Flush();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -789,10 +873,9 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
     // Get the reply
     int size = 0;
     controller->Receive(&size, 1, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    unsigned char* raw_data = new unsigned char[size + 1];
-    controller->Receive(raw_data, size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    this->ServerLastInvokeResult->SetData(raw_data, size);
-    delete[] raw_data;
+    std::vector<unsigned char> raw_data(size);
+    controller->Receive(raw_data.data(), size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
+    this->ServerLastInvokeResult->SetData(std::move(raw_data));
     this->EndBusyWork();
     return *this->ServerLastInvokeResult;
   }
@@ -805,6 +888,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->Flush();
   this->StartBusyWork();
   if (this->RenderServerController == nullptr)
   {
@@ -868,17 +952,16 @@ bool vtkSMSessionClient::GatherInformation(
       this->EndBusyWork();
       return false;
     }
-    unsigned char* data2 = new unsigned char[length2];
+    std::vector<unsigned char> data2(length2);
     if (!controller->Receive(
-          (char*)data2, length2, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG))
+          data2.data(), length2, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG))
     {
       vtkErrorMacro("Failed to receive information correctly.");
-      delete[] data2;
       this->EndBusyWork();
       return false;
     }
     vtkClientServerStream csstream;
-    csstream.SetData(data2, length2);
+    csstream.SetData(std::move(data2));
     if (add_local_info)
     {
       vtkPVInformation* tempInfo = information->NewInstance();
@@ -890,12 +973,159 @@ bool vtkSMSessionClient::GatherInformation(
     {
       information->CopyFromStream(&csstream);
     }
-    delete[] data2;
   }
   this->EndBusyWork();
   return false;
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMSessionClient::GatherInformationAsync(vtkTypeUInt32 location,
+  vtkPVInformation* information, vtkTypeUInt32 globalid, InformationCallback callback)
+{
+  location = this->GetRealLocation(location);
+
+  bool add_local_info = false;
+  if ((location & vtkPVSession::CLIENT) != 0)
+  {
+    if (information->GetRootOnly())
+    {
+      return this->Superclass::GatherInformationAsync(location, information, globalid, callback);
+    }
+    this->Superclass::GatherInformation(location, information, globalid);
+    add_local_info = true;
+  }
+
+  vtkMultiProcessController* controller = nullptr;
+  if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
+  {
+    controller = this->DataServerController;
+  }
+  else if (this->RenderServerController != nullptr &&
+    (location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
+  {
+    controller = this->RenderServerController;
+  }
+
+  const vtkTypeUInt32 requestId = ++this->LastInformationRequestId;
+  if (!controller)
+  {
+    if (callback)
+    {
+      callback(information, true);
+    }
+    return requestId;
+  }
+
+  vtkInformationRequests::Request& request = this->InformationRequests->Pending[requestId];
+  request.Information = information;
+  request.AddLocalInformation = add_local_info;
+  request.Callback = std::move(callback);
+
+  // The request is appended to the queued messages it depends on, then the
+  // batch is sent right away: nothing else may flush it before the caller
+  // waits for the reply, e.g. by processing the network events.
+  const std::string classname = information->GetClassName();
+  vtkMultiProcessStream* batch = this->GetBatch(controller, classname.size());
+  vtkMultiProcessStream stream;
+  vtkMultiProcessStream& message = batch ? *batch : stream;
+  message << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION_ASYNC) << requestId
+          << location << classname << globalid;
+  information->CopyParametersToStream(message);
+  if (batch)
+  {
+    this->Flush();
+  }
+  else
+  {
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+  return requestId;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::IsInformationRequestPending(vtkTypeUInt32 requestId)
+{
+  return this->InformationRequests->Pending.find(requestId) !=
+    this->InformationRequests->Pending.end();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::WaitForInformation(vtkTypeUInt32 requestId)
+{
+  this->Flush();
+  vtkNetworkAccessManager* nam = vtkProcessModule::GetProcessModule()->GetNetworkAccessManager();
+  while (this->IsInformationRequestPending(requestId))
+  {
+    if (nam->ProcessEvents(100) == -1)
+    {
+      vtkErrorMacro("Connection lost while waiting for information.");
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::CancelInformationRequest(vtkTypeUInt32 requestId)
+{
+  // the reply, if any, is simply ignored.
+  this->InformationRequests->Pending.erase(requestId);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::OnGatherInformationReplyRMI(void* message, int message_length)
+{
+  vtkMultiProcessStream stream;
+  stream.SetRawData(reinterpret_cast<const unsigned char*>(message), message_length);
+  vtkTypeUInt32 requestId;
+  int length;
+  stream >> requestId >> length;
+
+  auto iter = this->InformationRequests->Pending.find(requestId);
+  if (iter == this->InformationRequests->Pending.end())
+  {
+    // cancelled request.
+    return;
+  }
+  vtkInformationRequests::Request request = std::move(iter->second);
+  this->InformationRequests->Pending.erase(iter);
+
+  bool success = length > 0;
+  if (success)
+  {
+    std::vector<unsigned char> data(length);
+    unsigned char* ptr = data.data();
+    unsigned int size = static_cast<unsigned int>(length);
+    stream.Pop(ptr, size);
+
+    vtkClientServerStream csstream;
+    csstream.SetData(std::move(data));
+    if (request.AddLocalInformation)
+    {
+      vtkSmartPointer<vtkPVInformation> tempInfo;
+      tempInfo.TakeReference(request.Information->NewInstance());
+      tempInfo->CopyFromStream(&csstream);
+      request.Information->AddInformation(tempInfo);
+    }
+    else
+    {
+      request.Information->CopyFromStream(&csstream);
+    }
+  }
+  else
+  {
+    vtkErrorMacro("Server failed to gather information.");
+  }
+
+  if (request.Callback)
+  {
+    request.Callback(request.Information, success);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
 {
@@ -920,15 +1150,10 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::UNREGISTER_SI);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string state = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->SendStateMessage(controllers[cc], vtkPVSessionServer::UNREGISTER_SI, state);
     }
   }
 
@@ -961,17 +1186,12 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::REGISTER_SI);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string state = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
       if (controllers[cc] != nullptr)
       {
-        controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendStateMessage(controllers[cc], vtkPVSessionServer::REGISTER_SI, state);
       }
     }
   }
@@ -982,10 +1202,89 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SetBatchRequests(bool batch)
+{
+  if (this->BatchRequests != batch)
+  {
+    this->BatchRequests = batch;
+    if (!batch)
+    {
+      this->Flush();
+    }
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::Flush()
+{
+  for (auto& item : this->RequestBatch->Queues)
+  {
+    vtkRequestBatch::Queue& queue = item.second;
+    if (queue.Size == 0)
+    {
+      continue;
+    }
+    std::vector<unsigned char> raw_message;
+    queue.Messages.GetRawData(raw_message);
+    queue.Messages.Reset();
+    queue.Size = 0;
+    item.first->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkMultiProcessStream* vtkSMSessionClient::GetBatch(
+  vtkMultiProcessController* controller, size_t size)
+{
+  if (!this->BatchRequests)
+  {
+    return nullptr;
+  }
+
+  vtkRequestBatch::Queue& queue = this->RequestBatch->Queues[controller];
+  if (queue.Size > 0 && queue.Size + size > MAX_BATCH_SIZE)
+  {
+    this->Flush();
+  }
+  if (size > MAX_BATCH_SIZE)
+  {
+    return nullptr;
+  }
+  if (queue.Size == 0)
+  {
+    queue.Messages << static_cast<int>(vtkPVSessionServer::BATCH);
+  }
+  // account for the message header too so that empty payloads count.
+  queue.Size += size + sizeof(int);
+  return &queue.Messages;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendStateMessage(
+  vtkMultiProcessController* controller, int type, const std::string& state)
+{
+  if (vtkMultiProcessStream* batch = this->GetBatch(controller, state.size()))
+  {
+    *batch << type << state;
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << type << state;
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+  controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BatchRequests: " << this->BatchRequests << endl;
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
@@ -1036,18 +1335,20 @@ void vtkSMSessionClient::OnServerNotificationMessageRMI(void* message, int messa
 }
 //-----------------------------------------------------------------------------
 bool vtkSMSessionClient::OnWrongTagEvent(
-  vtkObject* vtkNotUsed(obj), unsigned long vtkNotUsed(event), void* calldata)
+  vtkObject* obj, unsigned long vtkNotUsed(event), void* calldata)
 {
   int tag = -1;
   const char* data = reinterpret_cast<const char*>(calldata);
   const char* ptr = data;
   memcpy(&tag, ptr, sizeof(tag));
 
-  // Just buffer RMI_TAG's
-  if (tag == vtkMultiProcessController::RMI_TAG || tag == vtkMultiProcessController::RMI_ARG_TAG)
+  // Just buffer RMI_TAG's, on the connection they were received on: both the
+  // data server and the render server may send RMIs.
+  vtkSocketCommunicator* communicator = vtkSocketCommunicator::SafeDownCast(obj);
+  if (communicator &&
+    (tag == vtkMultiProcessController::RMI_TAG || tag == vtkMultiProcessController::RMI_ARG_TAG))
   {
-    vtkSocketCommunicator::SafeDownCast(this->DataServerController->GetCommunicator())
-      ->BufferCurrentMessage();
+    communicator->BufferCurrentMessage();
   }
   else
   {
@@ -14,7 +14,10 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <string> // for std::string
+
 class vtkMultiProcessController;
+class vtkMultiProcessStream;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
 class vtkSMProxyLocator;
@@ -108,6 +111,28 @@ public:
   const vtkClientServerStream& GetLastResult(vtkTypeUInt32 location) override;
   ///@}
 
+  ///@{
+  /**
+   * When enabled, messages that do not expect a reply from the server i.e.
+   * PushState(), ExecuteStream() and the registration of server side objects,
+   * are queued and sent together as a single message when Flush() is called or
+   * before any call that waits for a reply from the server (PullState(),
+   * GatherInformation(), GetLastResult(), GetController() etc.) or that
+   * expects one later (GatherInformationAsync()). This avoids
+   * paying the network latency for every message when a large number of
+   * proxies is modified e.g. when loading a state file.
+   * Disabling batching flushes the queued messages. Default is false.
+   */
+  void SetBatchRequests(bool);
+  vtkGetMacro(BatchRequests, bool);
+  vtkBooleanMacro(BatchRequests, bool);
+  ///@}
+
+  /**
+   * Sends the messages queued while BatchRequests is enabled.
+   */
+  void Flush();
+
   ///@{
   /**
    * When Connect() is waiting for a server to connect back to the client (in
@@ -132,6 +157,21 @@ public:
   bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid) override;
 
+  ///@{
+  /**
+   * Overridden to send the request to the server without waiting for the
+   * reply. Replies are processed, and callbacks invoked, when the network
+   * events are processed e.g. by vtkNetworkAccessManager::ProcessEvents() or
+   * WaitForInformation(). When BatchRequests is enabled, the request is sent
+   * along with the queued messages, flushing them.
+   */
+  vtkTypeUInt32 GatherInformationAsync(vtkTypeUInt32 location, vtkPVInformation* information,
+    vtkTypeUInt32 globalid, InformationCallback callback) override;
+  bool IsInformationRequestPending(vtkTypeUInt32 requestId) override;
+  bool WaitForInformation(vtkTypeUInt32 requestId) override;
+  void CancelInformationRequest(vtkTypeUInt32 requestId) override;
+  ///@}
+
   /**
    * Returns the number of processes on the given server/s. If more than 1
    * server is identified, than it returns the maximum number of processes e.g.
@@ -213,6 +253,7 @@ public:
   vtkTypeUInt32 GetNextChunkGlobalUniqueIdentifier(vtkTypeUInt32 chunkSize) override;
 
   void OnServerNotificationMessageRMI(void* message, int message_length);
+  void OnGatherInformationReplyRMI(void* message, int message_length);
 
 protected:
   vtkSMSessionClient();
@@ -239,6 +280,18 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Returns the stream in which a message of `size` bytes for `controller`
+   * must be written when BatchRequests is enabled, nullptr if the message
+   * must be sent right away.
+   */
+  vtkMultiProcessStream* GetBatch(vtkMultiProcessController* controller, size_t size);
+
+  /**
+   * Sends or queues a message of the given `type` carrying a serialized state.
+   */
+  void SendStateMessage(vtkMultiProcessController* controller, int type, const std::string& state);
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -262,6 +315,8 @@ protected:
   // Field used to communicate with other clients
   vtkSMCollaborationManager* CollaborationCommunicator;
 
+  bool BatchRequests;
+
   /**
    * Callback when any vtkMultiProcessController subclass fires a WrongTagEvent.
    * Return true if the event was handle locally.
@@ -280,6 +335,12 @@ private:
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  class vtkRequestBatch;
+  vtkRequestBatch* RequestBatch;
+
+  class vtkInformationRequests;
+  vtkInformationRequests* InformationRequests;
 };
 
 #endif
@@ -1220,6 +1220,16 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
 
   bool prev = this->InLoadXMLState;
   this->InLoadXMLState = true;
+
+  // Loading a state pushes the state of every proxy, batch these messages
+  // to avoid a round trip per proxy when connected to a remote server.
+  vtkSMSessionClient* client = vtkSMSessionClient::SafeDownCast(this->GetSession());
+  const bool prevBatchRequests = client ? client->GetBatchRequests() : false;
+  if (client)
+  {
+    client->SetBatchRequests(true);
+  }
+
   vtkSmartPointer<vtkSMStateLoader> spLoader;
   if (!loader)
   {
@@ -1237,6 +1247,10 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
     info.ProxyLocator = spLoader->GetProxyLocator();
     this->InvokeEvent(vtkCommand::LoadStateEvent, &info);
   }
+  if (client)
+  {
+    client->SetBatchRequests(prevBatchRequests);
+  }
   this->InLoadXMLState = prev;
 }
 
@@ -32,6 +32,10 @@
 #include "vtkmFilterOverrides.h"
 #endif
 
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+#include "vtkFileSeriesReader.h"
+#endif
+
 #include <cassert>
 
 vtkSmartPointer<vtkPVGeneralSettings> vtkPVGeneralSettings::Instance;
@@ -95,6 +99,54 @@ bool vtkPVGeneralSettings::GetCacheGeometryForAnimation()
 #endif
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetCacheFileSeriesTimeInformation(bool val)
+{
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  if (vtkFileSeriesReader::GetGlobalUseMetaDataCache() != val)
+  {
+    vtkFileSeriesReader::SetGlobalUseMetaDataCache(val);
+    this->Modified();
+  }
+#else
+  static_cast<void>(val);
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetCacheFileSeriesTimeInformation()
+{
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  return vtkFileSeriesReader::GetGlobalUseMetaDataCache();
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetFileSeriesPrefetchMemoryLimit(int val)
+{
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  if (vtkFileSeriesReader::GetGlobalPrefetchMemoryLimit() != val)
+  {
+    vtkFileSeriesReader::SetGlobalPrefetchMemoryLimit(val);
+    this->Modified();
+  }
+#else
+  static_cast<void>(val);
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetFileSeriesPrefetchMemoryLimit()
+{
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  return vtkFileSeriesReader::GetGlobalPrefetchMemoryLimit();
+#else
+  return 0;
+#endif
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
 {
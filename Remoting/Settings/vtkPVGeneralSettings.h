@@ -131,6 +131,24 @@ public:
   bool GetCacheGeometryForAnimation();
   ///@}
 
+  ///@{
+  /**
+   * Set whether file series readers keep the time information of their files
+   * in a sidecar cache file.
+   */
+  void SetCacheFileSeriesTimeInformation(bool val);
+  bool GetCacheFileSeriesTimeInformation();
+  ///@}
+
+  ///@{
+  /**
+   * Set the amount of data, in MiB, file series readers read ahead of the
+   * current file. 0 disables prefetching.
+   */
+  void SetFileSeriesPrefetchMemoryLimit(int val);
+  int GetFileSeriesPrefetchMemoryLimit();
+  ///@}
+
   ///@{
   /**
    * Set the animation cache limit in KBs.
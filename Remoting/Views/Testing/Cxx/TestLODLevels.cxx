@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompositeDataSet.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVRenderView.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+
+// Tests the LOD levels picked by vtkPVRenderView from LODTargetFrameRate: the
+// level follows the frame rate, levels already decimated are reused, and the
+// low-res data delivered is replaced when the input changes.
+
+namespace
+{
+// Returns the first polydata of the low-res data set for `repr`.
+vtkPolyData* GetLODPiece(vtkPVRenderView* rv, vtkPVDataRepresentation* repr)
+{
+  vtkDataObject* lod = rv->GetDeliveryManager()->GetPiece(repr, /*low_res=*/true);
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(lod))
+  {
+    const auto pieces = vtkCompositeDataSet::GetDataSets<vtkPolyData>(cd);
+    return pieces.empty() ? nullptr : pieces[0];
+  }
+  return vtkPolyData::SafeDownCast(lod);
+}
+}
+
+int TestLODLevels(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestLODLevels");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session);
+    controller->InitializeSession(session);
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkSMRenderViewProxy> view;
+    view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+    controller->InitializeProxy(view);
+    // always render interactively using LOD, starting with 4 levels.
+    vtkSMPropertyHelper(view, "LODThreshold").Set(0.0);
+    vtkSMPropertyHelper(view, "NumberOfLODLevels").Set(4);
+    view->UpdateVTKObjects();
+    controller->RegisterViewProxy(view);
+
+    vtkSmartPointer<vtkSMSourceProxy> sphere;
+    sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    controller->InitializeProxy(sphere);
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(512);
+    vtkSMPropertyHelper(sphere, "PhiResolution").Set(512);
+    sphere->UpdateVTKObjects();
+    controller->RegisterPipelineProxy(sphere);
+
+    vtkSMProxy* reprProxy = controller->Show(sphere, 0, view);
+    auto rv = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+    auto repr = vtkPVDataRepresentation::SafeDownCast(
+      reprProxy->GetSubProxy("SurfaceRepresentation")->GetClientSideObject());
+
+    view->ResetCamera();
+    view->StillRender();
+
+    // A target that every render reaches moves one level finer per render,
+    // starting from the coarsest one.
+    vtkSMPropertyHelper(view, "LODTargetFrameRate").Set(1e-6);
+    view->UpdateVTKObjects();
+
+    vtkIdType previousCells = 0;
+    vtkPoints* levelPoints[4] = { nullptr, nullptr, nullptr, nullptr };
+    for (int level = 3; level >= 0 && status == EXIT_SUCCESS; --level)
+    {
+      view->InteractiveRender();
+      vtkPolyData* lod = GetLODPiece(rv, repr);
+      if (rv->GetLODLevel() != level || lod == nullptr)
+      {
+        vtkLogF(ERROR, "Expected LOD level %d, got %d.", level, rv->GetLODLevel());
+        status = EXIT_FAILURE;
+      }
+      else if (lod->GetNumberOfCells() <= previousCells)
+      {
+        vtkLogF(ERROR, "LOD level %d is not finer than level %d.", level, level + 1);
+        status = EXIT_FAILURE;
+      }
+      else
+      {
+        previousCells = lod->GetNumberOfCells();
+        levelPoints[level] = lod->GetPoints();
+      }
+    }
+
+    // A target no render reaches moves back one level coarser per render,
+    // reusing the levels decimated above.
+    vtkSMPropertyHelper(view, "LODTargetFrameRate").Set(1e9);
+    view->UpdateVTKObjects();
+    for (int level = 0; level < 4 && status == EXIT_SUCCESS; ++level)
+    {
+      view->InteractiveRender();
+      vtkPolyData* lod = GetLODPiece(rv, repr);
+      if (rv->GetLODLevel() != level || lod == nullptr)
+      {
+        vtkLogF(ERROR, "Expected LOD level %d, got %d.", level, rv->GetLODLevel());
+        status = EXIT_FAILURE;
+      }
+      else if (lod->GetPoints() != levelPoints[level])
+      {
+        vtkLogF(ERROR, "LOD level %d was decimated again instead of being reused.", level);
+        status = EXIT_FAILURE;
+      }
+    }
+
+    // The coarsest level is kept when renders still miss the target.
+    if (status == EXIT_SUCCESS)
+    {
+      view->InteractiveRender();
+      if (rv->GetLODLevel() != 3)
+      {
+        vtkLogF(ERROR, "Expected LOD level to stay at 3, got %d.", rv->GetLODLevel());
+        status = EXIT_FAILURE;
+      }
+    }
+
+    // Changing the input replaces the low-res data at the current level.
+    if (status == EXIT_SUCCESS)
+    {
+      vtkSMPropertyHelper(sphere, "Radius").Set(2.0);
+      sphere->UpdateVTKObjects();
+      view->StillRender();
+      view->InteractiveRender();
+      vtkPolyData* lod = GetLODPiece(rv, repr);
+      double bounds[6];
+      if (lod)
+      {
+        lod->GetBounds(bounds);
+      }
+      if (lod == nullptr || bounds[1] < 1.5)
+      {
+        vtkLogF(ERROR, "LOD data was not replaced when the input changed.");
+        status = EXIT_FAILURE;
+      }
+    }
+
+    controller->UnRegisterProxy(sphere);
+    controller->UnRegisterProxy(view);
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  }
+  vtkInitializationHelper::Finalize();
+  return status;
+}
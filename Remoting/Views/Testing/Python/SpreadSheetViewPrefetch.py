@@ -0,0 +1,65 @@
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+blockSize = 16
+
+sphere = Sphere(ThetaResolution=64, PhiResolution=64)
+view = CreateView("SpreadSheetView")
+view.BlockSize = blockSize
+view.MaximumNumberOfPrefetchedBlocks = 0
+Show(sphere, view)
+Render(view)
+
+pvview = view.GetClientSideObject()
+assert pvview.GetNumberOfRows() > 20 * blockSize
+
+# every block fetched from the server fires an UpdateEvent.
+fetches = []
+pvview.AddObserver("UpdateEvent", lambda obj, event: fetches.append(event))
+
+def read_rows(first, last):
+    return [pvview.GetValue(row, col).ToString()
+            for row in range(first, last + 1) for col in range(pvview.GetNumberOfColumns())]
+
+def read_block(block):
+    count = len(fetches)
+    read_rows(block * blockSize, (block + 1) * blockSize - 1)
+    return len(fetches) - count
+
+# without prefetching, the cache keeps the 10 most recently used blocks.
+pvview.ClearCache()
+for block in range(10):
+    assert read_block(block) == 1
+assert read_block(0) == 0
+# block 0 was used last, block 1 is the least recently used one.
+assert read_block(10) == 1
+assert read_block(0) == 0
+assert read_block(1) == 1
+
+# prefetching fetches the blocks ahead of the scroll direction without
+# changing the rows shown.
+view.MaximumNumberOfPrefetchedBlocks = 4
+pvview.ClearCache()
+pvview.SetViewedRows(2 * blockSize, 4 * blockSize - 1)
+pvview.SetViewedRows(3 * blockSize, 5 * blockSize - 1)
+shown = read_rows(3 * blockSize, 5 * blockSize - 1)
+count = len(fetches)
+while pvview.PrefetchBlock():
+    pass
+assert len(fetches) > count
+assert read_rows(3 * blockSize, 5 * blockSize - 1) == shown
+assert read_block(3) == 0 and read_block(4) == 0
+assert read_block(5) == 0
+
+# hidden columns are not delivered but are still listed, in the same order.
+names = [pvview.GetColumnName(col) for col in range(pvview.GetNumberOfColumns())]
+view.HiddenColumnLabels = ['Normals']
+Render(view)
+pvview.GetValue(0, 0)
+assert [pvview.GetColumnName(col) for col in range(pvview.GetNumberOfColumns())] == names
+normals = [col for col in range(len(names)) if pvview.GetColumnLabel(col) == 'Normals']
+assert normals
+for col in normals:
+    assert not pvview.GetColumnVisibility(col)
+assert any(pvview.GetColumnVisibility(col) for col in range(len(names)) if col not in normals)
@@ -0,0 +1,23 @@
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+# the calculator only changes the fields, the surface of its unchanged mesh
+# must come from the cache of the representation's geometry filter.
+wavelet = Wavelet()
+tetra = Tetrahedralize(Input=wavelet)
+calc = Calculator(Input=tetra, ResultArrayName="Result", Function="RTData")
+display = Show(calc)
+display.SurfaceCacheLimit = 64
+Render()
+
+display.UpdatePropertyInformation()
+hits = display.GetPropertyValue("SurfaceCacheHits")
+assert display.GetPropertyValue("SurfaceCacheMisses") > 0
+
+calc.Function = "2*RTData"
+Render()
+
+display.UpdatePropertyInformation()
+assert display.GetPropertyValue("SurfaceCacheHits") > hits
+assert display.GetPropertyValue("SurfaceCacheMemorySize") > 0
@@ -51,6 +51,7 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <numeric>
 #include <tuple>
@@ -449,23 +450,31 @@ int vtkGeometryRepresentation::ProcessViewRequest(
         // Pass along the LOD geometry to the view so that it can deliver it to
         // the rendering node as and when needed.
         vtkPVView::SetPieceLOD(inInfo, this, this->LODOutlineFilter->GetOutputDataObject(0));
+        this->LODLevelOutputTime = 0;
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        // We handle the LOD resolution differently depending on decimator
+        // implementation.
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
+        const int level =
+          inInfo->Has(vtkPVRenderView::LOD_LEVEL()) ? inInfo->Get(vtkPVRenderView::LOD_LEVEL()) : 0;
+        vtkDataObject* lod = this->GetLODLevel(data, factor, level);
+
+        // The view only replaces the LOD geometry it delivers when it is newer,
+        // so switching to a cached level passes a new shallow copy of it.
+        if (lod->GetMTime() != this->LODLevelOutputTime)
         {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
+          this->LODLevelOutput.TakeReference(lod->NewInstance());
+          this->LODLevelOutput->ShallowCopy(lod);
+          this->LODLevelOutputTime = lod->GetMTime();
         }
 
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
-
         // Pass along the LOD geometry to the view so that it can deliver it to
         // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        vtkPVView::SetPieceLOD(inInfo, this, this->LODLevelOutput);
       }
     }
   }
@@ -510,6 +519,45 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetLODLevel(
+  vtkDataObject* data, double factor, int level)
+{
+  if (data->GetMTime() > this->LODLevelsDataTime || factor != this->LODLevelsFactor)
+  {
+    this->LODLevels.clear();
+    this->LODLevelsDataTime = data->GetMTime();
+    this->LODLevelsFactor = factor;
+  }
+
+  level = std::max(level, 0);
+  if (static_cast<int>(this->LODLevels.size()) <= level)
+  {
+    this->LODLevels.resize(level + 1);
+  }
+  if (this->LODLevels[level] == nullptr)
+  {
+    vtkDataObject* source = data;
+    for (int finer = level - 1; finer >= 0; --finer)
+    {
+      if (this->LODLevels[finer] != nullptr)
+      {
+        source = this->LODLevels[finer];
+        break;
+      }
+    }
+
+    this->Decimator->SetLODFactor(factor * std::pow(0.5, level));
+    this->Decimator->SetInputDataObject(source);
+    this->Decimator->Update();
+
+    vtkDataObject* output = this->Decimator->GetOutputDataObject(0);
+    this->LODLevels[level].TakeReference(output->NewInstance());
+    this->LODLevels[level]->ShallowCopy(output);
+  }
+  return this->LODLevels[level];
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestUpdateExtent(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -1482,6 +1530,49 @@ void vtkGeometryRepresentation::SetFeatureAngle(double val)
   this->MarkModified();
 }
 
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetSurfaceCacheLimit(int val)
+{
+  if (auto geometryFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter))
+  {
+    geometryFilter->SetSurfaceCacheLimit(val);
+  }
+  // since geometry filter needs to execute, we need to mark the representation modified.
+  this->MarkModified();
+}
+
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::GetSurfaceCacheHits()
+{
+  auto geometryFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter);
+  return geometryFilter ? geometryFilter->GetSurfaceCacheHits() : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::GetSurfaceCacheMisses()
+{
+  auto geometryFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter);
+  return geometryFilter ? geometryFilter->GetSurfaceCacheMisses() : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::GetSurfaceCacheMemorySize()
+{
+  auto geometryFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter);
+  return geometryFilter ? geometryFilter->GetSurfaceCacheMemorySize() : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetThreadedBlockExecution(bool val)
+{
+  if (auto geometryFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter))
+  {
+    geometryFilter->SetThreadedBlockExecution(val);
+  }
+  // since geometry filter needs to execute, we need to mark the representation modified.
+  this->MarkModified();
+}
+
 //----------------------------------------------------------------------------
 void vtkGeometryRepresentation::SetPlaceHolderDataType(int datatype)
 {
@@ -20,6 +20,7 @@
 #include "vtkParaViewDeprecation.h" // for PV_DEPRECATED
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer
 #include "vtkVector.h"              // for vtkVector.
 
 #include <set>           // needed for std::set
@@ -182,6 +183,11 @@ public:
   void SetComputePointNormals(bool);
   void SetSplitting(bool);
   void SetFeatureAngle(double);
+  void SetSurfaceCacheLimit(int);
+  int GetSurfaceCacheHits();
+  int GetSurfaceCacheMisses();
+  int GetSurfaceCacheMemorySize();
+  void SetThreadedBlockExecution(bool);
 
   //***************************************************************************
   // Forwarded to vtkProperty.
@@ -527,11 +533,29 @@ protected:
    */
   void UpdateGeneralTextureTransform();
 
+  /**
+   * Returns `data` decimated for the given LOD level, level 0 using `factor`
+   * and each following level half the factor of the previous one. Levels are
+   * cached until `data` or `factor` change, and a level is decimated from the
+   * closest finer level already built since that is much cheaper than
+   * decimating `data` again.
+   */
+  vtkDataObject* GetLODLevel(vtkDataObject* data, double factor, int level);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
   vtkPVGeometryFilter* LODOutlineFilter;
 
+  // LOD levels built by GetLODLevel(), finest first, with the time of the data
+  // and the factor they were built from.
+  std::vector<vtkSmartPointer<vtkDataObject>> LODLevels;
+  vtkMTimeType LODLevelsDataTime = 0;
+  double LODLevelsFactor = -1;
+  // Shallow copy of the LOD level passed to the view, and that level's time.
+  vtkSmartPointer<vtkDataObject> LODLevelOutput;
+  vtkMTimeType LODLevelOutputTime = 0;
+
   vtkMapper* Mapper;
   vtkMapper* LODMapper;
   vtkPVLODActor* Actor;
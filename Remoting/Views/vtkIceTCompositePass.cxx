@@ -20,6 +20,7 @@
 #include "vtkOpenGLState.h"
 #include "vtkOrderedCompositingHelper.h"
 #include "vtkPVLogger.h"
+#include "vtkPVProfiler.h"
 #include "vtkPixelBufferObject.h"
 #include "vtkRenderState.h"
 #include "vtkRenderWindow.h"
@@ -337,6 +338,7 @@ void vtkIceTCompositePass::CleanupContext(const vtkRenderState*) {}
 void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
 {
   vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: Render", vtkLogIdentifier(this));
+  vtkPVProfiler::Scope scope("compositing", "vtkIceTCompositePass::Render");
   vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass::Render Start");
   this->IceTContext->SetController(this->Controller);
   if (!this->IceTContext->IsValid())
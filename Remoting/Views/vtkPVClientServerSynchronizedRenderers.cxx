@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -34,6 +35,40 @@ vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers(
   this->SetCompressor(nullptr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::MasterStartRender()
+{
+  this->Superclass::MasterStartRender();
+  if (!this->ExchangeKeyFrameRequests)
+  {
+    return;
+  }
+
+  // A delta frame is rejected when it does not match the reference frame.
+  // Only the server can fix that, by sending a key frame.
+  vtkDeltaImageCompressor* delta = vtkDeltaImageCompressor::SafeDownCast(this->Compressor);
+  int requestKeyFrame = (delta && !delta->HasReferenceFrame()) ? 1 : 0;
+  this->ParallelController->Send(&requestKeyFrame, 1, 1, 0x023431);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::SlaveStartRender()
+{
+  this->Superclass::SlaveStartRender();
+  if (!this->ExchangeKeyFrameRequests)
+  {
+    return;
+  }
+
+  int requestKeyFrame = 0;
+  this->ParallelController->Receive(&requestKeyFrame, 1, 1, 0x023431);
+  vtkDeltaImageCompressor* delta = vtkDeltaImageCompressor::SafeDownCast(this->Compressor);
+  if (requestKeyFrame && delta)
+  {
+    delta->ForceKeyFrame();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 {
@@ -143,6 +178,7 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
   std::istringstream iss(stream);
   std::string className;
   iss >> className;
+  this->ExchangeKeyFrameRequests = (className == "vtkDeltaImageCompressor");
   // Allocate the desired compressor unless we have one in hand.
   if (this->Compressor == nullptr || !this->Compressor->IsA(className.c_str()))
   {
@@ -159,6 +195,10 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkDeltaImageCompressor")
+    {
+      comp = vtkDeltaImageCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
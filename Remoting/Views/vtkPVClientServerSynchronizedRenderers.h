@@ -62,6 +62,17 @@ protected:
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
   void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
 
+  ///@{
+  /**
+   * When the compressor configuration selects vtkDeltaImageCompressor, the
+   * client tells the server whether its compressor lost the reference frame,
+   * e.g. after a rejected delta frame, so that the server sends a key frame
+   * for this render. Other compressors do not exchange anything here.
+   */
+  void MasterStartRender() override;
+  void SlaveStartRender() override;
+  ///@}
+
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
@@ -69,6 +80,10 @@ protected:
   bool LossLessCompression;
   bool NVPipeSupport;
 
+  // Set by ConfigureCompressor(). Since both ends are configured with the same
+  // string, they agree on whether the key frame request is exchanged.
+  bool ExchangeKeyFrameRequests = false;
+
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
   void operator=(const vtkPVClientServerSynchronizedRenderers&) = delete;
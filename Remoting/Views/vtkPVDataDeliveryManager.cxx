@@ -9,6 +9,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVLogger.h"
+#include "vtkPVProfiler.h"
 #include "vtkPVView.h"
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
@@ -98,8 +99,11 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   if (item)
   {
     const auto cacheKey = this->GetCacheKey(repr);
+    // low-res data may change without the pipeline updating e.g. when the
+    // view requests another LOD level, so it is replaced whenever it is newer.
     if (item->GetDataObject(cacheKey) == nullptr ||
-      repr->GetPipelineDataTime() > item->GetTimeStamp())
+      repr->GetPipelineDataTime() > item->GetTimeStamp() ||
+      (low_res && data != nullptr && data->GetMTime() > item->GetTimeStamp(cacheKey)))
     {
       vtkLogF(
         TRACE, "SetDataObject %s (key=%g) : %p", repr->GetLogName().c_str(), cacheKey, (void*)data);
@@ -249,6 +253,9 @@ void vtkPVDataDeliveryManager::Deliver(int low_res, unsigned int size, unsigned
       }
       vtkVLogScopeF(
         PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "move-data: %s", repr->GetLogName().c_str());
+      vtkPVProfiler::Scope scope("delivery", low_res ? "Deliver (low-res)" : "Deliver",
+        repr->GetLogName());
+      scope.AddBytes(static_cast<vtkTypeInt64>(item->GetActualMemorySize(cacheKey)) * 1024);
       this->MoveData(repr, low_res != 0, port);
     }
   }
@@ -70,6 +70,8 @@ public:
    * method to register the geometry type they are rendering. Every
    * representation that requires delivering of any geometry must register with
    * the vtkPVDataDeliveryManager and never manage the delivery on its own.
+   * Data is only replaced when the representation's pipeline has updated since
+   * it was last set or, for low-res data, when `data` was modified since.
    */
   void SetPiece(vtkPVDataRepresentation* repr, vtkDataObject* data, bool low_res,
     unsigned long trueSize = 0, int port = 0);
@@ -41,6 +41,9 @@ vtkStandardNewMacro(vtkPVHistogramChartRepresentation);
 vtkPVHistogramChartRepresentation::vtkPVHistogramChartRepresentation()
 {
   this->ExtractHistogram = vtkPExtractHistogram::New();
+  // bin on all threads and keep the counts so that changing the bin count is
+  // interactive.
+  this->ExtractHistogram->EnableSMPOn();
   this->SetChartTypeToBar();
   this->SetUseIndexForXAxis(false);
   this->SetXAxisSeriesName(BIN_EXTENTS);
@@ -53,6 +53,7 @@
 #include "vtkPVInteractorStyle.h"
 #include "vtkPVLogger.h"
 #include "vtkPVMaterialLibrary.h"
+#include "vtkPVProfiler.h"
 #include "vtkPVRenderViewDataDeliveryManager.h"
 #include "vtkPVRenderViewSettings.h"
 #include "vtkPVServerInformation.h"
@@ -102,6 +103,7 @@
 #include "vtkOSPRayRendererNode.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <set>
@@ -349,6 +351,7 @@ vtkObjectFactoryNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_LEVEL, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, REQUEST_STREAMING_UPDATE, Request);
@@ -1515,6 +1518,7 @@ void vtkPVRenderView::UpdateLOD()
   // Update LOD geometry.
 
   this->RequestInformation->Set(LOD_RESOLUTION(), this->LODResolution);
+  this->RequestInformation->Set(LOD_LEVEL(), this->LODLevel);
   if (this->UseOutlineForLODRendering)
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
@@ -1573,11 +1577,39 @@ void vtkPVRenderView::InteractiveRender()
   this->Internals->OSPRayCount = 0;
   this->Internals->PreRender(this->RenderView);
 
+  const double start = vtkTimerLog::GetUniversalTime();
   this->Render(true, this->SuppressRendering);
+  if (this->LODTargetFrameRate > 0 && this->UsedLODForLastRender)
+  {
+    // a finer level typically renders several times as many triangles, hence
+    // only move to it when well within the target to avoid oscillating.
+    const double frameTime = vtkTimerLog::GetUniversalTime() - start;
+    const double targetFrameTime = 1.0 / this->LODTargetFrameRate;
+    const int level = this->GetPreferredLODLevel();
+    if (frameTime > targetFrameTime)
+    {
+      this->PreferredLODLevel = std::min(level + 1, this->NumberOfLODLevels - 1);
+    }
+    else if (frameTime < 0.25 * targetFrameTime)
+    {
+      this->PreferredLODLevel = std::max(level - 1, 0);
+    }
+  }
 
   vtkTimerLog::MarkEndEvent("Interactive Render");
 }
 
+//----------------------------------------------------------------------------
+int vtkPVRenderView::GetPreferredLODLevel() const
+{
+  if (this->LODTargetFrameRate <= 0)
+  {
+    return 0;
+  }
+  // start from the coarsest level until renders have been timed.
+  return std::max(0, std::min(this->PreferredLODLevel, this->NumberOfLODLevels - 1));
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
 {
@@ -1590,6 +1622,8 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
 
   vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Render(interactive=%s, skip_rendering=%s)",
     (interactive ? "true" : "false"), (skip_rendering ? "true" : "false"));
+  vtkPVProfiler::Scope scope(
+    "rendering", interactive ? "InteractiveRender" : "StillRender", this->GetLogName());
 
   this->UpdateStereoProperties();
 
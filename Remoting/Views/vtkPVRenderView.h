@@ -277,6 +277,39 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the frame rate, in frames per second, interactive renders using
+   * LOD should reach. When greater than 0, the frame time of each interactive
+   * render picks which of NumberOfLODLevels LOD levels to use next: level 0 is
+   * decimated with LODResolution and each following level with half the
+   * resolution of the previous one. Levels are tried from the coarsest and a
+   * finer one is used when renders are well within the target. 0 (default)
+   * always uses level 0.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(LODTargetFrameRate, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODTargetFrameRate, double);
+  vtkSetClampMacro(NumberOfLODLevels, int, 1, 8);
+  vtkGetMacro(NumberOfLODLevels, int);
+  ///@}
+
+  /**
+   * Returns the LOD level picked from the frame time of the previous
+   * interactive renders on this process. vtkSMRenderViewProxy passes the level
+   * picked on the client to all processes using SetLODLevel().
+   */
+  int GetPreferredLODLevel() const;
+
+  ///@{
+  /**
+   * Get/Set the LOD level requested from representations by UpdateLOD().
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(LODLevel, int, 0, 7);
+  vtkGetMacro(LODLevel, int);
+  ///@}
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -318,6 +351,12 @@ public:
    */
   static vtkInformationDoubleKey* LOD_RESOLUTION();
 
+  /**
+   * Indicates the LOD level in REQUEST_UPDATE_LOD() pass. Representations
+   * supporting several levels decimate level `n` with LOD_RESOLUTION / 2^n.
+   */
+  static vtkInformationIntegerKey* LOD_LEVEL();
+
   /**
    * Indicates the LOD must use outline if possible in REQUEST_UPDATE_LOD()
    * pass.
@@ -1308,6 +1347,10 @@ protected:
   bool Blur;
 
   double LODResolution;
+  double LODTargetFrameRate = 0;
+  int NumberOfLODLevels = 4;
+  int LODLevel = 0;
+  int PreferredLODLevel = VTK_INT_MAX;
   bool UseLightKit;
 
   bool UsedLODForLastRender;
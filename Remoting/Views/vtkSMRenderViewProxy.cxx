@@ -341,9 +341,20 @@ void vtkSMRenderViewProxy::Update()
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::UpdateLOD()
 {
+  // the LOD level is picked on the client from the frame time of the previous
+  // interactive renders.
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  const int level = rv ? rv->GetPreferredLODLevel() : 0;
+  if (rv && level != rv->GetLODLevel())
+  {
+    this->NeedsUpdateLOD = true;
+  }
+
   if (this->ObjectsCreated && this->NeedsUpdateLOD)
   {
     vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetLODLevel" << level
+           << vtkClientServerStream::End;
     stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "UpdateLOD"
            << vtkClientServerStream::End;
     this->GetSession()->PrepareProgress();
@@ -1567,9 +1578,11 @@ bool vtkSMRenderViewProxy::SelectPolygonInternal(vtkIntArray* polygonPts,
 {
   const char* method =
     fieldAssociation == vtkSelectionNode::POINT ? "SelectPolygonPoints" : "SelectPolygonCells";
+  // polygonPts outlives the stream, which is executed right away, so its
+  // values can be sent without copying them into the stream.
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << method
-         << vtkClientServerStream::InsertArray(polygonPts->GetPointer(0),
+         << vtkClientServerStream::ReferenceArray(polygonPts->GetPointer(0),
               polygonPts->GetNumberOfTuples() * polygonPts->GetNumberOfComponents())
          << polygonPts->GetNumberOfTuples() * polygonPts->GetNumberOfComponents()
          << vtkClientServerStream::End;
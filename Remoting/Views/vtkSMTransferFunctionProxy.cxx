@@ -20,6 +20,7 @@
 #include "vtkSMScalarBarWidgetRepresentationProxy.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSettings.h"
+#include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
 #include "vtkSMTrace.h"
 #include "vtkSMTransferFunctionManager.h"
@@ -483,13 +484,8 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
     component = vtkSMPropertyHelper(this, "VectorComponent").GetAsInt();
   }
 
-  // Create a GroupDataSet filter
-  vtkSMSessionProxyManager* pxm =
-    vtkSMProxyManager::GetProxyManager()->GetActiveSessionProxyManager();
-  vtkSmartPointer<vtkSMSourceProxy> group;
-  group.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "GroupDataSets")));
-
   // Group all visible consumers using the transfer function proxy
+  std::vector<vtkSMProxy*> inputs;
   vtkPVArrayInformation* arrayInfo = nullptr;
   std::string arrayName;
   int arrayAsso = -1;
@@ -569,10 +565,7 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
       }
 
       // Add consumer to group filter
-      vtkSMSourceProxy* input =
-        vtkSMSourceProxy::SafeDownCast(vtkSMPropertyHelper(consumer, "Input").GetAsProxy());
-      vtkSMPropertyHelper(group, "Input").Add(input);
-      group->UpdateVTKObjects();
+      inputs.push_back(vtkSMPropertyHelper(consumer, "Input").GetAsProxy());
       hasData = true;
       usedProxy.insert(consumer);
     }
@@ -585,37 +578,68 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
     return this->HistogramTableCache;
   }
 
-  // Compute the histogram
-  vtkSmartPointer<vtkSMSourceProxy> histo;
-  histo.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ExtractHistogram")));
-  vtkSMPropertyHelper(histo, "Input").Set(group);
+  // The pipeline is created once and kept, so that the histogram filter only
+  // bins the data again when it changes. The group filter is only referenced
+  // by the histogram filter input.
+  if (!this->HistogramDelivery)
+  {
+    vtkSMSessionProxyManager* pxm = this->GetSessionProxyManager();
+
+    // Create a GroupDataSet filter
+    vtkSmartPointer<vtkSMSourceProxy> group;
+    group.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "GroupDataSets")));
+
+    // Compute the histogram
+    this->HistogramFilter.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ExtractHistogram")));
+    vtkSMPropertyHelper(this->HistogramFilter, "Input").Set(group);
+    vtkSMPropertyHelper(this->HistogramFilter, "UseCustomBinRanges").Set(true);
+    vtkSMPropertyHelper(this->HistogramFilter, "EnableSMP").Set(1);
+
+    // Reduce it
+    vtkSmartPointer<vtkSMSourceProxy> reducer;
+    reducer.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ReductionFilter")));
+    vtkSMPropertyHelper(reducer, "Input").Set(this->HistogramFilter);
+    vtkSMPropertyHelper(reducer, "PostGatherHelperName").Set("vtkPVMergeTables");
+    reducer->UpdateVTKObjects();
+
+    // Move it from server to client
+    this->HistogramDelivery.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ClientServerMoveData")));
+    vtkSMPropertyHelper(this->HistogramDelivery, "Input").Set(reducer);
+    vtkSMPropertyHelper(this->HistogramDelivery, "OutputDataType").Set(VTK_TABLE);
+    this->HistogramDelivery->UpdateVTKObjects();
+  }
+
+  // The inputs are removed again once the histogram is computed, so that
+  // the consumers are not kept alive by this proxy. The histogram filter
+  // still reuses its bin counts as long as the input arrays are unchanged.
+  vtkSMProxy* group = vtkSMPropertyHelper(this->HistogramFilter, "Input").GetAsProxy();
+  vtkSMPropertyHelper groupInput(group, "Input");
+  groupInput.RemoveAllValues();
+  for (vtkSMProxy* input : inputs)
+  {
+    groupInput.Add(input);
+  }
+  group->UpdateVTKObjects();
+
+  vtkSMSourceProxy* histo = this->HistogramFilter;
   vtkSMPropertyHelper(histo, "SelectInputArray")
     .SetInputArrayToProcess(arrayAsso, arrayName.c_str());
   vtkSMPropertyHelper(histo, "Component").Set(component);
   vtkSMPropertyHelper(histo, "BinCount").Set(numberOfBins);
-  vtkSMPropertyHelper(histo, "UseCustomBinRanges").Set(true);
   vtkSMPropertyHelper(histo, "CustomBinRanges").Set(this->LastRange, 2);
   histo->UpdateVTKObjects();
 
-  // Reduce it
-  vtkSmartPointer<vtkSMSourceProxy> reducer;
-  reducer.TakeReference(
-    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ReductionFilter")));
-  vtkSMPropertyHelper(reducer, "Input").Set(histo);
-  vtkSMPropertyHelper(reducer, "PostGatherHelperName").Set("vtkPVMergeTables");
-  reducer->UpdateVTKObjects();
-
-  // Move it from server to client and save it to the case
-  vtkSmartPointer<vtkSMSourceProxy> mover;
-  mover.TakeReference(
-    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ClientServerMoveData")));
-  vtkSMPropertyHelper(mover, "Input").Set(reducer);
-  vtkSMPropertyHelper(mover, "OutputDataType").Set(VTK_TABLE);
-  mover->UpdateVTKObjects();
-  mover->UpdatePipeline();
+  // Update the pipeline and save the result to the cache
+  this->HistogramDelivery->UpdatePipeline();
   vtkTable* histoTable = vtkTable::SafeDownCast(
-    vtkAlgorithm::SafeDownCast(mover->GetClientSideObject())->GetOutputDataObject(0));
+    vtkAlgorithm::SafeDownCast(this->HistogramDelivery->GetClientSideObject())
+      ->GetOutputDataObject(0));
   this->HistogramTableCache->ShallowCopy(histoTable);
+  groupInput.RemoveAllValues();
+  group->UpdateVTKObjects();
 
   // Sanity check of the histogram table
   if (this->HistogramTableCache->GetNumberOfColumns() < 2)
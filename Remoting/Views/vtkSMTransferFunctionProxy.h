@@ -21,6 +21,7 @@
 
 // Forward declarations
 class vtkPVArrayInformation;
+class vtkSMSourceProxy;
 
 class VTKREMOTINGVIEWS_EXPORT vtkSMTransferFunctionProxy : public vtkSMProxy
 {
@@ -393,6 +394,14 @@ protected:
    */
   vtkSmartPointer<vtkTable> HistogramTableCache;
 
+  /*
+   * Pipeline computing the histogram table, kept between calls to
+   * ComputeDataHistogramTable so that the histogram filter can reuse its
+   * cached bin counts. Its inputs are only set during these calls.
+   */
+  vtkSmartPointer<vtkSMSourceProxy> HistogramFilter;
+  vtkSmartPointer<vtkSMSourceProxy> HistogramDelivery;
+
 private:
   vtkSMTransferFunctionProxy(const vtkSMTransferFunctionProxy&) = delete;
   void operator=(const vtkSMTransferFunctionProxy&) = delete;
@@ -19,6 +19,8 @@
 #include "vtkMemberFunctionCommand.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNetworkAccessManager.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVMergeTables.h"
@@ -31,15 +33,20 @@
 #include "vtkSpreadSheetRepresentation.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
+#include "vtkTableAlgorithm.h"
 #include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkVariant.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <list>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -151,17 +158,38 @@ protected:
     auto output = vtkTable::GetData(outputVector, 0);
     auto inputs = vtkPVMergeTables::GetTables(inputVector[0]);
 
+    // the hidden columns are the same on all ranks that have any.
+    vtkSmartPointer<vtkAbstractArray> hiddenColumns;
+    for (const auto& input : inputs)
+    {
+      if ((hiddenColumns = input->GetFieldData()->GetAbstractArray("vtkHiddenColumns")))
+      {
+        break;
+      }
+    }
+
     const bool has_block_names =
       (!inputs.empty() && inputs[0]->GetFieldData()->GetAbstractArray("vtkBlockNames"));
     if (!has_block_names)
     {
-      return this->Superclass::RequestData(req, inputVector, outputVector);
+      if (!this->Superclass::RequestData(req, inputVector, outputVector))
+      {
+        return 0;
+      }
     }
+    else
+    {
+      vtkPVMergeTables::MergeTables(output, inputs);
 
-    vtkPVMergeTables::MergeTables(output, inputs);
-
-    output->GetFieldData()->RemoveArray("vtkBlockNames");
-    output->GetFieldData()->AddArray(inputs[0]->GetFieldData()->GetAbstractArray("vtkBlockNames"));
+      output->GetFieldData()->RemoveArray("vtkBlockNames");
+      output->GetFieldData()->AddArray(
+        inputs[0]->GetFieldData()->GetAbstractArray("vtkBlockNames"));
+    }
+    if (hiddenColumns)
+    {
+      output->GetFieldData()->RemoveArray("vtkHiddenColumns");
+      output->GetFieldData()->AddArray(hiddenColumns);
+    }
     return 1;
   }
 
@@ -170,6 +198,119 @@ private:
   void operator=(const SpreadSheetViewMergeTables&) = delete;
 };
 vtkStandardNewMacro(SpreadSheetViewMergeTables);
+
+/**
+ * Removes the columns hidden in the view from the blocks before they are
+ * reduced and delivered to the client, so that only the columns the user can
+ * see are sent. Columns needed to identify the rows are always kept. The
+ * name, original array name and original component of the removed columns
+ * are listed in the "vtkHiddenColumns" field data array so that the client
+ * still knows about them, see vtkSpreadSheetView::vtkInternals::AddToCache().
+ */
+class SpreadSheetViewVisibleColumns : public vtkTableAlgorithm
+{
+public:
+  static SpreadSheetViewVisibleColumns* New();
+  vtkTypeMacro(SpreadSheetViewVisibleColumns, vtkTableAlgorithm);
+
+  vtkSpreadSheetView* View = nullptr;
+
+protected:
+  SpreadSheetViewVisibleColumns() = default;
+  ~SpreadSheetViewVisibleColumns() override = default;
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector) override
+  {
+    auto input = vtkTable::GetData(inputVector[0], 0);
+    auto output = vtkTable::GetData(outputVector, 0);
+    output->ShallowCopy(input);
+    if (this->View == nullptr)
+    {
+      return 1;
+    }
+
+    const char* maskPrefix = "__vtkValidMask__";
+    const size_t maskPrefixLength = strlen(maskPrefix);
+    std::vector<std::string> hidden;
+    vtkNew<vtkStringArray> hiddenColumns;
+    hiddenColumns->SetName("vtkHiddenColumns");
+    hiddenColumns->SetNumberOfComponents(3);
+    for (vtkIdType cc = 0, max = input->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      auto column = input->GetColumn(cc);
+      const char* name = column ? column->GetName() : nullptr;
+      if (name == nullptr)
+      {
+        continue;
+      }
+      if (std::strstr(name, maskPrefix) == name)
+      {
+        // a mask goes with the column it masks.
+        column = input->GetColumnByName(name + maskPrefixLength);
+      }
+      if (column && this->IsHidden(column))
+      {
+        hidden.push_back(name);
+        if (column == input->GetColumn(cc))
+        {
+          auto colInfo = column->GetInformation();
+          const int component = colInfo->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER())
+            ? colInfo->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER())
+            : -1;
+          const char* originalName = colInfo->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME())
+            ? colInfo->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME())
+            : "";
+          hiddenColumns->InsertNextValue(name);
+          hiddenColumns->InsertNextValue(originalName);
+          hiddenColumns->InsertNextValue(std::to_string(component));
+        }
+      }
+    }
+    for (const auto& name : hidden)
+    {
+      output->RemoveColumnByName(name.c_str());
+    }
+    if (hiddenColumns->GetNumberOfTuples() > 0)
+    {
+      output->GetFieldData()->AddArray(hiddenColumns);
+    }
+    return 1;
+  }
+
+  bool IsHidden(vtkAbstractArray* column) const
+  {
+    const char* name = column->GetName();
+    if (name == nullptr || this->View->IsColumnInternal(name) ||
+      strcmp(name, "vtkOriginalProcessIds") == 0 || strcmp(name, "vtkCompositeIndexArray") == 0 ||
+      strcmp(name, "vtkOriginalIndices") == 0)
+    {
+      return false;
+    }
+    if (this->View->IsColumnHiddenByName(name))
+    {
+      return true;
+    }
+
+    // same as vtkSpreadSheetView::GetColumnLabel(), which can only be used for
+    // the columns of the blocks cached on the client.
+    bool cleaned = false;
+    std::string label = ::get_userfriendly_name(name, this->View, &cleaned);
+    auto colInfo = column->GetInformation();
+    if (!cleaned && colInfo->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) &&
+      colInfo->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) >= 0 &&
+      colInfo->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME()))
+    {
+      label = colInfo->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME());
+    }
+    return this->View->IsColumnHiddenByLabel(label);
+  }
+
+private:
+  SpreadSheetViewVisibleColumns(const SpreadSheetViewVisibleColumns&) = delete;
+  void operator=(const SpreadSheetViewVisibleColumns&) = delete;
+};
+vtkStandardNewMacro(SpreadSheetViewVisibleColumns);
 }
 
 class vtkSpreadSheetView::vtkInternals
@@ -221,33 +362,29 @@ class vtkSpreadSheetView::vtkInternals
     return 0;
   }
 
-  class CacheInfo
-  {
-  public:
-    vtkSmartPointer<vtkTable> Dataobject;
-    vtkTimeStamp RecentUseTime;
-
-    CacheInfo()
-    {
-      this->Dataobject = nullptr;
-      this->RecentUseTime = vtkTimeStamp();
-    }
-  };
-
-  typedef std::map<vtkIdType, CacheInfo> CacheType;
+  // Cached blocks, most recently used first, and their position in that list
+  // by block id so that lookups and evictions are done in constant time.
+  typedef std::pair<vtkIdType, vtkSmartPointer<vtkTable>> CacheItem;
+  typedef std::list<CacheItem> CacheType;
   CacheType CachedBlocks;
-  std::pair<vtkIdType, CacheInfo> PreviousFirstCachedBlock;
+  std::unordered_map<vtkIdType, CacheType::iterator> CachedBlocksIndex;
+  CacheItem PreviousFirstCachedBlock;
 
 public:
   void ClearCache()
   {
     if (!this->CachedBlocks.empty())
     {
-      this->PreviousFirstCachedBlock = *this->CachedBlocks.begin();
+      this->PreviousFirstCachedBlock = *std::min_element(this->CachedBlocks.begin(),
+        this->CachedBlocks.end(),
+        [](const CacheItem& a, const CacheItem& b) { return a.first < b.first; });
     }
     this->CachedBlocks.clear();
+    this->CachedBlocksIndex.clear();
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
+    // the reply to a pending prefetch carries outdated data, it is ignored.
+    this->PendingPrefetchBlock = -1;
   }
 
   vtkIdType GetNumberOfColumns(vtkSpreadSheetView* self)
@@ -292,16 +429,30 @@ public:
 
   vtkTable* GetDataObject(vtkIdType blockId)
   {
-    CacheType::iterator iter = this->CachedBlocks.find(blockId);
-    if (iter != this->CachedBlocks.end())
+    auto iter = this->CachedBlocksIndex.find(blockId);
+    if (iter != this->CachedBlocksIndex.end())
     {
-      iter->second.RecentUseTime.Modified();
+      this->CachedBlocks.splice(this->CachedBlocks.begin(), this->CachedBlocks, iter->second);
       this->MostRecentlyAccessedBlock = blockId;
-      return iter->second.Dataobject.GetPointer();
+      return iter->second->second.GetPointer();
     }
     return nullptr;
   }
 
+  bool IsCached(vtkIdType blockId) const
+  {
+    return this->CachedBlocksIndex.find(blockId) != this->CachedBlocksIndex.end();
+  }
+
+  /**
+   * Number of blocks kept in the cache, enough for the blocks being viewed and
+   * the prefetched blocks on either side of them.
+   */
+  vtkIdType GetCacheSize(vtkSpreadSheetView* self) const
+  {
+    return 10 + 2 * static_cast<vtkIdType>(self->GetMaximumNumberOfPrefetchedBlocks());
+  }
+
   bool OrderByNames(vtkAbstractArray* a1, vtkAbstractArray* a2)
   {
     std::vector<std::string> firstOrder = { "vtkBlockNameIndices", "vtkOriginalProcessIds",
@@ -368,28 +519,20 @@ public:
 
   vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
   {
-    CacheType::iterator iter = this->CachedBlocks.find(blockId);
-    if (iter != this->CachedBlocks.end())
+    auto iter = this->CachedBlocksIndex.find(blockId);
+    if (iter != this->CachedBlocksIndex.end())
     {
-      this->CachedBlocks.erase(iter);
+      this->CachedBlocks.erase(iter->second);
+      this->CachedBlocksIndex.erase(iter);
     }
 
-    if (static_cast<vtkIdType>(this->CachedBlocks.size()) == max)
+    while (!this->CachedBlocks.empty() && static_cast<vtkIdType>(this->CachedBlocks.size()) >= max)
     {
       // remove least-recent-used block.
-      iter = this->CachedBlocks.begin();
-      CacheType::iterator iterToRemove = this->CachedBlocks.begin();
-      for (; iter != this->CachedBlocks.end(); ++iter)
-      {
-        if (iterToRemove->second.RecentUseTime > iter->second.RecentUseTime)
-        {
-          iterToRemove = iter;
-        }
-      }
-      this->CachedBlocks.erase(iterToRemove);
+      this->CachedBlocksIndex.erase(this->CachedBlocks.back().first);
+      this->CachedBlocks.pop_back();
     }
 
-    CacheInfo info;
     vtkTable* clone = vtkTable::New();
 
     // sort columns for better usability.
@@ -409,6 +552,27 @@ public:
         }
       }
     }
+    // hidden columns are not delivered, add them back with empty values so
+    // that the columns and their order do not depend on their visibility.
+    if (auto hidden =
+          vtkStringArray::SafeDownCast(data->GetFieldData()->GetAbstractArray("vtkHiddenColumns")))
+    {
+      for (vtkIdType cc = 0, max = hidden->GetNumberOfTuples(); cc < max; ++cc)
+      {
+        vtkNew<vtkStringArray> column;
+        column->SetName(hidden->GetValue(3 * cc).c_str());
+        column->SetNumberOfTuples(data->GetNumberOfRows());
+        const int component = std::atoi(hidden->GetValue(3 * cc + 2).c_str());
+        if (component >= 0)
+        {
+          column->GetInformation()->Set(
+            vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME(), hidden->GetValue(3 * cc + 1).c_str());
+          column->GetInformation()->Set(
+            vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER(), component);
+        }
+        arrays.push_back(column.GetPointer());
+      }
+    }
     // if block-names are present in field-data, create an array
     std::sort(arrays.begin(), arrays.end(),
       [this](vtkAbstractArray* a1, vtkAbstractArray* a2) { return this->OrderByNames(a1, a2); });
@@ -416,10 +580,9 @@ public:
     {
       clone->AddColumn(column);
     }
-    info.Dataobject = clone;
+    this->CachedBlocks.emplace_front(blockId, clone);
+    this->CachedBlocksIndex[blockId] = this->CachedBlocks.begin();
     clone->FastDelete();
-    info.RecentUseTime.Modified();
-    this->CachedBlocks[blockId] = info;
     this->MostRecentlyAccessedBlock = blockId;
     if (this->CachedBlocks.size() == 1)
     {
@@ -431,7 +594,7 @@ public:
   /**
    * Get Previous first cached block
    */
-  std::pair<vtkIdType, CacheInfo> GetPreviousFirstCachedBlock()
+  CacheItem GetPreviousFirstCachedBlock()
   {
     return this->PreviousFirstCachedBlock;
   }
@@ -448,11 +611,11 @@ public:
       return table;
     }
 
-    for (const auto& cinfo : this->CachedBlocks)
+    for (const auto& item : this->CachedBlocks)
     {
-      if (cinfo.second.Dataobject != nullptr)
+      if (item.second != nullptr)
       {
-        return cinfo.second.Dataobject;
+        return item.second;
       }
     }
     return nullptr;
@@ -481,6 +644,88 @@ public:
   std::set<std::string> HiddenColumnsByName;
   std::set<std::string> HiddenColumnsByLabel;
 
+  // Hidden columns when the cached blocks were fetched. Hidden columns are not
+  // delivered, so the blocks must be fetched again when these change.
+  std::set<std::string> DeliveredHiddenColumnsByName;
+  std::set<std::string> DeliveredHiddenColumnsByLabel;
+
+  vtkNew<SpreadSheetViewVisibleColumns> VisibleColumns;
+
+  // Rows being viewed, when they last changed and the scroll velocity in rows
+  // per second, used to predict the blocks viewed next.
+  vtkIdType ViewedRows[2] = { -1, -1 };
+  double ViewedRowsTime = 0;
+  double ScrollVelocity = 0;
+
+  // Block requested from the server by PrefetchBlock(), -1 if none, and the
+  // identifier of that request that its reply must match.
+  vtkIdType PendingPrefetchBlock = -1;
+  vtkTypeUInt64 PrefetchRequestId = 0;
+
+  void SetViewedRows(vtkIdType first, vtkIdType last)
+  {
+    if (first == this->ViewedRows[0] && last == this->ViewedRows[1])
+    {
+      return;
+    }
+    const double now = vtkTimerLog::GetUniversalTime();
+    if (this->ViewedRows[0] >= 0 && first != this->ViewedRows[0])
+    {
+      const double elapsed = std::max(now - this->ViewedRowsTime, 1e-3);
+      const double velocity = (first - this->ViewedRows[0]) / elapsed;
+      // start over when the direction changes or after a pause, otherwise
+      // smooth out the jitter between successive repaints.
+      this->ScrollVelocity = (velocity * this->ScrollVelocity <= 0 || elapsed > 1.0)
+        ? velocity
+        : 0.5 * (this->ScrollVelocity + velocity);
+    }
+    this->ViewedRows[0] = first;
+    this->ViewedRows[1] = last;
+    this->ViewedRowsTime = now;
+  }
+
+  /**
+   * Returns the blocks worth prefetching, most urgent first: the blocks being
+   * viewed, the blocks scrolled into within the next second at the current
+   * velocity, at least one, and one block behind in case the user turns back.
+   */
+  std::vector<vtkIdType> GetBlocksToPrefetch(vtkSpreadSheetView* self) const
+  {
+    std::vector<vtkIdType> blocks;
+    const vtkIdType blockSize = self->TableStreamer->GetBlockSize();
+    const int maxPrefetch = self->GetMaximumNumberOfPrefetchedBlocks();
+    if (this->ViewedRows[0] < 0 || blockSize <= 0 || maxPrefetch <= 0)
+    {
+      return blocks;
+    }
+    const vtkIdType numBlocks = (self->GetNumberOfRows() + blockSize - 1) / blockSize;
+    const vtkIdType first = this->ViewedRows[0] / blockSize;
+    const vtkIdType last = std::max(this->ViewedRows[1] / blockSize, first);
+    for (vtkIdType block = first; block <= last && block < numBlocks; ++block)
+    {
+      blocks.push_back(block);
+    }
+
+    const bool stale = vtkTimerLog::GetUniversalTime() - this->ViewedRowsTime > 1.0;
+    const double blocksPerSecond = stale ? 0 : std::abs(this->ScrollVelocity) / blockSize;
+    const vtkIdType ahead =
+      std::min(std::max(static_cast<vtkIdType>(std::ceil(blocksPerSecond)), vtkIdType(1)),
+        static_cast<vtkIdType>(maxPrefetch));
+    const vtkIdType direction = this->ScrollVelocity < 0 ? -1 : 1;
+    const vtkIdType front = direction > 0 ? last : first;
+    const vtkIdType back = direction > 0 ? first : last;
+    for (vtkIdType cc = 1; cc <= ahead; ++cc)
+    {
+      blocks.push_back(front + direction * cc);
+    }
+    blocks.push_back(back - direction);
+
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                   [numBlocks](vtkIdType block) { return block < 0 || block >= numBlocks; }),
+      blocks.end());
+    return blocks;
+  }
+
   std::vector<std::string> OrderedColumnList;
   bool OrderColumnsByList = false;
 };
@@ -500,6 +745,50 @@ void FetchRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
   }
 }
 
+void PrefetchRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
+{
+  assert(remoteArgLength == sizeof(vtkTypeUInt64) * 3);
+  (void)remoteArgLength;
+
+  auto arg = reinterpret_cast<vtkTypeUInt64*>(remoteArg);
+  vtkSpreadSheetView* self = reinterpret_cast<vtkSpreadSheetView*>(localArg);
+  if (self->GetIdentifier() == arg[0])
+  {
+    self->PrefetchBlockCallback(static_cast<vtkIdType>(arg[1]), arg[2]);
+  }
+}
+
+// The reply starts with the same header as the request, followed by the
+// marshalled block, if any.
+void PrefetchReplyRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
+{
+  constexpr int headerLength = static_cast<int>(sizeof(vtkTypeUInt64) * 3);
+  if (remoteArgLength < headerLength)
+  {
+    return;
+  }
+
+  vtkTypeUInt64 arg[3];
+  memcpy(arg, remoteArg, headerLength);
+  vtkSpreadSheetView* self = reinterpret_cast<vtkSpreadSheetView*>(localArg);
+  if (self->GetIdentifier() != arg[0])
+  {
+    return;
+  }
+
+  vtkSmartPointer<vtkDataObject> block;
+  if (remoteArgLength > headerLength)
+  {
+    // the buffer is only read from, it is not released by the array.
+    vtkNew<vtkCharArray> buffer;
+    buffer->SetArray(reinterpret_cast<char*>(remoteArg) + headerLength,
+      remoteArgLength - headerLength, /*save=*/1);
+    block = vtkCommunicator::UnMarshalDataObject(buffer);
+  }
+  self->PrefetchBlockReplyCallback(
+    static_cast<vtkIdType>(arg[1]), arg[2], vtkTable::SafeDownCast(block));
+}
+
 unsigned long vtkCountNumberOfRows(vtkDataObject* dobj)
 {
   vtkTable* table = vtkTable::SafeDownCast(dobj);
@@ -574,7 +863,9 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   this->ReductionFilter->SetController(vtkMultiProcessController::GetGlobalController());
   this->ReductionFilter->SetPostGatherHelper(vtkNew<SpreadSheetViewMergeTables>().GetPointer());
   this->DeliveryFilter->SetOutputDataType(VTK_TABLE);
-  this->ReductionFilter->SetInputConnection(this->TableStreamer->GetOutputPort());
+  this->Internals->VisibleColumns->View = this;
+  this->Internals->VisibleColumns->SetInputConnection(this->TableStreamer->GetOutputPort());
+  this->ReductionFilter->SetInputConnection(this->Internals->VisibleColumns->GetOutputPort());
 
   this->Internals->MostRecentlyAccessedBlock = -1;
   this->Internals->Observer =
@@ -585,6 +876,13 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   if (auto cController = session->GetController(vtkPVSession::CLIENT))
   {
     this->CRMICallbackTag = cController->AddRMICallback(::FetchRMI, this, FETCH_BLOCK_TAG);
+    this->CRMIPrefetchCallbackTag =
+      cController->AddRMICallback(::PrefetchRMI, this, PREFETCH_BLOCK_TAG);
+  }
+  if (auto dController = session->GetController(vtkPVSession::DATA_SERVER_ROOT))
+  {
+    this->DRMIPrefetchReplyCallbackTag =
+      dController->AddRMICallback(::PrefetchReplyRMI, this, PREFETCH_BLOCK_REPLY_TAG);
   }
   if (auto pController = vtkMultiProcessController::GetGlobalController())
   {
@@ -599,7 +897,14 @@ vtkSpreadSheetView::~vtkSpreadSheetView()
   if (auto cController = session ? session->GetController(vtkPVSession::CLIENT) : nullptr)
   {
     cController->RemoveRMICallback(this->CRMICallbackTag);
+    cController->RemoveRMICallback(this->CRMIPrefetchCallbackTag);
     this->CRMICallbackTag = 0;
+    this->CRMIPrefetchCallbackTag = 0;
+  }
+  if (auto dController = session ? session->GetController(vtkPVSession::DATA_SERVER_ROOT) : nullptr)
+  {
+    dController->RemoveRMICallback(this->DRMIPrefetchReplyCallbackTag);
+    this->DRMIPrefetchReplyCallbackTag = 0;
   }
   if (auto pController = session ? vtkMultiProcessController::GetGlobalController() : nullptr)
   {
@@ -838,15 +1143,16 @@ void vtkSpreadSheetView::Update()
   {
     // Add the previous first cached block to the cache if it exists.
     auto previousFirstCachedBlock = this->Internals->GetPreviousFirstCachedBlock();
-    vtkSmartPointer<vtkTable> table = previousFirstCachedBlock.second.Dataobject;
+    vtkSmartPointer<vtkTable> table = previousFirstCachedBlock.second;
+    const vtkIdType cacheSize = this->Internals->GetCacheSize(this);
     if (table)
     {
-      this->Internals->AddToCache(previousFirstCachedBlock.first, table, 10);
+      this->Internals->AddToCache(previousFirstCachedBlock.first, table, cacheSize);
     }
     else // Add an empty block to the cache.
     {
       table = vtkSmartPointer<vtkTable>::New();
-      this->Internals->AddToCache(0, table, 10);
+      this->Internals->AddToCache(0, table, cacheSize);
     }
   }
 
@@ -906,6 +1212,15 @@ int vtkSpreadSheetView::StreamToClient()
     this->SomethingUpdated = true;
   }
   this->NumberOfRows = num_rows;
+
+  auto& internals = *this->Internals;
+  if (internals.DeliveredHiddenColumnsByName != internals.HiddenColumnsByName ||
+    internals.DeliveredHiddenColumnsByLabel != internals.HiddenColumnsByLabel)
+  {
+    internals.DeliveredHiddenColumnsByName = internals.HiddenColumnsByName;
+    internals.DeliveredHiddenColumnsByLabel = internals.HiddenColumnsByLabel;
+    this->SomethingUpdated = true;
+  }
   if (this->SomethingUpdated)
   {
     this->ClearCache();
@@ -930,7 +1245,7 @@ vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
     block = this->FetchBlockCallback(blockindex);
     // use the block returned from the AddToCache since that is cleaned up
     // to have columns in correct order.
-    block = this->Internals->AddToCache(blockindex, block, 10);
+    block = this->Internals->AddToCache(blockindex, block, this->Internals->GetCacheSize(this));
     this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
   }
   return block;
@@ -951,6 +1266,17 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
   {
     dController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
   }
+
+  this->PrepareBlock(blockindex);
+  this->DeliveryFilter->Modified();
+  this->DeliveryFilter->Update();
+  return vtkTable::SafeDownCast(this->DeliveryFilter->GetOutput());
+}
+
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::PrepareBlock(vtkIdType blockindex)
+{
+  vtkTypeUInt64 data[2] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex) };
   auto pController = vtkMultiProcessController::GetGlobalController();
   if (pController && pController->GetLocalProcessId() == 0 &&
     pController->GetNumberOfProcesses() > 1)
@@ -963,9 +1289,55 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
   this->TableStreamer->Modified();
   this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
   this->ReductionFilter->Modified();
-  this->DeliveryFilter->Modified();
-  this->DeliveryFilter->Update();
-  return vtkTable::SafeDownCast(this->DeliveryFilter->GetOutput());
+}
+
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::PrefetchBlockCallback(vtkIdType blockindex, vtkTypeUInt64 requestId)
+{
+  // Runs on the data server root. The block is reduced as for
+  // FetchBlockCallback() but sent back as a RMI, so that the client does not
+  // wait for it.
+  vtkNew<vtkCharArray> buffer;
+  if (this->Internals->ActiveRepresentation &&
+    this->DeliveryFilter->GetNumberOfInputConnections(0) > 0)
+  {
+    this->PrepareBlock(blockindex);
+    this->ReductionFilter->Update();
+    vtkCommunicator::MarshalDataObject(this->ReductionFilter->GetOutputDataObject(0), buffer);
+  }
+
+  const vtkTypeUInt64 header[3] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex),
+    requestId };
+  const size_t length = static_cast<size_t>(buffer->GetNumberOfValues());
+  std::vector<unsigned char> message(sizeof(header) + length);
+  memcpy(message.data(), header, sizeof(header));
+  if (length > 0)
+  {
+    memcpy(message.data() + sizeof(header), buffer->GetPointer(0), length);
+  }
+  if (auto cController = this->GetSession()->GetController(vtkPVSession::CLIENT))
+  {
+    cController->TriggerRMI(
+      1, message.data(), static_cast<int>(message.size()), PREFETCH_BLOCK_REPLY_TAG);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::PrefetchBlockReplyCallback(
+  vtkIdType blockindex, vtkTypeUInt64 requestId, vtkTable* block)
+{
+  auto& internals = *this->Internals;
+  if (internals.PendingPrefetchBlock != blockindex || internals.PrefetchRequestId != requestId)
+  {
+    // cancelled by ClearCache().
+    return;
+  }
+  internals.PendingPrefetchBlock = -1;
+  if (block && !internals.IsCached(blockindex))
+  {
+    internals.AddToCache(blockindex, block, internals.GetCacheSize(this));
+    this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1083,6 +1455,63 @@ bool vtkSpreadSheetView::IsDataValid(vtkIdType row, vtkIdType col)
   return true;
 }
 
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::SetViewedRows(vtkIdType first, vtkIdType last)
+{
+  this->Internals->SetViewedRows(first, last);
+}
+
+//----------------------------------------------------------------------------
+bool vtkSpreadSheetView::PrefetchBlock()
+{
+  auto& internals = *this->Internals;
+  if (!internals.ActiveRepresentation)
+  {
+    return false;
+  }
+
+  if (internals.PendingPrefetchBlock >= 0)
+  {
+    // process the reply if it has been received, without waiting for it.
+    vtkNetworkAccessManager* nam =
+      vtkProcessModule::GetProcessModule()->GetNetworkAccessManager();
+    while (internals.PendingPrefetchBlock >= 0 && nam->GetNetworkEventsAvailable())
+    {
+      if (nam->ProcessEvents(1) == -1)
+      {
+        internals.PendingPrefetchBlock = -1;
+        return false;
+      }
+    }
+    if (internals.PendingPrefetchBlock >= 0)
+    {
+      return true;
+    }
+  }
+
+  auto dController = this->GetSession()->GetController(vtkPVSession::DATA_SERVER_ROOT);
+  for (const vtkIdType block : internals.GetBlocksToPrefetch(this))
+  {
+    if (!internals.IsCached(block))
+    {
+      vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: prefetch block %lld",
+        this->GetLogName().c_str(), static_cast<long long>(block));
+      if (!dController)
+      {
+        // the data is local, there is no delivery to wait for.
+        this->FetchBlock(block);
+        return true;
+      }
+      internals.PendingPrefetchBlock = block;
+      vtkTypeUInt64 data[3] = { this->Identifier, static_cast<vtkTypeUInt64>(block),
+        ++internals.PrefetchRequestId };
+      dController->TriggerRMIOnAllChildren(data, sizeof(data), PREFETCH_BLOCK_TAG);
+      return true;
+    }
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 bool vtkSpreadSheetView::Export(vtkCSVExporter* exporter)
 {
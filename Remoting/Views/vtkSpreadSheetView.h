@@ -206,6 +206,38 @@ public:
    */
   virtual bool IsDataValid(vtkIdType row, vtkIdType col);
 
+  ///@{
+  /**
+   * Set the maximum number of blocks prefetched ahead of the rows being
+   * viewed, in the direction the view is scrolled. The faster the scrolling,
+   * the more blocks are prefetched, up to this number. Set to 0 to disable
+   * prefetching. Default is 4.
+   */
+  vtkSetClampMacro(MaximumNumberOfPrefetchedBlocks, int, 0, 64);
+  vtkGetMacro(MaximumNumberOfPrefetchedBlocks, int);
+  ///@}
+
+  /**
+   * Set the range of rows currently shown to the user. Successive ranges are
+   * used to estimate the scroll direction and velocity, that determine which
+   * blocks PrefetchBlock() fetches.
+   * \note CallOnClient
+   */
+  void SetViewedRows(vtkIdType first, vtkIdType last);
+
+  /**
+   * Request the next block likely to be viewed that is not cached yet,
+   * starting with the blocks of the viewed rows, then the blocks ahead of them
+   * in the scroll direction. In client-server mode the request does not wait
+   * for the block: the server sends it back when ready and it is added to the
+   * cache, firing vtkCommand::UpdateEvent, by a later call that finds it
+   * received. Returns true while prefetching is in progress, false if there is
+   * nothing left to prefetch. At most one block is requested at a time so that
+   * callers, e.g. a UI timer, can interleave prefetching with user interaction.
+   * \note CallOnClient
+   */
+  virtual bool PrefetchBlock();
+
   //***************************************************************************
   // Forwarded to vtkSortedTableStreamer.
   /**
@@ -240,6 +272,8 @@ public:
 
   // INTERNAL METHOD. Don't call directly.
   vtkTable* FetchBlockCallback(vtkIdType blockindex);
+  void PrefetchBlockCallback(vtkIdType blockindex, vtkTypeUInt64 requestId);
+  void PrefetchBlockReplyCallback(vtkIdType blockindex, vtkTypeUInt64 requestId, vtkTable* block);
 
 protected:
   vtkSpreadSheetView();
@@ -257,6 +291,12 @@ protected:
 
   virtual vtkTable* FetchBlock(vtkIdType blockindex);
 
+  /**
+   * Sets up the pipeline to produce the block and has the satellites do the
+   * same, shared by FetchBlockCallback() and PrefetchBlockCallback().
+   */
+  void PrepareBlock(vtkIdType blockindex);
+
   bool ShowExtractedSelection = false;
   bool GenerateCellConnectivity = false;
   bool ShowFieldData = false;
@@ -265,14 +305,19 @@ protected:
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  int MaximumNumberOfPrefetchedBlocks = 4;
 
   unsigned long CRMICallbackTag;
   unsigned long PRMICallbackTag;
+  unsigned long CRMIPrefetchCallbackTag = 0;
+  unsigned long DRMIPrefetchReplyCallbackTag = 0;
   vtkTypeUInt32 Identifier;
 
   enum
   {
-    FETCH_BLOCK_TAG = 394732
+    FETCH_BLOCK_TAG = 394732,
+    PREFETCH_BLOCK_TAG = 394733,
+    PREFETCH_BLOCK_REPLY_TAG = 394734
   };
 
 private:
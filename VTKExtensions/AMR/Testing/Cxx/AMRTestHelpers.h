@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// Synthetic AMR datasets shared by the tests that compare processing AMR
+// blocks serially and concurrently.
+
+#ifndef AMRTestHelpers_h
+#define AMRTestHelpers_h
+
+#include "vtkCellData.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+
+namespace AMRTestHelpers
+{
+/**
+ * Creates a single level of numBlocks^3 blocks of blockSize^3 cells with unit
+ * spacing, each padded with ghostLayers layers of cells. The cell array named
+ * arrayName is set to cellValue(x, y, z) at the center of every cell,
+ * including the ghost cells.
+ */
+template <typename ArrayT, typename FunctorT>
+vtkSmartPointer<vtkNonOverlappingAMR> CreateAMR(
+  int numBlocks, int blockSize, int ghostLayers, const char* arrayName, FunctorT cellValue)
+{
+  const int blocksPerLevel[1] = { numBlocks * numBlocks * numBlocks };
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(1, blocksPerLevel);
+  amr->SetGridDescription(VTK_XYZ_GRID);
+
+  const int numCells = blockSize + 2 * ghostLayers;
+  unsigned int blockId = 0;
+  for (int bz = 0; bz < numBlocks; ++bz)
+  {
+    for (int by = 0; by < numBlocks; ++by)
+    {
+      for (int bx = 0; bx < numBlocks; ++bx)
+      {
+        const int first[3] = { bx * blockSize - ghostLayers, by * blockSize - ghostLayers,
+          bz * blockSize - ghostLayers };
+        vtkNew<vtkUniformGrid> grid;
+        grid->SetDimensions(numCells + 1, numCells + 1, numCells + 1);
+        grid->SetOrigin(first[0], first[1], first[2]);
+        grid->SetSpacing(1.0, 1.0, 1.0);
+
+        vtkNew<ArrayT> array;
+        array->SetName(arrayName);
+        array->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkIdType cellId = 0;
+        for (int z = 0; z < numCells; ++z)
+        {
+          for (int y = 0; y < numCells; ++y)
+          {
+            for (int x = 0; x < numCells; ++x)
+            {
+              array->SetValue(
+                cellId++, cellValue(first[0] + x + 0.5, first[1] + y + 0.5, first[2] + z + 0.5));
+            }
+          }
+        }
+        grid->GetCellData()->AddArray(array);
+        amr->SetDataSet(0, blockId++, grid);
+      }
+    }
+  }
+  return amr;
+}
+}
+
+#endif
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that clipping and contouring the blocks of an AMR dataset concurrently
+// (EnableSMP) gives the same mesh as processing them serially, in particular
+// that the point ids shared between neighbor blocks are merged the same way.
+#include "AMRTestHelpers.h"
+
+#include "vtkAMRDualClip.h"
+#include "vtkAMRDualContour.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr int BlockSize = 8;
+constexpr int NumBlocks = 3;
+
+// A single level of NumBlocks^3 blocks with one ghost layer, with a cell array
+// that is 100 on a sphere crossing many block boundaries.
+vtkSmartPointer<vtkNonOverlappingAMR> CreateAMR()
+{
+  const double center = 0.5 * NumBlocks * BlockSize;
+  const double radius = 0.3 * NumBlocks * BlockSize;
+  vtkSmartPointer<vtkNonOverlappingAMR> amr = AMRTestHelpers::CreateAMR<vtkDoubleArray>(
+    NumBlocks, BlockSize, 1, "Density", [&](double x, double y, double z) {
+      const double dx = x - center;
+      const double dy = y - center;
+      const double dz = z - center;
+      return 200.0 - 100.0 * std::sqrt(dx * dx + dy * dy + dz * dz) / radius;
+    });
+
+  // Global meta data, as passed by the simulation adaptors.
+  vtkNew<vtkDoubleArray> globalBounds;
+  globalBounds->SetName("GlobalBounds");
+  vtkNew<vtkIntArray> boxSize;
+  boxSize->SetName("GlobalBoxSize");
+  vtkNew<vtkIntArray> minLevel;
+  minLevel->SetName("MinLevel");
+  minLevel->InsertNextValue(0);
+  vtkNew<vtkDoubleArray> minLevelSpacing;
+  minLevelSpacing->SetName("MinLevelSpacing");
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    globalBounds->InsertNextValue(0.0);
+    globalBounds->InsertNextValue(NumBlocks * BlockSize);
+    boxSize->InsertNextValue(BlockSize + 2);
+    minLevelSpacing->InsertNextValue(1.0);
+  }
+  amr->GetFieldData()->AddArray(globalBounds);
+  amr->GetFieldData()->AddArray(boxSize);
+  amr->GetFieldData()->AddArray(minLevel);
+  amr->GetFieldData()->AddArray(minLevelSpacing);
+  return amr;
+}
+
+// Blocks are not appended in the same order serially and with SMP, so compare
+// the cells by the sorted coordinates of their points.
+using CellKey = std::vector<std::array<double, 3>>;
+
+std::vector<CellKey> GetCellKeys(vtkMultiBlockDataSet* output, vtkIdType& numPoints)
+{
+  std::vector<CellKey> keys;
+  numPoints = 0;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(output->NewIterator());
+  vtkNew<vtkIdList> ptIds;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!ds)
+    {
+      continue;
+    }
+    numPoints += ds->GetNumberOfPoints();
+    for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+    {
+      ds->GetCellPoints(cellId, ptIds);
+      CellKey key(ptIds->GetNumberOfIds());
+      for (vtkIdType ii = 0; ii < ptIds->GetNumberOfIds(); ++ii)
+      {
+        ds->GetPoint(ptIds->GetId(ii), key[ii].data());
+      }
+      std::sort(key.begin(), key.end());
+      keys.push_back(key);
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+template <typename FilterT>
+int CompareSerialAndSMP(vtkNonOverlappingAMR* amr, const char* name)
+{
+  std::vector<CellKey> keys[2];
+  vtkIdType numPoints[2];
+  for (int smp = 0; smp < 2; ++smp)
+  {
+    vtkNew<FilterT> filter;
+    filter->SetInputData(amr);
+    filter->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Density");
+    filter->SetIsoValue(100.0);
+    filter->SetEnableMergePoints(1);
+    filter->SetEnableSMP(smp != 0);
+    filter->Update();
+    keys[smp] = GetCellKeys(filter->GetOutput(), numPoints[smp]);
+  }
+
+  if (keys[0].empty())
+  {
+    vtkLogF(ERROR, "%s produced no cells.", name);
+    return EXIT_FAILURE;
+  }
+  if (numPoints[0] != numPoints[1])
+  {
+    vtkLogF(ERROR, "%s points differ: %lld serial, %lld SMP.", name,
+      static_cast<long long>(numPoints[0]), static_cast<long long>(numPoints[1]));
+    return EXIT_FAILURE;
+  }
+  if (keys[0].size() != keys[1].size())
+  {
+    vtkLogF(ERROR, "%s cells differ: %d serial, %d SMP.", name, static_cast<int>(keys[0].size()),
+      static_cast<int>(keys[1].size()));
+    return EXIT_FAILURE;
+  }
+  if (keys[0] != keys[1])
+  {
+    vtkLogF(ERROR, "%s cells do not use the same points serially and SMP.", name);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestAMRDualSMP(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkNonOverlappingAMR> amr = CreateAMR();
+  int ret = CompareSerialAndSMP<vtkAMRDualClip>(amr, "vtkAMRDualClip");
+  if (ret == EXIT_SUCCESS)
+  {
+    ret = CompareSerialAndSMP<vtkAMRDualContour>(amr, "vtkAMRDualContour");
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return ret;
+}
@@ -4,6 +4,7 @@
 #include "vtkAMRDualClip.h"
 #include "vtkAMRDualGridHelper.h"
 
+#include <algorithm>
 #include <vector>
 
 // Pipeline & VTK
@@ -21,6 +22,7 @@
 // Data sets
 #include "vtkAMRBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
@@ -30,6 +32,9 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -132,6 +137,9 @@ public:
 
   vtkUnsignedCharArray* GetLevelMaskArray() { return this->LevelMaskArray; }
 
+  // Adds offset to the point ids greater or equal to firstId.
+  void OffsetPointIds(vtkIdType firstId, vtkIdType offset);
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -751,6 +759,22 @@ vtkIdType* vtkAMRDualClipLocator::GetCornerPointer(
   return this->Corners + (xCell + (yCell * this->YIncrement) + (zCell * this->ZIncrement));
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::OffsetPointIds(vtkIdType firstId, vtkIdType offset)
+{
+  vtkIdType* arrays[4] = { this->XEdges, this->YEdges, this->ZEdges, this->Corners };
+  for (vtkIdType* ptr : arrays)
+  {
+    for (int idx = 0; idx < this->ArrayLength; ++idx)
+    {
+      if (ptr[idx] >= firstId)
+      {
+        ptr[idx] += offset;
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 // Deprecciated
 void vtkAMRDualClipLocator::SharePointIdsWithNeighbor(
@@ -1017,6 +1041,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->EnableSMP = false;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1029,6 +1054,8 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->Helper = nullptr;
 
   this->BlockLocator = nullptr;
+  this->PointIdOffset = 0;
+  this->DeferLocatorSharing = false;
 }
 
 //----------------------------------------------------------------------------
@@ -1039,9 +1066,20 @@ vtkAMRDualClip::~vtkAMRDualClip()
     delete this->BlockLocator;
     this->BlockLocator = nullptr;
   }
+  this->ReleaseHelper();
   this->SetController(nullptr);
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ReleaseHelper()
+{
+  if (this->Helper)
+  {
+    this->Helper->Delete();
+    this->Helper = nullptr;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1051,6 +1089,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableSMP: " << this->EnableSMP << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1123,6 +1162,14 @@ int vtkAMRDualClip::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkMultiBlockDataSet* out = this->DoRequestData(hbdsInput, arrayNameToProcess);
 
+  // The helper is kept so the next request can reuse the dual grid, unless the
+  // input is released: the helper's blocks still reference its images.
+  if (vtkDataObject::GetGlobalReleaseDataFlag() ||
+    inInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+  {
+    this->ReleaseHelper();
+  }
+
   if (out)
   {
     mbdsOutput0->CompositeShallowCopy(out);
@@ -1146,24 +1193,32 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
 
   mpds->SetNumberOfPieces(0);
 
+  // The helper of the previous request is reused when the AMR hierarchy did not
+  // change, only the iso value or the array.
   if (this->Helper)
   {
-    this->Helper->Delete();
-  }
-
-  this->Helper = vtkAMRDualGridHelper::New();
-  this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
-  if (this->EnableMultiProcessCommunication)
-  {
-    this->Helper->SetController(this->Controller);
+    this->Helper->SetController(this->EnableMultiProcessCommunication ? this->Controller : nullptr);
+    if (!this->Helper->CanReuse(hbdsInput))
+    {
+      this->ReleaseHelper();
+    }
   }
-  else
+  if (!this->Helper)
   {
-    this->Helper->SetController(nullptr);
-  }
+    this->Helper = vtkAMRDualGridHelper::New();
+    if (this->EnableMultiProcessCommunication)
+    {
+      this->Helper->SetController(this->Controller);
+    }
+    else
+    {
+      this->Helper->SetController(nullptr);
+    }
 
-  // @TODO: Check if this is the right thing to do.
-  this->Helper->Initialize(hbdsInput);
+    // @TODO: Check if this is the right thing to do.
+    this->Helper->Initialize(hbdsInput);
+  }
+  this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
   this->Helper->SetupData(hbdsInput, arrayNameToProcess);
 
   if (this->Controller && this->Controller->GetNumberOfProcesses() > 1 &&
@@ -1194,14 +1249,34 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   int numBlocks;
   int blockId;
 
-  // Add each block.
+  if (this->EnableSMP)
+  {
+    this->ProcessBlocksSMP(hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
+    {
+      numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(block, blockId, arrayNameToProcess);
+      }
+    }
+  }
+
+  // Blocks without the array (and level masks distributed between processes)
+  // can leave locators behind. Delete them since the helper may be reused.
   for (int level = 0; level < numLevels; ++level)
   {
     numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      delete static_cast<vtkAMRDualClipLocator*>(block->UserData);
+      block->UserData = nullptr;
     }
   }
 
@@ -1220,8 +1295,6 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   this->Cells = nullptr;
 
   mpds->Delete();
-  this->Helper->Delete();
-  this->Helper = nullptr;
 
   return mbdsOutput0;
 }
@@ -1476,7 +1549,10 @@ void vtkAMRDualClip::ProcessBlock(
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->InitializeLevelMask(block);
+    if (!this->DeferLocatorSharing)
+    {
+      this->InitializeLevelMask(block);
+    }
     this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
   }
   else
@@ -1574,20 +1650,186 @@ void vtkAMRDualClip::ProcessBlock(
 
   if (this->EnableMergePoints)
   {
-    this->ShareLevelMask(block);
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
+    // The block owns its locator.
     this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
+    if (!this->DeferLocatorSharing)
+    {
+      this->ReleaseBlockLocator(block);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ReleaseBlockLocator(vtkAMRDualGridHelperBlock* block)
+{
+  this->ShareLevelMask(block);
+  // Copy point ids into neighbor locators.
+  this->ShareBlockLocatorWithNeighbors(block);
+  // We are done.  We no longer need the locator for this block.
+  delete vtkAMRDualClipGetBlockLocator(block);
+  block->UserData = nullptr;
+  // Lets use this unused flag (owner of center region/block) to indicate
+  // that the block is already processes.
+  // This will keep neighbors from recreating the locator.
+  // Another option would be to create the locator object for
+  // all blocks but do not allocate until needed.  Then the existence of the locator
+  // would tell whether the block was processed.
+  block->RegionBits[1][1][1] = 0;
+}
+
+//----------------------------------------------------------------------------
+// Output of a single block clipped by a worker of ProcessBlocksSMP.
+struct vtkAMRDualClipPiece
+{
+  vtkSmartPointer<vtkUnstructuredGrid> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells;
+  vtkSmartPointer<vtkIntArray> BlockIds;
+  vtkSmartPointer<vtkUnsignedCharArray> LevelMask;
+};
+
+//----------------------------------------------------------------------------
+// Each block is clipped into its own piece, and the pieces are appended to the
+// output in the same order blocks are processed serially.
+// With merge points on, blocks are clipped one wave at a time (see
+// vtkAMRDualGridHelper::ComputeBlockWaves): level masks are initialized from
+// the neighbors before a wave and shared with the neighbors after it, so each
+// block sees the same level masks and point ids as in the serial case.  The new
+// point ids of a piece start at the number of points already in the output so
+// they do not collide with the shared ids.  They are moved to their final value
+// in the cells and in the block locator when the piece is appended.
+void vtkAMRDualClip::ProcessBlocksSMP(
+  vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
+  std::vector<int> waves;
+  int numWaves = this->Helper->ComputeBlockWaves(blocks, blockIds, waves);
+  if (!this->EnableMergePoints)
+  { // Blocks are independent, clip them all at once.
+    std::fill(waves.begin(), waves.end(), 0);
+    numWaves = blocks.empty() ? 0 : 1;
+  }
+  std::vector<std::vector<size_t>> waveBlocks(numWaves);
+  for (size_t ii = 0; ii < blocks.size(); ++ii)
+  {
+    waveBlocks[waves[ii]].push_back(ii);
+  }
+
+  const int numWorkers = static_cast<int>(std::min<size_t>(
+    blocks.size(), static_cast<size_t>(4 * vtkSMPTools::GetEstimatedNumberOfThreads())));
+  std::vector<vtkAMRDualClip*> workers(numWorkers, nullptr);
+  for (auto& worker : workers)
+  {
+    worker = vtkAMRDualClip::New();
+    worker->IsoValue = this->IsoValue;
+    worker->EnableInternalDecimation = this->EnableInternalDecimation;
+    worker->EnableMergePoints = this->EnableMergePoints;
+    // The helper is shared, it is released before deleting the worker.
+    worker->Helper = this->Helper;
+    worker->DeferLocatorSharing = true;
+  }
+
+  std::vector<vtkAMRDualClipPiece> pieces;
+  vtkIdType pointIds[4];
+  for (const auto& wave : waveBlocks)
+  {
+    const vtkIdType firstPieceId = this->Points->GetNumberOfPoints();
+    const vtkIdType numPieces = static_cast<vtkIdType>(wave.size());
+    pieces.clear();
+    pieces.resize(wave.size());
+    for (vtkIdType ii = 0; ii < numPieces; ++ii)
+    {
+      vtkAMRDualClipPiece& piece = pieces[ii];
+      piece.Mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      piece.Points = vtkSmartPointer<vtkPoints>::New();
+      piece.Cells = vtkSmartPointer<vtkCellArray>::New();
+      piece.BlockIds = vtkSmartPointer<vtkIntArray>::New();
+      piece.LevelMask = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      piece.LevelMask->SetName("LevelMask");
+      piece.Mesh->SetPoints(piece.Points);
+      piece.Mesh->GetPointData()->AddArray(piece.LevelMask);
+      this->InitializeCopyAttributes(hbdsInput, piece.Mesh);
+
+      vtkAMRDualGridHelperBlock* block = blocks[wave[ii]];
+      if (this->EnableMergePoints && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        this->InitializeLevelMask(block);
+      }
+    }
+
+    const vtkIdType numChunks = std::min<vtkIdType>(numWorkers, numPieces);
+    vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        vtkAMRDualClip* worker = workers[chunk];
+        worker->PointIdOffset = firstPieceId;
+        for (vtkIdType ii = numPieces * chunk / numChunks;
+             ii < numPieces * (chunk + 1) / numChunks; ++ii)
+        {
+          vtkAMRDualClipPiece& piece = pieces[ii];
+          worker->Mesh = piece.Mesh;
+          worker->Points = piece.Points;
+          worker->Cells = piece.Cells;
+          worker->BlockIdCellArray = piece.BlockIds;
+          worker->LevelMaskPointArray = piece.LevelMask;
+          worker->ProcessBlock(blocks[wave[ii]], blockIds[wave[ii]], arrayNameToProcess);
+        }
+        worker->Mesh = nullptr;
+        worker->Points = nullptr;
+        worker->Cells = nullptr;
+        worker->BlockIdCellArray = nullptr;
+        worker->LevelMaskPointArray = nullptr;
+      }
+    });
+
+    // Append the pieces in block order.
+    vtkPointData* outPD = this->Mesh->GetPointData();
+    for (vtkIdType ii = 0; ii < numPieces; ++ii)
+    {
+      const vtkAMRDualClipPiece& piece = pieces[ii];
+      const vtkIdType offset = this->Points->GetNumberOfPoints();
+      const vtkIdType numPoints = piece.Points->GetNumberOfPoints();
+      if (numPoints > 0)
+      {
+        this->Points->GetData()->InsertTuples(offset, numPoints, 0, piece.Points->GetData());
+        vtkPointData* inPD = piece.Mesh->GetPointData();
+        for (int arrayIdx = 0; arrayIdx < outPD->GetNumberOfArrays(); ++arrayIdx)
+        {
+          outPD->GetAbstractArray(arrayIdx)->InsertTuples(
+            offset, numPoints, 0, inPD->GetAbstractArray(arrayIdx));
+        }
+      }
+
+      auto iter = vtk::TakeSmartPointer(piece.Cells->NewIterator());
+      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        iter->GetCurrentCell(npts, pts);
+        for (vtkIdType jj = 0; jj < npts; ++jj)
+        {
+          pointIds[jj] = pts[jj] >= firstPieceId ? pts[jj] - firstPieceId + offset : pts[jj];
+        }
+        this->Cells->InsertNextCell(npts, pointIds);
+      }
+      this->BlockIdCellArray->InsertTuples(this->BlockIdCellArray->GetNumberOfTuples(),
+        piece.BlockIds->GetNumberOfTuples(), 0, piece.BlockIds);
+
+      vtkAMRDualGridHelperBlock* block = blocks[wave[ii]];
+      if (this->EnableMergePoints && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        vtkAMRDualClipGetBlockLocator(block)->OffsetPointIds(firstPieceId, offset - firstPieceId);
+        this->ReleaseBlockLocator(block);
+      }
+    }
+    this->Points->Modified();
+  }
+
+  for (vtkAMRDualClip* worker : workers)
+  {
+    worker->Helper = nullptr;
+    worker->Delete();
   }
 }
 
@@ -1876,7 +2118,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          const vtkIdType outId = this->Points->InsertNextPoint(pt);
+          *ptIdPtr = outId + this->PointIdOffset;
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1890,7 +2133,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, outId);
 
           this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
         }
@@ -1914,7 +2157,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          const vtkIdType outId = this->Points->InsertNextPoint(pt);
+          *ptIdPtr = outId + this->PointIdOffset;
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1925,7 +2169,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
           this->Mesh->GetPointData()->InterpolateEdge(
-            block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
+            block->Image->GetCellData(), outId, offset0, offset1, k);
 
           this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
         }
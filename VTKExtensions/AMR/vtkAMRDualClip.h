@@ -74,6 +74,19 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the blocks of a process are clipped concurrently using
+   * vtkSMPTools. Each block is clipped into its own piece and the pieces are
+   * merged in block order, so the output does not depend on the number of
+   * threads. With merge points on, touching blocks are not clipped at the same
+   * time so that level masks are shared as in the serial case. Off by default.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -88,6 +101,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  bool EnableSMP;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
@@ -96,6 +110,11 @@ protected:
 
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
 
+  /**
+   * Deletes the dual grid helper kept between requests.
+   */
+  void ReleaseHelper();
+
   /**
    * Not a pipeline function. This is a helper function that
    * allows creating a new data set given a input and a cell array name.
@@ -109,6 +128,17 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Clip the blocks concurrently into the output (see EnableSMP).
+   */
+  void ProcessBlocksSMP(vtkNonOverlappingAMR* input, const char* arrayName);
+
+  /**
+   * Share the level mask of a processed block with its neighbors and delete
+   * its locator.
+   */
+  void ReleaseBlockLocator(vtkAMRDualGridHelperBlock* block);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -139,6 +169,12 @@ protected:
 
   vtkAMRDualClipLocator* BlockLocator;
 
+  // Used by the workers of ProcessBlocksSMP: point ids are offset in the
+  // locators and the cells, and the filter initializes and releases the block
+  // locators before and after the workers process a wave.
+  vtkIdType PointIdOffset;
+  bool DeferLocatorSharing;
+
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
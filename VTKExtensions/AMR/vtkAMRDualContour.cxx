@@ -20,19 +20,25 @@
 // Data sets
 #include "vtkAMRBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 
@@ -92,6 +98,11 @@ public:
   void ShareBlockLocatorWithNeighbor(
     vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
 
+  // Description:
+  // Add offset to all point ids greater or equal to firstId.
+  // Used to move the points of a block piece into the merged output.
+  void OffsetPointIds(vtkIdType firstId, vtkIdType offset);
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -420,6 +431,22 @@ vtkIdType* vtkAMRDualContourEdgeLocator::GetCornerPointer(
   return this->Corners + (xCell + (yCell * this->YIncrement) + (zCell * this->ZIncrement));
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualContourEdgeLocator::OffsetPointIds(vtkIdType firstId, vtkIdType offset)
+{
+  vtkIdType* arrays[4] = { this->XEdges, this->YEdges, this->ZEdges, this->Corners };
+  for (vtkIdType* ptr : arrays)
+  {
+    for (int idx = 0; idx < this->ArrayLength; ++idx)
+    {
+      if (ptr[idx] >= firstId)
+      {
+        ptr[idx] += offset;
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkAMRDualContourEdgeLocator* vtkAMRDualContourGetBlockLocator(vtkAMRDualGridHelperBlock* block)
 {
@@ -612,6 +639,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->EnableSMP = false;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -624,6 +652,8 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->Helper = nullptr;
 
   this->BlockLocator = nullptr;
+  this->PointIdOffset = 0;
+  this->DeferLocatorSharing = false;
 }
 
 //----------------------------------------------------------------------------
@@ -634,6 +664,7 @@ vtkAMRDualContour::~vtkAMRDualContour()
     delete this->BlockLocator;
     this->BlockLocator = nullptr;
   }
+  this->ReleaseHelper();
   this->SetController(nullptr);
 }
 
@@ -650,6 +681,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "EnableSMP: " << this->EnableSMP << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -727,7 +759,7 @@ int vtkAMRDualContour::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->InitializeRequest(hbdsInput);
   vtkMultiBlockDataSet* out = this->DoRequestData(hbdsInput, arrayNameToProcess);
-  this->FinalizeRequest();
+  this->FinalizeRequest(inInfo);
 
   if (out)
   {
@@ -746,7 +778,15 @@ void vtkAMRDualContour::InitializeRequest(vtkNonOverlappingAMR* hbdsInput)
 {
   if (this->Helper)
   {
-    this->Helper->Delete();
+    this->Helper->SetController(this->EnableMultiProcessCommunication ? this->Controller : nullptr);
+    if (this->Helper->CanReuse(hbdsInput))
+    {
+      // Same AMR hierarchy, only the iso value or the arrays changed.
+      this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
+      this->Helper->SetSkipGhostCopy(this->SkipGhostCopy);
+      return;
+    }
+    this->ReleaseHelper();
   }
 
   this->Helper = vtkAMRDualGridHelper::New();
@@ -763,10 +803,24 @@ void vtkAMRDualContour::InitializeRequest(vtkNonOverlappingAMR* hbdsInput)
   this->Helper->Initialize(hbdsInput);
 }
 
-void vtkAMRDualContour::FinalizeRequest()
+void vtkAMRDualContour::FinalizeRequest(vtkInformation* inInfo)
 {
-  this->Helper->Delete();
-  this->Helper = nullptr;
+  // The helper is kept so the next request can reuse the dual grid, unless the
+  // input is released: the helper's blocks still reference its images.
+  if (vtkDataObject::GetGlobalReleaseDataFlag() ||
+    inInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+  {
+    this->ReleaseHelper();
+  }
+}
+
+void vtkAMRDualContour::ReleaseHelper()
+{
+  if (this->Helper)
+  {
+    this->Helper->Delete();
+    this->Helper = nullptr;
+  }
 }
 
 vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
@@ -798,14 +852,34 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
 
-  // Add each block.
+  if (this->EnableSMP)
+  {
+    this->ProcessBlocksSMP(hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
+    {
+      int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (int blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(block, blockId, arrayNameToProcess);
+      }
+    }
+  }
+
+  // Blocks without the array keep the point ids their neighbors shared with
+  // them. Delete these locators since the helper may be reused.
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      delete static_cast<vtkAMRDualContourEdgeLocator*>(block->UserData);
+      block->UserData = nullptr;
     }
   }
 
@@ -1007,19 +1081,176 @@ void vtkAMRDualContour::ProcessBlock(
 
   if (this->EnableMergePoints)
   {
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
+    // The block owns its locator.
     this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
+    if (!this->DeferLocatorSharing)
+    {
+      this->ReleaseBlockLocator(block);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ReleaseBlockLocator(vtkAMRDualGridHelperBlock* block)
+{
+  // Copy point ids into neighbor locators.
+  this->ShareBlockLocatorWithNeighbors(block);
+  // We are done.  We no longer need the locator for this block.
+  delete vtkAMRDualContourGetBlockLocator(block);
+  block->UserData = nullptr;
+  // Lets use this unused flag (owner of center region/block) to indicate
+  // that the block is already processes.
+  // This will keep neighbors from recreating the locator.
+  // Another option would be to create the locator object for
+  // all blocks but do not allocate until needed.  Then the existence of the locator
+  // would tell whether the block was processed.
+  block->RegionBits[1][1][1] = 0;
+}
+
+//----------------------------------------------------------------------------
+// Output of a single block contoured by a worker of ProcessBlocksSMP.
+struct vtkAMRDualContourPiece
+{
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Faces;
+  vtkSmartPointer<vtkIntArray> BlockIds;
+};
+
+//----------------------------------------------------------------------------
+// Each block is contoured into its own piece, and the pieces are appended to
+// the output in the same order blocks are processed serially.
+// With merge points on, blocks are contoured one wave at a time (see
+// vtkAMRDualGridHelper::ComputeBlockWaves) so a block gets the point ids of all
+// the neighbors processed before it, as in the serial case.  The new point ids
+// of a piece start at the number of points already in the output so they do
+// not collide with the shared ids.  They are moved to their final value in the
+// faces and in the block locator when the piece is appended, and the locator
+// is then shared with the neighbors of the next waves.
+void vtkAMRDualContour::ProcessBlocksSMP(
+  vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
+  std::vector<int> waves;
+  int numWaves = this->Helper->ComputeBlockWaves(blocks, blockIds, waves);
+  if (!this->EnableMergePoints)
+  { // Blocks do not share points, contour them all at once.
+    std::fill(waves.begin(), waves.end(), 0);
+    numWaves = blocks.empty() ? 0 : 1;
+  }
+  std::vector<std::vector<size_t>> waveBlocks(numWaves);
+  for (size_t ii = 0; ii < blocks.size(); ++ii)
+  {
+    waveBlocks[waves[ii]].push_back(ii);
+  }
+
+  const int numWorkers = static_cast<int>(std::min<size_t>(
+    blocks.size(), static_cast<size_t>(4 * vtkSMPTools::GetEstimatedNumberOfThreads())));
+  std::vector<vtkAMRDualContour*> workers(numWorkers, nullptr);
+  for (auto& worker : workers)
+  {
+    worker = vtkAMRDualContour::New();
+    worker->IsoValue = this->IsoValue;
+    worker->EnableCapping = this->EnableCapping;
+    worker->EnableMergePoints = this->EnableMergePoints;
+    worker->TriangulateCap = this->TriangulateCap;
+    // The helper is shared, it is released before deleting the worker.
+    worker->Helper = this->Helper;
+    worker->DeferLocatorSharing = true;
+  }
+
+  std::vector<vtkAMRDualContourPiece> pieces;
+  std::vector<vtkIdType> pointIds;
+  for (const auto& wave : waveBlocks)
+  {
+    const vtkIdType firstPieceId = this->Points->GetNumberOfPoints();
+    const vtkIdType numPieces = static_cast<vtkIdType>(wave.size());
+    pieces.clear();
+    pieces.resize(wave.size());
+    for (auto& piece : pieces)
+    {
+      piece.Mesh = vtkSmartPointer<vtkPolyData>::New();
+      piece.Points = vtkSmartPointer<vtkPoints>::New();
+      piece.Faces = vtkSmartPointer<vtkCellArray>::New();
+      piece.BlockIds = vtkSmartPointer<vtkIntArray>::New();
+      piece.Mesh->SetPoints(piece.Points);
+      piece.Mesh->SetPolys(piece.Faces);
+      this->InitializeCopyAttributes(hbdsInput, piece.Mesh);
+    }
+
+    const vtkIdType numChunks = std::min<vtkIdType>(numWorkers, numPieces);
+    vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        vtkAMRDualContour* worker = workers[chunk];
+        worker->PointIdOffset = firstPieceId;
+        for (vtkIdType ii = numPieces * chunk / numChunks;
+             ii < numPieces * (chunk + 1) / numChunks; ++ii)
+        {
+          vtkAMRDualContourPiece& piece = pieces[ii];
+          worker->Mesh = piece.Mesh;
+          worker->Points = piece.Points;
+          worker->Faces = piece.Faces;
+          worker->BlockIdCellArray = piece.BlockIds;
+          worker->ProcessBlock(blocks[wave[ii]], blockIds[wave[ii]], arrayNameToProcess);
+        }
+        worker->Mesh = nullptr;
+        worker->Points = nullptr;
+        worker->Faces = nullptr;
+        worker->BlockIdCellArray = nullptr;
+      }
+    });
+
+    // Append the pieces in block order.
+    vtkPointData* outPD = this->Mesh->GetPointData();
+    for (vtkIdType ii = 0; ii < numPieces; ++ii)
+    {
+      const vtkAMRDualContourPiece& piece = pieces[ii];
+      const vtkIdType offset = this->Points->GetNumberOfPoints();
+      const vtkIdType numPoints = piece.Points->GetNumberOfPoints();
+      if (numPoints > 0)
+      {
+        this->Points->GetData()->InsertTuples(offset, numPoints, 0, piece.Points->GetData());
+        vtkPointData* inPD = piece.Mesh->GetPointData();
+        for (int arrayIdx = 0; arrayIdx < outPD->GetNumberOfArrays(); ++arrayIdx)
+        {
+          outPD->GetAbstractArray(arrayIdx)->InsertTuples(
+            offset, numPoints, 0, inPD->GetAbstractArray(arrayIdx));
+        }
+      }
+
+      auto iter = vtk::TakeSmartPointer(piece.Faces->NewIterator());
+      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        iter->GetCurrentCell(npts, pts);
+        pointIds.resize(npts);
+        for (vtkIdType jj = 0; jj < npts; ++jj)
+        {
+          pointIds[jj] = pts[jj] >= firstPieceId ? pts[jj] - firstPieceId + offset : pts[jj];
+        }
+        this->Faces->InsertNextCell(npts, pointIds.data());
+      }
+      this->BlockIdCellArray->InsertTuples(this->BlockIdCellArray->GetNumberOfTuples(),
+        piece.BlockIds->GetNumberOfTuples(), 0, piece.BlockIds);
+
+      vtkAMRDualGridHelperBlock* block = blocks[wave[ii]];
+      if (this->EnableMergePoints && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        vtkAMRDualContourGetBlockLocator(block)->OffsetPointIds(
+          firstPieceId, offset - firstPieceId);
+        this->ReleaseBlockLocator(block);
+      }
+    }
+    this->Points->Modified();
+  }
+
+  for (vtkAMRDualContour* worker : workers)
+  {
+    worker->Helper = nullptr;
+    worker->Delete();
   }
 }
 
@@ -1346,12 +1577,13 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        vtkIdType outId = this->Points->InsertNextPoint(pt);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, outId);
+        *ptIdPtr = outId + this->PointIdOffset;
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
@@ -1466,9 +1698,10 @@ void vtkAMRDualContour::CapCell(
           ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType outId = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, outId);
+            *ptIdPtr = outId + this->PointIdOffset;
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1502,9 +1735,10 @@ void vtkAMRDualContour::CapCell(
           ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType outId = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, outId);
+            *ptIdPtr = outId + this->PointIdOffset;
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1539,9 +1773,10 @@ void vtkAMRDualContour::CapCell(
           ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType outId = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, outId);
+            *ptIdPtr = outId + this->PointIdOffset;
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1576,9 +1811,10 @@ void vtkAMRDualContour::CapCell(
           ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType outId = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, outId);
+            *ptIdPtr = outId + this->PointIdOffset;
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1612,9 +1848,10 @@ void vtkAMRDualContour::CapCell(
           ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType outId = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, outId);
+            *ptIdPtr = outId + this->PointIdOffset;
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1649,9 +1886,10 @@ void vtkAMRDualContour::CapCell(
           ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType outId = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, outId);
+            *ptIdPtr = outId + this->PointIdOffset;
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -103,6 +103,19 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the blocks of a process are contoured concurrently using
+   * vtkSMPTools. Each block is contoured into its own piece and the pieces are
+   * merged in block order, so the output does not depend on the number of
+   * threads. With merge points on, touching blocks are not contoured at the
+   * same time so that points on their seams are still shared. Off by default.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -119,18 +132,28 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  bool EnableSMP;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   /**
-   * This should be called before any number of calls to DoRequestData
+   * This should be called before any number of calls to DoRequestData.
+   * The dual grid helper of the previous request is reused when the input
+   * has not changed.
    */
   void InitializeRequest(vtkNonOverlappingAMR* input);
 
   /**
-   * This should be called after any number of calls to DoRequestData
+   * This should be called after any number of calls to DoRequestData.
+   * The dual grid helper is released when the pipeline releases the input
+   * described by `inInfo` after this request.
+   */
+  void FinalizeRequest(vtkInformation* inInfo);
+
+  /**
+   * Deletes the dual grid helper kept between requests.
    */
-  void FinalizeRequest();
+  void ReleaseHelper();
 
   /**
    * Not a pipeline function. This is a helper function that
@@ -145,6 +168,17 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Contour the blocks concurrently into the output (see EnableSMP).
+   */
+  void ProcessBlocksSMP(vtkNonOverlappingAMR* input, const char* arrayName);
+
+  /**
+   * Copy the point ids of a processed block into the locators of its neighbors
+   * and delete its locator.
+   */
+  void ReleaseBlockLocator(vtkAMRDualGridHelperBlock* block);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -189,6 +223,12 @@ protected:
 
   vtkAMRDualContourEdgeLocator* BlockLocator;
 
+  // Used by the workers of ProcessBlocksSMP: point ids are offset in the
+  // locators and the faces, and the filter releases the block locators once
+  // the pieces are merged.
+  vtkIdType PointIdOffset;
+  bool DeferLocatorSharing;
+
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
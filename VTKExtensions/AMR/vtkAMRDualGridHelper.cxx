@@ -22,7 +22,9 @@
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+#include <algorithm>
 #include <list>
+#include <map>
 #include <vector>
 
 #include "vtksys/SystemTools.hxx"
@@ -709,6 +711,8 @@ vtkAMRDualGridHelper::vtkAMRDualGridHelper()
   this->EnableDegenerateCells = 1;
   this->EnableAsynchronousCommunication = 1;
   this->NumberOfBlocksInThisProcess = 0;
+  this->InitializedInputTime = 0;
+  this->InitializedController = nullptr;
   for (ii = 0; ii < 3; ++ii)
   {
     this->StandardBlockDimensions[ii] = 0;
@@ -2314,6 +2318,10 @@ int vtkAMRDualGridHelper::Initialize(vtkNonOverlappingAMR* input)
     // All processes will have all blocks (but not image data).
     this->ShareBlocks();
   }
+
+  this->InitializedInput = input;
+  this->InitializedInputTime = input->GetMTime();
+  this->InitializedController = this->Controller;
   return VTK_OK;
 }
 
@@ -2372,8 +2380,88 @@ int vtkAMRDualGridHelper::SetupData(vtkNonOverlappingAMR* input, const char* arr
   // Setup faces for seeding connectivity between blocks.
   // this->CreateFaces();
 
+  // Copying degenerate regions may modify the input blocks.
+  if (input == this->InitializedInput)
+  {
+    this->InitializedInputTime = input->GetMTime();
+  }
+
   return VTK_OK;
 }
+
+//----------------------------------------------------------------------------
+bool vtkAMRDualGridHelper::CanReuse(vtkNonOverlappingAMR* input)
+{
+  int reuse = (input && input == this->InitializedInput &&
+    input->GetMTime() <= this->InitializedInputTime &&
+    this->Controller == this->InitializedController &&
+    input->GetNumberOfLevels() == this->GetNumberOfLevels());
+
+  // Initialize() communicates, so all processes have to agree.
+  if (this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int globalReuse = 0;
+    this->Controller->AllReduce(&reuse, &globalReuse, 1, vtkCommunicator::MIN_OP);
+    reuse = globalReuse;
+  }
+  return reuse != 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkAMRDualGridHelper::ComputeBlockWaves(std::vector<vtkAMRDualGridHelperBlock*>& blocks,
+  std::vector<int>& blockIds, std::vector<int>& waves)
+{
+  blocks.clear();
+  blockIds.clear();
+  std::map<vtkAMRDualGridHelperBlock*, size_t> order;
+  int numLevels = this->GetNumberOfLevels();
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      vtkAMRDualGridHelperBlock* block = this->GetBlock(level, blockId);
+      if (block->Image)
+      {
+        order[block] = blocks.size();
+        blocks.push_back(block);
+        blockIds.push_back(blockId);
+      }
+    }
+  }
+
+  int numWaves = 0;
+  waves.assign(blocks.size(), 0);
+  for (size_t ii = 0; ii < blocks.size(); ++ii)
+  {
+    vtkAMRDualGridHelperBlock* block = blocks[ii];
+    numWaves = std::max(numWaves, waves[ii] + 1);
+    // Same neighborhood the dual filters share their locators with:
+    // blocks in the same level or higher.
+    for (int level = block->Level; level < numLevels; ++level)
+    {
+      int levelDiff = level - block->Level;
+      int xMid = block->GridIndex[0];
+      int yMid = block->GridIndex[1];
+      int zMid = block->GridIndex[2];
+      for (int iz = (zMid << levelDiff) - 1; iz <= ((zMid + 1) << levelDiff); ++iz)
+      {
+        for (int iy = (yMid << levelDiff) - 1; iy <= ((yMid + 1) << levelDiff); ++iy)
+        {
+          for (int ix = (xMid << levelDiff) - 1; ix <= ((xMid + 1) << levelDiff); ++ix)
+          {
+            auto neighbor = order.find(this->GetBlock(level, ix, iy, iz));
+            if (neighbor != order.end() && neighbor->second > ii)
+            {
+              waves[neighbor->second] = std::max(waves[neighbor->second], waves[ii] + 1);
+            }
+          }
+        }
+      }
+    }
+  }
+  return numWaves;
+}
 void vtkAMRDualGridHelper::ClearRegionRemoteCopyQueue()
 {
   this->DegenerateRegionQueue.clear();
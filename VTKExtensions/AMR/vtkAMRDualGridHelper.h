@@ -19,6 +19,7 @@
 
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsAMRModule.h" //needed for exports
+#include "vtkWeakPointer.h"              // for vtkWeakPointer
 #include <vector>                        // for std::vector
 
 class vtkDataArray;
@@ -85,6 +86,26 @@ public:
 
   int Initialize(vtkNonOverlappingAMR* input);
   int SetupData(vtkNonOverlappingAMR* input, const char* arrayName);
+
+  /**
+   * Returns true when Initialize() was called with this input and controller,
+   * and the input has not been modified since. The dual grid
+   * can then be set up again with SetupData() (for another array or iso value)
+   * instead of initializing a new helper. With a controller, this has to be
+   * called on all processes.
+   */
+  bool CanReuse(vtkNonOverlappingAMR* input);
+
+  /**
+   * Groups the blocks of this process into waves that can be processed
+   * concurrently. `blocks` is filled with the blocks that have an image, level
+   * by level, in the order the dual filters process them, and `blockIds` with
+   * their index in their level. A block is put in a later wave than all the
+   * neighbors listed before it, so the blocks of a wave do not touch each other.
+   * Returns the number of waves.
+   */
+  int ComputeBlockWaves(std::vector<vtkAMRDualGridHelperBlock*>& blocks,
+    std::vector<int>& blockIds, std::vector<int>& waves);
   const double* GetGlobalOrigin() { return this->GlobalOrigin; }
   const double* GetRootSpacing() { return this->RootSpacing; }
   int GetNumberOfBlocks() { return this->NumberOfBlocksInThisProcess; }
@@ -212,6 +233,12 @@ private:
 
   int EnableAsynchronousCommunication;
 
+  // Input and controller of the last Initialize(), to reuse the dual grid.
+  // The controller is only compared, never dereferenced.
+  vtkWeakPointer<vtkNonOverlappingAMR> InitializedInput;
+  vtkMTimeType InitializedInputTime;
+  vtkMultiProcessController* InitializedController;
+
   vtkAMRDualGridHelper(const vtkAMRDualGridHelper&) = delete;
   void operator=(const vtkAMRDualGridHelper&) = delete;
 };
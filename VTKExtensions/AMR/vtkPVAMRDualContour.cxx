@@ -84,7 +84,7 @@ int vtkPVAMRDualContour::RequestData(vtkInformation* vtkNotUsed(request),
       out->Delete();
     }
   }
-  this->FinalizeRequest();
+  this->FinalizeRequest(inInfo);
 
   return 1;
 }
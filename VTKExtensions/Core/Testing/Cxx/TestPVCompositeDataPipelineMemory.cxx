@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVCompositeDataPipeline.h"
+
+#include "vtkInformation.h"
+#include "vtkInformationIdTypeKey.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVMemoryAccounting.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+
+int TestPVCompositeDataPipelineMemory(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(256);
+  sphere->SetPhiResolution(256);
+
+  vtkNew<vtkPVCompositeDataPipeline> executive;
+  sphere->SetExecutive(executive);
+
+  // disabled by default.
+  vtkInformation* info = sphere->GetInformation();
+  sphere->Update();
+  if (vtkPVMemoryAccounting::GetEnabled() ||
+    info->Has(vtkPVCompositeDataPipeline::MEMORY_OUTPUT_SIZE()))
+  {
+    vtkLog(ERROR, "Memory accounting recorded while disabled.");
+    return EXIT_FAILURE;
+  }
+
+  vtkPVMemoryAccounting::SetEnabled(true);
+  sphere->Modified();
+  sphere->Update();
+  vtkPVMemoryAccounting::SetEnabled(false);
+
+  const vtkIdType outputSize = info->Get(vtkPVCompositeDataPipeline::MEMORY_OUTPUT_SIZE());
+  if (outputSize != static_cast<vtkIdType>(sphere->GetOutput()->GetActualMemorySize()))
+  {
+    vtkLog(ERROR, "Wrong output size: " << outputSize);
+    return EXIT_FAILURE;
+  }
+  if (!info->Has(vtkPVCompositeDataPipeline::MEMORY_ALLOCATION_DELTA()) ||
+    !info->Has(vtkPVCompositeDataPipeline::MEMORY_PEAK()))
+  {
+    vtkLog(ERROR, "Missing memory accounting.");
+    return EXIT_FAILURE;
+  }
+  if (info->Get(vtkPVCompositeDataPipeline::MEMORY_PEAK()) <= 0)
+  {
+    vtkLog(ERROR, "Wrong peak memory: " << info->Get(vtkPVCompositeDataPipeline::MEMORY_PEAK()));
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLElementDatabase.h"
+#include "vtkPVXMLParser.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const char* TestXML = R"(<ServerManagerConfiguration>
+  <ProxyGroup name="sources">
+    <SourceProxy name="Sphere" class="vtkSphereSource" label="Sphere">
+      <DoubleVectorProperty name="Radius" command="SetRadius" default_values="0.5"
+                            number_of_elements="1">
+        <DoubleRangeDomain name="range" min="0" />
+        <Documentation>Radius of the &quot;sphere&quot;.</Documentation>
+      </DoubleVectorProperty>
+      <Hints><ShowInMenu category="Alphabetical" /></Hints>
+    </SourceProxy>
+    <SourceProxy name="Cone" class="vtkConeSource" />
+  </ProxyGroup>
+</ServerManagerConfiguration>)";
+
+std::string ToString(vtkPVXMLElement* element)
+{
+  std::ostringstream stream;
+  element->PrintXML(stream, vtkIndent());
+  return stream.str();
+}
+}
+
+int TestPVXMLElementDatabase(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    vtkLogF(ERROR, "Could not determine the temporary directory.");
+    return EXIT_FAILURE;
+  }
+  const std::string filename = std::string(tempDir) + "/TestPVXMLElementDatabase.pvdb";
+  delete[] tempDir;
+
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->Parse(TestXML))
+  {
+    vtkLogF(ERROR, "Failed to parse the test XML.");
+    return EXIT_FAILURE;
+  }
+  vtkPVXMLElement* group = parser->GetRootElement()->GetNestedElement(0);
+  vtkPVXMLElement* sphere = group->GetNestedElement(0);
+  vtkPVXMLElement* cone = group->GetNestedElement(1);
+
+  vtkNew<vtkPVXMLElementDatabase> writer;
+  writer->AddElement("sources", "Sphere", sphere);
+  writer->AddElement("sources", "Cone", cone);
+  writer->AddElement("filters", "Sphere", cone);
+  if (!writer->Write(filename.c_str(), "key-1"))
+  {
+    vtkLogF(ERROR, "Failed to write '%s'.", filename.c_str());
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPVXMLElementDatabase> reader;
+  if (reader->Open(filename.c_str(), "key-2") || reader->IsOpen())
+  {
+    vtkLogF(ERROR, "A database was opened with the wrong key.");
+    return EXIT_FAILURE;
+  }
+  if (!reader->Open(filename.c_str(), "key-1"))
+  {
+    vtkLogF(ERROR, "Failed to open '%s'.", filename.c_str());
+    return EXIT_FAILURE;
+  }
+  if (reader->GetNumberOfElements() != 3)
+  {
+    vtkLogF(ERROR, "Expected 3 elements, got %u.", reader->GetNumberOfElements());
+    return EXIT_FAILURE;
+  }
+  // elements are sorted by group, then name.
+  if (std::string(reader->GetGroup(0)) != "filters" || std::string(reader->GetName(1)) != "Cone" ||
+    std::string(reader->GetName(2)) != "Sphere")
+  {
+    vtkLogF(ERROR, "Elements are not sorted by group, then name.");
+    return EXIT_FAILURE;
+  }
+
+  auto decoded = reader->GetElement("sources", "Sphere");
+  if (!decoded || ToString(decoded) != ToString(sphere) ||
+    std::string(decoded->GetId()) != sphere->GetId())
+  {
+    vtkLogF(ERROR, "The decoded 'Sphere' source does not match the original.");
+    return EXIT_FAILURE;
+  }
+  vtkPVXMLElement* radius = decoded->FindNestedElementByName("DoubleVectorProperty");
+  if (std::string(radius->FindNestedElementByName("Documentation")->GetCharacterData()) !=
+    "Radius of the \"sphere\".")
+  {
+    vtkLogF(ERROR, "Character data was not decoded correctly.");
+    return EXIT_FAILURE;
+  }
+  if (ToString(reader->GetElement("filters", "Sphere")) != ToString(cone))
+  {
+    vtkLogF(ERROR, "The 'Sphere' filter does not match the original.");
+    return EXIT_FAILURE;
+  }
+  if (reader->GetElement("sources", "Cylinder") ||
+    reader->GetElement("representations", "Sphere"))
+  {
+    vtkLogF(ERROR, "A missing element was found.");
+    return EXIT_FAILURE;
+  }
+
+  reader->Close();
+  if (reader->GetNumberOfElements() != 0)
+  {
+    vtkLogF(ERROR, "Elements remain after Close().");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -7,16 +7,59 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkInformationIdTypeKey.h"
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationKey.h"
 #include "vtkInformationObjectBaseKey.h"
+#include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVMemoryAccounting.h"
 #include "vtkPVPostFilterExecutive.h"
+#include "vtkPVProfiler.h"
 
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
 #include <cassert>
 
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+struct vtkPVCompositeDataPipelineMemory
+{
+  vtkIdType Current; // KiB
+  vtkIdType Peak;    // KiB
+};
+
+vtkPVCompositeDataPipelineMemory GetProcessMemory()
+{
+  thread_local vtksys::SystemInformation systemInformation;
+  vtkPVCompositeDataPipelineMemory memory;
+  memory.Current = static_cast<vtkIdType>(systemInformation.GetProcMemoryUsed());
+  memory.Peak = memory.Current;
+#if !defined(_WIN32)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#if defined(__APPLE__)
+    memory.Peak = static_cast<vtkIdType>(usage.ru_maxrss / 1024);
+#else
+    memory.Peak = static_cast<vtkIdType>(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return memory;
+}
+}
+
 vtkStandardNewMacro(vtkPVCompositeDataPipeline);
+vtkInformationKeyMacro(vtkPVCompositeDataPipeline, MEMORY_OUTPUT_SIZE, IdType);
+vtkInformationKeyMacro(vtkPVCompositeDataPipeline, MEMORY_ALLOCATION_DELTA, IdType);
+vtkInformationKeyMacro(vtkPVCompositeDataPipeline, MEMORY_PEAK, IdType);
 //----------------------------------------------------------------------------
 vtkPVCompositeDataPipeline::vtkPVCompositeDataPipeline() = default;
 
@@ -73,6 +116,51 @@ void vtkPVCompositeDataPipeline::ResetPipelineInformation(int port, vtkInformati
   this->Superclass::ResetPipelineInformation(port, info);
 }
 
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  vtkInformation* algorithmInfo = this->Algorithm->GetInformation();
+  const bool accounting = vtkPVMemoryAccounting::GetEnabled();
+  vtkPVCompositeDataPipelineMemory before = { 0, 0 };
+  if (accounting)
+  {
+    before = ::GetProcessMemory();
+  }
+
+  int result;
+  if (!vtkPVProfiler::GetEnabled())
+  {
+    result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  }
+  else
+  {
+    const char* proxyName = algorithmInfo->Get(vtkPVProfiler::PROXY_NAME());
+    vtkPVProfiler::Scope scope("pipeline",
+      std::string("RequestData ") + this->Algorithm->GetClassName(), proxyName ? proxyName : "");
+    result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  }
+
+  if (!accounting)
+  {
+    return result;
+  }
+  const vtkPVCompositeDataPipelineMemory after = ::GetProcessMemory();
+  vtkIdType outputSize = 0;
+  for (int cc = 0, max = outInfoVec->GetNumberOfInformationObjects(); cc < max; ++cc)
+  {
+    vtkDataObject* output = outInfoVec->GetInformationObject(cc)->Get(vtkDataObject::DATA_OBJECT());
+    outputSize += output ? static_cast<vtkIdType>(output->GetActualMemorySize()) : 0;
+  }
+  algorithmInfo->Set(MEMORY_OUTPUT_SIZE(), outputSize);
+  algorithmInfo->Set(MEMORY_ALLOCATION_DELTA(), after.Current - before.Current);
+  // without sampling during the execution, the peak is only known when the
+  // execution raised the high-water mark.
+  algorithmInfo->Set(MEMORY_PEAK(),
+    after.Peak > before.Peak ? after.Peak : std::max(before.Current, after.Current));
+  return result;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -12,6 +12,11 @@
  *     algorithms are passed along to the input vtkPVPostFilter, if one exists.
  *     vtkPVPostFilter is used to automatically extract components or generated
  *     derived arrays such as magnitude array for vectors.
+ * \li Memory accounting :- when enabled with vtkPVMemoryAccounting, every
+ *     execution records the size of the outputs, the change in process memory
+ *     and an estimate of the peak process memory, in KiB, on the algorithm
+ *     information (see MEMORY_OUTPUT_SIZE(), MEMORY_ALLOCATION_DELTA() and
+ *     MEMORY_PEAK()).
  */
 
 #ifndef vtkPVCompositeDataPipeline_h
@@ -20,6 +25,8 @@
 #include "vtkCompositeDataPipeline.h"
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 
+class vtkInformationIdTypeKey;
+
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVCompositeDataPipeline : public vtkCompositeDataPipeline
 {
 public:
@@ -27,6 +34,23 @@ public:
   vtkTypeMacro(vtkPVCompositeDataPipeline, vtkCompositeDataPipeline);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * Keys set on the algorithm information after each execution: the actual
+   * memory size of the outputs, the change in process memory and the peak
+   * process memory during the execution. All values are in KiB.
+   *
+   * The peak is only an estimate since memory is not sampled during the
+   * execution. It is the process high-water mark when the execution raised
+   * it, otherwise the larger of the memory in use before and after the
+   * execution, which misses temporary allocations freed before the end of an
+   * execution that did not raise the high-water mark.
+   */
+  static vtkInformationIdTypeKey* MEMORY_OUTPUT_SIZE();
+  static vtkInformationIdTypeKey* MEMORY_ALLOCATION_DELTA();
+  static vtkInformationIdTypeKey* MEMORY_PEAK();
+  ///@}
+
 protected:
   vtkPVCompositeDataPipeline();
   ~vtkPVCompositeDataPipeline() override;
@@ -38,6 +62,11 @@ protected:
   // Remove update/whole extent when resetting pipeline information.
   void ResetPipelineInformation(int port, vtkInformation*) override;
 
+  // Record the memory use of the execution, and the execution itself with
+  // vtkPVProfiler when enabled.
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
 private:
   vtkPVCompositeDataPipeline(const vtkPVCompositeDataPipeline&) = delete;
   void operator=(const vtkPVCompositeDataPipeline&) = delete;
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVMappedFile.h"
+
+#ifdef _WIN32
+#include "vtksys/Encoding.hxx"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+vtkPVMappedFile::~vtkPVMappedFile()
+{
+  this->Unmap();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVMappedFile::Map(const char* filename, int accessPattern)
+{
+  this->Unmap();
+  if (!filename)
+  {
+    return false;
+  }
+#ifdef _WIN32
+  const DWORD flags =
+    accessPattern == SEQUENTIAL_ACCESS ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(filename).c_str(),
+    GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  this->File = file;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+  {
+    this->Unmap();
+    return false;
+  }
+  this->Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!this->Mapping)
+  {
+    this->Unmap();
+    return false;
+  }
+  void* data = MapViewOfFile(static_cast<HANDLE>(this->Mapping), FILE_MAP_READ, 0, 0, 0);
+  if (!data)
+  {
+    this->Unmap();
+    return false;
+  }
+  this->Size = static_cast<size_t>(size.QuadPart);
+#else
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid once the descriptor is closed.
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    return false;
+  }
+  this->Size = static_cast<size_t>(info.st_size);
+  madvise(data, this->Size, accessPattern == SEQUENTIAL_ACCESS ? MADV_SEQUENTIAL : MADV_NORMAL);
+#endif
+  this->Data = static_cast<unsigned char*>(data);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVMappedFile::Unmap()
+{
+#ifdef _WIN32
+  if (this->Data)
+  {
+    UnmapViewOfFile(this->Data);
+  }
+  if (this->Mapping)
+  {
+    CloseHandle(static_cast<HANDLE>(this->Mapping));
+  }
+  if (this->File)
+  {
+    CloseHandle(static_cast<HANDLE>(this->File));
+  }
+  this->Mapping = nullptr;
+  this->File = nullptr;
+#else
+  if (this->Data)
+  {
+    munmap(this->Data, this->Size);
+  }
+#endif
+  this->Data = nullptr;
+  this->Size = 0;
+}
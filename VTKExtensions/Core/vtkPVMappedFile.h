@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVMappedFile
+ * @brief   read-only memory mapping of a whole file.
+ *
+ * vtkPVMappedFile maps a file in memory with mmap, or MapViewOfFile on
+ * Windows, so that readers can access it with plain pointer arithmetic and
+ * let the system page the data in on demand. The mapping is released when the
+ * object is destroyed or Unmap() is called.
+ */
+
+#ifndef vtkPVMappedFile_h
+#define vtkPVMappedFile_h
+
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+#include <cstddef> // for size_t
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVMappedFile
+{
+public:
+  vtkPVMappedFile() = default;
+  ~vtkPVMappedFile();
+
+  /**
+   * Hint on how the file is going to be accessed, which the system may use to
+   * schedule read-ahead.
+   */
+  enum AccessPatterns
+  {
+    RANDOM_ACCESS,
+    SEQUENTIAL_ACCESS
+  };
+
+  /**
+   * Maps the whole file, releasing any previous mapping. Returns false if the
+   * file cannot be opened, is empty or cannot be mapped.
+   */
+  bool Map(const char* filename, int accessPattern = RANDOM_ACCESS);
+
+  /**
+   * Releases the mapping, if any.
+   */
+  void Unmap();
+
+  ///@{
+  /**
+   * Get the mapped data and its size in bytes. The data is null when nothing
+   * is mapped.
+   */
+  const unsigned char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+  ///@}
+
+private:
+  vtkPVMappedFile(const vtkPVMappedFile&) = delete;
+  void operator=(const vtkPVMappedFile&) = delete;
+
+  unsigned char* Data = nullptr;
+  size_t Size = 0;
+  // file and file mapping handles on Windows.
+  void* File = nullptr;
+  void* Mapping = nullptr;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVMappedFile.h
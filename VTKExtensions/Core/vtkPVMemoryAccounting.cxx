@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVMemoryAccounting.h"
+
+#include "vtkObjectFactory.h"
+
+#include <atomic>
+
+namespace
+{
+std::atomic<bool> vtkPVMemoryAccountingEnabled(false);
+}
+
+vtkStandardNewMacro(vtkPVMemoryAccounting);
+//----------------------------------------------------------------------------
+vtkPVMemoryAccounting::vtkPVMemoryAccounting() = default;
+
+//----------------------------------------------------------------------------
+vtkPVMemoryAccounting::~vtkPVMemoryAccounting() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryAccounting::SetEnabled(bool enabled)
+{
+  vtkPVMemoryAccountingEnabled = enabled;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVMemoryAccounting::GetEnabled()
+{
+  return vtkPVMemoryAccountingEnabled;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryAccounting::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPVMemoryAccounting::GetEnabled() << endl;
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVMemoryAccounting
+ * @brief enables the memory accounting of pipeline executions
+ *
+ * vtkPVMemoryAccounting controls whether vtkPVCompositeDataPipeline records
+ * the memory used by each algorithm execution on this process (see
+ * vtkPVCompositeDataPipeline::MEMORY_OUTPUT_SIZE()). It is disabled by
+ * default since it reads the process memory twice per execution.
+ *
+ * All methods are static, the instance only exists so that the
+ * "MemoryAccounting" proxy can enable accounting on all processes. Recorded
+ * values are gathered with vtkPVAlgorithmMemoryInformation.
+ */
+
+#ifndef vtkPVMemoryAccounting_h
+#define vtkPVMemoryAccounting_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVMemoryAccounting : public vtkObject
+{
+public:
+  static vtkPVMemoryAccounting* New();
+  vtkTypeMacro(vtkPVMemoryAccounting, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable/disable memory accounting on this process. Disabled by default.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+protected:
+  vtkPVMemoryAccounting();
+  ~vtkPVMemoryAccounting() override;
+
+private:
+  vtkPVMemoryAccounting(const vtkPVMemoryAccounting&) = delete;
+  void operator=(const vtkPVMemoryAccounting&) = delete;
+};
+
+#endif
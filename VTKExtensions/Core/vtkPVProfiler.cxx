@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVProfiler.h"
+
+#include "vtkInformationStringKey.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemInformation.hxx>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+struct vtkPVProfilerOpenEvent
+{
+  vtkPVProfiler::Event Event;
+  // process memory when the event began, -1 if not sampled.
+  vtkTypeInt64 Memory;
+};
+
+struct vtkPVProfilerStorage
+{
+  std::mutex Mutex;
+  std::vector<vtkPVProfiler::Event> Events;
+  vtkIdType MaximumNumberOfEvents = 1000000;
+  vtkIdType NumberOfDroppedEvents = 0;
+};
+
+std::atomic<bool> vtkPVProfilerEnabled(false);
+std::atomic<bool> vtkPVProfilerRecordMemory(false);
+
+vtkPVProfilerStorage& GetStorage()
+{
+  static vtkPVProfilerStorage storage;
+  return storage;
+}
+
+// events begun but not ended yet on the calling thread, innermost last.
+std::vector<vtkPVProfilerOpenEvent>& GetOpenEvents()
+{
+  thread_local std::vector<vtkPVProfilerOpenEvent> events;
+  return events;
+}
+
+// process memory in bytes.
+vtkTypeInt64 GetProcessMemory()
+{
+  thread_local vtksys::SystemInformation systemInformation;
+  return static_cast<vtkTypeInt64>(systemInformation.GetProcMemoryUsed()) * 1024;
+}
+}
+
+vtkStandardNewMacro(vtkPVProfiler);
+vtkInformationKeyMacro(vtkPVProfiler, PROXY_NAME, String);
+//----------------------------------------------------------------------------
+vtkPVProfiler::vtkPVProfiler() = default;
+
+//----------------------------------------------------------------------------
+vtkPVProfiler::~vtkPVProfiler() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::SetEnabled(bool enabled)
+{
+  vtkPVProfilerEnabled = enabled;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVProfiler::GetEnabled()
+{
+  return vtkPVProfilerEnabled;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::SetRecordMemory(bool record)
+{
+  vtkPVProfilerRecordMemory = record;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVProfiler::GetRecordMemory()
+{
+  return vtkPVProfilerRecordMemory;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::SetMaximumNumberOfEvents(vtkIdType count)
+{
+  auto& storage = GetStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  storage.MaximumNumberOfEvents = count;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVProfiler::GetMaximumNumberOfEvents()
+{
+  auto& storage = GetStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  return storage.MaximumNumberOfEvents;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::BeginEvent(
+  const char* category, const std::string& name, const std::string& proxyName)
+{
+  if (!vtkPVProfilerEnabled)
+  {
+    return;
+  }
+  vtkPVProfilerOpenEvent openEvent;
+  openEvent.Event.Category = category ? category : "";
+  openEvent.Event.Name = name;
+  openEvent.Event.ProxyName = proxyName;
+  openEvent.Event.ThreadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+  openEvent.Memory = vtkPVProfilerRecordMemory ? GetProcessMemory() : -1;
+  // read the clock last so that the overhead of recording is not included.
+  openEvent.Event.Start = vtkTimerLog::GetUniversalTime();
+  GetOpenEvents().push_back(std::move(openEvent));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::EndEvent(vtkTypeInt64 bytes)
+{
+  // events are ended even if recording was disabled since they began.
+  auto& openEvents = GetOpenEvents();
+  if (openEvents.empty())
+  {
+    return;
+  }
+  const double end = vtkTimerLog::GetUniversalTime();
+  vtkPVProfilerOpenEvent openEvent = std::move(openEvents.back());
+  openEvents.pop_back();
+  openEvent.Event.Duration = end - openEvent.Event.Start;
+  openEvent.Event.Bytes += bytes;
+  if (openEvent.Memory >= 0)
+  {
+    openEvent.Event.MemoryDelta = GetProcessMemory() - openEvent.Memory;
+  }
+
+  auto& storage = GetStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  if (static_cast<vtkIdType>(storage.Events.size()) >= storage.MaximumNumberOfEvents)
+  {
+    ++storage.NumberOfDroppedEvents;
+    return;
+  }
+  storage.Events.push_back(std::move(openEvent.Event));
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkPVProfiler::Event> vtkPVProfiler::GetEvents()
+{
+  auto& storage = GetStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  return storage.Events;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVProfiler::GetNumberOfDroppedEvents()
+{
+  auto& storage = GetStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  return storage.NumberOfDroppedEvents;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::ClearEvents()
+{
+  auto& storage = GetStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  storage.Events.clear();
+  storage.Events.shrink_to_fit();
+  storage.NumberOfDroppedEvents = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPVProfiler::GetEnabled() << endl;
+  os << indent << "RecordMemory: " << vtkPVProfiler::GetRecordMemory() << endl;
+  os << indent << "MaximumNumberOfEvents: " << vtkPVProfiler::GetMaximumNumberOfEvents() << endl;
+  os << indent << "NumberOfDroppedEvents: " << vtkPVProfiler::GetNumberOfDroppedEvents() << endl;
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVProfiler
+ * @brief records timed events of a ParaView process
+ *
+ * vtkPVProfiler records begin/end events for the expensive operations of a
+ * ParaView process, e.g. algorithm executions, data delivery, compositing
+ * and client-server stream execution. Unlike vtkTimerLog, each event is a
+ * structured record with the thread it ran on, the name of the proxy it was
+ * executed for, the number of bytes it moved and, when RecordMemory is on, the
+ * change in process memory between its begin and end, so that the events of
+ * all ranks can be put on a single timeline.
+ *
+ * Recording is disabled by default and all methods are static, the instance
+ * only exists so that the "Profiler" proxy can enable recording on all
+ * processes. Events are gathered with vtkPVProfilerInformation.
+ *
+ * Use vtkPVProfiler::Scope to record an event for the lifetime of a block:
+ * @code{cpp}
+ * vtkPVProfiler::Scope scope("delivery", "Deliver");
+ * ...
+ * scope.AddBytes(size);
+ * @endcode
+ */
+
+#ifndef vtkPVProfiler_h
+#define vtkPVProfiler_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkInformationStringKey;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVProfiler : public vtkObject
+{
+public:
+  static vtkPVProfiler* New();
+  vtkTypeMacro(vtkPVProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * A recorded event. Times are in seconds since the epoch.
+   */
+  struct Event
+  {
+    std::string Category;
+    std::string Name;
+    std::string ProxyName;
+    double Start = 0;
+    double Duration = 0;
+    vtkTypeUInt64 ThreadId = 0;
+    vtkTypeInt64 Bytes = 0;
+    vtkTypeInt64 MemoryDelta = 0;
+  };
+
+  ///@{
+  /**
+   * Enable/disable recording on this process. Disabled by default.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Enable/disable sampling the process memory when events begin and end,
+   * reported as Event::MemoryDelta. Sampling reads the process status on
+   * every event, which costs more than the event itself for short scopes,
+   * hence it is disabled by default and MemoryDelta is left to 0.
+   */
+  static void SetRecordMemory(bool record);
+  static bool GetRecordMemory();
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of events kept on this process, events recorded past this
+   * limit are dropped and counted. Default is 1000000.
+   */
+  static void SetMaximumNumberOfEvents(vtkIdType count);
+  static vtkIdType GetMaximumNumberOfEvents();
+  ///@}
+
+  /**
+   * Begins an event on the calling thread. Events can be nested, each
+   * BeginEvent() must be matched by an EndEvent() on the same thread. Does
+   * nothing when recording is disabled.
+   */
+  static void BeginEvent(
+    const char* category, const std::string& name, const std::string& proxyName = std::string());
+
+  /**
+   * Ends the innermost event of the calling thread, adding `bytes` to the bytes
+   * it moved.
+   */
+  static void EndEvent(vtkTypeInt64 bytes = 0);
+
+  /**
+   * Returns a copy of the events recorded so far.
+   */
+  static std::vector<Event> GetEvents();
+
+  /**
+   * Number of events dropped because MaximumNumberOfEvents was reached.
+   */
+  static vtkIdType GetNumberOfDroppedEvents();
+
+  /**
+   * Clears the recorded events.
+   */
+  static void ClearEvents();
+
+  /**
+   * Key set on the information of algorithms to report the name of the proxy
+   * they belong to.
+   */
+  static vtkInformationStringKey* PROXY_NAME();
+
+  /**
+   * Records an event for the lifetime of the scope.
+   */
+  class VTKPVVTKEXTENSIONSCORE_EXPORT Scope
+  {
+  public:
+    Scope(
+      const char* category, const std::string& name, const std::string& proxyName = std::string())
+      : Active(vtkPVProfiler::GetEnabled())
+    {
+      if (this->Active)
+      {
+        vtkPVProfiler::BeginEvent(category, name, proxyName);
+      }
+    }
+    ~Scope()
+    {
+      if (this->Active)
+      {
+        vtkPVProfiler::EndEvent(this->Bytes);
+      }
+    }
+    void AddBytes(vtkTypeInt64 bytes) { this->Bytes += bytes; }
+    bool IsActive() const { return this->Active; }
+
+  private:
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+
+    bool Active;
+    vtkTypeInt64 Bytes = 0;
+  };
+
+protected:
+  vtkPVProfiler();
+  ~vtkPVProfiler() override;
+
+private:
+  vtkPVProfiler(const vtkPVProfiler&) = delete;
+  void operator=(const vtkPVProfiler&) = delete;
+};
+
+#endif
@@ -254,6 +254,29 @@ const char* vtkPVXMLElement::GetAttributeOrDefault(const char* name, const char*
   }
   return notFound;
 }
+
+//----------------------------------------------------------------------------
+unsigned int vtkPVXMLElement::GetNumberOfAttributes()
+{
+  return static_cast<unsigned int>(this->Internal->AttributeNames.size());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeName(unsigned int index)
+{
+  return index < this->Internal->AttributeNames.size()
+    ? this->Internal->AttributeNames[index].c_str()
+    : nullptr;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeValue(unsigned int index)
+{
+  return index < this->Internal->AttributeValues.size()
+    ? this->Internal->AttributeValues[index].c_str()
+    : nullptr;
+}
+
 //----------------------------------------------------------------------------
 const char* vtkPVXMLElement::GetCharacterData()
 {
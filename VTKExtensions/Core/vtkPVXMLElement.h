@@ -65,6 +65,16 @@ public:
    */
   const char* GetAttributeOrDefault(const char* name, const char* notFound);
 
+  ///@{
+  /**
+   * Get the number of attributes, and the name and value of the attribute at
+   * the given index, in the order they were added.
+   */
+  unsigned int GetNumberOfAttributes();
+  const char* GetAttributeName(unsigned int index);
+  const char* GetAttributeValue(unsigned int index);
+  ///@}
+
   /**
    * Get the character data for the element.
    */
@@ -273,6 +283,7 @@ protected:
   vtkPVXMLElement* LookupElementUpScope(const char* id);
   void SetParent(vtkPVXMLElement* parent);
 
+  friend class vtkPVXMLElementDatabase;
   friend class vtkPVXMLParser;
 
 private:
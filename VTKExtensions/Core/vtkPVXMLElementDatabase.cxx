@@ -0,0 +1,476 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVXMLElementDatabase.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkPVMappedFile.h"
+#include "vtkPVXMLElement.h"
+
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemInformation.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// A database file is laid out as follows, all words being 32-bit unsigned
+// integers in the byte order of the process that wrote it:
+//
+//   header        the magic string followed by the HeaderWords words.
+//   key           the key, padded with zeros to a multiple of 4 bytes.
+//   offsets       NumberOfStrings words, the offset of each string.
+//   records       NumberOfRecords triplets (group, name, element), sorted by
+//                 group then name. Group and name are string indices and
+//                 element is the index of the first word of the element.
+//   elements      NumberOfWords words. Each element is saved as its name, id
+//                 and character data string indices, its number of
+//                 attributes, its number of nested elements, a (name, value)
+//                 pair of string indices per attribute and then its nested
+//                 elements.
+//   strings       StringBytes bytes of null terminated strings.
+const char Magic[8] = { 'P', 'V', 'X', 'M', 'L', 'D', 'B', '\0' };
+const vtkTypeUInt32 ByteOrderMark = 0x01020304;
+const vtkTypeUInt32 FormatVersion = 1;
+const vtkTypeUInt32 NullString = 0xffffffff;
+const unsigned int MaximumDepth = 256;
+
+enum HeaderWords
+{
+  HEADER_BYTE_ORDER = 0,
+  HEADER_VERSION,
+  HEADER_KEY_LENGTH,
+  HEADER_NUMBER_OF_STRINGS,
+  HEADER_NUMBER_OF_RECORDS,
+  HEADER_NUMBER_OF_WORDS,
+  HEADER_STRING_BYTES,
+  NUMBER_OF_HEADER_WORDS
+};
+
+size_t Padded(size_t length)
+{
+  return (length + 3) / 4 * 4;
+}
+
+vtkTypeUInt32 ReadWord(const unsigned char* words, size_t index)
+{
+  vtkTypeUInt32 word;
+  std::memcpy(&word, words + 4 * index, sizeof(word));
+  return word;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Builds the string table and element words of a database being written.
+ */
+class vtkPVXMLElementEncoder
+{
+public:
+  vtkTypeUInt32 AddString(const char* str)
+  {
+    if (!str)
+    {
+      return NullString;
+    }
+    auto iter = this->StringIndices.find(str);
+    if (iter != this->StringIndices.end())
+    {
+      return iter->second;
+    }
+    const vtkTypeUInt32 index = static_cast<vtkTypeUInt32>(this->Offsets.size());
+    this->Offsets.push_back(static_cast<vtkTypeUInt32>(this->Strings.size()));
+    this->Strings.insert(this->Strings.end(), str, str + strlen(str) + 1);
+    this->StringIndices.emplace(str, index);
+    return index;
+  }
+
+  void AddElement(vtkPVXMLElement* element)
+  {
+    const char* characterData = element->GetCharacterData();
+    this->Words.push_back(this->AddString(element->GetName()));
+    this->Words.push_back(this->AddString(element->GetId()));
+    this->Words.push_back(this->AddString(*characterData ? characterData : nullptr));
+    this->Words.push_back(element->GetNumberOfAttributes());
+    this->Words.push_back(element->GetNumberOfNestedElements());
+    for (unsigned int cc = 0; cc < element->GetNumberOfAttributes(); ++cc)
+    {
+      this->Words.push_back(this->AddString(element->GetAttributeName(cc)));
+      this->Words.push_back(this->AddString(element->GetAttributeValue(cc)));
+    }
+    for (unsigned int cc = 0; cc < element->GetNumberOfNestedElements(); ++cc)
+    {
+      this->AddElement(element->GetNestedElement(cc));
+    }
+  }
+
+  std::vector<char> Strings;
+  std::vector<vtkTypeUInt32> Offsets;
+  std::vector<vtkTypeUInt32> Words;
+
+private:
+  std::unordered_map<std::string, vtkTypeUInt32> StringIndices;
+};
+}
+
+//-----------------------------------------------------------------------------
+class vtkPVXMLElementDatabase::vtkInternals
+{
+public:
+  // elements to write.
+  std::map<std::pair<std::string, std::string>, vtkSmartPointer<vtkPVXMLElement>> Elements;
+
+  // opened database.
+  vtkPVMappedFile File;
+  std::string FileName;
+  vtkTypeUInt32 NumberOfStrings = 0;
+  vtkTypeUInt32 NumberOfRecords = 0;
+  vtkTypeUInt32 NumberOfWords = 0;
+  const unsigned char* Offsets = nullptr;
+  const unsigned char* Records = nullptr;
+  const unsigned char* Words = nullptr;
+  const char* Strings = nullptr;
+
+  void Close()
+  {
+    this->File.Unmap();
+    this->FileName.clear();
+    this->NumberOfStrings = this->NumberOfRecords = this->NumberOfWords = 0;
+    this->Offsets = this->Records = this->Words = nullptr;
+    this->Strings = nullptr;
+  }
+
+  const char* GetString(vtkTypeUInt32 index, bool& valid) const
+  {
+    if (index == NullString)
+    {
+      return nullptr;
+    }
+    if (index >= this->NumberOfStrings)
+    {
+      valid = false;
+      return nullptr;
+    }
+    return this->Strings + ReadWord(this->Offsets, index);
+  }
+
+  const char* GetRecordString(unsigned int record, int which) const
+  {
+    if (record >= this->NumberOfRecords)
+    {
+      return nullptr;
+    }
+    bool valid = true;
+    return this->GetString(ReadWord(this->Records, 3 * record + which), valid);
+  }
+
+  vtkSmartPointer<vtkPVXMLElement> Decode(vtkTypeUInt32& cursor, unsigned int depth) const
+  {
+    if (depth > MaximumDepth || cursor > this->NumberOfWords || this->NumberOfWords - cursor < 5)
+    {
+      return nullptr;
+    }
+    bool valid = true;
+    const char* name = this->GetString(ReadWord(this->Words, cursor), valid);
+    const char* id = this->GetString(ReadWord(this->Words, cursor + 1), valid);
+    const char* characterData = this->GetString(ReadWord(this->Words, cursor + 2), valid);
+    const vtkTypeUInt32 numberOfAttributes = ReadWord(this->Words, cursor + 3);
+    const vtkTypeUInt32 numberOfNestedElements = ReadWord(this->Words, cursor + 4);
+    cursor += 5;
+    if (!valid || (this->NumberOfWords - cursor) / 2 < numberOfAttributes)
+    {
+      return nullptr;
+    }
+
+    auto element = vtkSmartPointer<vtkPVXMLElement>::New();
+    element->SetName(name);
+    vtkPVXMLElementDatabase::SetIdAndCharacterData(element, id, characterData);
+    for (vtkTypeUInt32 cc = 0; cc < numberOfAttributes; ++cc, cursor += 2)
+    {
+      const char* attrName = this->GetString(ReadWord(this->Words, cursor), valid);
+      const char* attrValue = this->GetString(ReadWord(this->Words, cursor + 1), valid);
+      element->AddAttribute(attrName, attrValue);
+    }
+    if (!valid)
+    {
+      return nullptr;
+    }
+    for (vtkTypeUInt32 cc = 0; cc < numberOfNestedElements; ++cc)
+    {
+      auto nested = this->Decode(cursor, depth + 1);
+      if (!nested)
+      {
+        return nullptr;
+      }
+      element->AddNestedElement(nested);
+    }
+    return element;
+  }
+};
+
+vtkStandardNewMacro(vtkPVXMLElementDatabase);
+//----------------------------------------------------------------------------
+vtkPVXMLElementDatabase::vtkPVXMLElementDatabase()
+  : Internals(new vtkPVXMLElementDatabase::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElementDatabase::~vtkPVXMLElementDatabase() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElementDatabase::SetIdAndCharacterData(
+  vtkPVXMLElement* element, const char* id, const char* characterData)
+{
+  element->SetId(id);
+  if (characterData)
+  {
+    element->AddCharacterData(characterData, static_cast<int>(strlen(characterData)));
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElementDatabase::AddElement(
+  const char* group, const char* name, vtkPVXMLElement* element)
+{
+  if (group && name && element)
+  {
+    this->Internals->Elements[std::make_pair(std::string(group), std::string(name))] = element;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElementDatabase::RemoveAllElements()
+{
+  this->Internals->Elements.clear();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElementDatabase::Write(const char* filename, const char* key)
+{
+  if (!filename || !key)
+  {
+    vtkErrorMacro("A filename and a key are required.");
+    return false;
+  }
+
+  vtkPVXMLElementEncoder encoder;
+  std::vector<vtkTypeUInt32> records;
+  records.reserve(3 * this->Internals->Elements.size());
+  for (const auto& item : this->Internals->Elements)
+  {
+    records.push_back(encoder.AddString(item.first.first.c_str()));
+    records.push_back(encoder.AddString(item.first.second.c_str()));
+    records.push_back(static_cast<vtkTypeUInt32>(encoder.Words.size()));
+    encoder.AddElement(item.second);
+  }
+
+  const size_t keyLength = strlen(key);
+  vtkTypeUInt32 header[NUMBER_OF_HEADER_WORDS];
+  header[HEADER_BYTE_ORDER] = ByteOrderMark;
+  header[HEADER_VERSION] = FormatVersion;
+  header[HEADER_KEY_LENGTH] = static_cast<vtkTypeUInt32>(keyLength);
+  header[HEADER_NUMBER_OF_STRINGS] = static_cast<vtkTypeUInt32>(encoder.Offsets.size());
+  header[HEADER_NUMBER_OF_RECORDS] = static_cast<vtkTypeUInt32>(records.size() / 3);
+  header[HEADER_NUMBER_OF_WORDS] = static_cast<vtkTypeUInt32>(encoder.Words.size());
+  header[HEADER_STRING_BYTES] = static_cast<vtkTypeUInt32>(encoder.Strings.size());
+  std::vector<char> paddedKey(key, key + keyLength);
+  paddedKey.resize(Padded(keyLength), '\0');
+
+  // write next to the destination so that the rename does not cross file systems.
+  const std::string tmpname =
+    std::string(filename) + "." + std::to_string(vtksys::SystemInformation::GetProcessId());
+  {
+    vtksys::ofstream file(tmpname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+      vtkErrorMacro("Failed to open '" << tmpname << "' for writing.");
+      return false;
+    }
+    file.write(Magic, sizeof(Magic));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(paddedKey.data(), paddedKey.size());
+    file.write(reinterpret_cast<const char*>(encoder.Offsets.data()),
+      encoder.Offsets.size() * sizeof(vtkTypeUInt32));
+    file.write(
+      reinterpret_cast<const char*>(records.data()), records.size() * sizeof(vtkTypeUInt32));
+    file.write(reinterpret_cast<const char*>(encoder.Words.data()),
+      encoder.Words.size() * sizeof(vtkTypeUInt32));
+    file.write(encoder.Strings.data(), encoder.Strings.size());
+    if (!file)
+    {
+      file.close();
+      vtksys::SystemTools::RemoveFile(tmpname);
+      vtkErrorMacro("Failed to write '" << tmpname << "'.");
+      return false;
+    }
+  }
+
+  if (!vtksys::SystemTools::RenameFile(tmpname, filename))
+  {
+    vtksys::SystemTools::RemoveFile(tmpname);
+    vtkErrorMacro("Failed to rename '" << tmpname << "' to '" << filename << "'.");
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElementDatabase::Open(const char* filename, const char* key)
+{
+  auto& internals = *this->Internals;
+  internals.Close();
+  if (!filename || !key || !internals.File.Map(filename))
+  {
+    return false;
+  }
+
+  const unsigned char* data = internals.File.GetData();
+  const size_t size = internals.File.GetSize();
+  const size_t headerSize = sizeof(Magic) + 4 * NUMBER_OF_HEADER_WORDS;
+  if (size < headerSize || memcmp(data, Magic, sizeof(Magic)) != 0)
+  {
+    vtkWarningMacro("'" << filename << "' is not an XML element database.");
+    internals.Close();
+    return false;
+  }
+
+  const unsigned char* header = data + sizeof(Magic);
+  const size_t keyLength = strlen(key);
+  const vtkTypeUInt32 numberOfStrings = ReadWord(header, HEADER_NUMBER_OF_STRINGS);
+  const vtkTypeUInt32 numberOfRecords = ReadWord(header, HEADER_NUMBER_OF_RECORDS);
+  const vtkTypeUInt32 numberOfWords = ReadWord(header, HEADER_NUMBER_OF_WORDS);
+  const vtkTypeUInt32 stringBytes = ReadWord(header, HEADER_STRING_BYTES);
+  const vtkTypeUInt64 numberOfTableWords = static_cast<vtkTypeUInt64>(numberOfStrings) +
+    3 * static_cast<vtkTypeUInt64>(numberOfRecords) + numberOfWords;
+  const vtkTypeUInt64 expectedSize =
+    headerSize + Padded(keyLength) + 4 * numberOfTableWords + stringBytes;
+  // a database written with another key, format or byte order is simply stale.
+  if (ReadWord(header, HEADER_BYTE_ORDER) != ByteOrderMark ||
+    ReadWord(header, HEADER_VERSION) != FormatVersion ||
+    ReadWord(header, HEADER_KEY_LENGTH) != keyLength ||
+    memcmp(data + headerSize, key, keyLength) != 0)
+  {
+    internals.Close();
+    return false;
+  }
+  if (expectedSize != size || (stringBytes > 0 && data[size - 1] != '\0'))
+  {
+    vtkWarningMacro("'" << filename << "' is truncated or corrupt.");
+    internals.Close();
+    return false;
+  }
+
+  internals.Offsets = data + headerSize + Padded(keyLength);
+  internals.Records = internals.Offsets + 4 * static_cast<size_t>(numberOfStrings);
+  internals.Words = internals.Records + 12 * static_cast<size_t>(numberOfRecords);
+  internals.Strings =
+    reinterpret_cast<const char*>(internals.Words + 4 * static_cast<size_t>(numberOfWords));
+  for (vtkTypeUInt32 cc = 0; cc < numberOfStrings; ++cc)
+  {
+    if (ReadWord(internals.Offsets, cc) >= stringBytes)
+    {
+      vtkWarningMacro("'" << filename << "' is truncated or corrupt.");
+      internals.Close();
+      return false;
+    }
+  }
+  internals.NumberOfStrings = numberOfStrings;
+  internals.NumberOfRecords = numberOfRecords;
+  internals.NumberOfWords = numberOfWords;
+  internals.FileName = filename;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElementDatabase::Close()
+{
+  this->Internals->Close();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElementDatabase::IsOpen() const
+{
+  return this->Internals->File.GetData() != nullptr;
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkPVXMLElementDatabase::GetNumberOfElements() const
+{
+  return this->Internals->NumberOfRecords;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElementDatabase::GetGroup(unsigned int index) const
+{
+  return this->Internals->GetRecordString(index, 0);
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElementDatabase::GetName(unsigned int index) const
+{
+  return this->Internals->GetRecordString(index, 1);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPVXMLElement> vtkPVXMLElementDatabase::GetElement(
+  const char* group, const char* name)
+{
+  const auto& internals = *this->Internals;
+  if (!group || !name)
+  {
+    return nullptr;
+  }
+
+  // binary search of the records, sorted by group then name.
+  unsigned int first = 0;
+  unsigned int last = internals.NumberOfRecords;
+  while (first < last)
+  {
+    const unsigned int middle = first + (last - first) / 2;
+    const char* middleGroup = internals.GetRecordString(middle, 0);
+    const char* middleName = internals.GetRecordString(middle, 1);
+    if (!middleGroup || !middleName)
+    {
+      break;
+    }
+    int order = strcmp(middleGroup, group);
+    if (order == 0)
+    {
+      order = strcmp(middleName, name);
+    }
+    if (order == 0)
+    {
+      vtkTypeUInt32 cursor = ReadWord(internals.Records, 3 * middle + 2);
+      auto element = internals.Decode(cursor, 0);
+      if (!element)
+      {
+        vtkErrorMacro("Failed to decode (" << group << ", " << name << ") from '"
+                                           << internals.FileName << "'.");
+      }
+      return element;
+    }
+    if (order < 0)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElementDatabase::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << this->Internals->FileName << endl;
+  os << indent << "NumberOfElements: " << this->Internals->NumberOfRecords << endl;
+  os << indent << "NumberOfElementsToWrite: " << this->Internals->Elements.size() << endl;
+}
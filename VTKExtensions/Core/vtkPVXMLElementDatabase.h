@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVXMLElementDatabase
+ * @brief compiled, memory-mapped store of vtkPVXMLElement trees
+ *
+ * vtkPVXMLElementDatabase saves vtkPVXMLElement trees, keyed by a group and a
+ * name, in a compact binary file and reads them back without parsing any XML.
+ * Elements added with AddElement() are saved with Write(). A file opened with
+ * Open() is memory-mapped and an element tree is only decoded when it is
+ * requested with GetElement(), so opening a database is cheap no matter how
+ * many elements it holds.
+ *
+ * Every file is stamped with a key given by the caller, e.g. a hash of the XML
+ * the elements were parsed from. Open() refuses files stamped with a different
+ * key, or written with a different format or byte order, so a database can be
+ * used as a cache that is rebuilt whenever its source changes.
+ */
+
+#ifndef vtkPVXMLElementDatabase_h
+#define vtkPVXMLElementDatabase_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkSmartPointer.h"              // needed for vtkSmartPointer
+
+#include <memory> // for std::unique_ptr
+
+class vtkPVXMLElement;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVXMLElementDatabase : public vtkObject
+{
+public:
+  static vtkPVXMLElementDatabase* New();
+  vtkTypeMacro(vtkPVXMLElementDatabase, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Add an element tree to be saved by the next Write(), replacing any element
+   * already added with the same group and name. The element is not copied, so
+   * it must not be modified before Write() is called.
+   */
+  void AddElement(const char* group, const char* name, vtkPVXMLElement* element);
+
+  /**
+   * Remove all elements added with AddElement().
+   */
+  void RemoveAllElements();
+
+  /**
+   * Save the elements added with AddElement() to `filename`, stamped with
+   * `key`. The file is written under a temporary name and renamed once
+   * complete, so that a concurrent Open() never sees a partial file.
+   * Returns false on failure.
+   */
+  bool Write(const char* filename, const char* key);
+
+  /**
+   * Map a database saved with Write(). Returns false if the file cannot be
+   * read, is not a database or is not stamped with `key`.
+   */
+  bool Open(const char* filename, const char* key);
+
+  /**
+   * Unmap the database opened with Open(), if any.
+   */
+  void Close();
+
+  /**
+   * Returns true if a database is opened.
+   */
+  bool IsOpen() const;
+
+  ///@{
+  /**
+   * Get the number of elements in the opened database, and the group and name
+   * of the element at the given index. Elements are sorted by group, then
+   * name.
+   */
+  unsigned int GetNumberOfElements() const;
+  const char* GetGroup(unsigned int index) const;
+  const char* GetName(unsigned int index) const;
+  ///@}
+
+  /**
+   * Decode the element tree saved under the given group and name. Returns
+   * nullptr if there is none, or if the database is corrupt. Each call
+   * decodes a new tree.
+   */
+  vtkSmartPointer<vtkPVXMLElement> GetElement(const char* group, const char* name);
+
+protected:
+  vtkPVXMLElementDatabase();
+  ~vtkPVXMLElementDatabase() override;
+
+private:
+  vtkPVXMLElementDatabase(const vtkPVXMLElementDatabase&) = delete;
+  void operator=(const vtkPVXMLElementDatabase&) = delete;
+
+  // vtkPVXMLElement only lets its friends set these.
+  static void SetIdAndCharacterData(
+    vtkPVXMLElement* element, const char* id, const char* characterData);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
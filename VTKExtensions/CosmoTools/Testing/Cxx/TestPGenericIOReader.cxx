@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkPGenericIOReader gives the same points, arrays and
+// gio_block_indices as vtkPGenericIOMultiBlockReader, which still converts the
+// particles one at a time, with and without requested halos. The coordinates
+// are read into structure-of-arrays points of the type they have in the file.
+
+#include <vtk_mpi.h>
+
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericIOMultiBlockReader.h"
+#include "vtkPGenericIOReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+const char* ArrayNames[] = { "vx", "id" };
+
+// Points, arrays and block coordinates of the particles, in the order they
+// are read.
+struct Particles
+{
+  std::vector<double> Points;
+  std::vector<double> Arrays[2];
+  std::vector<vtkTypeUInt64> Blocks;
+};
+
+bool AppendParticles(vtkUnstructuredGrid* grid, const vtkTypeUInt64* blockCoords,
+  Particles& particles)
+{
+  const vtkIdType numPoints = grid->GetNumberOfPoints();
+  if (grid->GetNumberOfCells() != numPoints)
+  {
+    vtkLogF(ERROR, "%lld vertices for %lld points.",
+      static_cast<long long>(grid->GetNumberOfCells()), static_cast<long long>(numPoints));
+    return false;
+  }
+  vtkDataArray* blocks = grid->GetPointData()->GetArray("gio_block_indices");
+  for (vtkIdType ii = 0; ii < numPoints; ++ii)
+  {
+    double pnt[3];
+    grid->GetPoint(ii, pnt);
+    particles.Points.insert(particles.Points.end(), pnt, pnt + 3);
+    for (int jj = 0; jj < 2; ++jj)
+    {
+      vtkDataArray* array = grid->GetPointData()->GetArray(ArrayNames[jj]);
+      particles.Arrays[jj].push_back(array->GetTuple1(ii));
+    }
+    for (int jj = 0; jj < 3; ++jj)
+    {
+      particles.Blocks.push_back(
+        blocks ? static_cast<vtkTypeUInt64>(blocks->GetComponent(ii, jj)) : blockCoords[jj]);
+    }
+  }
+  return true;
+}
+
+bool ReadReference(const std::string& fname, const std::vector<vtkIdType>& haloIds,
+  Particles& particles, bool& hasBlockCoords)
+{
+  vtkNew<vtkPGenericIOMultiBlockReader> reader;
+  reader->SetFileName(fname.c_str());
+  reader->UpdateInformation();
+  reader->SetXAxisVariableName("x");
+  reader->SetYAxisVariableName("y");
+  reader->SetZAxisVariableName("z");
+  reader->SetHaloIdVariableName("id");
+  for (vtkIdType haloId : haloIds)
+  {
+    reader->AddRequestedHaloId(haloId);
+  }
+  for (const char* name : ArrayNames)
+  {
+    reader->SetPointArrayStatus(name, 1);
+  }
+  reader->Update();
+
+  hasBlockCoords = true;
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  for (unsigned int ii = 0; ii < output->GetNumberOfBlocks(); ++ii)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(output->GetBlock(ii));
+    if (grid == nullptr)
+    {
+      continue;
+    }
+    vtkTypeUInt64 coords[3] = { 0, 0, 0 };
+    vtkDataArray* blockCoords = grid->GetFieldData()->GetArray("genericio_block_coords");
+    hasBlockCoords = hasBlockCoords && (blockCoords != nullptr);
+    for (int jj = 0; blockCoords && jj < 3; ++jj)
+    {
+      coords[jj] = static_cast<vtkTypeUInt64>(blockCoords->GetComponent(0, jj));
+    }
+    if (!AppendParticles(grid, coords, particles))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int CompareParticles(const Particles& expected, const Particles& actual, bool compareBlocks,
+  const char* name)
+{
+  if (expected.Points.size() != actual.Points.size())
+  {
+    vtkLogF(ERROR, "%s: expected %d points, got %d.", name,
+      static_cast<int>(expected.Points.size() / 3), static_cast<int>(actual.Points.size() / 3));
+    return EXIT_FAILURE;
+  }
+  if (expected.Points != actual.Points)
+  {
+    vtkLogF(ERROR, "%s: points differ.", name);
+    return EXIT_FAILURE;
+  }
+  for (int jj = 0; jj < 2; ++jj)
+  {
+    if (expected.Arrays[jj] != actual.Arrays[jj])
+    {
+      vtkLogF(ERROR, "%s: array %s differs.", name, ArrayNames[jj]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (compareBlocks && expected.Blocks != actual.Blocks)
+  {
+    vtkLogF(ERROR, "%s: gio_block_indices differ.", name);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int runGenericIOReaderTest(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/genericio/m000.499.allparticles");
+  const std::string fileName = fname;
+  delete[] fname;
+
+  vtkNew<vtkPGenericIOReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  reader->SetXAxisVariableName("x");
+  reader->SetYAxisVariableName("y");
+  reader->SetZAxisVariableName("z");
+  reader->SetHaloIdVariableName("id");
+  reader->AppendBlockCoordinatesOn();
+  for (const char* name : ArrayNames)
+  {
+    reader->SetPointArrayStatus(name, 1);
+  }
+  reader->Update();
+
+  // all particles: the coordinates are used as the points without any copy.
+  vtkUnstructuredGrid* output = reader->GetOutput();
+  vtkDataArray* points = output->GetPoints()->GetData();
+  if (!vtkSOADataArrayTemplate<float>::SafeDownCast(points) &&
+    !vtkSOADataArrayTemplate<double>::SafeDownCast(points))
+  {
+    vtkLogF(ERROR, "Expected structure-of-arrays points, got %s.", points->GetClassName());
+    return EXIT_FAILURE;
+  }
+  if (output->GetPointData()->GetArray("gio_block_indices") == nullptr)
+  {
+    vtkLogF(ERROR, "Missing gio_block_indices.");
+    return EXIT_FAILURE;
+  }
+
+  Particles expected;
+  bool hasBlockCoords = false;
+  if (!ReadReference(fileName, std::vector<vtkIdType>(), expected, hasBlockCoords))
+  {
+    vtkLogF(ERROR, "Could not read the reference particles.");
+    return EXIT_FAILURE;
+  }
+  if (expected.Points.empty())
+  {
+    vtkLogF(ERROR, "No reference particles.");
+    return EXIT_FAILURE;
+  }
+  Particles actual;
+  if (!AppendParticles(output, nullptr, actual))
+  {
+    vtkLogF(ERROR, "Invalid particles.");
+    return EXIT_FAILURE;
+  }
+  if (CompareParticles(expected, actual, hasBlockCoords, "all particles") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // requested halos: "id" is unique per particle, request a few of them in
+  // no particular order along with one that does not exist.
+  const vtkIdType numPoints = static_cast<vtkIdType>(expected.Arrays[1].size());
+  std::vector<vtkIdType> haloIds;
+  const vtkIdType indices[4] = { numPoints - 1, numPoints / 3, 0, numPoints / 2 };
+  for (vtkIdType ii : indices)
+  {
+    haloIds.push_back(static_cast<vtkIdType>(expected.Arrays[1][ii]));
+  }
+  haloIds.push_back(-1);
+  for (vtkIdType haloId : haloIds)
+  {
+    reader->AddRequestedHaloId(haloId);
+  }
+  reader->Update();
+
+  Particles expectedInHalos;
+  if (!ReadReference(fileName, haloIds, expectedInHalos, hasBlockCoords))
+  {
+    vtkLogF(ERROR, "Could not read the reference particles in halos.");
+    return EXIT_FAILURE;
+  }
+  if (expectedInHalos.Points.size() != 3 * (haloIds.size() - 1))
+  {
+    vtkLogF(ERROR, "Expected %d reference particles in halos, got %d.",
+      static_cast<int>(haloIds.size() - 1), static_cast<int>(expectedInHalos.Points.size() / 3));
+    return EXIT_FAILURE;
+  }
+  Particles actualInHalos;
+  if (!AppendParticles(reader->GetOutput(), nullptr, actualInHalos))
+  {
+    vtkLogF(ERROR, "Invalid particles in halos.");
+    return EXIT_FAILURE;
+  }
+  return CompareParticles(expectedInHalos, actualInHalos, hasBlockCoords, "particles in halos");
+}
+}
+
+int TestPGenericIOReader(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize();
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  int retVal = runGenericIOReaderTest(argc, argv);
+
+  controller->Finalize();
+  return retVal;
+}
@@ -46,44 +46,34 @@ MPI_Comm GetMPICommunicator(vtkMultiProcessController* mpc)
 }
 
 //==============================================================================
-vtkDataArray* GetVtkDataArray(std::string name, int type, void* rawBuffer, int N)
+vtkDataArray* NewVtkDataArray(const std::string& name, int type, vtkIdType N)
 {
-  assert("pre: cannot read from nullptr buffer!" && (rawBuffer != nullptr));
   vtkDataArray* dataArray = nullptr;
-  size_t dataSize = 0;
-
   switch (type)
   {
     case gio::GENERIC_IO_INT32_TYPE:
       dataArray = vtkDataArray::CreateDataArray(VTK_TYPE_INT32);
-      dataSize = sizeof(vtkTypeInt32);
       break;
     case gio::GENERIC_IO_INT64_TYPE:
       dataArray = vtkDataArray::CreateDataArray(VTK_TYPE_INT64);
       // i.e., don't run this on windows
       assert(sizeof(vtkTypeInt64) == sizeof(uint64_t));
-      dataSize = sizeof(vtkTypeInt64);
       break;
     case gio::GENERIC_IO_UINT32_TYPE:
       dataArray = vtkDataArray::CreateDataArray(VTK_TYPE_UINT32);
-      dataSize = sizeof(vtkTypeUInt32);
       break;
     case gio::GENERIC_IO_UINT64_TYPE:
       dataArray = vtkDataArray::CreateDataArray(VTK_TYPE_UINT64);
       // i.e., don't run this on windows
       assert(sizeof(vtkTypeUInt64) == sizeof(uint64_t));
-      dataSize = sizeof(vtkTypeUInt64);
       break;
     case gio::GENERIC_IO_DOUBLE_TYPE:
       dataArray = vtkDataArray::CreateDataArray(VTK_DOUBLE);
-      dataSize = sizeof(double);
       break;
     case gio::GENERIC_IO_FLOAT_TYPE:
       dataArray = vtkDataArray::CreateDataArray(VTK_FLOAT);
-      dataSize = sizeof(float);
       break;
     default:
-      dataSize = 0;
       return nullptr;
   } // END switch
 
@@ -92,11 +82,19 @@ vtkDataArray* GetVtkDataArray(std::string name, int type, void* rawBuffer, int N
   dataArray->SetNumberOfComponents(1);
   dataArray->SetNumberOfTuples(N);
   dataArray->SetName(name.c_str());
-  if (N > 0)
+  return (dataArray);
+}
+
+//==============================================================================
+vtkDataArray* GetVtkDataArray(std::string name, int type, void* rawBuffer, int N)
+{
+  assert("pre: cannot read from nullptr buffer!" && (rawBuffer != nullptr));
+  vtkDataArray* dataArray = NewVtkDataArray(name, type, N);
+  if (dataArray != nullptr && N > 0)
   {
     void* dataBuffer = dataArray->GetVoidPointer(0);
     assert("pre: encountered nullptr data buffer!" && (dataBuffer != nullptr));
-    memcpy(dataBuffer, rawBuffer, N * dataSize);
+    memcpy(dataBuffer, rawBuffer, N * dataArray->GetDataTypeSize());
   }
   return (dataArray);
 }
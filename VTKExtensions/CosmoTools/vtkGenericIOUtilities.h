@@ -75,6 +75,15 @@ inline std::string& trim(std::string& s)
  */
 MPI_Comm GetMPICommunicator(vtkMultiProcessController* mpc);
 
+//==============================================================================
+/**
+ * This method creates a single-component vtkDataArray of the VTK type that
+ * matches the given GenericIO type, with N tuples. GenericIO can read a
+ * variable directly into the storage of the array, see
+ * vtkDataArray::GetVoidPointer(). Returns nullptr for unsupported types.
+ */
+vtkDataArray* NewVtkDataArray(const std::string& name, int type, vtkIdType N);
+
 //==============================================================================
 /**
  * This method parses the data in the rawbuffer and reads it into a vtkDataArray
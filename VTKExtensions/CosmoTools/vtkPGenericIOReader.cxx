@@ -13,15 +13,19 @@
 #include "vtkDataArraySelection.h"
 #include "vtkDataObject.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMPI.h"
 #include "vtkMPICommunicator.h"
 #include "vtkMPIController.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -39,8 +43,11 @@
 
 // C/C++ includes
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
+#include <memory>
+#include <numeric>
 #include <set>
 #include <stdexcept>
 #include <vector>
@@ -58,6 +65,19 @@ public:
   std::map<std::string, bool> VariableStatus;
   std::map<std::string, void*> RawCache;
   MPI_Comm MPICommunicator;
+
+  // Arrays GenericIO reads each variable into, RawCache points to their
+  // storage. The coordinate variables share the structure-of-arrays
+  // Coordinates array, one component per variable.
+  std::map<std::string, vtkSmartPointer<vtkDataArray>> Arrays;
+  vtkSmartPointer<vtkDataArray> Coordinates;
+  std::string CoordinateNames[3];
+
+  // Storage given to GenericIO for variables without elements on this rank.
+  vtkTypeUInt64 EmptyBuffer = 0;
+
+  // Variables given to GenericIO since the last read.
+  std::vector<std::string> PendingVariables;
   std::set<int> RanksToLoad;
 
   /**
@@ -122,13 +142,14 @@ public:
     this->VariableStatus.clear();
     this->Information.clear();
     this->RanksToLoad.clear();
-
-    std::map<std::string, void*>::iterator iter;
-    for (iter = this->RawCache.begin(); iter != this->RawCache.end(); ++iter)
-    {
-      delete[] static_cast<char*>(iter->second);
-    } // END for
     this->RawCache.clear();
+    this->PendingVariables.clear();
+    this->Arrays.clear();
+    this->Coordinates = nullptr;
+    for (int i = 0; i < 3; ++i)
+    {
+      this->CoordinateNames[i].clear();
+    }
   }
 };
 
@@ -492,11 +513,24 @@ void vtkPGenericIOReader::LoadRawVariableData(std::string varName)
     return;
   }
 
-  this->MetaData->RawCache[varName] = gio::GenericIOUtilities::AllocateVariableArray(
-    this->MetaData->Information[varName], this->MetaData->NumberOfElements);
+  // GenericIO reads the variable directly into the array that is later added to
+  // the output, so that the data is not copied.
+  vtkSmartPointer<vtkDataArray> array;
+  array.TakeReference(vtkGenericIOUtilities::NewVtkDataArray(varName,
+    this->MetaData->VariableGenericIOType[varName], this->MetaData->NumberOfElements));
+  if (array == nullptr)
+  {
+    vtkErrorMacro(<< "Variable " << varName << " has an unsupported type!");
+    return;
+  }
+  this->MetaData->Arrays[varName] = array;
+  this->MetaData->RawCache[varName] = (this->MetaData->NumberOfElements > 0)
+    ? array->GetVoidPointer(0)
+    : &this->MetaData->EmptyBuffer;
 
   this->Reader->AddVariable(
     this->MetaData->Information[varName], this->MetaData->RawCache[varName]);
+  this->MetaData->PendingVariables.push_back(varName);
 
   this->MetaData->VariableStatus[varName] = true;
 
@@ -506,6 +540,76 @@ void vtkPGenericIOReader::LoadRawVariableData(std::string varName)
 #endif
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+template <typename T>
+vtkDataArray* NewCoordinates(vtkIdType numberOfPoints, void* components[3])
+{
+  vtkSOADataArrayTemplate<T>* coordinates = vtkSOADataArrayTemplate<T>::New();
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(numberOfPoints);
+  for (int i = 0; i < 3; ++i)
+  {
+    components[i] = coordinates->GetComponentArrayPointer(i);
+  }
+  return coordinates;
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkPGenericIOReader::LoadRawCoordinates(
+  const std::string& xaxis, const std::string& yaxis, const std::string& zaxis)
+{
+  const std::string names[3] = { xaxis, yaxis, zaxis };
+  if (this->MetaData->Coordinates != nullptr && this->MetaData->CoordinateNames[0] == xaxis &&
+    this->MetaData->CoordinateNames[1] == yaxis && this->MetaData->CoordinateNames[2] == zaxis)
+  {
+    // coordinates have already been loaded
+    return;
+  }
+
+  const int type =
+    this->MetaData->HasVariable(xaxis) ? this->MetaData->VariableGenericIOType[xaxis] : -1;
+  bool soa = (type == gio::GENERIC_IO_FLOAT_TYPE || type == gio::GENERIC_IO_DOUBLE_TYPE) &&
+    (xaxis != yaxis) && (yaxis != zaxis) && (xaxis != zaxis);
+  for (int i = 1; soa && i < 3; ++i)
+  {
+    soa = this->MetaData->HasVariable(names[i]) &&
+      (this->MetaData->VariableGenericIOType[names[i]] == type);
+  }
+  if (!soa)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->LoadRawVariableData(names[i]);
+    }
+    return;
+  }
+
+  void* components[3];
+  vtkSmartPointer<vtkDataArray> coordinates;
+  coordinates.TakeReference((type == gio::GENERIC_IO_FLOAT_TYPE)
+      ? NewCoordinates<float>(this->MetaData->NumberOfElements, components)
+      : NewCoordinates<double>(this->MetaData->NumberOfElements, components));
+  coordinates->SetName("Points");
+
+  for (int i = 0; i < 3; ++i)
+  {
+    // variables read before for other arrays are read again into the
+    // coordinates, the arrays they were read into are released.
+    this->MetaData->Arrays[names[i]] = coordinates;
+    this->MetaData->RawCache[names[i]] =
+      (this->MetaData->NumberOfElements > 0) ? components[i] : &this->MetaData->EmptyBuffer;
+    this->Reader->AddVariable(
+      this->MetaData->Information[names[i]], this->MetaData->RawCache[names[i]]);
+    this->MetaData->PendingVariables.push_back(names[i]);
+    this->MetaData->VariableStatus[names[i]] = true;
+    this->MetaData->CoordinateNames[i] = names[i];
+  }
+  this->MetaData->Coordinates = coordinates;
+}
+
 //------------------------------------------------------------------------------
 void vtkPGenericIOReader::LoadRawData()
 {
@@ -520,9 +624,7 @@ void vtkPGenericIOReader::LoadRawData()
   std::string zaxis = std::string(this->ZAxisVariableName);
   zaxis = vtkGenericIOUtilities::trim(zaxis);
 
-  this->LoadRawVariableData(xaxis);
-  this->LoadRawVariableData(yaxis);
-  this->LoadRawVariableData(zaxis);
+  this->LoadRawCoordinates(xaxis, yaxis, zaxis);
 
   if (this->HaloList->GetNumberOfIds() > 0)
   {
@@ -567,7 +669,7 @@ void vtkPGenericIOReader::LoadRawData()
   std::cout << "\t[INFO]: Reading data...";
 #endif
 
-  this->Reader->ReadData();
+  this->ReadRawData();
 
 #ifdef DEBUG
   std::cout << "[DONE]\n";
@@ -575,6 +677,93 @@ void vtkPGenericIOReader::LoadRawData()
 #endif
 }
 
+//------------------------------------------------------------------------------
+void vtkPGenericIOReader::ReadRawData()
+{
+  const int numBlocks = static_cast<int>(this->Reader->GetNumberOfAssignedBlocks());
+  const int numWorkers = std::min(vtkSMPTools::GetEstimatedNumberOfThreads(), numBlocks);
+  std::vector<std::string> variables;
+  variables.swap(this->MetaData->PendingVariables);
+
+  // MPI-IO reads are collective, so only POSIX reads are split across threads.
+  if (this->GenericIOType != IOTYPEPOSIX || numWorkers < 2 || variables.empty())
+  {
+    this->Reader->ReadData();
+    return;
+  }
+
+  // GenericIO reads the assigned blocks one after the other into the
+  // variable buffers, find where each of them starts.
+  std::vector<uint64_t> blockStarts(numBlocks + 1, 0);
+  std::vector<int> blockIds(numBlocks);
+  for (int i = 0; i < numBlocks; ++i)
+  {
+    blockIds[i] = static_cast<int>(this->Reader->GetBlockHeader(i).GlobalRank);
+    blockStarts[i + 1] = blockStarts[i] + this->Reader->GetNumberOfElementsInBlock(i);
+  }
+  if (blockStarts.back() != static_cast<uint64_t>(this->MetaData->NumberOfElements))
+  {
+    vtkWarningMacro(<< "Block headers do not add up to the number of elements, "
+                    << "reading the blocks serially.");
+    this->Reader->ReadData();
+    return;
+  }
+
+  // Each worker has its own reader, hence its own file handle, and reads
+  // (and checks the CRC of) every numWorkers-th block with ReadBlock(). The
+  // workers own all blocks of the file since they are opened on
+  // MPI_COMM_SELF, so they are given the global block ids.
+  std::vector<std::unique_ptr<gio::GenericIOReader>> workers(numWorkers);
+  for (auto& worker : workers)
+  {
+    worker.reset(vtkGenericIOUtilities::GetReader(
+      MPI_COMM_SELF, true, gio::RR_BLOCK_ASSIGNMENT, std::string(this->FileName)));
+    worker->OpenAndReadHeader();
+  }
+
+  // the metadata maps are not touched from the workers.
+  std::vector<gio::VariableInfo*> infos;
+  std::vector<char*> buffers;
+  for (const std::string& name : variables)
+  {
+    infos.push_back(&this->MetaData->Information[name]);
+    buffers.push_back(static_cast<char*>(this->MetaData->RawCache[name]));
+  }
+
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, numWorkers, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType w = begin; w < end; ++w)
+    {
+      gio::GenericIOReader* worker = workers[w].get();
+      try
+      {
+        for (int block = static_cast<int>(w); block < numBlocks; block += numWorkers)
+        {
+          worker->ClearVariables();
+          for (size_t i = 0; i < infos.size(); ++i)
+          {
+            worker->AddVariable(*infos[i], buffers[i] + blockStarts[block] * infos[i]->Size);
+          }
+          worker->ReadBlock(blockIds[block]);
+        }
+      }
+      catch (const std::exception&)
+      {
+        failed = true;
+      }
+    }
+  });
+
+  for (auto& worker : workers)
+  {
+    worker->Close();
+  }
+  if (failed)
+  {
+    vtkErrorMacro(<< "Failed to read the blocks of " << this->FileName);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkPGenericIOReader::GetPointFromRawData(int xType, void* xBuffer, int yType, void* yBuffer,
   int zType, void* zBuffer, vtkIdType idx, double pnt[3])
@@ -593,7 +782,7 @@ void vtkPGenericIOReader::GetPointFromRawData(int xType, void* xBuffer, int yTyp
 
 //------------------------------------------------------------------------------
 void vtkPGenericIOReader::LoadCoordinates(
-  vtkUnstructuredGrid* grid, std::set<vtkIdType>& pointsInSelectedHalos)
+  vtkUnstructuredGrid* grid, std::vector<vtkIdType>& pointsInSelectedHalos)
 {
   assert("pre: grid is nullptr!" && (grid != nullptr));
 
@@ -626,24 +815,31 @@ void vtkPGenericIOReader::LoadCoordinates(
   int zType = this->MetaData->VariableGenericIOType[zaxis];
   void* zBuffer = this->MetaData->RawCache[zaxis];
 
-  vtkCellArray* cells = vtkCellArray::New();
-  cells->Allocate(cells->EstimateSize(this->MetaData->NumberOfElements, 1));
-
   vtkPoints* pnts = vtkPoints::New();
-  pnts->SetDataTypeToDouble();
-  pnts->SetNumberOfPoints(this->MetaData->NumberOfElements);
 
-  int nparticles = this->MetaData->NumberOfElements;
-  double pnt[3];
-  vtkIdType idx = 0;
+  vtkIdType nparticles = this->MetaData->NumberOfElements;
   if (this->HaloList->GetNumberOfIds() == 0)
   {
-    for (; idx < nparticles; ++idx)
+    if (this->MetaData->Coordinates != nullptr && this->MetaData->CoordinateNames[0] == xaxis &&
+      this->MetaData->CoordinateNames[1] == yaxis && this->MetaData->CoordinateNames[2] == zaxis)
+    {
+      // the coordinates were read directly into the points, see
+      // LoadRawCoordinates().
+      pnts->SetData(this->MetaData->Coordinates);
+    }
+    else
     {
-      this->GetPointFromRawData(xType, xBuffer, yType, yBuffer, zType, zBuffer, idx, pnt);
-      pnts->SetPoint(idx, pnt);
-      cells->InsertNextCell(1, &idx);
-    } // END for all points
+      pnts->SetDataTypeToDouble();
+      pnts->SetNumberOfPoints(nparticles);
+      double* coords = static_cast<double*>(pnts->GetVoidPointer(0));
+      vtkSMPTools::For(0, nparticles, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType idx = begin; idx < end; ++idx)
+        {
+          this->GetPointFromRawData(
+            xType, xBuffer, yType, yBuffer, zType, zBuffer, idx, coords + 3 * idx);
+        }
+      });
+    }
   }
   else
   {
@@ -651,32 +847,52 @@ void vtkPGenericIOReader::LoadCoordinates(
     haloVarName = vtkGenericIOUtilities::trim(haloVarName);
     int haloType = this->MetaData->VariableGenericIOType[haloVarName];
     void* haloBuffer = this->MetaData->RawCache[haloVarName];
-    vtkIdType numPointsSoFar = 0;
-    for (; idx < nparticles; ++idx)
-    {
-      vtkIdType haloId = vtkGenericIOUtilities::GetIdFromRawBuffer(haloType, haloBuffer, idx);
-      bool isInRequestedHalo = false;
-      for (vtkIdType j = 0; j < this->GetNumberOfRequestedHaloIds(); ++j)
+
+    std::vector<vtkIdType> haloIds(this->HaloList->GetPointer(0),
+      this->HaloList->GetPointer(0) + this->HaloList->GetNumberOfIds());
+    std::sort(haloIds.begin(), haloIds.end());
+    std::vector<unsigned char> isInRequestedHalo(nparticles);
+    vtkSMPTools::For(0, nparticles, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType idx = begin; idx < end; ++idx)
       {
-        if (haloId == this->HaloList->GetId(j))
-        {
-          isInRequestedHalo = true;
-          pointsInSelectedHalos.insert(idx);
-          break;
-        }
+        vtkIdType haloId = vtkGenericIOUtilities::GetIdFromRawBuffer(haloType, haloBuffer, idx);
+        isInRequestedHalo[idx] = std::binary_search(haloIds.begin(), haloIds.end(), haloId);
       }
-      if (isInRequestedHalo)
+    });
+
+    pointsInSelectedHalos.clear();
+    for (vtkIdType idx = 0; idx < nparticles; ++idx)
+    {
+      if (isInRequestedHalo[idx])
       {
-        this->GetPointFromRawData(xType, xBuffer, yType, yBuffer, zType, zBuffer, idx, pnt);
-        pnts->SetPoint(numPointsSoFar, pnt);
-        cells->InsertNextCell(1, &numPointsSoFar);
-        ++numPointsSoFar;
+        pointsInSelectedHalos.push_back(idx);
       }
     }
-    // set the number of points correctly
-    pnts->SetNumberOfPoints(numPointsSoFar);
+
+    const vtkIdType numPoints = static_cast<vtkIdType>(pointsInSelectedHalos.size());
+    pnts->SetDataTypeToDouble();
+    pnts->SetNumberOfPoints(numPoints);
+    double* coords = static_cast<double*>(pnts->GetVoidPointer(0));
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        this->GetPointFromRawData(xType, xBuffer, yType, yBuffer, zType, zBuffer,
+          pointsInSelectedHalos[idx], coords + 3 * idx);
+      }
+    });
   }
 
+  // one vertex per point.
+  const vtkIdType numPoints = pnts->GetNumberOfPoints();
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfTuples(numPoints + 1);
+  std::iota(offsets->GetPointer(0), offsets->GetPointer(0) + numPoints + 1, 0);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples(numPoints);
+  std::iota(connectivity->GetPointer(0), connectivity->GetPointer(0) + numPoints, 0);
+  vtkCellArray* cells = vtkCellArray::New();
+  cells->SetData(offsets, connectivity);
+
   grid->SetPoints(pnts);
   pnts->Delete();
 
@@ -690,21 +906,25 @@ namespace
 {
 template <typename T>
 void GetOnlyDataInHalo(
-  vtkDataArray* allData, vtkDataArray* haloData, std::set<vtkIdType> pointsInHalo)
+  vtkDataArray* allData, vtkDataArray* haloData, const std::vector<vtkIdType>& pointsInHalo)
 {
-  T* data = (T*)allData->GetVoidPointer(0);
-  T* filteredData = (T*)haloData->GetVoidPointer(0);
-  vtkIdType i = 0;
-  for (std::set<vtkIdType>::iterator itr = pointsInHalo.begin(); itr != pointsInHalo.end(); ++itr)
-  {
-    filteredData[i++] = data[*itr];
-  }
+  const T* data = static_cast<T*>(allData->GetVoidPointer(0));
+  T* filteredData = static_cast<T*>(haloData->GetVoidPointer(0));
+  const int numComps = allData->GetNumberOfComponents();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pointsInHalo.size()),
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        std::copy(data + pointsInHalo[i] * numComps, data + (pointsInHalo[i] + 1) * numComps,
+          filteredData + i * numComps);
+      }
+    });
 }
 }
 
 //------------------------------------------------------------------------------
 void vtkPGenericIOReader::LoadData(
-  vtkUnstructuredGrid* grid, const std::set<vtkIdType>& pointsInSelectedHalos)
+  vtkUnstructuredGrid* grid, const std::vector<vtkIdType>& pointsInSelectedHalos)
 {
   assert("pre: grid is nullptr!" && (grid != nullptr));
 
@@ -722,10 +942,20 @@ void vtkPGenericIOReader::LoadData(
     if (this->PointDataArraySelection->ArrayIsEnabled(name))
     {
       std::string varName = std::string(name);
-      vtkSmartPointer<vtkDataArray> dataArray;
-      dataArray.TakeReference(vtkGenericIOUtilities::GetVtkDataArray(varName,
-        this->MetaData->VariableGenericIOType[varName], this->MetaData->RawCache[varName],
-        this->MetaData->NumberOfElements));
+      auto iter = this->MetaData->Arrays.find(varName);
+      if (iter == this->MetaData->Arrays.end() || iter->second == nullptr)
+      {
+        continue; // unsupported variable type, reported when loading it.
+      }
+      // the array GenericIO read the variable into is used as is, unless the
+      // variable was read into the coordinates.
+      vtkSmartPointer<vtkDataArray> dataArray = iter->second;
+      if (dataArray->GetNumberOfComponents() != 1)
+      {
+        dataArray.TakeReference(vtkGenericIOUtilities::GetVtkDataArray(varName,
+          this->MetaData->VariableGenericIOType[varName], this->MetaData->RawCache[varName],
+          this->MetaData->NumberOfElements));
+      }
       if (this->HaloList->GetNumberOfIds() != 0)
       {
         vtkSmartPointer<vtkDataArray> onlyDataInHalo;
@@ -749,21 +979,36 @@ void vtkPGenericIOReader::LoadData(
     dataArray->SetNumberOfComponents(3);
     dataArray->SetNumberOfTuples(this->MetaData->NumberOfElements);
     dataArray->SetName("gio_block_indices");
-    int nextBlockIdx = 0;
-    int nextBlockStart = 0;
-    unsigned long long coords[3];
+
+    // the blocks are queried first since the reader is not thread-safe.
+    std::vector<vtkIdType> blockStarts(1, 0);
+    std::vector<vtkTypeUInt64> blockCoords;
     // since the compiler can't tell if they're the same....
-    assert(sizeof(unsigned long long) == sizeof(uint64_t));
-    for (int i = 0; i < this->MetaData->NumberOfElements; ++i)
+    assert(sizeof(vtkTypeUInt64) == sizeof(uint64_t));
+    const int numBlocks = static_cast<int>(this->Reader->GetNumberOfAssignedBlocks());
+    for (int blockIdx = 0;
+         blockIdx < numBlocks && blockStarts.back() < this->MetaData->NumberOfElements; ++blockIdx)
     {
-      if (i == nextBlockStart)
-      {
-        this->Reader->GetBlockCoords(nextBlockIdx, (uint64_t*)coords);
-        nextBlockStart += this->Reader->GetNumberOfElementsInBlock(nextBlockIdx);
-        ++nextBlockIdx;
-      }
-      dataArray->SetTypedTuple(i, coords);
+      vtkTypeUInt64 coords[3];
+      this->Reader->GetBlockCoords(blockIdx, (uint64_t*)coords);
+      blockCoords.insert(blockCoords.end(), coords, coords + 3);
+      blockStarts.push_back(
+        blockStarts.back() + this->Reader->GetNumberOfElementsInBlock(blockIdx));
     }
+    vtkTypeUInt64* indices = dataArray->GetPointer(0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blockCoords.size() / 3),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType blockIdx = begin; blockIdx < end; ++blockIdx)
+        {
+          const vtkIdType last =
+            std::min<vtkIdType>(blockStarts[blockIdx + 1], this->MetaData->NumberOfElements);
+          for (vtkIdType i = blockStarts[blockIdx]; i < last; ++i)
+          {
+            std::copy(&blockCoords[3 * blockIdx], &blockCoords[3 * blockIdx] + 3, indices + 3 * i);
+          }
+        }
+      });
+
     if (this->HaloList->GetNumberOfIds() != 0)
     {
       vtkSmartPointer<vtkTypeUInt64Array> onlyDataInHalo;
@@ -771,14 +1016,7 @@ void vtkPGenericIOReader::LoadData(
       onlyDataInHalo->SetNumberOfComponents(3);
       onlyDataInHalo->SetNumberOfTuples(grid->GetNumberOfPoints());
       onlyDataInHalo->SetName(dataArray->GetName());
-      vtkIdType i = 0;
-      for (std::set<vtkIdType>::iterator itr = pointsInSelectedHalos.begin();
-           itr != pointsInSelectedHalos.end(); ++itr, ++i)
-      {
-        vtkTypeUInt64 data[3];
-        dataArray->GetTypedTuple(*itr, data);
-        onlyDataInHalo->SetTypedTuple(i, data);
-      }
+      GetOnlyDataInHalo<vtkTypeUInt64>(dataArray, onlyDataInHalo, pointsInSelectedHalos);
       dataArray = onlyDataInHalo;
     }
 
@@ -901,7 +1139,7 @@ int vtkPGenericIOReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
   assert("pre: output grid is nullptr!" && (output != nullptr));
-  std::set<vtkIdType> pointsInSelectedHalos;
+  std::vector<vtkIdType> pointsInSelectedHalos;
 
   // STEP 1: Load raw data
   this->LoadRawData();
@@ -916,5 +1154,6 @@ int vtkPGenericIOReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   // STEP 4: Clear variables
   this->Reader->ClearVariables();
+  this->MetaData->PendingVariables.clear();
   return 1;
 }
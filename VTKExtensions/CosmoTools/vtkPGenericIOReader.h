@@ -15,7 +15,8 @@
 #include "vtkPVVTKExtensionsCosmoToolsModule.h" // For export macro
 #include "vtkUnstructuredGridAlgorithm.h"
 
-#include <set> // for std::set in protected methods
+#include <string> // for std::string in protected methods
+#include <vector> // for std::vector in protected methods
 
 // Forward Declarations
 class vtkCallbackCommand;
@@ -273,20 +274,40 @@ protected:
    */
   void LoadRawVariableData(std::string varName);
 
+  /**
+   * Loads the variables with the given names as the components of a
+   * structure-of-arrays point array, so that GenericIO reads the coordinates
+   * directly into the points without interleaving them. Falls back to
+   * LoadRawVariableData() if the variables are not distinct or do not share a
+   * floating point type.
+   */
+  void LoadRawCoordinates(
+    const std::string& xaxis, const std::string& yaxis, const std::string& zaxis);
+
   /**
    * Loads the Raw data
    */
   void LoadRawData();
 
   /**
-   * Loads the particle coordinates
+   * Reads the variables given to GenericIO since the last read. With POSIX
+   * I/O, the blocks assigned to this rank are read concurrently by a pool of
+   * readers, one file handle each, so that reading and CRC checks of
+   * different blocks overlap.
+   */
+  void ReadRawData();
+
+  /**
+   * Loads the particle coordinates. When halos are requested, the sorted
+   * indices of the particles in those halos are returned in
+   * pointsInSelectedHalos.
    */
-  void LoadCoordinates(vtkUnstructuredGrid* grid, std::set<vtkIdType>& pointsInSelectedHalos);
+  void LoadCoordinates(vtkUnstructuredGrid* grid, std::vector<vtkIdType>& pointsInSelectedHalos);
 
   /**
    * Loads the particle data arrays
    */
-  void LoadData(vtkUnstructuredGrid* grid, const std::set<vtkIdType>& pointsInSelectedHalos);
+  void LoadData(vtkUnstructuredGrid* grid, const std::vector<vtkIdType>& pointsInSelectedHalos);
 
   /**
    * Finds the neighbors of the user-supplied rank
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that labelling the blocks of an AMR dataset concurrently (EnableSMP)
+// finds the same fragments, with the same volumes and surfaces, as labelling
+// them serially.
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDummyController.h"
+#include "vtkLogger.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr int BlockSize = 8;
+constexpr int NumBlocks = 3;
+
+// Spheres of material: one crossing many blocks, one across a block edge
+// and two inside a single block.
+const double Spheres[][4] = { { 12.0, 12.0, 12.0, 6.5 }, { 16.0, 16.0, 4.0, 3.0 },
+  { 4.0, 4.0, 4.0, 2.0 }, { 20.0, 4.0, 20.0, 2.5 } };
+
+unsigned char MaterialFraction(double x, double y, double z)
+{
+  double fraction = 0.0;
+  for (const auto& sphere : Spheres)
+  {
+    const double dx = x - sphere[0];
+    const double dy = y - sphere[1];
+    const double dz = z - sphere[2];
+    const double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+    fraction = std::max(fraction, std::min(1.0, std::max(0.0, sphere[3] - dist)));
+  }
+  return static_cast<unsigned char>(255.0 * fraction);
+}
+
+// A single level of NumBlocks^3 blocks of BlockSize^3 cells with unit spacing,
+// without ghost cells, with the "Material" fraction of each cell center.
+vtkSmartPointer<vtkNonOverlappingAMR> CreateAMR()
+{
+  const int blocksPerLevel[1] = { NumBlocks * NumBlocks * NumBlocks };
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(1, blocksPerLevel);
+  amr->SetGridDescription(VTK_XYZ_GRID);
+
+  unsigned int blockId = 0;
+  for (int bz = 0; bz < NumBlocks; ++bz)
+  {
+    for (int by = 0; by < NumBlocks; ++by)
+    {
+      for (int bx = 0; bx < NumBlocks; ++bx)
+      {
+        const int first[3] = { bx * BlockSize, by * BlockSize, bz * BlockSize };
+        vtkNew<vtkUniformGrid> grid;
+        grid->SetDimensions(BlockSize + 1, BlockSize + 1, BlockSize + 1);
+        grid->SetOrigin(first[0], first[1], first[2]);
+        grid->SetSpacing(1.0, 1.0, 1.0);
+
+        vtkNew<vtkUnsignedCharArray> array;
+        array->SetName("Material");
+        array->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkIdType cellId = 0;
+        for (int z = 0; z < BlockSize; ++z)
+        {
+          for (int y = 0; y < BlockSize; ++y)
+          {
+            for (int x = 0; x < BlockSize; ++x)
+            {
+              array->SetValue(cellId++,
+                MaterialFraction(first[0] + x + 0.5, first[1] + y + 0.5, first[2] + z + 0.5));
+            }
+          }
+        }
+        grid->GetCellData()->AddArray(array);
+        amr->SetDataSet(0, blockId++, grid);
+      }
+    }
+  }
+  return amr;
+}
+
+struct Fragments
+{
+  std::vector<double> Volumes;
+  vtkIdType NumberOfFaces = 0;
+};
+
+Fragments GetFragments(vtkMaterialInterfaceFilter* filter)
+{
+  Fragments fragments;
+  vtkPolyData* centers = vtkPolyData::SafeDownCast(filter->GetOutput(1)->GetBlock(0));
+  vtkDataArray* volumes = centers ? centers->GetPointData()->GetArray("Volume") : nullptr;
+  for (vtkIdType ii = 0; volumes && ii < volumes->GetNumberOfTuples(); ++ii)
+  {
+    fragments.Volumes.push_back(volumes->GetTuple1(ii));
+  }
+  std::sort(fragments.Volumes.begin(), fragments.Volumes.end());
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(filter->GetOutput(0)->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (vtkPolyData* mesh = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      fragments.NumberOfFaces += mesh->GetNumberOfPolys();
+    }
+  }
+  return fragments;
+}
+}
+
+int TestMaterialInterfaceFilterSMP(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkNonOverlappingAMR> amr = CreateAMR();
+  Fragments fragments[2];
+  for (int smp = 0; smp < 2; ++smp)
+  {
+    vtkNew<vtkMaterialInterfaceFilter> filter;
+    filter->SetInputData(amr);
+    filter->SelectMaterialArray("Material");
+    filter->SetMaterialFractionThreshold(0.5);
+    filter->SetEnableSMP(smp != 0);
+    filter->Update();
+    fragments[smp] = GetFragments(filter);
+  }
+  vtkMultiProcessController::SetGlobalController(nullptr);
+
+  const size_t numFragments = sizeof(Spheres) / sizeof(Spheres[0]);
+  for (int smp = 0; smp < 2; ++smp)
+  {
+    if (fragments[smp].Volumes.size() != numFragments)
+    {
+      vtkLogF(ERROR, "Expected %d fragments %s, got %d.", static_cast<int>(numFragments),
+        smp ? "with SMP" : "serially", static_cast<int>(fragments[smp].Volumes.size()));
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t ii = 0; ii < numFragments; ++ii)
+  {
+    const double serial = fragments[0].Volumes[ii];
+    const double smp = fragments[1].Volumes[ii];
+    if (std::abs(serial - smp) > 1e-9 * serial)
+    {
+      vtkLogF(ERROR, "Fragment volumes differ: %g serial, %g SMP.", serial, smp);
+      return EXIT_FAILURE;
+    }
+  }
+  if (fragments[0].NumberOfFaces == 0)
+  {
+    vtkLogF(ERROR, "No fragment surface.");
+    return EXIT_FAILURE;
+  }
+  if (fragments[0].NumberOfFaces != fragments[1].NumberOfFaces)
+  {
+    vtkLogF(ERROR, "Fragment surfaces differ: %lld faces serially, %lld with SMP.",
+      static_cast<long long>(fragments[0].NumberOfFaces),
+      static_cast<long long>(fragments[1].NumberOfFaces));
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -9,6 +9,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -530,6 +531,9 @@ public:
   int* GetBaseFragmentIdPointer();
   int GetBaseFlatIndex();
   int* GetFragmentIdPointer() { return this->FragmentIds; }
+  // Add an offset to the fragment ids assigned so far.
+  // Only for normal (local) blocks.
+  void ShiftFragmentIds(int offset);
   int GetLevel() { return this->Level; }
   double* GetSpacing() { return this->Spacing; }
   double* GetOrigin() { return this->Origin; }
@@ -682,6 +686,19 @@ vtkMaterialInterfaceFilterBlock::~vtkMaterialInterfaceFilterBlock()
   this->NToSum = 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilterBlock::ShiftFragmentIds(int offset)
+{
+  vtkIdType numCells = this->Image->GetNumberOfCells();
+  for (vtkIdType ii = 0; ii < numCells; ++ii)
+  {
+    if (this->FragmentIds[ii] != -1)
+    {
+      this->FragmentIds[ii] += offset;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilterBlock::InitializeVolumeFractionArray(int invertVolumeFraction,
   vtkMaterialInterfaceFilterHalfSphere* implicitFunction, vtkDataArray* volumeFractionArray)
@@ -1657,6 +1674,9 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
 
   // 1 Layer of ghost cell by block by default
   this->BlockGhostLevel = 1;
+
+  this->EnableSMP = false;
+  this->LabelledBlock = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -1881,18 +1901,12 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
     this->InputBlocks[blockId] = nullptr;
   }
 
-  // Initialize each block with the input image
-  // and global index coordinate system.
+  // Create a block for each input image.
   int blockIndex = -1;
-  this->Levels.resize(numLevels);
+  vector<vtkImageData*> images(this->NumberOfInputBlocks, nullptr);
+  vector<int> imageLevels(this->NumberOfInputBlocks, 0);
   for (level = 0; level < numLevels; ++level)
   {
-    this->Levels[level] = new vtkMaterialInterfaceLevel;
-
-    int cumulativeExt[6];
-    cumulativeExt[0] = cumulativeExt[2] = cumulativeExt[4] = VTK_INT_MAX;
-    cumulativeExt[1] = cumulativeExt[3] = cumulativeExt[5] = -VTK_INT_MAX;
-
     int numBlocks = input->GetNumberOfDataSets(level);
     for (int levelBlockId = 0; levelBlockId < numBlocks; ++levelBlockId)
     {
@@ -1904,43 +1918,81 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
       if (image)
       {
         block = this->InputBlocks[++blockIndex] = new vtkMaterialInterfaceFilterBlock;
-        // Do we really need the block to know its id?
-        // We use it to find neighbors.  We should save pointers
-        // directly in neighbor array. We also use it for debugging.
-        block->Initialize(blockIndex, image, level, this->GlobalOrigin, this->RootSpacing,
-          materialFractionArrayName, massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames,
-          summedArrayNames, integratedArrayNames, this->InvertVolumeFraction, sphere);
         // For debugging:
         block->LevelBlockId = levelBlockId;
+        images[blockIndex] = image;
+        imageLevels[blockIndex] = level;
+      }
+    }
+  }
 
-        // Collect information about the blocks in this level.
-        const int* ext;
-        ext = block->GetBaseCellExtent();
-        // We need the cumulative extent to determine the grid extent.
-        if (cumulativeExt[0] > ext[0])
-        {
-          cumulativeExt[0] = ext[0];
-        }
-        if (cumulativeExt[1] < ext[1])
-        {
-          cumulativeExt[1] = ext[1];
-        }
-        if (cumulativeExt[2] > ext[2])
-        {
-          cumulativeExt[2] = ext[2];
-        }
-        if (cumulativeExt[3] < ext[3])
-        {
-          cumulativeExt[3] = ext[3];
-        }
-        if (cumulativeExt[4] > ext[4])
-        {
-          cumulativeExt[4] = ext[4];
-        }
-        if (cumulativeExt[5] < ext[5])
-        {
-          cumulativeExt[5] = ext[5];
-        }
+  // Initialize each block with the input image
+  // and global index coordinate system.
+  // Blocks do not depend on each other yet, so this can run concurrently.
+  auto initializeBlocks = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      // Do we really need the block to know its id?
+      // We use it to find neighbors.  We should save pointers
+      // directly in neighbor array. We also use it for debugging.
+      this->InputBlocks[blockId]->Initialize(static_cast<int>(blockId), images[blockId],
+        imageLevels[blockId], this->GlobalOrigin, this->RootSpacing, materialFractionArrayName,
+        massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames, summedArrayNames,
+        integratedArrayNames, this->InvertVolumeFraction, sphere);
+    }
+  };
+  if (this->EnableSMP)
+  {
+    vtkSMPTools::For(0, blockIndex + 1, initializeBlocks);
+  }
+  else
+  {
+    initializeBlocks(0, blockIndex + 1);
+  }
+
+  this->Levels.resize(numLevels);
+  blockIndex = 0;
+  for (level = 0; level < numLevels; ++level)
+  {
+    this->Levels[level] = new vtkMaterialInterfaceLevel;
+
+    int cumulativeExt[6];
+    cumulativeExt[0] = cumulativeExt[2] = cumulativeExt[4] = VTK_INT_MAX;
+    cumulativeExt[1] = cumulativeExt[3] = cumulativeExt[5] = -VTK_INT_MAX;
+
+    // Blocks were created in level order.
+    for (; blockIndex < this->NumberOfInputBlocks && this->InputBlocks[blockIndex] &&
+         imageLevels[blockIndex] == level;
+         ++blockIndex)
+    {
+      block = this->InputBlocks[blockIndex];
+      // Collect information about the blocks in this level.
+      const int* ext;
+      ext = block->GetBaseCellExtent();
+      // We need the cumulative extent to determine the grid extent.
+      if (cumulativeExt[0] > ext[0])
+      {
+        cumulativeExt[0] = ext[0];
+      }
+      if (cumulativeExt[1] < ext[1])
+      {
+        cumulativeExt[1] = ext[1];
+      }
+      if (cumulativeExt[2] > ext[2])
+      {
+        cumulativeExt[2] = ext[2];
+      }
+      if (cumulativeExt[3] < ext[3])
+      {
+        cumulativeExt[3] = ext[3];
+      }
+      if (cumulativeExt[4] > ext[4])
+      {
+        cumulativeExt[4] = ext[4];
+      }
+      if (cumulativeExt[5] < ext[5])
+      {
+        cumulativeExt[5] = ext[5];
       }
     }
 
@@ -3566,11 +3618,19 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+    if (this->EnableSMP && this->NumberOfInputBlocks > 1)
     {
-      // build fragments
-      this->ProcessBlock(blockId);
+      // build fragments concurrently
+      this->ProcessBlocksSMP(hbdsInput, SummedArrayNames);
+    }
+    else
+    {
+      int blockId;
+      for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+      {
+        // build fragments
+        this->ProcessBlock(blockId);
+      }
     }
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
@@ -3723,8 +3783,11 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
                << this->MaterialId;
   this->SetProgressText(progressMesg.str().c_str());
 #endif
-  this->Progress += this->ProgressBlockInc;
-  this->UpdateProgress(this->Progress);
+  if (this->LabelledBlock == nullptr)
+  { // Workers labelling blocks concurrently do not report progress.
+    this->Progress += this->ProgressBlockInc;
+    this->UpdateProgress(this->Progress);
+  }
 
   vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
   if (block == nullptr)
@@ -3846,6 +3909,288 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Label the local blocks concurrently. Connectivity and surface extraction in
+// a worker stop at the faces of the block it is labelling, so a worker only
+// touches the cells of its own blocks. The fragments and the faces between
+// blocks are then stitched serially. Workers are merged in block order, so
+// the fragment ids do not depend on the number of threads.
+void vtkMaterialInterfaceFilter::ProcessBlocksSMP(
+  vtkNonOverlappingAMR* hbdsInput, vector<string>& summedArrayNames)
+{
+  const int numWorkers =
+    std::min(this->NumberOfInputBlocks, 4 * vtkSMPTools::GetEstimatedNumberOfThreads());
+  vector<vtkMaterialInterfaceFilter*> workers(numWorkers, nullptr);
+  vector<int> firstBlockIds(numWorkers + 1, 0);
+  for (int ii = 0; ii < numWorkers; ++ii)
+  {
+    firstBlockIds[ii + 1] = static_cast<int>(
+      static_cast<vtkIdType>(this->NumberOfInputBlocks) * (ii + 1) / numWorkers);
+
+    vtkMaterialInterfaceFilter* worker = vtkMaterialInterfaceFilter::New();
+    worker->Controller = this->Controller;
+    worker->MaterialId = this->MaterialId;
+    worker->MaterialFractionThreshold = this->MaterialFractionThreshold;
+    worker->scaledMaterialFractionThreshold = this->scaledMaterialFractionThreshold;
+    worker->ClipWithSphere = this->ClipWithSphere;
+    worker->ClipWithPlane = this->ClipWithPlane;
+    worker->ClipRadius = this->ClipRadius;
+    for (int q = 0; q < 3; ++q)
+    {
+      worker->ClipCenter[q] = this->ClipCenter[q];
+      worker->ClipPlaneVector[q] = this->ClipPlaneVector[q];
+      worker->ClipPlaneNormal[q] = this->ClipPlaneNormal[q];
+    }
+    worker->ComputeMoments = this->ComputeMoments;
+    worker->NVolumeWtdAvgs = this->NVolumeWtdAvgs;
+    worker->NMassWtdAvgs = this->NMassWtdAvgs;
+    worker->NToSum = this->NToSum;
+    worker->NToIntegrate = this->NToIntegrate;
+    worker->IntegratedArrayNames = this->IntegratedArrayNames;
+    worker->PrepareForPass(hbdsInput, this->VolumeWtdAvgArrayNames, this->MassWtdAvgArrayNames,
+      summedArrayNames, this->IntegratedArrayNames);
+    worker->EquivalenceSet->Initialize();
+    // The blocks are shared, they are released before deleting the worker.
+    worker->NumberOfInputBlocks = this->NumberOfInputBlocks;
+    worker->InputBlocks = this->InputBlocks;
+    workers[ii] = worker;
+  }
+
+  vtkSMPTools::For(0, numWorkers, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      vtkMaterialInterfaceFilter* worker = workers[ii];
+      for (int blockId = firstBlockIds[ii]; blockId < firstBlockIds[ii + 1]; ++blockId)
+      {
+        if (this->InputBlocks[blockId])
+        {
+          worker->LabelledBlock = this->InputBlocks[blockId];
+          worker->ProcessBlock(blockId);
+        }
+      }
+    }
+  });
+
+  vector<int> offsets(numWorkers, 0);
+  for (int ii = 0; ii < numWorkers; ++ii)
+  {
+    offsets[ii] = this->FragmentId;
+    this->MergeFragments(workers[ii]);
+    workers[ii]->InputBlocks = nullptr;
+    workers[ii]->NumberOfInputBlocks = 0;
+    workers[ii]->Delete();
+  }
+
+  vtkSMPTools::For(0, numWorkers, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      for (int blockId = firstBlockIds[ii]; offsets[ii] > 0 && blockId < firstBlockIds[ii + 1];
+           ++blockId)
+      {
+        if (this->InputBlocks[blockId])
+        {
+          this->InputBlocks[blockId]->ShiftFragmentIds(offsets[ii]);
+        }
+      }
+    }
+  });
+
+  this->Progress += this->ProgressBlockInc * this->NumberOfInputBlocks;
+  this->UpdateProgress(this->Progress);
+
+  // Now that all local cells are labelled, connect across block faces and
+  // make the surface between blocks.
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    this->StitchBlock(blockId);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilter::MergeFragments(vtkMaterialInterfaceFilter* worker)
+{
+  const int offset = this->FragmentId;
+  const int numFragments = worker->FragmentId;
+  if (numFragments == 0)
+  {
+    return;
+  }
+
+  // geometry, the meshes are now owned by this filter.
+  this->FragmentMeshes.insert(
+    this->FragmentMeshes.end(), worker->FragmentMeshes.begin(), worker->FragmentMeshes.end());
+  worker->FragmentMeshes.clear();
+
+  // integrated attributes
+  this->FragmentVolumes->InsertTuples(offset, numFragments, 0, worker->FragmentVolumes);
+  if (this->ClipWithPlane)
+  {
+    this->ClipDepthMaximums->InsertTuples(offset, numFragments, 0, worker->ClipDepthMaximums);
+    this->ClipDepthMinimums->InsertTuples(offset, numFragments, 0, worker->ClipDepthMinimums);
+  }
+  if (this->ComputeMoments)
+  {
+    this->FragmentMoments->InsertTuples(offset, numFragments, 0, worker->FragmentMoments);
+  }
+  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  {
+    this->FragmentVolumeWtdAvgs[i]->InsertTuples(
+      offset, numFragments, 0, worker->FragmentVolumeWtdAvgs[i]);
+  }
+  for (int i = 0; i < this->NMassWtdAvgs; ++i)
+  {
+    this->FragmentMassWtdAvgs[i]->InsertTuples(
+      offset, numFragments, 0, worker->FragmentMassWtdAvgs[i]);
+  }
+  for (int i = 0; i < this->NToSum; ++i)
+  {
+    this->FragmentSums[i]->InsertTuples(offset, numFragments, 0, worker->FragmentSums[i]);
+  }
+
+  // equivalences
+  for (int ii = 0; ii < numFragments; ++ii)
+  {
+    this->EquivalenceSet->AddEquivalence(
+      offset + ii, offset + worker->EquivalenceSet->GetEquivalentSetId(ii));
+  }
+
+  this->FragmentId += numFragments;
+}
+
+//----------------------------------------------------------------------------
+// Visit the neighbors of the cells on the faces of a block that were labelled
+// separately. This mirrors the neighbor search in ConnectFragment.
+void vtkMaterialInterfaceFilter::StitchBlock(int blockId)
+{
+  vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+  if (block == nullptr)
+  {
+    return;
+  }
+
+  // Connectivity into ghost cells uses the id of the fragment it comes from.
+  const int numberOfFragments = this->FragmentId;
+
+  vtkMaterialInterfaceFilterRingBuffer* queue = new vtkMaterialInterfaceFilterRingBuffer;
+  vtkMaterialInterfaceFilterIterator iterator;
+  vtkMaterialInterfaceFilterIterator next;
+  vtkMaterialInterfaceFilterIterator next2;
+  vtkMaterialInterfaceFilterIterator next3;
+  iterator.Block = block;
+
+  const int* ext = block->GetBaseCellExtent();
+  const int* incs = block->GetCellIncrements();
+  for (int iz = ext[4]; iz <= ext[5]; ++iz)
+  {
+    for (int iy = ext[2]; iy <= ext[3]; ++iy)
+    {
+      // Only the cells on the faces of the block can have neighbors in other blocks.
+      bool onFace = (iz == ext[4] || iz == ext[5] || iy == ext[2] || iy == ext[3]);
+      int xStep = (onFace || ext[1] == ext[0]) ? 1 : ext[1] - ext[0];
+      for (int ix = ext[0]; ix <= ext[1]; ix += xStep)
+      {
+        int offset = (ix - ext[0]) * incs[0] + (iy - ext[2]) * incs[1] + (iz - ext[4]) * incs[2];
+        iterator.Index[0] = ix;
+        iterator.Index[1] = iy;
+        iterator.Index[2] = iz;
+        iterator.VolumeFractionPointer = block->GetBaseVolumeFractionPointer() + offset;
+        iterator.FragmentIdPointer = block->GetBaseFragmentIdPointer() + offset;
+        iterator.FlatIndex = block->GetBaseFlatIndex() + offset;
+        if (*(iterator.FragmentIdPointer) == -1)
+        {
+          continue;
+        }
+
+        for (int ii = 0; ii < 3; ++ii)
+        {
+          for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
+          {
+            this->GetNeighborIterator(
+              &next, &iterator, ii, maxFlag, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
+            if (next.Block == nullptr || next.Block == block)
+            {
+              continue;
+            }
+            this->StitchNeighbor(&iterator, &next, ii, maxFlag, queue);
+
+            // The four smaller cells that touch this face.
+            if (next.Block->GetLevel() > block->GetLevel())
+            {
+              bool threeDimFlag =
+                next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
+              next2.Initialize();
+              // +Y
+              if (ii != 1 || threeDimFlag)
+              {
+                this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+                this->StitchNeighbor(&iterator, &next2, ii, maxFlag, queue);
+              }
+              // +Z
+              if (ii != 0 || threeDimFlag)
+              {
+                this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
+                this->StitchNeighbor(&iterator, &next2, ii, maxFlag, queue);
+              }
+              // +Y+Z
+              if (next2.Block && threeDimFlag)
+              {
+                this->GetNeighborIterator(&next3, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+                this->StitchNeighbor(&iterator, &next3, ii, maxFlag, queue);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  delete queue;
+  this->FragmentId = numberOfFragments;
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilter::StitchNeighbor(vtkMaterialInterfaceFilterIterator* in,
+  vtkMaterialInterfaceFilterIterator* next, int axis, int maxFlag,
+  vtkMaterialInterfaceFilterRingBuffer* queue)
+{
+  if (next->Block == nullptr)
+  { // The face on the boundary of the dataset was made by the worker.
+    return;
+  }
+  if (next->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+  { // Make the face into the mesh of the fragment it bounds.
+    const int fragmentId = *(in->FragmentIdPointer);
+    this->CurrentFragmentMesh = this->FragmentMeshes[fragmentId];
+    if (this->ClipWithPlane)
+    {
+      this->ClipDepthMax = this->ClipDepthMaximums->GetValue(fragmentId);
+      this->ClipDepthMin = this->ClipDepthMinimums->GetValue(fragmentId);
+    }
+    this->CreateFace(in, next, axis, maxFlag);
+    if (this->ClipWithPlane)
+    {
+      this->ClipDepthMaximums->SetValue(fragmentId, this->ClipDepthMax);
+      this->ClipDepthMinimums->SetValue(fragmentId, this->ClipDepthMin);
+      this->ClipDepthMax = 0.0;
+      this->ClipDepthMin = VTK_FLOAT_MAX;
+    }
+    this->CurrentFragmentMesh = nullptr;
+    return;
+  }
+  if (next->FragmentIdPointer[0] == -1)
+  { // A ghost cell that has not been reached yet. Continue the search from
+    // it as the serial search would have.
+    this->FragmentId = *(in->FragmentIdPointer);
+    *(next->FragmentIdPointer) = this->FragmentId;
+    queue->Push(next);
+    this->ConnectFragment(queue);
+  }
+  else
+  {
+    this->AddEquivalence(in, next);
+  }
+}
+
 // We conserver neighbor relations and put the reference (in)
 // block in position 0, and the out block in position 1.
 // The face being generated is between 0 and 1.
@@ -5531,10 +5876,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       // "Left"/min
       this->GetNeighborIterator(&next, &iterator, ii, 0, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
 
-      if (next.VolumeFractionPointer == nullptr ||
+      if (this->LabelledBlock && next.Block && next.Block != this->LabelledBlock)
+      { // Another block is labelled separately. Faces and fragments are stitched later.
+      }
+      else if (next.VolumeFractionPointer == nullptr ||
         next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      {
-        // Neighbor is outside of fragment.  Make a face.
+      { // Neighbor is outside of fragment.  Make a face.
         this->CreateFace(&iterator, &next, ii, 0);
       }
       else if (next.FragmentIdPointer[0] == -1)
@@ -5562,10 +5909,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         if (ii != 1 || threeDimFlag)
         { // stupid after the fact way of dealing with 2d AMR input.
           this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
+          if (this->LabelledBlock && next2.Block && next2.Block != this->LabelledBlock)
+          { // Another block is labelled separately. Faces and fragments are stitched later.
+          }
+          else if (next2.VolumeFractionPointer == nullptr ||
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
+          { // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 0);
           }
           else if (next2.FragmentIdPointer[0] == -1)
@@ -5583,10 +5932,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         if (ii != 0 || threeDimFlag)
         { // stupid after the fact way of dealing with 2d AMR input.
           this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
+          if (this->LabelledBlock && next2.Block && next2.Block != this->LabelledBlock)
+          { // Another block is labelled separately. Faces and fragments are stitched later.
+          }
+          else if (next2.VolumeFractionPointer == nullptr ||
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
+          { // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 0);
           }
           else if (next2.FragmentIdPointer[0] == -1)
@@ -5604,10 +5955,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         if (next2.Block && threeDimFlag)
         {
           this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
+          if (this->LabelledBlock && next.Block && next.Block != this->LabelledBlock)
+          { // Another block is labelled separately. Faces and fragments are stitched later.
+          }
+          else if (next.VolumeFractionPointer == nullptr ||
             next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
+          { // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next, ii, 0);
           }
           else if (next.FragmentIdPointer[0] == -1)
@@ -5625,7 +5978,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
 
       // "Right"/max
       this->GetNeighborIterator(&next, &iterator, ii, 1, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-      if (next.VolumeFractionPointer == nullptr ||
+      if (this->LabelledBlock && next.Block && next.Block != this->LabelledBlock)
+      { // Another block is labelled separately. Faces and fragments are stitched later.
+      }
+      else if (next.VolumeFractionPointer == nullptr ||
         next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
       { // Neighbor is outside of fragment.  Make a face.
         this->CreateFace(&iterator, &next, ii, 1);
@@ -5650,10 +6006,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         if (ii != 1 || threeDimFlag)
         { // stupid after the fact way of dealing with 2d AMR input.
           this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
+          if (this->LabelledBlock && next2.Block && next2.Block != this->LabelledBlock)
+          { // Another block is labelled separately. Faces and fragments are stitched later.
+          }
+          else if (next2.VolumeFractionPointer == nullptr ||
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
+          { // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 1);
           }
           else if (next2.FragmentIdPointer[0] == -1)
@@ -5671,10 +6029,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         if (ii != 0 || threeDimFlag)
         { // stupid after the fact way of dealing with 2d AMR input.
           this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
+          if (this->LabelledBlock && next2.Block && next2.Block != this->LabelledBlock)
+          { // Another block is labelled separately. Faces and fragments are stitched later.
+          }
+          else if (next2.VolumeFractionPointer == nullptr ||
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
+          { // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 1);
           }
           else if (next2.FragmentIdPointer[0] == -1)
@@ -5692,10 +6052,12 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         if (next2.Block && threeDimFlag)
         {
           this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
+          if (this->LabelledBlock && next.Block && next.Block != this->LabelledBlock)
+          { // Another block is labelled separately. Faces and fragments are stitched later.
+          }
+          else if (next.VolumeFractionPointer == nullptr ||
             next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
+          { // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next, ii, 1);
           }
           else if (next.FragmentIdPointer[0] == -1)
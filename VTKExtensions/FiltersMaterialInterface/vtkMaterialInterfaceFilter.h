@@ -316,6 +316,18 @@ public:
   vtkGetMacro(InvertVolumeFraction, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the blocks local to a process are initialized and labelled
+   * concurrently with vtkSMPTools. Fragments that cross block boundaries
+   * are connected afterwards, so the fragments and their attributes are
+   * the same as with serial execution. Off by default.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  ///@}
+
   /**
    * Return the mtime also considering the locator and clip function.
    */
@@ -342,6 +354,20 @@ protected:
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
   void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
+  // Label the local blocks concurrently. Each worker filter labels a
+  // contiguous range of blocks, its fragments are then moved into this filter.
+  void ProcessBlocksSMP(vtkNonOverlappingAMR* hbdsInput,
+    std::vector<std::string>& summedArrayNames);
+  // Move the fragments found by a worker into this filter, offsetting
+  // their ids by the number of fragments already found.
+  void MergeFragments(vtkMaterialInterfaceFilter* worker);
+  // Connect fragments labelled separately across the faces of a block,
+  // create the surface faces between blocks and continue the connectivity
+  // into the ghost cells they touch.
+  void StitchBlock(int blockId);
+  void StitchNeighbor(vtkMaterialInterfaceFilterIterator* in,
+    vtkMaterialInterfaceFilterIterator* next, int axis, int maxFlag,
+    vtkMaterialInterfaceFilterRingBuffer* queue);
   void GetNeighborIterator(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
@@ -702,6 +728,13 @@ protected:
   // By default set to 1
   unsigned char BlockGhostLevel;
 
+  // Label blocks concurrently.
+  bool EnableSMP;
+  // When set, connectivity and surface extraction stop at the faces of this
+  // block, so a worker only reads and writes the cells of its own block. Used
+  // by the workers that label blocks concurrently.
+  vtkMaterialInterfaceFilterBlock* LabelledBlock;
+
 #ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
   vtkSmartPointer<vtkTimerLog> InitializeBlocksTimer;
@@ -0,0 +1,418 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGenericDataObjectReader.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVDataObjectSerializer.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// Round trips polydata, an unstructured grid and a multiblock dataset through
+// the legacy VTK format and vtkPVDataObjectSerializer, with and without
+// compression, and reports marshal, transfer (copy into a receive buffer) and
+// unmarshal times separately. The default size keeps the test quick, set
+// PARAVIEW_SERIALIZER_BENCHMARK_MB to the approximate size of each dataset in
+// MB to benchmark bigger datasets (10 to 10000).
+namespace
+{
+vtkSmartPointer<vtkPoints> MakePoints(vtkIdType numPoints)
+{
+  vtkNew<vtkFloatArray> coordinates;
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(numPoints);
+  for (vtkIdType cc = 0; cc < numPoints; ++cc)
+  {
+    coordinates->SetTypedComponent(cc, 0, static_cast<float>(cc % 1000));
+    coordinates->SetTypedComponent(cc, 1, static_cast<float>((cc / 1000) % 1000));
+    coordinates->SetTypedComponent(cc, 2, static_cast<float>(std::sin(0.001 * cc)));
+  }
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetData(coordinates);
+  return points;
+}
+
+void AddValues(vtkDataSetAttributes* attributes, const char* name, vtkIdType numTuples)
+{
+  vtkNew<vtkDoubleArray> values;
+  values->SetName(name);
+  values->SetNumberOfTuples(numTuples);
+  for (vtkIdType cc = 0; cc < numTuples; ++cc)
+  {
+    values->SetValue(cc, std::cos(0.01 * cc) * 100.0);
+  }
+  attributes->SetScalars(values);
+}
+
+// About 84 bytes per point.
+vtkSmartPointer<vtkPolyData> MakePolyData(vtkIdType numPoints)
+{
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(MakePoints(numPoints));
+  vtkNew<vtkCellArray> polys;
+  polys->AllocateExact(2 * numPoints, 6 * numPoints);
+  for (vtkIdType cc = 0; cc + 2 < numPoints; ++cc)
+  {
+    const vtkIdType triangle[3] = { cc, cc + 1, cc + 2 };
+    polys->InsertNextCell(3, triangle);
+    const vtkIdType other[3] = { cc + 2, cc + 1, cc };
+    polys->InsertNextCell(3, other);
+  }
+  pd->SetPolys(polys);
+  AddValues(pd->GetPointData(), "pointValues", numPoints);
+  return pd;
+}
+
+// About 70 bytes per point.
+vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid(vtkIdType numPoints)
+{
+  auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  ug->SetPoints(MakePoints(numPoints));
+  ug->AllocateExact(numPoints, 4 * numPoints);
+  for (vtkIdType cc = 0; cc + 3 < numPoints; ++cc)
+  {
+    const vtkIdType tetra[4] = { cc, cc + 1, cc + 2, cc + 3 };
+    ug->InsertNextCell(VTK_TETRA, 4, tetra);
+  }
+  AddValues(ug->GetPointData(), "pointValues", numPoints);
+  AddValues(ug->GetCellData(), "cellValues", ug->GetNumberOfCells());
+  return ug;
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> MakeMultiBlock(vtkIdType numPoints)
+{
+  auto mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  mb->SetBlock(0, MakePolyData(numPoints / 2));
+  mb->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+  mb->SetBlock(1, MakeUnstructuredGrid(numPoints / 2));
+  mb->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "volume");
+  // an empty block.
+  mb->SetBlock(2, nullptr);
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-2, 5, 0, 3, 1, 4);
+  image->SetOrigin(0.5, 1, -1);
+  image->SetSpacing(0.25, 1, 2);
+  AddValues(image->GetPointData(), "pointValues", image->GetNumberOfPoints());
+  mb->SetBlock(3, image);
+
+  vtkNew<vtkTable> table;
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("labels");
+  labels->InsertNextValue("first");
+  labels->InsertNextValue("");
+  labels->InsertNextValue("third");
+  table->AddColumn(labels);
+  mb->SetBlock(4, table);
+
+  vtkNew<vtkStringArray> comment;
+  comment->SetName("comment");
+  comment->InsertNextValue("field data");
+  mb->GetFieldData()->AddArray(comment);
+  return mb;
+}
+
+bool CompareArrays(vtkFieldData* expected, vtkFieldData* actual)
+{
+  if (expected->GetNumberOfArrays() != actual->GetNumberOfArrays())
+  {
+    vtkLogF(ERROR, "Expected %d arrays, got %d.", expected->GetNumberOfArrays(),
+      actual->GetNumberOfArrays());
+    return false;
+  }
+  for (int arrayIdx = 0; arrayIdx < expected->GetNumberOfArrays(); ++arrayIdx)
+  {
+    vtkAbstractArray* expectedArray = expected->GetAbstractArray(arrayIdx);
+    vtkAbstractArray* actualArray = actual->GetAbstractArray(arrayIdx);
+    if (!actualArray || std::strcmp(expectedArray->GetName(), actualArray->GetName()) != 0 ||
+      expectedArray->GetDataType() != actualArray->GetDataType() ||
+      expectedArray->GetNumberOfComponents() != actualArray->GetNumberOfComponents() ||
+      expectedArray->GetNumberOfValues() != actualArray->GetNumberOfValues())
+    {
+      vtkLogF(ERROR, "Mismatched array '%s'.", expectedArray->GetName());
+      return false;
+    }
+    // sample big arrays.
+    const vtkIdType stride = std::max<vtkIdType>(1, expectedArray->GetNumberOfValues() / 100000);
+    for (vtkIdType cc = 0; cc < expectedArray->GetNumberOfValues(); cc += stride)
+    {
+      if (expectedArray->GetVariantValue(cc) != actualArray->GetVariantValue(cc))
+      {
+        vtkLogF(ERROR, "Mismatched value in array '%s'.", expectedArray->GetName());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareLeaves(vtkDataObject* expected, vtkDataObject* actual)
+{
+  if (!expected || !actual)
+  {
+    return expected == actual;
+  }
+  if (std::strcmp(expected->GetClassName(), actual->GetClassName()) != 0)
+  {
+    vtkLogF(ERROR, "Expected a %s, got a %s.", expected->GetClassName(), actual->GetClassName());
+    return false;
+  }
+  if (auto expectedTable = vtkTable::SafeDownCast(expected))
+  {
+    return CompareArrays(expectedTable->GetRowData(), vtkTable::SafeDownCast(actual)->GetRowData());
+  }
+  auto expectedDS = vtkDataSet::SafeDownCast(expected);
+  auto actualDS = vtkDataSet::SafeDownCast(actual);
+  if (expectedDS->GetNumberOfPoints() != actualDS->GetNumberOfPoints() ||
+    expectedDS->GetNumberOfCells() != actualDS->GetNumberOfCells())
+  {
+    vtkLogF(ERROR, "Mismatched number of points or cells.");
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expectedDS->GetNumberOfPoints(); cc += 997)
+  {
+    double expectedPoint[3];
+    double actualPoint[3];
+    expectedDS->GetPoint(cc, expectedPoint);
+    actualDS->GetPoint(cc, actualPoint);
+    if (expectedPoint[0] != actualPoint[0] || expectedPoint[1] != actualPoint[1] ||
+      expectedPoint[2] != actualPoint[2])
+    {
+      vtkLogF(ERROR, "Mismatched point %lld.", static_cast<long long>(cc));
+      return false;
+    }
+  }
+  for (vtkIdType cc = 0; cc < expectedDS->GetNumberOfCells(); cc += 997)
+  {
+    if (expectedDS->GetCellType(cc) != actualDS->GetCellType(cc) ||
+      expectedDS->GetCell(cc)->GetPointId(0) != actualDS->GetCell(cc)->GetPointId(0))
+    {
+      vtkLogF(ERROR, "Mismatched cell %lld.", static_cast<long long>(cc));
+      return false;
+    }
+  }
+  return CompareArrays(expectedDS->GetPointData(), actualDS->GetPointData()) &&
+    CompareArrays(expectedDS->GetCellData(), actualDS->GetCellData()) &&
+    (!expectedDS->GetPointData()->GetScalars() || actualDS->GetPointData()->GetScalars());
+}
+
+bool Compare(vtkDataObject* expected, vtkDataObject* actual)
+{
+  auto expectedMB = vtkMultiBlockDataSet::SafeDownCast(expected);
+  if (!expectedMB)
+  {
+    return CompareLeaves(expected, actual);
+  }
+  auto actualMB = vtkMultiBlockDataSet::SafeDownCast(actual);
+  if (!actualMB || expectedMB->GetNumberOfBlocks() != actualMB->GetNumberOfBlocks() ||
+    !CompareArrays(expectedMB->GetFieldData(), actualMB->GetFieldData()))
+  {
+    vtkLogF(ERROR, "Mismatched multiblock dataset.");
+    return false;
+  }
+  for (unsigned int cc = 0; cc < expectedMB->GetNumberOfBlocks(); ++cc)
+  {
+    const char* expectedName = expectedMB->HasMetaData(cc)
+      ? expectedMB->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+      : nullptr;
+    const char* actualName = actualMB->HasMetaData(cc)
+      ? actualMB->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+      : nullptr;
+    if (expectedName && (!actualName || std::strcmp(expectedName, actualName) != 0))
+    {
+      vtkLogF(ERROR, "Mismatched name for block %u.", cc);
+      return false;
+    }
+    if (!CompareLeaves(expectedMB->GetBlock(cc), actualMB->GetBlock(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the first point coordinate of `data` lies in `buffer`.
+bool SharesBuffer(vtkDataObject* data, const char* buffer, vtkIdType length)
+{
+  auto pointSet = vtkPointSet::SafeDownCast(data);
+  if (auto mb = vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    pointSet = vtkPointSet::SafeDownCast(mb->GetBlock(0));
+  }
+  const char* pointer =
+    static_cast<const char*>(pointSet->GetPoints()->GetData()->GetVoidPointer(0));
+  return pointer >= buffer && pointer < buffer + length;
+}
+
+struct Timings
+{
+  double Marshal = 0;
+  double Transfer = 0;
+  double Unmarshal = 0;
+  vtkIdType Length = 0;
+};
+
+void Report(const char* dataName, const char* encoding, const Timings& timings)
+{
+  std::cout << dataName << " / " << encoding << ": " << timings.Length / (1024.0 * 1024.0)
+            << " MB, marshal " << timings.Marshal << " s, transfer " << timings.Transfer
+            << " s, unmarshal " << timings.Unmarshal << " s" << std::endl;
+}
+
+bool RoundTripLegacy(vtkDataObject* data, const char* dataName)
+{
+  Timings timings;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkNew<vtkGenericDataObjectWriter> writer;
+  writer->SetInputData(data);
+  writer->SetFileTypeToBinary();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  timer->StopTimer();
+  timings.Marshal = timer->GetElapsedTime();
+  timings.Length = writer->GetOutputStringLength();
+
+  timer->StartTimer();
+  char* received = new char[timings.Length];
+  std::memcpy(received, writer->GetOutputString(), timings.Length);
+  timer->StopTimer();
+  timings.Transfer = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  vtkNew<vtkCharArray> input;
+  input->SetArray(received, timings.Length, 0, vtkCharArray::VTK_DATA_ARRAY_DELETE);
+  vtkNew<vtkGenericDataObjectReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputArray(input);
+  reader->Update();
+  timer->StopTimer();
+  timings.Unmarshal = timer->GetElapsedTime();
+
+  Report(dataName, "legacy", timings);
+  return reader->GetOutputDataObject(0) != nullptr;
+}
+
+bool RoundTrip(vtkDataObject* data, const char* dataName, int compression)
+{
+  static const char* encodings[] = { "raw", "raw+zlib", "raw+lz4" };
+  Timings timings;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkNew<vtkPVDataObjectSerializer> serializer;
+  serializer->SetCompression(compression);
+  char* buffer = nullptr;
+  if (!serializer->Serialize(data, buffer, timings.Length))
+  {
+    vtkLogF(ERROR, "Failed to serialize %s.", dataName);
+    return false;
+  }
+  timer->StopTimer();
+  timings.Marshal = timer->GetElapsedTime();
+  if (timings.Length % 64 != 0)
+  {
+    vtkLogF(ERROR, "Serialized length is not aligned.");
+    delete[] buffer;
+    return false;
+  }
+
+  timer->StartTimer();
+  char* received = new char[timings.Length];
+  std::memcpy(received, buffer, timings.Length);
+  timer->StopTimer();
+  timings.Transfer = timer->GetElapsedTime();
+  delete[] buffer;
+
+  timer->StartTimer();
+  vtkSmartPointer<vtkDataObject> result;
+  {
+    std::shared_ptr<const char> storage(received, std::default_delete<char[]>());
+    result = vtkPVDataObjectSerializer::Deserialize(received, timings.Length, storage);
+  }
+  timer->StopTimer();
+  timings.Unmarshal = timer->GetElapsedTime();
+  Report(dataName, encodings[compression], timings);
+
+  // uncompressed arrays must share the received buffer, which stays alive as
+  // long as they do.
+  if (compression == vtkPVDataObjectSerializer::NO_COMPRESSION && result &&
+    !SharesBuffer(result, received, timings.Length))
+  {
+    vtkLogF(ERROR, "Arrays were copied instead of sharing the received buffer.");
+    return false;
+  }
+  return Compare(data, result);
+}
+}
+
+int TestDataObjectSerializer(int, char*[])
+{
+  double sizeInMB = 2;
+  if (const char* benchmarkSize = std::getenv("PARAVIEW_SERIALIZER_BENCHMARK_MB"))
+  {
+    sizeInMB = std::atof(benchmarkSize);
+  }
+  const double bytes = sizeInMB * 1024 * 1024;
+
+  struct
+  {
+    const char* Name;
+    vtkSmartPointer<vtkDataObject> Data;
+  } datasets[] = {
+    { "polydata", MakePolyData(static_cast<vtkIdType>(bytes / 84)) },
+    { "unstructured grid", MakeUnstructuredGrid(static_cast<vtkIdType>(bytes / 70)) },
+    { "multiblock", MakeMultiBlock(static_cast<vtkIdType>(bytes / 77)) },
+  };
+
+  for (const auto& dataset : datasets)
+  {
+    if (!RoundTripLegacy(dataset.Data, dataset.Name) ||
+      !RoundTrip(dataset.Data, dataset.Name, vtkPVDataObjectSerializer::NO_COMPRESSION) ||
+      !RoundTrip(dataset.Data, dataset.Name, vtkPVDataObjectSerializer::ZLIB) ||
+      !RoundTrip(dataset.Data, dataset.Name, vtkPVDataObjectSerializer::LZ4))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // unsupported data must be rejected so that callers can fall back.
+  vtkNew<vtkUnstructuredGrid> polyhedral;
+  polyhedral->SetPoints(MakePoints(4));
+  const vtkIdType faces[] = { 3, 0, 1, 2, 3, 0, 1, 3, 3, 1, 2, 3, 3, 0, 2, 3 };
+  const vtkIdType pointIds[] = { 0, 1, 2, 3 };
+  polyhedral->InsertNextCell(VTK_POLYHEDRON, 4, pointIds, 4, faces);
+  vtkNew<vtkPVDataObjectSerializer> serializer;
+  char* buffer = nullptr;
+  vtkIdType length = 0;
+  if (serializer->Serialize(polyhedral, buffer, length) || buffer)
+  {
+    vtkLogF(ERROR, "Polyhedral cells should not be supported.");
+    delete[] buffer;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDeltaImageCompressor.h"
+#include "vtkNew.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+void FillImage(vtkUnsignedCharArray* image, int width, int height)
+{
+  image->SetNumberOfComponents(4);
+  image->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+  unsigned char* ptr = image->GetPointer(0);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x, ptr += 4)
+    {
+      ptr[0] = static_cast<unsigned char>(x);
+      ptr[1] = static_cast<unsigned char>(y);
+      ptr[2] = static_cast<unsigned char>(x ^ y);
+      ptr[3] = 255;
+    }
+  }
+}
+
+// Sends `image` from `sender` to `receiver` and checks the result.
+bool SendFrame(vtkDeltaImageCompressor* sender, vtkDeltaImageCompressor* receiver,
+  vtkUnsignedCharArray* image, int width, int height, bool expectKeyFrame,
+  vtkIdType expectedDirtyTiles)
+{
+  vtkNew<vtkUnsignedCharArray> compressed;
+  sender->SetImageResolution(width, height);
+  sender->SetInput(image);
+  sender->SetOutput(compressed);
+  if (sender->Compress() != VTK_OK)
+  {
+    cerr << "Compress failed." << endl;
+    return false;
+  }
+
+  vtkNew<vtkUnsignedCharArray> result;
+  result->SetNumberOfComponents(image->GetNumberOfComponents());
+  result->SetNumberOfTuples(image->GetNumberOfTuples());
+  receiver->SetImageResolution(width, height);
+  receiver->SetInput(compressed);
+  receiver->SetOutput(result);
+  if (receiver->Decompress() != VTK_OK)
+  {
+    cerr << "Decompress failed." << endl;
+    return false;
+  }
+
+  if (memcmp(result->GetPointer(0), image->GetPointer(0), image->GetNumberOfValues()) != 0)
+  {
+    cerr << "Decompressed image does not match the input." << endl;
+    return false;
+  }
+  if (sender->GetLastFrameWasKeyFrame() != expectKeyFrame ||
+    receiver->GetLastFrameWasKeyFrame() != expectKeyFrame)
+  {
+    cerr << "Unexpected frame type, expected key frame: " << expectKeyFrame << endl;
+    return false;
+  }
+  if (expectedDirtyTiles >= 0 &&
+    (sender->GetLastNumberOfDirtyTiles() != expectedDirtyTiles ||
+      receiver->GetLastNumberOfDirtyTiles() != expectedDirtyTiles))
+  {
+    cerr << "Expected " << expectedDirtyTiles << " dirty tiles, got "
+         << sender->GetLastNumberOfDirtyTiles() << endl;
+    return false;
+  }
+  cout << "frame: " << (expectKeyFrame ? "key" : "delta")
+       << " dirty tiles: " << sender->GetLastNumberOfDirtyTiles() << "/"
+       << sender->GetLastNumberOfTiles() << " compressed size: " << compressed->GetNumberOfValues()
+       << endl;
+  return true;
+}
+}
+
+int TestDeltaImageCompressor(int, char*[])
+{
+  vtkNew<vtkDeltaImageCompressor> sender;
+  vtkNew<vtkDeltaImageCompressor> receiver;
+  const char* config = "vtkDeltaImageCompressor 0 16 0";
+  if (!sender->RestoreConfiguration(config) || !receiver->RestoreConfiguration(config) ||
+    sender->GetTileSize() != 16)
+  {
+    cerr << "Failed to restore configuration." << endl;
+    return TEST_FAILED;
+  }
+
+  int width = 100;
+  int height = 70;
+  vtkNew<vtkUnsignedCharArray> image;
+  FillImage(image, width, height);
+
+  // First frame is always a key frame.
+  if (!SendFrame(sender, receiver, image, width, height, true, -1))
+  {
+    return TEST_FAILED;
+  }
+
+  // Unchanged frame, nothing to send.
+  if (!SendFrame(sender, receiver, image, width, height, false, 0))
+  {
+    return TEST_FAILED;
+  }
+
+  // Change one pixel in the last, partial, tile and one in the first tile.
+  image->SetTypedComponent(image->GetNumberOfTuples() - 1, 0, 0);
+  image->SetTypedComponent(0, 1, 42);
+  if (!SendFrame(sender, receiver, image, width, height, false, 2))
+  {
+    return TEST_FAILED;
+  }
+
+  // Resizing triggers a key frame.
+  width = 64;
+  height = 48;
+  FillImage(image, width, height);
+  if (!SendFrame(sender, receiver, image, width, height, true, -1))
+  {
+    return TEST_FAILED;
+  }
+
+  // Reconfiguring both ends triggers a key frame.
+  config = "vtkDeltaImageCompressor 0 32 2";
+  sender->RestoreConfiguration(config);
+  receiver->RestoreConfiguration(config);
+  if (!SendFrame(sender, receiver, image, width, height, true, -1) ||
+    !SendFrame(sender, receiver, image, width, height, false, 0) ||
+    // KeyFrameInterval reached.
+    !SendFrame(sender, receiver, image, width, height, true, -1))
+  {
+    return TEST_FAILED;
+  }
+
+  // A receiver that missed frames must reject deltas.
+  vtkNew<vtkDeltaImageCompressor> lateReceiver;
+  lateReceiver->RestoreConfiguration(config);
+  vtkNew<vtkUnsignedCharArray> compressed;
+  sender->SetInput(image);
+  sender->SetOutput(compressed);
+  sender->Compress();
+  vtkNew<vtkUnsignedCharArray> result;
+  result->SetNumberOfComponents(4);
+  result->SetNumberOfTuples(image->GetNumberOfTuples());
+  lateReceiver->SetInput(compressed);
+  lateReceiver->SetOutput(result);
+  if (sender->GetLastFrameWasKeyFrame() || lateReceiver->Decompress() != VTK_ERROR)
+  {
+    cerr << "Delta frame without reference should have been rejected." << endl;
+    return TEST_FAILED;
+  }
+
+  // Drop a frame with periodic key frames disabled: the receiver rejects the
+  // next delta and asks for a key frame, as vtkPVClientServerSynchronizedRenderers
+  // does, after which the stream recovers.
+  config = "vtkDeltaImageCompressor 0 16 0";
+  sender->RestoreConfiguration(config);
+  receiver->RestoreConfiguration(config);
+  if (!SendFrame(sender, receiver, image, width, height, true, -1) ||
+    !receiver->HasReferenceFrame())
+  {
+    return TEST_FAILED;
+  }
+  image->SetTypedComponent(0, 0, 1);
+  sender->SetInput(image);
+  sender->SetOutput(compressed);
+  sender->Compress(); // dropped
+  image->SetTypedComponent(0, 0, 2);
+  sender->Compress();
+  receiver->SetInput(compressed);
+  receiver->SetOutput(result);
+  if (sender->GetLastFrameWasKeyFrame() || receiver->Decompress() != VTK_ERROR ||
+    receiver->HasReferenceFrame())
+  {
+    cerr << "Delta frame following a dropped frame should have been rejected." << endl;
+    return TEST_FAILED;
+  }
+  // Without a key frame request, the sender keeps sending deltas.
+  image->SetTypedComponent(0, 0, 3);
+  sender->Compress();
+  if (sender->GetLastFrameWasKeyFrame() || receiver->Decompress() != VTK_ERROR)
+  {
+    cerr << "Delta frame should have been rejected until a key frame is received." << endl;
+    return TEST_FAILED;
+  }
+  if (!receiver->HasReferenceFrame())
+  {
+    sender->ForceKeyFrame();
+  }
+  if (!SendFrame(sender, receiver, image, width, height, true, -1) ||
+    !SendFrame(sender, receiver, image, width, height, false, 0))
+  {
+    return TEST_FAILED;
+  }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+// Returns a new image with the same mesh for a given `spacing` but with
+// attributes that depend on `time`.
+vtkSmartPointer<vtkImageData> MakeImage(double spacing, double time)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 6, 0, 5, 0, 4);
+  image->SetSpacing(spacing, spacing, spacing);
+
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("pointValues");
+  pointValues->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    pointValues->SetValue(cc, time * 1000 + cc);
+  }
+  image->GetPointData()->SetScalars(pointValues);
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("cellValues");
+  cellValues->SetNumberOfComponents(2);
+  cellValues->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+  {
+    cellValues->SetTypedComponent(cc, 0, time);
+    cellValues->SetTypedComponent(cc, 1, -static_cast<double>(cc));
+  }
+  image->GetCellData()->AddArray(cellValues);
+  return image;
+}
+
+vtkSmartPointer<vtkPolyData> Reference(vtkDataObject* input)
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetInputDataObject(input);
+  filter->Update();
+  return vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+}
+
+bool CompareArrays(vtkDataSetAttributes* expected, vtkDataSetAttributes* actual)
+{
+  // leaves of composite outputs also have a vtkCompositeIndex array.
+  const int numActual =
+    actual->GetNumberOfArrays() - (actual->GetArray("vtkCompositeIndex") ? 1 : 0);
+  if (expected->GetNumberOfArrays() != numActual)
+  {
+    vtkLogF(ERROR, "Expected %d arrays, got %d.", expected->GetNumberOfArrays(), numActual);
+    return false;
+  }
+  for (int arrayIdx = 0; arrayIdx < expected->GetNumberOfArrays(); ++arrayIdx)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(arrayIdx);
+    if (!expectedArray)
+    {
+      continue;
+    }
+    vtkDataArray* actualArray = actual->GetArray(expectedArray->GetName());
+    if (!actualArray ||
+      actualArray->GetNumberOfComponents() != expectedArray->GetNumberOfComponents() ||
+      actualArray->GetNumberOfTuples() != expectedArray->GetNumberOfTuples())
+    {
+      vtkLogF(ERROR, "Mismatched array '%s'.", expectedArray->GetName());
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < expectedArray->GetNumberOfValues(); ++cc)
+    {
+      const int nComps = expectedArray->GetNumberOfComponents();
+      if (expectedArray->GetComponent(cc / nComps, cc % nComps) !=
+        actualArray->GetComponent(cc / nComps, cc % nComps))
+      {
+        vtkLogF(ERROR, "Mismatched value in array '%s'.", expectedArray->GetName());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (!expected || !actual || expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    vtkLogF(ERROR, "Mismatched surface.");
+    return false;
+  }
+  if (!actual->GetPointData()->GetScalars() ||
+    strcmp(actual->GetPointData()->GetScalars()->GetName(), "pointValues") != 0)
+  {
+    vtkLogF(ERROR, "Active scalars were not preserved.");
+    return false;
+  }
+  return CompareArrays(expected->GetPointData(), actual->GetPointData()) &&
+    CompareArrays(expected->GetCellData(), actual->GetCellData());
+}
+
+bool CheckCounters(vtkPVGeometryFilter* filter, int hits, int misses)
+{
+  if (filter->GetSurfaceCacheHits() != hits || filter->GetSurfaceCacheMisses() != misses)
+  {
+    vtkLogF(ERROR, "Expected %d hits and %d misses, got %d and %d.", hits, misses,
+      filter->GetSurfaceCacheHits(), filter->GetSurfaceCacheMisses());
+    return false;
+  }
+  return true;
+}
+}
+
+// Checks that surfaces are reused across "timesteps" when only attributes
+// change and that the forwarded attributes match a regular execution.
+int TestPVGeometryFilterSurfaceCache(int, char*[])
+{
+  // keep the same connection, as a reader producing new timesteps would.
+  vtkNew<vtkTrivialProducer> producer;
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetSurfaceCacheLimit(16);
+  filter->SetInputConnection(producer->GetOutputPort());
+
+  // single dataset.
+  for (int step = 0; step < 3; ++step)
+  {
+    auto image = MakeImage(1.0, step);
+    producer->SetOutput(image);
+    filter->Update();
+    if (!CheckCounters(filter, step, 1) ||
+      !Compare(Reference(image), vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0))))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (filter->GetSurfaceCacheMemorySize() <= 0)
+  {
+    vtkLogF(ERROR, "Cache memory size not reported.");
+    return EXIT_FAILURE;
+  }
+
+  // a different mesh must not reuse the cached surface.
+  auto scaled = MakeImage(2.0, 3);
+  producer->SetOutput(scaled);
+  filter->Update();
+  if (!CheckCounters(filter, 2, 2) ||
+    !Compare(Reference(scaled), vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0))))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // composite dataset, one entry per block.
+  filter->ClearSurfaceCache();
+  for (int step = 0; step < 2; ++step)
+  {
+    vtkNew<vtkMultiBlockDataSet> mb;
+    mb->SetBlock(0, MakeImage(1.0, step));
+    mb->SetBlock(1, MakeImage(0.5, step));
+    producer->SetOutput(mb);
+    filter->Update();
+    auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+    if (!CheckCounters(filter, 2 * step, 2) || !output)
+    {
+      return EXIT_FAILURE;
+    }
+    for (unsigned int cc = 0; cc < 2; ++cc)
+    {
+      if (!Compare(Reference(mb->GetBlock(cc)), vtkPolyData::SafeDownCast(output->GetBlock(cc))))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // changing a filter setting invalidates the cache.
+  filter->SetPassThroughCellIds(0);
+  filter->Update();
+  if (filter->GetSurfaceCacheMemorySize() <= 0 || !CheckCounters(filter, 2, 4))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
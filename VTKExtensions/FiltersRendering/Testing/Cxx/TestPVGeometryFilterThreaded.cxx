@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> MakeBlock(int index)
+{
+  const int size = 2 + index % 7;
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, size, 0, size + 1, 0, size + 2);
+  image->SetOrigin(index * 10.0, 0, 0);
+
+  vtkNew<vtkFloatArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    values->SetValue(cc, static_cast<float>(index + cc));
+  }
+  image->GetPointData()->AddArray(values);
+  return image;
+}
+
+vtkSmartPointer<vtkDataObject> Execute(
+  vtkDataObject* input, bool threaded, bool useOutline, int& outlineFlag)
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(useOutline);
+  filter->SetGenerateProcessIds(false);
+  filter->SetThreadedBlockExecution(threaded);
+  filter->SetInputDataObject(input);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  filter->Update();
+  timer->StopTimer();
+  vtkLogF(INFO, "%s execution: %g s", threaded ? "threaded" : "serial", timer->GetElapsedTime());
+  outlineFlag = filter->GetOutlineFlag();
+  return filter->GetOutputDataObject(0);
+}
+
+bool Compare(vtkPolyData* serial, vtkPolyData* threaded, unsigned int index)
+{
+  if (serial->GetNumberOfPoints() != threaded->GetNumberOfPoints() ||
+    serial->GetNumberOfCells() != threaded->GetNumberOfCells())
+  {
+    vtkLogF(ERROR, "Mismatched surface for block %u.", index);
+    return false;
+  }
+  auto serialIds =
+    vtkUnsignedIntArray::SafeDownCast(serial->GetPointData()->GetArray("vtkCompositeIndex"));
+  auto threadedIds =
+    vtkUnsignedIntArray::SafeDownCast(threaded->GetPointData()->GetArray("vtkCompositeIndex"));
+  if (!serialIds || !threadedIds || serialIds->GetValue(0) != threadedIds->GetValue(0))
+  {
+    vtkLogF(ERROR, "Mismatched composite index for block %u.", index);
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < serial->GetNumberOfPoints(); ++cc)
+  {
+    double p0[3], p1[3];
+    serial->GetPoint(cc, p0);
+    threaded->GetPoint(cc, p1);
+    if (p0[0] != p1[0] || p0[1] != p1[1] || p0[2] != p1[2])
+    {
+      vtkLogF(ERROR, "Mismatched point %lld for block %u.", static_cast<long long>(cc), index);
+      return false;
+    }
+  }
+  return true;
+}
+
+// The settings printed by vtkPVGeometryFilter::PrintSelf, without the
+// superclass state that differs between instances.
+std::string GetSettings(vtkPVGeometryFilter* filter)
+{
+  std::ostringstream stream;
+  filter->PrintSelf(stream, vtkIndent());
+  const std::string settings = stream.str();
+  const size_t start = settings.find("OutlineFlag:");
+  return start != std::string::npos ? settings.substr(start) : std::string();
+}
+
+// Checks that a clone configured with CopySettings, as the per-thread clones
+// are, matches the original for settings that all differ from the defaults.
+bool TestCopySettings()
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(!filter->GetUseOutline());
+  filter->SetGenerateFeatureEdges(!filter->GetGenerateFeatureEdges());
+  filter->SetBlockColorsDistinctValues(filter->GetBlockColorsDistinctValues() + 3);
+  filter->SetGenerateCellNormals(!filter->GetGenerateCellNormals());
+  filter->SetGeneratePointNormals(!filter->GetGeneratePointNormals());
+  filter->SetSplitting(false);
+  filter->SetFeatureAngle(filter->GetFeatureAngle() + 10.0);
+  filter->SetTriangulate(!filter->GetTriangulate());
+  filter->SetNonlinearSubdivisionLevel(filter->GetNonlinearSubdivisionLevel() + 2);
+  filter->SetMatchBoundariesIgnoringCellOrder(!filter->GetMatchBoundariesIgnoringCellOrder());
+  filter->SetPassThroughCellIds(!filter->GetPassThroughCellIds());
+  filter->SetPassThroughPointIds(!filter->GetPassThroughPointIds());
+  filter->SetGenerateProcessIds(!filter->GetGenerateProcessIds());
+  filter->SetHideInternalAMRFaces(!filter->GetHideInternalAMRFaces());
+  filter->SetUseNonOverlappingAMRMetaDataForOutlines(
+    !filter->GetUseNonOverlappingAMRMetaDataForOutlines());
+  filter->SetThreadedBlockExecution(!filter->GetThreadedBlockExecution());
+  filter->SetSurfaceCacheLimit(filter->GetSurfaceCacheLimit() + 16);
+
+  vtkSmartPointer<vtkPVGeometryFilter> clone;
+  clone.TakeReference(filter->NewInstance());
+  clone->CopySettings(filter);
+  const std::string expected = GetSettings(filter);
+  const std::string actual = GetSettings(clone);
+  if (expected.empty() || actual != expected)
+  {
+    vtkLogF(ERROR, "Mismatched clone settings:\n%s\ninstead of:\n%s", actual.c_str(),
+      expected.c_str());
+    return false;
+  }
+  return true;
+}
+}
+
+// Checks that extracting the surfaces, or outlines, of leaf blocks
+// concurrently produces the same output tree and OutlineFlag as the serial
+// execution, using clones with the same settings.
+int TestPVGeometryFilterThreaded(int, char*[])
+{
+  if (!TestCopySettings())
+  {
+    return EXIT_FAILURE;
+  }
+
+  const unsigned int numBlocks = 500;
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(numBlocks);
+  for (unsigned int cc = 0; cc < numBlocks; ++cc)
+  {
+    // leave a few empty nodes to check that they are preserved.
+    if (cc % 11 != 5)
+    {
+      input->SetBlock(cc, MakeBlock(static_cast<int>(cc)));
+    }
+  }
+
+  for (const bool useOutline : { false, true })
+  {
+    int serialFlag = -1, threadedFlag = -1;
+    auto serial =
+      vtkMultiBlockDataSet::SafeDownCast(Execute(input, false, useOutline, serialFlag));
+    auto threaded =
+      vtkMultiBlockDataSet::SafeDownCast(Execute(input, true, useOutline, threadedFlag));
+    if (!serial || !threaded || serial->GetNumberOfBlocks() != threaded->GetNumberOfBlocks())
+    {
+      vtkLogF(ERROR, "Mismatched output structure.");
+      return EXIT_FAILURE;
+    }
+    if (serialFlag != (useOutline ? 1 : 0) || threadedFlag != serialFlag)
+    {
+      vtkLogF(ERROR, "Mismatched OutlineFlag: %d serial, %d threaded, with UseOutline %d.",
+        serialFlag, threadedFlag, useOutline ? 1 : 0);
+      return EXIT_FAILURE;
+    }
+
+    for (unsigned int cc = 0; cc < numBlocks; ++cc)
+    {
+      auto serialBlock = vtkPolyData::SafeDownCast(serial->GetBlock(cc));
+      auto threadedBlock = vtkPolyData::SafeDownCast(threaded->GetBlock(cc));
+      if ((serialBlock == nullptr) != (threadedBlock == nullptr))
+      {
+        vtkLogF(ERROR, "Mismatched empty node at %u.", cc);
+        return EXIT_FAILURE;
+      }
+      if (serialBlock && !Compare(serialBlock, threadedBlock, cc))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
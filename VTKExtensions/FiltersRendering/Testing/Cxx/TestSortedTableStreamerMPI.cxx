@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// Sorts a table distributed over at least 3 ranks, with uneven and empty
+// partitions, NaNs and duplicated values, and compares every block in both
+// orders with a serial sort of all the rows. Also checks that the sorted index
+// is only built again when the sorted values change, and sorts again with no
+// rows on the first rank, which gathers the blocks.
+
+namespace
+{
+const vtkIdType BlockSize = 4;
+
+// Number of rows of the partitions of `rank`. Rank 1 has no partition, other
+// ranks after the first have an empty partition followed by a non-empty one.
+// When `emptyFirstRank` is set, the first rank only has an empty partition.
+std::vector<vtkIdType> GetPartitionSizes(int rank, bool emptyFirstRank)
+{
+  if (rank == 0)
+  {
+    return emptyFirstRank ? std::vector<vtkIdType>{ 0 } : std::vector<vtkIdType>{ 11 };
+  }
+  if (rank == 1)
+  {
+    return {};
+  }
+  return { 0, 5 * rank };
+}
+
+double GetValue(int rank, vtkIdType row)
+{
+  if (row % 4 == 3)
+  {
+    return vtkMath::Nan();
+  }
+  return static_cast<double>((row * 7 + rank * 3) % 10);
+}
+
+// Rows are identified by rank * 1000 + their row in the merged table of the
+// rank, hence rows with the same value are ordered by id.
+vtkSmartPointer<vtkPartitionedDataSet> MakeInput(int rank, bool emptyFirstRank)
+{
+  auto input = vtkSmartPointer<vtkPartitionedDataSet>::New();
+  vtkIdType row = 0;
+  for (vtkIdType size : GetPartitionSizes(rank, emptyFirstRank))
+  {
+    vtkNew<vtkDoubleArray> values;
+    values->SetName("value");
+    values->SetNumberOfTuples(size);
+    vtkNew<vtkIdTypeArray> ids;
+    ids->SetName("id");
+    ids->SetNumberOfTuples(size);
+    for (vtkIdType cc = 0; cc < size; ++cc, ++row)
+    {
+      values->SetValue(cc, GetValue(rank, row));
+      ids->SetValue(cc, rank * 1000 + row);
+    }
+
+    vtkNew<vtkTable> table;
+    table->AddColumn(values);
+    table->AddColumn(ids);
+    input->SetPartition(input->GetNumberOfPartitions(), table);
+  }
+  return input;
+}
+
+// Serial sort of the (value, id) rows of all ranks, NaNs last. `firstValue` is
+// the value of the first row of the first rank, if any.
+std::vector<std::pair<double, vtkIdType>> SerialSort(
+  int numRanks, double firstValue, bool emptyFirstRank)
+{
+  std::vector<std::pair<double, vtkIdType>> rows;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    vtkIdType row = 0;
+    for (vtkIdType size : GetPartitionSizes(rank, emptyFirstRank))
+    {
+      for (vtkIdType cc = 0; cc < size; ++cc, ++row)
+      {
+        rows.emplace_back(rank == 0 && row == 0 ? firstValue : GetValue(rank, row),
+          static_cast<vtkIdType>(rank * 1000 + row));
+      }
+    }
+  }
+  std::sort(rows.begin(), rows.end(),
+    [](const std::pair<double, vtkIdType>& a, const std::pair<double, vtkIdType>& b) {
+      const bool aNan = vtkMath::IsNan(a.first);
+      const bool bNan = vtkMath::IsNan(b.first);
+      if (aNan != bNan)
+      {
+        return bNan;
+      }
+      return (!aNan && a.first != b.first) ? a.first < b.first : a.second < b.second;
+    });
+  return rows;
+}
+
+// Requests every block in both orders on all ranks and compares them with
+// `expected` on the first rank.
+bool CompareBlocks(vtkSortedTableStreamer* streamer,
+  const std::vector<std::pair<double, vtkIdType>>& expected, int rank)
+{
+  bool success = true;
+  const vtkIdType total = static_cast<vtkIdType>(expected.size());
+  const vtkIdType numberOfBlocks = (total + BlockSize - 1) / BlockSize;
+  for (int invert = 0; invert < 2; ++invert)
+  {
+    streamer->SetInvertOrder(invert);
+    for (vtkIdType block = 0; block < numberOfBlocks; ++block)
+    {
+      streamer->SetBlock(block);
+      streamer->Update();
+      if (rank != 0 || !success)
+      {
+        continue;
+      }
+
+      vtkTable* output = streamer->GetOutput();
+      auto values = vtkDataArray::SafeDownCast(output->GetColumnByName("value"));
+      auto ids = vtkDataArray::SafeDownCast(output->GetColumnByName("id"));
+      const vtkIdType first = block * BlockSize;
+      const vtkIdType size = std::min(BlockSize, total - first);
+      if (!values || !ids || output->GetNumberOfRows() != size)
+      {
+        vtkLogF(ERROR, "Block %lld (inverted=%d) has %lld rows instead of %lld.",
+          static_cast<long long>(block), invert, static_cast<long long>(output->GetNumberOfRows()),
+          static_cast<long long>(size));
+        success = false;
+        continue;
+      }
+      for (vtkIdType row = 0; row < size && success; ++row)
+      {
+        const auto& item = expected[invert ? total - 1 - first - row : first + row];
+        const double value = values->GetTuple1(row);
+        const bool sameValue =
+          vtkMath::IsNan(item.first) ? vtkMath::IsNan(value) : value == item.first;
+        if (!sameValue || static_cast<vtkIdType>(ids->GetTuple1(row)) != item.second)
+        {
+          vtkLogF(ERROR,
+            "Block %lld (inverted=%d), row %lld: got (%g, %lld), expected (%g, %lld).",
+            static_cast<long long>(block), invert, static_cast<long long>(row), value,
+            static_cast<long long>(ids->GetTuple1(row)), item.first,
+            static_cast<long long>(item.second));
+          success = false;
+        }
+      }
+    }
+  }
+  return success;
+}
+
+bool CheckIndexBuilds(vtkSortedTableStreamer* streamer, int expected)
+{
+  if (streamer->GetNumberOfIndexBuilds() != expected)
+  {
+    vtkLogF(ERROR, "Expected %d index builds, got %d.", expected,
+      streamer->GetNumberOfIndexBuilds());
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSortedTableStreamerMPI(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int rank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  int success = 1;
+  if (numRanks < 3)
+  {
+    vtkLogF(ERROR, "This test requires at least 3 ranks, got %d.", numRanks);
+    success = 0;
+  }
+  else
+  {
+    auto input = MakeInput(rank, false);
+    vtkNew<vtkSortedTableStreamer> streamer;
+    streamer->SetController(contr);
+    streamer->SetInputData(input);
+    streamer->SetSelectedComponent(0);
+    streamer->SetBlockSize(BlockSize);
+    streamer->SetColumnNameToSort("value");
+
+    // Blocks are requested on all ranks even after a failure, the requests are
+    // collective. Both orders read the same index.
+    auto expected = SerialSort(numRanks, GetValue(0, 0), false);
+    bool ok = CompareBlocks(streamer, expected, rank);
+    ok = CheckIndexBuilds(streamer, 1) && ok;
+
+    // Sorting by another column and back reuses the index of "value".
+    streamer->SetInvertOrder(0);
+    streamer->SetColumnNameToSort("id");
+    streamer->SetBlock(0);
+    streamer->Update();
+    streamer->SetColumnNameToSort("value");
+    streamer->Modified();
+    ok = CompareBlocks(streamer, expected, rank) && ok;
+    ok = CheckIndexBuilds(streamer, 2) && ok;
+
+    // Modifying the sorted array in place sorts again on all ranks, even though
+    // the input dataset itself is not modified.
+    if (rank == 0)
+    {
+      auto table = vtkTable::SafeDownCast(input->GetPartitionAsDataObject(0));
+      auto values = vtkDoubleArray::SafeDownCast(table->GetColumnByName("value"));
+      values->SetValue(0, -1.0);
+      values->Modified();
+    }
+    streamer->Modified();
+    expected = SerialSort(numRanks, -1.0, false);
+    ok = CompareBlocks(streamer, expected, rank) && ok;
+    ok = CheckIndexBuilds(streamer, 3) && ok;
+
+    // The first rank holds no rows but still picks the splitters and merges
+    // the rows of every block from the other ranks.
+    auto emptyFirstInput = MakeInput(rank, true);
+    vtkNew<vtkSortedTableStreamer> emptyFirstStreamer;
+    emptyFirstStreamer->SetController(contr);
+    emptyFirstStreamer->SetInputData(emptyFirstInput);
+    emptyFirstStreamer->SetSelectedComponent(0);
+    emptyFirstStreamer->SetBlockSize(BlockSize);
+    emptyFirstStreamer->SetColumnNameToSort("value");
+    expected = SerialSort(numRanks, 0.0, true);
+    ok = CompareBlocks(emptyFirstStreamer, expected, rank) && ok;
+    ok = CheckIndexBuilds(emptyFirstStreamer, 1) && ok;
+    success = ok ? 1 : 0;
+  }
+
+  int allSuccess = 0;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
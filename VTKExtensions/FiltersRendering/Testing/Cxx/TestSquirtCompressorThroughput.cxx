@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Measures vtkSquirtCompressor throughput (MB/s) as a function of the number
+// of threads and the squirt level, and checks that banded streams decode to
+// the same image as the legacy single-stream format.
+
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <vtksys/CommandLineArguments.hxx>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+// Fill a RGBA/RGB image with flat regions and gradients so that both long
+// and short runs are exercised.
+void FillImage(vtkUnsignedCharArray* image, int width, int height, int numComps)
+{
+  image->SetNumberOfComponents(numComps);
+  image->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+  unsigned char* ptr = image->GetPointer(0);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      const bool background = ((x / 64) + (y / 64)) % 3 == 0;
+      ptr[0] = background ? 32 : static_cast<unsigned char>(x);
+      ptr[1] = background ? 32 : static_cast<unsigned char>(y);
+      ptr[2] = background ? 64 : static_cast<unsigned char>((x + y) / 4);
+      if (numComps == 4)
+      {
+        ptr[3] = background ? 0 : 255;
+      }
+      ptr += numComps;
+    }
+  }
+}
+
+// Squirt keeps only the upper 4 bits of the opacity, even at the lossless
+// level, so compare the opacity of RGBA images after quantizing it.
+bool MatchesLossless(vtkUnsignedCharArray* decoded, vtkUnsignedCharArray* input)
+{
+  const int numComps = input->GetNumberOfComponents();
+  const unsigned char* decodedPtr = decoded->GetPointer(0);
+  const unsigned char* inputPtr = input->GetPointer(0);
+  for (vtkIdType ii = 0; ii < input->GetNumberOfValues(); ++ii)
+  {
+    const unsigned char expected =
+      (numComps == 4 && ii % 4 == 3) ? (inputPtr[ii] & 0xF0) : inputPtr[ii];
+    if (decodedPtr[ii] != expected)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RoundTrip(vtkSquirtCompressor* compressor, vtkUnsignedCharArray* input,
+  vtkUnsignedCharArray* result, double& compressTime, double& decompressTime)
+{
+  vtkNew<vtkUnsignedCharArray> compressed;
+  result->SetNumberOfComponents(input->GetNumberOfComponents());
+  result->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  vtkNew<vtkTimerLog> timer;
+  compressor->SetInput(input);
+  compressor->SetOutput(compressed);
+  timer->StartTimer();
+  if (compressor->Compress() != VTK_OK)
+  {
+    return false;
+  }
+  timer->StopTimer();
+  compressTime += timer->GetElapsedTime();
+
+  compressor->SetInput(compressed);
+  compressor->SetOutput(result);
+  timer->StartTimer();
+  if (compressor->Decompress() != VTK_OK)
+  {
+    return false;
+  }
+  timer->StopTimer();
+  decompressTime += timer->GetElapsedTime();
+  return true;
+}
+}
+
+int TestSquirtCompressorThroughput(int argc, char* argv[])
+{
+  int width = 960;
+  int height = 540;
+  int iterations = 2;
+
+  // Use e.g. `--width=3840 --height=2160 --iterations=20` for benchmarking.
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--width", argT::EQUAL_ARGUMENT, &width, "Image width.");
+  arg.AddArgument("--height", argT::EQUAL_ARGUMENT, &height, "Image height.");
+  arg.AddArgument("--iterations", argT::EQUAL_ARGUMENT, &iterations, "Number of iterations.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  const int maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  bool success = true;
+  for (int numComps = 3; numComps <= 4; ++numComps)
+  {
+    vtkNew<vtkUnsignedCharArray> input;
+    FillImage(input, width, height, numComps);
+    const double megaBytes =
+      static_cast<double>(input->GetNumberOfValues()) * iterations / (1024.0 * 1024.0);
+
+    for (int level : { 0, 3, 5 })
+    {
+      // Reference: legacy single-stream format, the default.
+      vtkNew<vtkSquirtCompressor> legacy;
+      legacy->SetSquirtLevel(level);
+      if (legacy->GetNumberOfBands() != 1)
+      {
+        cerr << "The legacy format is not the default." << endl;
+        return TEST_FAILED;
+      }
+      vtkNew<vtkUnsignedCharArray> expected;
+      double compressTime = 0, decompressTime = 0;
+      if (!RoundTrip(legacy, input, expected, compressTime, decompressTime))
+      {
+        cerr << "Legacy round trip failed." << endl;
+        return TEST_FAILED;
+      }
+      if (level == 0 && !MatchesLossless(expected, input))
+      {
+        cerr << "Lossless legacy round trip does not reproduce the input." << endl;
+        return TEST_FAILED;
+      }
+
+      // A compressor configured for banding falls back to the legacy format
+      // for streams without a band index.
+      {
+        vtkNew<vtkUnsignedCharArray> compressed;
+        legacy->SetInput(input);
+        legacy->SetOutput(compressed);
+        legacy->Compress();
+        vtkNew<vtkSquirtCompressor> fallback;
+        fallback->SetNumberOfBands(0);
+        vtkNew<vtkUnsignedCharArray> result;
+        result->SetNumberOfComponents(numComps);
+        result->SetNumberOfTuples(input->GetNumberOfTuples());
+        fallback->SetInput(compressed);
+        fallback->SetOutput(result);
+        if (fallback->Decompress() != VTK_OK ||
+          memcmp(result->GetPointer(0), expected->GetPointer(0), input->GetNumberOfValues()) != 0)
+        {
+          cerr << "Legacy stream is not decoded by a banded compressor." << endl;
+          return TEST_FAILED;
+        }
+      }
+
+      for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+      {
+        vtkSMPTools::LocalScope(vtkSMPTools::Config{ numThreads }, [&]() {
+          vtkNew<vtkSquirtCompressor> banded;
+          banded->SetSquirtLevel(level);
+          banded->SetNumberOfBands(numThreads);
+          vtkNew<vtkUnsignedCharArray> result;
+          compressTime = decompressTime = 0;
+          for (int cc = 0; cc < iterations; ++cc)
+          {
+            if (!RoundTrip(banded, input, result, compressTime, decompressTime))
+            {
+              cerr << "Banded round trip failed." << endl;
+              success = false;
+              return;
+            }
+          }
+          // Bands only break runs at their boundaries, for the lossless level
+          // the decoded image must be identical.
+          if (level == 0 &&
+            memcmp(result->GetPointer(0), expected->GetPointer(0), input->GetNumberOfValues()) !=
+              0)
+          {
+            cerr << "Banded round trip does not match the legacy format." << endl;
+            success = false;
+            return;
+          }
+          cout << "components: " << numComps << " squirt-level: " << level
+               << " threads: " << numThreads
+               << " compress: " << megaBytes / std::max(compressTime, 1e-9) << " MB/s"
+               << " decompress: " << megaBytes / std::max(decompressTime, 1e-9) << " MB/s"
+               << endl;
+        });
+        if (!success)
+        {
+          return TEST_FAILED;
+        }
+      }
+    }
+  }
+  return TEST_SUCCESS;
+}
@@ -10,19 +10,34 @@
 #include "vtkGenericDataObjectWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMPIMoveData.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataObjectSerializer.h"
 #include "vtkPVSession.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkSelection.h"
 #include "vtkSelectionSerializer.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <memory>
 #include <sstream>
 
+namespace
+{
+// Encodings of non-selection data objects, sent before the data itself.
+enum
+{
+  DATA_OBJECT_ENCODING = 0,
+  RAW_ARRAYS_ENCODING = 1
+};
+}
+
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
@@ -227,7 +242,30 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
-  return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  // Use the same encoding settings as vtkMPIMoveData.
+  vtkNew<vtkPVDataObjectSerializer> serializer;
+  serializer->SetCompression(vtkMPIMoveData::GetCompressionMethod());
+  if (vtkMPIMoveData::GetCompressionMethod() == vtkPVDataObjectSerializer::NO_COMPRESSION &&
+    vtkMPIMoveData::GetUseZLibCompression())
+  {
+    serializer->SetCompression(vtkPVDataObjectSerializer::ZLIB);
+  }
+  char* buffer = nullptr;
+  vtkIdType length = 0;
+  const int encoding =
+    vtkMPIMoveData::GetUseRawArraysEncoding() && serializer->Serialize(input, buffer, length)
+    ? RAW_ARRAYS_ENCODING
+    : DATA_OBJECT_ENCODING;
+  controller->Send(&encoding, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  if (encoding == DATA_OBJECT_ENCODING)
+  {
+    return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
+  controller->Send(&length, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  const int result =
+    controller->Send(buffer, length, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  delete[] buffer;
+  return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -256,7 +294,27 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   }
   else
   {
-    data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    int encoding = DATA_OBJECT_ENCODING;
+    controller->Receive(&encoding, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    if (encoding == DATA_OBJECT_ENCODING)
+    {
+      return controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+
+    vtkIdType length = 0;
+    controller->Receive(&length, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    char* buffer = new char[length];
+    // arrays share `storage`, it is released along with them.
+    std::shared_ptr<const char> storage(buffer, std::default_delete<char[]>());
+    controller->Receive(buffer, length, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    vtkSmartPointer<vtkDataObject> result =
+      vtkPVDataObjectSerializer::Deserialize(buffer, length, storage);
+    data = result;
+    if (data)
+    {
+      // the caller releases the returned data object.
+      data->Register(nullptr);
+    }
   }
   return data;
 }
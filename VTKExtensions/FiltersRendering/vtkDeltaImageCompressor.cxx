@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int DELTA_FRAME_MAGIC = 0x544c4544; // "DELT"
+
+// Header preceding every compressed frame. For delta frames, it is followed
+// by a bitmap with one bit per tile and then by the LZ4 compressed pixels of
+// the dirty tiles, packed row by row in tile order. For key frames, it is
+// directly followed by the LZ4 compressed image.
+struct vtkDeltaFrameHeader
+{
+  unsigned int Magic;
+  unsigned int KeyFrame;
+  unsigned int Width;
+  unsigned int Height;
+  unsigned int NumberOfComponents;
+  unsigned int TileSize;
+  unsigned int BaseFrameId;
+  unsigned int FrameId;
+  unsigned int PayloadSize;
+  unsigned int CompressedPayloadSize;
+};
+
+// Tile layout of an image.
+struct vtkTileLayout
+{
+  vtkIdType Width;
+  vtkIdType Height;
+  vtkIdType NumberOfComponents;
+  vtkIdType TileSize;
+  vtkIdType TilesX;
+  vtkIdType TilesY;
+
+  vtkTileLayout(vtkIdType width, vtkIdType height, vtkIdType numComps, vtkIdType tileSize)
+    : Width(width)
+    , Height(height)
+    , NumberOfComponents(numComps)
+    , TileSize(tileSize)
+    , TilesX((width + tileSize - 1) / tileSize)
+    , TilesY((height + tileSize - 1) / tileSize)
+  {
+  }
+
+  vtkIdType GetNumberOfTiles() const { return this->TilesX * this->TilesY; }
+
+  // Returns the byte offset of the first pixel, the number of bytes per row
+  // and the number of rows of the tile.
+  void GetTile(vtkIdType tile, vtkIdType& offset, vtkIdType& rowBytes, vtkIdType& rows) const
+  {
+    const vtkIdType x0 = (tile % this->TilesX) * this->TileSize;
+    const vtkIdType y0 = (tile / this->TilesX) * this->TileSize;
+    rowBytes = (std::min(x0 + this->TileSize, this->Width) - x0) * this->NumberOfComponents;
+    rows = std::min(y0 + this->TileSize, this->Height) - y0;
+    offset = (y0 * this->Width + x0) * this->NumberOfComponents;
+  }
+
+  vtkIdType GetRowStride() const { return this->Width * this->NumberOfComponents; }
+};
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : TileSize(32)
+  , KeyFrameInterval(0)
+  , Width(0)
+  , Height(0)
+  , ReferenceDimensions{ 0, 0 }
+  , FrameId(0)
+  , FramesSinceKeyFrame(0)
+  , LastFrameWasKeyFrame(false)
+  , LastNumberOfDirtyTiles(0)
+  , LastNumberOfTiles(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::ForceKeyFrame()
+{
+  this->FrameId = 0;
+  this->Reference->Initialize();
+  this->ReferenceDimensions[0] = this->ReferenceDimensions[1] = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  this->Width = width;
+  this->Height = height;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  vtkIdType width = this->Width;
+  vtkIdType height = this->Height;
+  if (width * height != numPixels)
+  {
+    width = numPixels;
+    height = 1;
+  }
+
+  const bool keyFrame = this->FrameId == 0 || this->ReferenceDimensions[0] != width ||
+    this->ReferenceDimensions[1] != height ||
+    this->Reference->GetNumberOfComponents() != numComps ||
+    (this->KeyFrameInterval > 0 && this->FramesSinceKeyFrame >= this->KeyFrameInterval);
+
+  const vtkTileLayout layout(width, height, numComps, this->TileSize);
+  const vtkIdType numTiles = layout.GetNumberOfTiles();
+  const vtkIdType bitmapSize = keyFrame ? 0 : (numTiles + 7) / 8;
+  std::vector<unsigned char> dirty(numTiles, keyFrame ? 1 : 0);
+
+  const unsigned char* src = input->GetPointer(0);
+  const unsigned char* payload = src;
+  vtkIdType payloadSize = numPixels * numComps;
+  vtkIdType numDirtyTiles = numTiles;
+  if (!keyFrame)
+  {
+    // Find the tiles that changed since the reference frame.
+    unsigned char* ref = this->Reference->GetPointer(0);
+    vtkSMPTools::For(0, numTiles, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType tile = first; tile < last; ++tile)
+      {
+        vtkIdType offset, rowBytes, rows;
+        layout.GetTile(tile, offset, rowBytes, rows);
+        for (vtkIdType row = 0; row < rows; ++row, offset += layout.GetRowStride())
+        {
+          if (memcmp(src + offset, ref + offset, rowBytes) != 0)
+          {
+            dirty[tile] = 1;
+            break;
+          }
+        }
+      }
+    });
+
+    // Pack the dirty tiles and update the reference frame with them.
+    numDirtyTiles = 0;
+    payloadSize = 0;
+    this->TileBuffer->SetNumberOfTuples(numPixels * numComps);
+    unsigned char* packed = this->TileBuffer->GetPointer(0);
+    for (vtkIdType tile = 0; tile < numTiles; ++tile)
+    {
+      if (dirty[tile])
+      {
+        vtkIdType offset, rowBytes, rows;
+        layout.GetTile(tile, offset, rowBytes, rows);
+        for (vtkIdType row = 0; row < rows; ++row, offset += layout.GetRowStride())
+        {
+          memcpy(packed + payloadSize, src + offset, rowBytes);
+          memcpy(ref + offset, src + offset, rowBytes);
+          payloadSize += rowBytes;
+        }
+        ++numDirtyTiles;
+      }
+    }
+    payload = packed;
+  }
+  else
+  {
+    this->Reference->DeepCopy(input);
+    this->ReferenceDimensions[0] = static_cast<int>(width);
+    this->ReferenceDimensions[1] = static_cast<int>(height);
+  }
+
+  vtkDeltaFrameHeader header;
+  header.Magic = DELTA_FRAME_MAGIC;
+  header.KeyFrame = keyFrame ? 1 : 0;
+  header.Width = static_cast<unsigned int>(width);
+  header.Height = static_cast<unsigned int>(height);
+  header.NumberOfComponents = static_cast<unsigned int>(numComps);
+  header.TileSize = static_cast<unsigned int>(this->TileSize);
+  header.BaseFrameId = this->FrameId;
+  header.FrameId = this->FrameId + 1 == 0 ? 1 : this->FrameId + 1;
+  header.PayloadSize = static_cast<unsigned int>(payloadSize);
+
+  const int maxCompressedSize = LZ4_compressBound(static_cast<int>(payloadSize));
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* out = this->Output->WritePointer(0, sizeof(header) + bitmapSize + maxCompressedSize);
+  unsigned char* bitmap = out + sizeof(header);
+  std::fill(bitmap, bitmap + bitmapSize, 0);
+  if (!keyFrame)
+  {
+    for (vtkIdType tile = 0; tile < numTiles; ++tile)
+    {
+      bitmap[tile / 8] |= static_cast<unsigned char>(dirty[tile] << (tile % 8));
+    }
+  }
+
+  int compressedSize = 0;
+  if (payloadSize > 0)
+  {
+    compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(payload),
+      reinterpret_cast<char*>(bitmap + bitmapSize), static_cast<int>(payloadSize),
+      maxCompressedSize, 16);
+    if (compressedSize <= 0)
+    {
+      vtkErrorMacro("LZ4 compression failed.");
+      this->ForceKeyFrame();
+      return VTK_ERROR;
+    }
+  }
+  header.CompressedPayloadSize = static_cast<unsigned int>(compressedSize);
+  memcpy(out, &header, sizeof(header));
+  this->Output->SetNumberOfTuples(sizeof(header) + bitmapSize + compressedSize);
+
+  this->FrameId = header.FrameId;
+  this->FramesSinceKeyFrame = keyFrame ? 1 : this->FramesSinceKeyFrame + 1;
+  this->LastFrameWasKeyFrame = keyFrame;
+  this->LastNumberOfDirtyTiles = numDirtyTiles;
+  this->LastNumberOfTiles = numTiles;
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType inputSize = this->Input->GetNumberOfValues();
+  const unsigned char* in = this->Input->GetPointer(0);
+  vtkDeltaFrameHeader header;
+  if (inputSize < static_cast<vtkIdType>(sizeof(header)))
+  {
+    vtkErrorMacro("Truncated delta frame.");
+    return VTK_ERROR;
+  }
+  memcpy(&header, in, sizeof(header));
+
+  vtkUnsignedCharArray* output = this->Output;
+  const vtkIdType width = header.Width;
+  const vtkIdType height = header.Height;
+  const int numComps = output->GetNumberOfComponents();
+  if (header.Magic != DELTA_FRAME_MAGIC || header.TileSize == 0 ||
+    static_cast<int>(header.NumberOfComponents) != numComps ||
+    width * height != output->GetNumberOfTuples())
+  {
+    vtkErrorMacro("Delta frame does not match the output image.");
+    this->ForceKeyFrame();
+    return VTK_ERROR;
+  }
+
+  const vtkTileLayout layout(width, height, numComps, header.TileSize);
+  const vtkIdType numTiles = layout.GetNumberOfTiles();
+  const vtkIdType bitmapSize = header.KeyFrame ? 0 : (numTiles + 7) / 8;
+  if (static_cast<vtkIdType>(sizeof(header)) + bitmapSize + header.CompressedPayloadSize >
+    inputSize)
+  {
+    vtkErrorMacro("Truncated delta frame.");
+    this->ForceKeyFrame();
+    return VTK_ERROR;
+  }
+  const unsigned char* bitmap = in + sizeof(header);
+  const char* payload = reinterpret_cast<const char*>(bitmap + bitmapSize);
+
+  if (header.KeyFrame)
+  {
+    const int size = LZ4_decompress_safe(payload, reinterpret_cast<char*>(output->GetPointer(0)),
+      static_cast<int>(header.CompressedPayloadSize), static_cast<int>(output->GetNumberOfValues()));
+    if (size != static_cast<int>(header.PayloadSize) || size != output->GetNumberOfValues())
+    {
+      vtkErrorMacro("Failed to decompress key frame.");
+      this->ForceKeyFrame();
+      return VTK_ERROR;
+    }
+    this->Reference->DeepCopy(output);
+    this->ReferenceDimensions[0] = static_cast<int>(width);
+    this->ReferenceDimensions[1] = static_cast<int>(height);
+    this->FrameId = header.FrameId;
+    this->LastFrameWasKeyFrame = true;
+    this->LastNumberOfDirtyTiles = numTiles;
+    this->LastNumberOfTiles = numTiles;
+    return VTK_OK;
+  }
+
+  if (this->FrameId == 0 || header.BaseFrameId != this->FrameId ||
+    this->ReferenceDimensions[0] != width || this->ReferenceDimensions[1] != height ||
+    this->Reference->GetNumberOfComponents() != numComps)
+  {
+    vtkErrorMacro("Delta frame received without the matching reference frame.");
+    this->ForceKeyFrame();
+    return VTK_ERROR;
+  }
+
+  if (header.PayloadSize > 0)
+  {
+    this->TileBuffer->SetNumberOfTuples(header.PayloadSize);
+    const int size = LZ4_decompress_safe(payload,
+      reinterpret_cast<char*>(this->TileBuffer->GetPointer(0)),
+      static_cast<int>(header.CompressedPayloadSize), static_cast<int>(header.PayloadSize));
+    if (size != static_cast<int>(header.PayloadSize))
+    {
+      vtkErrorMacro("Failed to decompress delta frame.");
+      this->ForceKeyFrame();
+      return VTK_ERROR;
+    }
+  }
+
+  // Apply the dirty tiles to the reference frame, which becomes the output.
+  unsigned char* ref = this->Reference->GetPointer(0);
+  const unsigned char* packed = this->TileBuffer->GetPointer(0);
+  vtkIdType consumed = 0;
+  vtkIdType numDirtyTiles = 0;
+  for (vtkIdType tile = 0; tile < numTiles; ++tile)
+  {
+    if ((bitmap[tile / 8] >> (tile % 8)) & 0x1)
+    {
+      vtkIdType offset, rowBytes, rows;
+      layout.GetTile(tile, offset, rowBytes, rows);
+      if (consumed + rowBytes * rows > header.PayloadSize)
+      {
+        vtkErrorMacro("Corrupted delta frame.");
+        this->ForceKeyFrame();
+        return VTK_ERROR;
+      }
+      for (vtkIdType row = 0; row < rows; ++row, offset += layout.GetRowStride())
+      {
+        memcpy(ref + offset, packed + consumed, rowBytes);
+        consumed += rowBytes;
+      }
+      ++numDirtyTiles;
+    }
+  }
+  memcpy(output->GetPointer(0), ref, output->GetNumberOfValues());
+
+  this->FrameId = header.FrameId;
+  this->LastFrameWasKeyFrame = false;
+  this->LastNumberOfDirtyTiles = numDirtyTiles;
+  this->LastNumberOfTiles = numTiles;
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->TileSize << this->KeyFrameInterval;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int tileSize, keyFrameInterval;
+    *stream >> tileSize >> keyFrameInterval;
+    this->SetTileSize(tileSize);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->ForceKeyFrame();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->TileSize << " "
+      << this->KeyFrameInterval;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int tileSize = 32, keyFrameInterval = 0;
+    iss >> tileSize >> keyFrameInterval;
+    this->SetTileSize(tileSize);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->ForceKeyFrame();
+    const std::streamoff offset = iss.tellg();
+    return offset < 0 ? stream + strlen(stream) : stream + offset;
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "LastFrameWasKeyFrame: " << this->LastFrameWasKeyFrame << endl;
+  os << indent << "LastNumberOfDirtyTiles: " << this->LastNumberOfDirtyTiles << endl;
+  os << indent << "LastNumberOfTiles: " << this->LastNumberOfTiles << endl;
+}
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor that only sends the tiles that
+ * changed since the previous frame.
+ *
+ * vtkDeltaImageCompressor keeps the last frame it compressed (resp.
+ * decompressed) and splits every new frame into square tiles of TileSize
+ * pixels. Only the tiles that differ from the previous frame are sent,
+ * together with a bitmap of the dirty tiles. The tile payload is compressed
+ * with LZ4. This is very effective for interactions that keep the camera
+ * still (color map edits, widget interactions, annotations) where most of the
+ * image does not change between frames.
+ *
+ * A full frame (key frame) is sent for the first frame, whenever the image
+ * resolution or number of components changes, every KeyFrameInterval frames
+ * (if non-zero) and after ForceKeyFrame() is called. Both ends of the
+ * connection must process every frame in order, which is guaranteed by the
+ * reliable transport used by the synchronized renderers. A delta frame that
+ * does not match the decompressor's reference frame is rejected and the
+ * reference frame is discarded. The decompressing end must then ask the
+ * compressing end for a key frame, see HasReferenceFrame(),
+ * vtkPVClientServerSynchronizedRenderers does so at the start of the next
+ * render.
+ *
+ * The compression is always lossless, LossLessMode is ignored.
+ *
+ * The configuration stream format is:
+ * `vtkDeltaImageCompressor <losslessmode> <tilesize> <keyframeinterval>`.
+ *
+ * @sa vtkPVClientServerSynchronizedRenderers
+ */
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkNew.h"                                   // needed for vtkNew
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set the width and height in pixels of the tiles used to detect changes.
+   * Default is 32.
+   */
+  vtkSetClampMacro(TileSize, int, 4, 1024);
+  vtkGetMacro(TileSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the number of frames after which a key frame is sent even if the
+   * resolution did not change. 0 (default) means key frames are only sent
+   * when needed.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  ///@}
+
+  /**
+   * Discard the reference frame so that the next frame compressed or
+   * decompressed is a key frame. Must be called on both ends.
+   */
+  void ForceKeyFrame();
+
+  /**
+   * Returns false when there is no reference frame, i.e. before the first
+   * frame, after ForceKeyFrame() or after a delta frame was rejected. On the
+   * decompressing end, this means the compressing end must be asked for a key
+   * frame, otherwise all further delta frames are rejected.
+   */
+  bool HasReferenceFrame() const { return this->FrameId != 0; }
+
+  ///@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  ///@}
+
+  /**
+   * Communicates the next expected image resolution, used to lay out the
+   * tiles. When the resolution does not match the number of pixels of the
+   * input, the image is treated as a single row of pixels.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  ///@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   * Restoring a configuration forces a key frame.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  ///@}
+
+  ///@{
+  /**
+   * Statistics about the last compressed/decompressed frame: whether it was a
+   * key frame and how many tiles were sent.
+   */
+  vtkGetMacro(LastFrameWasKeyFrame, bool);
+  vtkGetMacro(LastNumberOfDirtyTiles, vtkIdType);
+  vtkGetMacro(LastNumberOfTiles, vtkIdType);
+  ///@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int TileSize;
+  int KeyFrameInterval;
+
+  int Width;
+  int Height;
+  int ReferenceDimensions[2];
+
+  // Identifier of the frame held in Reference, 0 when there is none.
+  unsigned int FrameId;
+  int FramesSinceKeyFrame;
+
+  bool LastFrameWasKeyFrame;
+  vtkIdType LastNumberOfDirtyTiles;
+  vtkIdType LastNumberOfTiles;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  // Last frame sent or received.
+  vtkNew<vtkUnsignedCharArray> Reference;
+  // Dirty tiles, packed, before LZ4 compression.
+  vtkNew<vtkUnsignedCharArray> TileBuffer;
+};
+
+#endif
@@ -17,23 +17,53 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
+#include "vtkPVDataObjectSerializer.h"
 #include "vtkPVLogger.h"
+#include "vtkPVProfiler.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
 #include "vtkProcessModule.h"
 #include "vtkSmartPointer.h"
+#include "vtkSocket.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTimerLog.h"
+#include "vtkWeakPointer.h"
 
 #include "vtk_zlib.h"
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <vector>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include <windows.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 bool vtkMPIMoveData::UseZLibCompression = false;
+bool vtkMPIMoveData::UseSharedMemory = true;
+bool vtkMPIMoveData::UseRawArraysEncoding = true;
+int vtkMPIMoveData::CompressionMethod = vtkPVDataObjectSerializer::NO_COMPRESSION;
 
 namespace
 {
@@ -42,6 +72,220 @@ bool vtkMPIMoveDataMerge(std::vector<vtkSmartPointer<vtkDataObject>>& pieces, vt
   return vtkMultiProcessControllerHelper::MergePieces(pieces, result);
 }
 
+// Tags used to move data between the data-server and the client.
+enum
+{
+  NUMBER_OF_BUFFERS_TAG = 23490,
+  BUFFER_LENGTHS_TAG = 23491,
+  BUFFERS_TAG = 23492,
+  SHARED_MEMORY_TAG = 23493,
+  SHARED_MEMORY_ACK_TAG = 23494
+};
+
+// Value sent instead of the number of buffers to tell the client that the
+// buffers are available in a shared memory segment.
+constexpr int SHARED_MEMORY_BUFFERS = -1;
+
+//-----------------------------------------------------------------------------
+// A named shared memory segment. The data-server creates the segment and
+// writes the marshaled buffers in it, the client maps it and reconstructs the
+// data directly from the mapping instead of receiving the buffers over the
+// socket.
+class vtkMPIMoveDataSharedMemory
+{
+public:
+  vtkMPIMoveDataSharedMemory() = default;
+  ~vtkMPIMoveDataSharedMemory() { this->Release(); }
+  vtkMPIMoveDataSharedMemory(const vtkMPIMoveDataSharedMemory&) = delete;
+  void operator=(const vtkMPIMoveDataSharedMemory&) = delete;
+
+  // Creates a new segment of `size` bytes, mapped for writing.
+  bool Create(size_t size)
+  {
+    static std::atomic<unsigned int> counter{ 0 };
+    std::ostringstream name;
+#if defined(_WIN32)
+    name << "Local\\pvmovedata-" << GetCurrentProcessId() << "-" << counter++;
+    this->Name = name.str();
+    const ULARGE_INTEGER lsize = { { static_cast<DWORD>(static_cast<unsigned long long>(size)),
+      static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32) } };
+    this->Handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+      lsize.HighPart, lsize.LowPart, this->Name.c_str());
+    if (this->Handle == nullptr)
+    {
+      return false;
+    }
+    this->Pointer = MapViewOfFile(this->Handle, FILE_MAP_WRITE, 0, 0, size);
+#else
+    // keep the name short, macOS limits it to 31 characters.
+    name << "/pvmd-" << getpid() << "-" << counter++;
+    this->Name = name.str();
+    const int fd = shm_open(this->Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+      return false;
+    }
+    this->Owner = true;
+#if defined(__linux__)
+    // ftruncate() does not reserve the pages of a tmpfs segment, writing to
+    // the mapping would raise SIGBUS if /dev/shm is full. Reserve them now so
+    // the caller falls back to the socket instead.
+    const bool sized = posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0;
+#else
+    const bool sized = ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+    if (sized)
+    {
+      this->Pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      this->Pointer = this->Pointer == MAP_FAILED ? nullptr : this->Pointer;
+    }
+    close(fd);
+#endif
+    this->Size = size;
+    return this->Pointer != nullptr;
+  }
+
+  // Maps the segment `name` of `size` bytes created by a peer. The mapping is
+  // copy-on-write since reconstructed arrays may share it and be modified.
+  bool Open(const std::string& name, size_t size)
+  {
+    this->Name = name;
+    this->Size = size;
+#if defined(_WIN32)
+    this->Handle = OpenFileMappingA(FILE_MAP_COPY, FALSE, this->Name.c_str());
+    if (this->Handle == nullptr)
+    {
+      return false;
+    }
+    this->Pointer = MapViewOfFile(this->Handle, FILE_MAP_COPY, 0, 0, size);
+#else
+    const int fd = shm_open(this->Name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+      return false;
+    }
+    this->Pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    this->Pointer = this->Pointer == MAP_FAILED ? nullptr : this->Pointer;
+    close(fd);
+#endif
+    return this->Pointer != nullptr;
+  }
+
+  // Unmaps the segment. The segment is removed once both sides released it.
+  void Release()
+  {
+#if defined(_WIN32)
+    if (this->Pointer)
+    {
+      UnmapViewOfFile(this->Pointer);
+    }
+    if (this->Handle)
+    {
+      CloseHandle(this->Handle);
+      this->Handle = nullptr;
+    }
+#else
+    if (this->Pointer)
+    {
+      munmap(this->Pointer, this->Size);
+    }
+    if (this->Owner)
+    {
+      // the name is not needed anymore, existing mappings stay valid.
+      shm_unlink(this->Name.c_str());
+      this->Owner = false;
+    }
+#endif
+    this->Pointer = nullptr;
+    this->Size = 0;
+  }
+
+  char* GetPointer() const { return static_cast<char*>(this->Pointer); }
+  const std::string& GetName() const { return this->Name; }
+
+private:
+  std::string Name;
+  void* Pointer = nullptr;
+  size_t Size = 0;
+#if defined(_WIN32)
+  HANDLE Handle = nullptr;
+#else
+  bool Owner = false;
+#endif
+};
+
+//-----------------------------------------------------------------------------
+// Returns true if the peer of the socket controller is connected through the
+// loopback interface, i.e. it runs on this host.
+bool vtkMPIMoveDataIsPeerLocal(vtkMultiProcessController* controller)
+{
+  vtkSocketCommunicator* comm =
+    vtkSocketCommunicator::SafeDownCast(controller ? controller->GetCommunicator() : nullptr);
+  vtkSocket* socket = comm ? comm->GetSocket() : nullptr;
+  if (!socket || !socket->GetConnected())
+  {
+    return false;
+  }
+  sockaddr_storage address;
+#if defined(_WIN32)
+  int length = sizeof(address);
+#else
+  socklen_t length = sizeof(address);
+#endif
+  if (getpeername(socket->GetSocketDescriptor(), reinterpret_cast<sockaddr*>(&address), &length) !=
+    0)
+  {
+    return false;
+  }
+  if (address.ss_family == AF_INET)
+  {
+    const auto* ipv4 = reinterpret_cast<const sockaddr_in*>(&address);
+    return (ntohl(ipv4->sin_addr.s_addr) >> 24) == 127;
+  }
+  if (address.ss_family == AF_INET6)
+  {
+    const auto* ipv6 = reinterpret_cast<const sockaddr_in6*>(&address);
+    return IN6_IS_ADDR_LOOPBACK(&ipv6->sin6_addr) != 0;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+// Connections whose client could not map a shared memory segment, e.g. because
+// it is connected through an SSH tunnel or runs in another container. The
+// socket is used for them from then on. Keyed on the controller, whose address
+// may be reused once it is deleted, hence the weak pointer.
+class vtkMPIMoveDataSharedMemoryFailures
+{
+public:
+  bool Contains(vtkMultiProcessController* controller)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Controllers.find(controller);
+    return iter != this->Controllers.end() && iter->second.GetPointer() == controller;
+  }
+
+  void Insert(vtkMultiProcessController* controller)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Controllers.begin(); iter != this->Controllers.end();)
+    {
+      iter = iter->second.GetPointer() ? std::next(iter) : this->Controllers.erase(iter);
+    }
+    this->Controllers[controller] = controller;
+  }
+
+private:
+  std::mutex Mutex;
+  std::map<vtkMultiProcessController*, vtkWeakPointer<vtkMultiProcessController>> Controllers;
+};
+
+vtkMPIMoveDataSharedMemoryFailures& GetSharedMemoryFailures()
+{
+  static vtkMPIMoveDataSharedMemoryFailures failures;
+  return failures;
+}
+
 void unsetGlobalIdsAttribute(vtkDataObject* piece)
 {
   vtkDataSet* ds = vtkDataSet::SafeDownCast(piece);
@@ -158,12 +402,48 @@ void vtkMPIMoveData::SetUseZLibCompression(bool b)
   vtkMPIMoveData::UseZLibCompression = b;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseSharedMemory(bool b)
+{
+  vtkMPIMoveData::UseSharedMemory = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseSharedMemory()
+{
+  return vtkMPIMoveData::UseSharedMemory;
+}
+
 //----------------------------------------------------------------------------
 bool vtkMPIMoveData::GetUseZLibCompression()
 {
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseRawArraysEncoding(bool b)
+{
+  vtkMPIMoveData::UseRawArraysEncoding = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseRawArraysEncoding()
+{
+  return vtkMPIMoveData::UseRawArraysEncoding;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionMethod(int method)
+{
+  vtkMPIMoveData::CompressionMethod = method;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompressionMethod()
+{
+  return vtkMPIMoveData::CompressionMethod;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -540,6 +820,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-all");
+  vtkPVProfiler::Scope scope("delivery", "vtkMPIMoveData gather-all");
 
   int idx;
   auto com = this->Controller->GetCommunicator();
@@ -580,6 +861,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
   this->Buffers = new char[this->BufferTotalLength];
   com->AllGatherV(
     inBuffer, this->Buffers, inBufferLength, this->BufferLengths, this->BufferOffsets);
+  scope.AddBytes(this->BufferTotalLength);
 
   this->ReconstructDataFromBuffer(output);
 
@@ -613,6 +895,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
   vtkTimerLog::MarkStartEvent("Dataserver gathering to 0");
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-to-0");
+  vtkPVProfiler::Scope scope("delivery", "vtkMPIMoveData gather-to-0");
   int idx;
   int myId = this->Controller->GetLocalProcessId();
   auto com = this->Controller->GetCommunicator();
@@ -658,6 +941,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
   }
   com->GatherV(
     inBuffer, this->Buffers, inBufferLength, this->BufferLengths, this->BufferOffsets, 0);
+  scope.AddBytes(myId == 0 ? this->BufferTotalLength : inBufferLength);
   this->NumberOfBuffers = numProcs;
 
   if (myId == 0)
@@ -687,6 +971,7 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver");
+  vtkPVProfiler::Scope scope("delivery", "vtkMPIMoveData send-to-renderserver");
 
   // int fixme;
   // We might be able to eliminate this marshal.
@@ -696,6 +981,7 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
   com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
   com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
   com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  scope.AddBytes(this->BufferTotalLength);
 }
 
 //-----------------------------------------------------------------------------
@@ -710,6 +996,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  vtkPVProfiler::Scope scope("delivery", "vtkMPIMoveData receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -725,6 +1012,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
   }
   this->Buffers = new char[this->BufferTotalLength];
   com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+  scope.AddBytes(this->BufferTotalLength);
 
   // int fixme;  // Can we avoid this?
   this->ReconstructDataFromBuffer(output);
@@ -748,6 +1036,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     }
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver-root");
+    vtkPVProfiler::Scope scope("delivery", "vtkMPIMoveData send-to-renderserver-root");
 
     // int fixme;
     // We might be able to eliminate this marshal.
@@ -756,6 +1045,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
     com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
     com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+    scope.AddBytes(this->BufferTotalLength);
     this->ClearBuffer();
   }
 }
@@ -776,6 +1066,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
     }
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver-root");
+    vtkPVProfiler::Scope scope("delivery", "vtkMPIMoveData receive-from-dataserver-root");
 
     this->ClearBuffer();
     com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -791,6 +1082,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
     }
     this->Buffers = new char[this->BufferTotalLength];
     com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+    scope.AddBytes(this->BufferTotalLength);
 
     // int fixme;  // Can we avoid this?
     this->ReconstructDataFromBuffer(data);
@@ -814,10 +1106,15 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
     this->ClearBuffer();
     this->MarshalDataToBuffer(output);
-    this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
-    this->ClientDataServerSocketController->Send(
-      this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-    this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
+    if (!this->SendToClientUsingSharedMemory())
+    {
+      this->ClientDataServerSocketController->Send(
+        &(this->NumberOfBuffers), 1, 1, NUMBER_OF_BUFFERS_TAG);
+      this->ClientDataServerSocketController->Send(
+        this->BufferLengths, this->NumberOfBuffers, 1, BUFFER_LENGTHS_TAG);
+      this->ClientDataServerSocketController->Send(
+        this->Buffers, this->BufferTotalLength, 1, BUFFERS_TAG);
+    }
     this->ClearBuffer();
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
   }
@@ -837,9 +1134,18 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
   this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
+  com->Receive(&(this->NumberOfBuffers), 1, 1, NUMBER_OF_BUFFERS_TAG);
+  if (this->NumberOfBuffers == SHARED_MEMORY_BUFFERS)
+  {
+    if (this->ReceiveFromDataServerUsingSharedMemory(output))
+    {
+      return;
+    }
+    // the data-server falls back to sending the buffers over the socket.
+    com->Receive(&(this->NumberOfBuffers), 1, 1, NUMBER_OF_BUFFERS_TAG);
+  }
   this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23491);
+  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, BUFFER_LENGTHS_TAG);
   // Compute additional buffer information.
   this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
   this->BufferTotalLength = 0;
@@ -849,11 +1155,94 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
     this->BufferTotalLength += this->BufferLengths[idx];
   }
   this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
+  com->Receive(this->Buffers, this->BufferTotalLength, 1, BUFFERS_TAG);
   this->ReconstructDataFromBuffer(output);
   this->ClearBuffer();
 }
 
+//-----------------------------------------------------------------------------
+bool vtkMPIMoveData::SendToClientUsingSharedMemory()
+{
+  if (!vtkMPIMoveData::UseSharedMemory || this->NumberOfBuffers <= 0 ||
+    this->BufferTotalLength <= 0 ||
+    ::GetSharedMemoryFailures().Contains(this->ClientDataServerSocketController) ||
+    !vtkMPIMoveDataIsPeerLocal(this->ClientDataServerSocketController))
+  {
+    return false;
+  }
+
+  vtkMPIMoveDataSharedMemory segment;
+  if (!segment.Create(static_cast<size_t>(this->BufferTotalLength)))
+  {
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+      "failed to create shared memory segment, using socket.");
+    return false;
+  }
+  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client using shared memory");
+  memcpy(segment.GetPointer(), this->Buffers, static_cast<size_t>(this->BufferTotalLength));
+
+  // only a small header goes through the socket.
+  vtkMultiProcessStream header;
+  header << segment.GetName() << this->NumberOfBuffers;
+  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
+  {
+    header << static_cast<vtkTypeInt64>(this->BufferLengths[idx]);
+  }
+  int marker = SHARED_MEMORY_BUFFERS;
+  this->ClientDataServerSocketController->Send(&marker, 1, 1, NUMBER_OF_BUFFERS_TAG);
+  this->ClientDataServerSocketController->Send(header, 1, SHARED_MEMORY_TAG);
+
+  // wait until the client mapped the segment before releasing it, the client
+  // may not be able to access it e.g. when running in a different container.
+  int mapped = 0;
+  this->ClientDataServerSocketController->Receive(&mapped, 1, 1, SHARED_MEMORY_ACK_TAG);
+  if (!mapped)
+  {
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+      "client could not map shared memory segment, using socket for this connection.");
+    ::GetSharedMemoryFailures().Insert(this->ClientDataServerSocketController);
+  }
+  return mapped != 0;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkMPIMoveData::ReceiveFromDataServerUsingSharedMemory(vtkDataObject* output)
+{
+  vtkMultiProcessStream header;
+  this->ClientDataServerSocketController->Receive(header, 1, SHARED_MEMORY_TAG);
+  std::string name;
+  header >> name >> this->NumberOfBuffers;
+  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
+  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
+  this->BufferTotalLength = 0;
+  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
+  {
+    vtkTypeInt64 length;
+    header >> length;
+    this->BufferLengths[idx] = static_cast<vtkIdType>(length);
+    this->BufferOffsets[idx] = this->BufferTotalLength;
+    this->BufferTotalLength += this->BufferLengths[idx];
+  }
+
+  auto segment = std::make_shared<vtkMPIMoveDataSharedMemory>();
+  int mapped = segment->Open(name, static_cast<size_t>(this->BufferTotalLength)) ? 1 : 0;
+  this->ClientDataServerSocketController->Send(&mapped, 1, 1, SHARED_MEMORY_ACK_TAG);
+  if (!mapped)
+  {
+    this->ClearBuffer();
+    return false;
+  }
+
+  vtkVLogScopeF(
+    PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver using shared memory");
+  // reconstruct directly from the mapping, arrays may keep it mapped.
+  this->Buffers = segment->GetPointer();
+  this->BufferStorage = std::shared_ptr<const char>(segment, segment->GetPointer());
+  this->ReconstructDataFromBuffer(output);
+  this->ClearBuffer();
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
 {
@@ -923,11 +1312,16 @@ void vtkMPIMoveData::ClearBuffer()
     delete[] this->BufferOffsets;
     this->BufferOffsets = nullptr;
   }
-  if (this->Buffers)
+  if (this->BufferStorage)
+  {
+    // arrays sharing the buffers keep them alive.
+    this->BufferStorage.reset();
+  }
+  else
   {
     delete[] this->Buffers;
-    this->Buffers = nullptr;
   }
+  this->Buffers = nullptr;
   this->BufferTotalLength = 0;
 }
 
@@ -943,6 +1337,31 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
+  char* buffer = nullptr;
+  vtkIdType buffer_length = 0;
+
+  if (vtkMPIMoveData::UseRawArraysEncoding)
+  {
+    vtkNew<vtkPVDataObjectSerializer> serializer;
+    serializer->SetCompression(vtkMPIMoveData::CompressionMethod);
+    if (vtkMPIMoveData::CompressionMethod == vtkPVDataObjectSerializer::NO_COMPRESSION &&
+      vtkMPIMoveData::UseZLibCompression)
+    {
+      serializer->SetCompression(vtkPVDataObjectSerializer::ZLIB);
+    }
+    if (serializer->Serialize(data, buffer, buffer_length))
+    {
+      this->NumberOfBuffers = 1;
+      this->BufferLengths = new vtkIdType[1];
+      this->BufferLengths[0] = buffer_length;
+      this->BufferOffsets = new vtkIdType[1];
+      this->BufferOffsets[0] = 0;
+      this->Buffers = buffer;
+      this->BufferTotalLength = buffer_length;
+      return;
+    }
+  }
+
   // Copy input to isolate reader from the pipeline.
   vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
   writer->SetInputData(data);
@@ -963,9 +1382,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   writer->WriteToOutputStringOn();
   writer->Write();
 
-  char* buffer = nullptr;
-  vtkIdType buffer_length = 0;
-
   if (vtkMPIMoveData::UseZLibCompression)
   {
     vtkTimerLog::MarkStartEvent("Zlib compress");
@@ -1018,6 +1434,12 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     return;
   }
 
+  if (!this->BufferStorage)
+  {
+    // let arrays decoded by vtkPVDataObjectSerializer share the buffers.
+    this->BufferStorage.reset(this->Buffers, std::default_delete<char[]>());
+  }
+
   bool is_image_data = data->IsA("vtkImageData") != 0;
   std::vector<vtkSmartPointer<vtkDataObject>> pieces;
 
@@ -1026,6 +1448,19 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     char* bufferArray = this->Buffers + this->BufferOffsets[idx];
     vtkIdType bufferLength = this->BufferLengths[idx];
 
+    if (vtkPVDataObjectSerializer::IsSerializedBuffer(bufferArray, bufferLength))
+    {
+      vtkSmartPointer<vtkDataObject> piece =
+        vtkPVDataObjectSerializer::Deserialize(bufferArray, bufferLength, this->BufferStorage);
+      if (piece)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(piece);
+        pieces.push_back(piece);
+      }
+      continue;
+    }
+
     char* realBuffer = nullptr;
     if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
     {
@@ -18,6 +18,8 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
 
+#include <memory> // for std::shared_ptr
+
 class vtkMultiProcessController;
 class vtkSocketController;
 class vtkMPIMToNSocketConnection;
@@ -102,6 +104,41 @@ public:
   static bool GetUseZLibCompression();
   ///@}
 
+  ///@{
+  /**
+   * When set to true, data delivered from the data-server to a client running
+   * on the same host is passed through a shared memory segment instead of the
+   * socket, only a small header is sent over the socket. The data-server falls
+   * back to the socket if the client cannot map the segment, and keeps using
+   * the socket for that connection afterwards. True by default.
+   */
+  static void SetUseSharedMemory(bool b);
+  static bool GetUseSharedMemory();
+  ///@}
+
+  ///@{
+  /**
+   * When set to true, data is marshaled using vtkPVDataObjectSerializer
+   * whenever it supports the data object, which avoids parsing the data on the
+   * receiving side and lets arrays share the received buffers. Otherwise, or
+   * for unsupported data, the legacy VTK file format is used. True by default.
+   * This value has any effect only on the data-sender processes.
+   */
+  static void SetUseRawArraysEncoding(bool b);
+  static bool GetUseRawArraysEncoding();
+  ///@}
+
+  ///@{
+  /**
+   * Compression used for large arrays when data is marshaled using
+   * vtkPVDataObjectSerializer, one of vtkPVDataObjectSerializer::CompressionMethods.
+   * When set to vtkPVDataObjectSerializer::NO_COMPRESSION (default), zlib is
+   * used if UseZLibCompression is true.
+   */
+  static void SetCompressionMethod(int method);
+  static int GetCompressionMethod();
+  ///@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -154,12 +191,26 @@ protected:
   void DataServerSendToClient(vtkDataObject* output);
   void ClientReceiveFromDataServer(vtkDataObject* output);
 
+  ///@{
+  /**
+   * Moves the marshaled buffers from the data-server to the client through a
+   * shared memory segment. Returns false if shared memory could not be used,
+   * in which case the buffers must be sent over the socket.
+   */
+  bool SendToClientUsingSharedMemory();
+  bool ReceiveFromDataServerUsingSharedMemory(vtkDataObject* output);
+  ///@}
+
   int NumberOfBuffers;
   vtkIdType* BufferLengths;
   vtkIdType* BufferOffsets;
   char* Buffers;
   vtkIdType BufferTotalLength;
 
+  // When set, owns the memory Buffers points to instead of Buffers itself.
+  // Arrays reconstructed from the buffers may share it.
+  std::shared_ptr<const char> BufferStorage;
+
   void ClearBuffer();
   void MarshalDataToBuffer(vtkDataObject* data);
   void ReconstructDataFromBuffer(vtkDataObject* data);
@@ -186,6 +237,9 @@ private:
   void operator=(const vtkMPIMoveData&) = delete;
 
   static bool UseZLibCompression;
+  static bool UseSharedMemory;
+  static bool UseRawArraysEncoding;
+  static int CompressionMethod;
 };
 
 #endif
@@ -0,0 +1,1188 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVDataObjectSerializer.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_lz4.h"
+#include "vtk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// Layout of a serialized buffer:
+//
+//   Header    | blob table | structure | padding | blob 0 | padding | blob 1 ...
+//   (64 bytes)                                   ^ PayloadOffset, 64-byte aligned
+//
+// The blob table and the structure are vtkMultiProcessStream raw data, which
+// carry their own byte order. The structure describes the data object tree,
+// its meshes and arrays, and refers to blobs by index. Blobs are the raw bytes
+// of data arrays, each starting on a 64-byte boundary of the buffer, either
+// as-is or compressed in independent chunks of ChunkSize bytes.
+constexpr char SerializerMagic[8] = { 'p', 'v', 'd', 'o', 'r', 'a', 'w', '\0' };
+constexpr vtkTypeUInt32 SerializerVersion = 1;
+constexpr vtkTypeUInt32 ByteOrderMark = 0x01020304;
+constexpr vtkTypeUInt64 Alignment = 64;
+constexpr vtkTypeUInt64 ChunkSize = 1 << 20;
+
+enum ArrayKinds
+{
+  DATA_ARRAY = 0,
+  STRING_ARRAY = 1
+};
+
+struct Header
+{
+  char Magic[8];
+  vtkTypeUInt32 Version;
+  vtkTypeUInt32 ByteOrder;
+  vtkTypeUInt64 TableSize;
+  vtkTypeUInt64 StructureSize;
+  vtkTypeUInt64 PayloadOffset;
+  vtkTypeUInt64 PayloadSize;
+  vtkTypeUInt64 Reserved[2];
+};
+static_assert(sizeof(Header) == Alignment, "header must fill the first aligned block");
+
+vtkTypeUInt64 Align(vtkTypeUInt64 value)
+{
+  return (value + Alignment - 1) / Alignment * Alignment;
+}
+
+vtkTypeUInt64 NumberOfChunks(vtkTypeUInt64 size)
+{
+  return (size + ChunkSize - 1) / ChunkSize;
+}
+
+template <typename T>
+void SwapBytes(T& value)
+{
+  vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+}
+
+//-----------------------------------------------------------------------------
+bool CompressChunk(int codec, const char* source, vtkTypeUInt64 size, std::vector<char>& target)
+{
+  if (codec == vtkPVDataObjectSerializer::LZ4)
+  {
+    const int bound = LZ4_compressBound(static_cast<int>(size));
+    target.resize(bound);
+    const int compressed =
+      LZ4_compress_default(source, target.data(), static_cast<int>(size), bound);
+    target.resize(compressed > 0 ? compressed : 0);
+    return compressed > 0;
+  }
+  uLongf compressed = compressBound(static_cast<uLong>(size));
+  target.resize(compressed);
+  const bool success = compress2(reinterpret_cast<Bytef*>(target.data()), &compressed,
+                         reinterpret_cast<const Bytef*>(source), static_cast<uLong>(size),
+                         Z_BEST_SPEED) == Z_OK;
+  target.resize(success ? compressed : 0);
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+bool DecompressChunk(
+  int codec, const char* source, vtkTypeUInt64 size, char* target, vtkTypeUInt64 targetSize)
+{
+  if (codec == vtkPVDataObjectSerializer::LZ4)
+  {
+    return LZ4_decompress_safe(source, target, static_cast<int>(size),
+             static_cast<int>(targetSize)) == static_cast<int>(targetSize);
+  }
+  if (codec == vtkPVDataObjectSerializer::ZLIB)
+  {
+    uLongf length = static_cast<uLongf>(targetSize);
+    return uncompress(reinterpret_cast<Bytef*>(target), &length,
+             reinterpret_cast<const Bytef*>(source), static_cast<uLong>(size)) == Z_OK &&
+      length == targetSize;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+// Arrays adopting the memory of a received buffer keep the owner of that
+// memory alive until they release it.
+std::mutex& GetAdoptedStorageMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::multimap<const void*, std::shared_ptr<const char>>& GetAdoptedStorage()
+{
+  static std::multimap<const void*, std::shared_ptr<const char>> storage;
+  return storage;
+}
+
+void AdoptStorage(const void* pointer, const std::shared_ptr<const char>& owner)
+{
+  std::lock_guard<std::mutex> lock(GetAdoptedStorageMutex());
+  GetAdoptedStorage().emplace(pointer, owner);
+}
+
+void ReleaseAdoptedStorage(void* pointer)
+{
+  std::shared_ptr<const char> owner;
+  {
+    std::lock_guard<std::mutex> lock(GetAdoptedStorageMutex());
+    auto& storage = GetAdoptedStorage();
+    auto iter = storage.find(pointer);
+    if (iter != storage.end())
+    {
+      owner = std::move(iter->second);
+      storage.erase(iter);
+    }
+  }
+  // `owner` may be the last reference, release it outside of the lock.
+}
+
+//-----------------------------------------------------------------------------
+struct OutputBlob
+{
+  const char* Data = nullptr;
+  vtkTypeUInt64 Size = 0;
+  int ElementSize = 1;
+  int Codec = vtkPVDataObjectSerializer::NO_COMPRESSION;
+  std::vector<std::vector<char>> Chunks;
+  vtkTypeUInt64 Offset = 0;
+
+  vtkTypeUInt64 GetStoredSize() const
+  {
+    if (this->Codec == vtkPVDataObjectSerializer::NO_COMPRESSION)
+    {
+      return this->Size;
+    }
+    vtkTypeUInt64 size = 0;
+    for (const auto& chunk : this->Chunks)
+    {
+      size += chunk.size();
+    }
+    return size;
+  }
+};
+
+class Writer
+{
+public:
+  bool WriteDataObject(vtkDataObject* data);
+  void Compress(int codec, vtkIdType threshold);
+  void Finish(char*& buffer, vtkIdType& length);
+
+private:
+  bool WriteArray(vtkAbstractArray* array);
+  bool WriteOptionalArray(vtkDataArray* array);
+  bool WriteCellArray(vtkCellArray* cells);
+  bool WriteFieldData(vtkFieldData* fieldData);
+  bool WriteAttributes(vtkDataSetAttributes* attributes);
+  bool WriteDataSetAttributes(vtkDataSet* dataSet);
+  void WriteExtent(const int extent[6]);
+
+  vtkMultiProcessStream Structure;
+  std::vector<OutputBlob> Blobs;
+
+  // Arrays that do not use the standard memory layout are copied, the copies
+  // must live until the buffer is written.
+  std::vector<vtkSmartPointer<vtkDataArray>> Copies;
+};
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteDataObject(vtkDataObject* data)
+{
+  if (!data)
+  {
+    this->Structure << -1;
+    return true;
+  }
+
+  const int type = data->GetDataObjectType();
+  this->Structure << type;
+  bool success = true;
+  switch (type)
+  {
+    case VTK_MULTIBLOCK_DATA_SET:
+    {
+      auto mb = static_cast<vtkMultiBlockDataSet*>(data);
+      const unsigned int numBlocks = mb->GetNumberOfBlocks();
+      this->Structure << numBlocks;
+      for (unsigned int cc = 0; success && cc < numBlocks; ++cc)
+      {
+        vtkInformation* metaData = mb->HasMetaData(cc) ? mb->GetMetaData(cc) : nullptr;
+        const char* name =
+          metaData && metaData->Has(vtkCompositeDataSet::NAME())
+          ? metaData->Get(vtkCompositeDataSet::NAME())
+          : nullptr;
+        this->Structure << (name ? 1 : 0) << std::string(name ? name : "");
+        success = this->WriteDataObject(mb->GetBlock(cc));
+      }
+      break;
+    }
+
+    case VTK_MULTIPIECE_DATA_SET:
+    {
+      auto mp = static_cast<vtkMultiPieceDataSet*>(data);
+      const unsigned int numPieces = mp->GetNumberOfPieces();
+      this->Structure << numPieces;
+      for (unsigned int cc = 0; success && cc < numPieces; ++cc)
+      {
+        success = this->WriteDataObject(mp->GetPieceAsDataObject(cc));
+      }
+      break;
+    }
+
+    case VTK_PARTITIONED_DATA_SET:
+    {
+      auto pds = static_cast<vtkPartitionedDataSet*>(data);
+      const unsigned int numPartitions = pds->GetNumberOfPartitions();
+      this->Structure << numPartitions;
+      for (unsigned int cc = 0; success && cc < numPartitions; ++cc)
+      {
+        success = this->WriteDataObject(pds->GetPartitionAsDataObject(cc));
+      }
+      break;
+    }
+
+    case VTK_POLY_DATA:
+    {
+      auto pd = static_cast<vtkPolyData*>(data);
+      success = this->WriteOptionalArray(pd->GetPoints() ? pd->GetPoints()->GetData() : nullptr) &&
+        this->WriteCellArray(pd->GetVerts()) && this->WriteCellArray(pd->GetLines()) &&
+        this->WriteCellArray(pd->GetPolys()) && this->WriteCellArray(pd->GetStrips()) &&
+        this->WriteDataSetAttributes(pd);
+      break;
+    }
+
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      auto ug = static_cast<vtkUnstructuredGrid*>(data);
+      vtkUnsignedCharArray* types = ug->GetCellTypesArray();
+      if (types &&
+        std::find(types->GetPointer(0), types->GetPointer(0) + types->GetNumberOfValues(),
+          static_cast<unsigned char>(VTK_POLYHEDRON)) !=
+          types->GetPointer(0) + types->GetNumberOfValues())
+      {
+        // polyhedral faces are not supported.
+        return false;
+      }
+      success = this->WriteOptionalArray(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr) &&
+        this->WriteOptionalArray(types) && this->WriteCellArray(ug->GetCells()) &&
+        this->WriteDataSetAttributes(ug);
+      break;
+    }
+
+    case VTK_IMAGE_DATA:
+    {
+      auto image = static_cast<vtkImageData*>(data);
+      this->WriteExtent(image->GetExtent());
+      const double* origin = image->GetOrigin();
+      const double* spacing = image->GetSpacing();
+      const double* direction = image->GetDirectionMatrix()->GetData();
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        this->Structure << origin[cc] << spacing[cc];
+      }
+      for (int cc = 0; cc < 9; ++cc)
+      {
+        this->Structure << direction[cc];
+      }
+      success = this->WriteDataSetAttributes(image);
+      break;
+    }
+
+    case VTK_STRUCTURED_GRID:
+    {
+      auto sg = static_cast<vtkStructuredGrid*>(data);
+      this->WriteExtent(sg->GetExtent());
+      success = this->WriteOptionalArray(sg->GetPoints() ? sg->GetPoints()->GetData() : nullptr) &&
+        this->WriteDataSetAttributes(sg);
+      break;
+    }
+
+    case VTK_RECTILINEAR_GRID:
+    {
+      auto rg = static_cast<vtkRectilinearGrid*>(data);
+      this->WriteExtent(rg->GetExtent());
+      success = this->WriteOptionalArray(rg->GetXCoordinates()) &&
+        this->WriteOptionalArray(rg->GetYCoordinates()) &&
+        this->WriteOptionalArray(rg->GetZCoordinates()) && this->WriteDataSetAttributes(rg);
+      break;
+    }
+
+    case VTK_TABLE:
+      success = this->WriteAttributes(static_cast<vtkTable*>(data)->GetRowData());
+      break;
+
+    default:
+      return false;
+  }
+  return success && this->WriteFieldData(data->GetFieldData());
+}
+
+//-----------------------------------------------------------------------------
+void Writer::WriteExtent(const int extent[6])
+{
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    this->Structure << extent[cc];
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteArray(vtkAbstractArray* array)
+{
+  const char* name = array->GetName();
+  const int numComps = array->GetNumberOfComponents();
+  if (auto strings = vtkStringArray::SafeDownCast(array))
+  {
+    this->Structure << static_cast<int>(STRING_ARRAY) << (name ? 1 : 0)
+                    << std::string(name ? name : "") << numComps
+                    << static_cast<vtkTypeInt64>(strings->GetNumberOfTuples());
+    for (vtkIdType cc = 0; cc < strings->GetNumberOfValues(); ++cc)
+    {
+      this->Structure << strings->GetValue(cc);
+    }
+    return true;
+  }
+
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  if (!dataArray || dataArray->GetDataType() == VTK_BIT)
+  {
+    return false;
+  }
+  if (!dataArray->HasStandardMemoryLayout())
+  {
+    auto copy = vtkSmartPointer<vtkDataArray>::Take(
+      vtkDataArray::CreateDataArray(dataArray->GetDataType()));
+    copy->DeepCopy(dataArray);
+    this->Copies.push_back(copy);
+    dataArray = copy;
+  }
+
+  this->Structure << static_cast<int>(DATA_ARRAY) << (name ? 1 : 0)
+                  << std::string(name ? name : "") << numComps
+                  << static_cast<vtkTypeInt64>(dataArray->GetNumberOfTuples())
+                  << dataArray->GetDataType() << (dataArray->HasAComponentName() ? 1 : 0);
+  if (dataArray->HasAComponentName())
+  {
+    for (int cc = 0; cc < numComps; ++cc)
+    {
+      const char* componentName = dataArray->GetComponentName(cc);
+      this->Structure << std::string(componentName ? componentName : "");
+    }
+  }
+
+  OutputBlob blob;
+  blob.ElementSize = dataArray->GetDataTypeSize();
+  blob.Size = static_cast<vtkTypeUInt64>(dataArray->GetNumberOfValues()) * blob.ElementSize;
+  blob.Data = blob.Size > 0 ? static_cast<const char*>(dataArray->GetVoidPointer(0)) : nullptr;
+  this->Structure << static_cast<vtkTypeInt64>(this->Blobs.size());
+  this->Blobs.push_back(std::move(blob));
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteOptionalArray(vtkDataArray* array)
+{
+  this->Structure << (array ? 1 : 0);
+  return !array || this->WriteArray(array);
+}
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteCellArray(vtkCellArray* cells)
+{
+  this->Structure << (cells ? 1 : 0);
+  return !cells ||
+    (this->WriteArray(cells->GetOffsetsArray()) && this->WriteArray(cells->GetConnectivityArray()));
+}
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteFieldData(vtkFieldData* fieldData)
+{
+  const int numArrays = fieldData ? fieldData->GetNumberOfArrays() : 0;
+  this->Structure << numArrays;
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    if (!this->WriteArray(fieldData->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteAttributes(vtkDataSetAttributes* attributes)
+{
+  if (!this->WriteFieldData(attributes))
+  {
+    return false;
+  }
+  int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  attributes->GetAttributeIndices(indices);
+  for (int cc = 0; cc < vtkDataSetAttributes::NUM_ATTRIBUTES; ++cc)
+  {
+    this->Structure << indices[cc];
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Writer::WriteDataSetAttributes(vtkDataSet* dataSet)
+{
+  return this->WriteAttributes(dataSet->GetPointData()) &&
+    this->WriteAttributes(dataSet->GetCellData());
+}
+
+//-----------------------------------------------------------------------------
+void Writer::Compress(int codec, vtkIdType threshold)
+{
+  if (codec == vtkPVDataObjectSerializer::NO_COMPRESSION)
+  {
+    return;
+  }
+
+  // compress all chunks of all blobs in a single parallel loop so that a few
+  // large arrays keep all threads busy as well as many small ones.
+  std::vector<std::pair<size_t, vtkTypeUInt64>> tasks;
+  for (size_t blobIdx = 0; blobIdx < this->Blobs.size(); ++blobIdx)
+  {
+    OutputBlob& blob = this->Blobs[blobIdx];
+    if (blob.Size == 0 || blob.Size < static_cast<vtkTypeUInt64>(threshold))
+    {
+      continue;
+    }
+    blob.Codec = codec;
+    blob.Chunks.resize(NumberOfChunks(blob.Size));
+    for (vtkTypeUInt64 chunk = 0; chunk < blob.Chunks.size(); ++chunk)
+    {
+      tasks.emplace_back(blobIdx, chunk);
+    }
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      OutputBlob& blob = this->Blobs[tasks[cc].first];
+      const vtkTypeUInt64 offset = tasks[cc].second * ChunkSize;
+      CompressChunk(blob.Codec, blob.Data + offset, std::min(ChunkSize, blob.Size - offset),
+        blob.Chunks[tasks[cc].second]);
+    }
+  });
+
+  // keep the blobs that do not compress, or failed to, uncompressed.
+  for (auto& blob : this->Blobs)
+  {
+    if (blob.Codec == vtkPVDataObjectSerializer::NO_COMPRESSION)
+    {
+      continue;
+    }
+    const bool failed = std::any_of(blob.Chunks.begin(), blob.Chunks.end(),
+      [](const std::vector<char>& chunk) { return chunk.empty(); });
+    if (failed || blob.GetStoredSize() >= blob.Size)
+    {
+      blob.Codec = vtkPVDataObjectSerializer::NO_COMPRESSION;
+      blob.Chunks.clear();
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void Writer::Finish(char*& buffer, vtkIdType& length)
+{
+  vtkMultiProcessStream table;
+  table << ChunkSize << static_cast<vtkTypeUInt64>(this->Blobs.size());
+  vtkTypeUInt64 payloadSize = 0;
+  for (auto& blob : this->Blobs)
+  {
+    blob.Offset = payloadSize;
+    payloadSize = Align(payloadSize + blob.GetStoredSize());
+    table << blob.Offset << blob.Size << blob.ElementSize << blob.Codec
+          << static_cast<vtkTypeUInt64>(blob.Chunks.size());
+    for (const auto& chunk : blob.Chunks)
+    {
+      table << static_cast<vtkTypeUInt64>(chunk.size());
+    }
+  }
+
+  std::vector<unsigned char> tableData;
+  std::vector<unsigned char> structureData;
+  table.GetRawData(tableData);
+  this->Structure.GetRawData(structureData);
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.Magic, SerializerMagic, sizeof(header.Magic));
+  header.Version = SerializerVersion;
+  header.ByteOrder = ByteOrderMark;
+  header.TableSize = tableData.size();
+  header.StructureSize = structureData.size();
+  header.PayloadOffset = Align(sizeof(Header) + tableData.size() + structureData.size());
+  header.PayloadSize = payloadSize;
+
+  // the total length is a multiple of the alignment so that buffers
+  // concatenated by vtkMPIMoveData stay aligned.
+  length = static_cast<vtkIdType>(header.PayloadOffset + header.PayloadSize);
+  buffer = new char[length];
+  std::memset(buffer, 0, header.PayloadOffset);
+  std::memcpy(buffer, &header, sizeof(header));
+  std::memcpy(buffer + sizeof(header), tableData.data(), tableData.size());
+  std::memcpy(
+    buffer + sizeof(header) + tableData.size(), structureData.data(), structureData.size());
+
+  struct CopyTask
+  {
+    char* Target;
+    const char* Source;
+    size_t Size;
+  };
+  std::vector<CopyTask> tasks;
+  char* payload = buffer + header.PayloadOffset;
+  for (const auto& blob : this->Blobs)
+  {
+    char* target = payload + blob.Offset;
+    const vtkTypeUInt64 storedSize = blob.GetStoredSize();
+    if (blob.Codec == vtkPVDataObjectSerializer::NO_COMPRESSION)
+    {
+      for (vtkTypeUInt64 offset = 0; offset < blob.Size; offset += ChunkSize)
+      {
+        tasks.push_back(
+          CopyTask{ target + offset, blob.Data + offset, std::min(ChunkSize, blob.Size - offset) });
+      }
+    }
+    else
+    {
+      for (const auto& chunk : blob.Chunks)
+      {
+        tasks.push_back(CopyTask{ target, chunk.data(), chunk.size() });
+        target += chunk.size();
+      }
+    }
+    std::memset(payload + blob.Offset + storedSize, 0, Align(storedSize) - storedSize);
+  }
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      std::memcpy(tasks[cc].Target, tasks[cc].Source, tasks[cc].Size);
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+struct InputBlob
+{
+  vtkTypeUInt64 Offset = 0;
+  vtkTypeUInt64 Size = 0;
+  int ElementSize = 1;
+  int Codec = vtkPVDataObjectSerializer::NO_COMPRESSION;
+  std::vector<vtkTypeUInt64> ChunkOffsets;
+  std::vector<vtkTypeUInt64> ChunkSizes;
+};
+
+class Reader
+{
+public:
+  Reader(const char* payload, bool swapBytes, const std::shared_ptr<const char>& storage)
+    : Payload(payload)
+    , SwapBytes(swapBytes)
+    , Storage(storage)
+  {
+  }
+
+  bool ReadTable(const unsigned char* data, vtkTypeUInt64 size, vtkTypeUInt64 payloadSize);
+  vtkSmartPointer<vtkDataObject> ReadDataObject();
+
+  vtkMultiProcessStream Structure;
+  bool Failed = false;
+
+private:
+  vtkSmartPointer<vtkAbstractArray> ReadArray(bool cellArrayStorage = false);
+  vtkSmartPointer<vtkDataArray> ReadOptionalArray();
+  vtkSmartPointer<vtkPoints> ReadPoints();
+  vtkSmartPointer<vtkCellArray> ReadCellArray();
+  void ReadFieldData(vtkFieldData* fieldData);
+  void ReadAttributes(vtkDataSetAttributes* attributes);
+  void ReadDataSetAttributes(vtkDataSet* dataSet);
+  void ReadExtent(int extent[6]);
+  bool ReadBlob(vtkTypeInt64 blobIdx, vtkDataArray* array, vtkIdType numValues);
+
+  const char* Payload;
+  bool SwapBytes;
+  std::shared_ptr<const char> Storage;
+  std::vector<InputBlob> Blobs;
+};
+
+//-----------------------------------------------------------------------------
+bool Reader::ReadTable(const unsigned char* data, vtkTypeUInt64 size, vtkTypeUInt64 payloadSize)
+{
+  vtkMultiProcessStream table;
+  table.SetRawData(data, static_cast<unsigned int>(size));
+  vtkTypeUInt64 chunkSize;
+  vtkTypeUInt64 numBlobs;
+  table >> chunkSize >> numBlobs;
+  if (chunkSize != ChunkSize)
+  {
+    return false;
+  }
+  this->Blobs.resize(numBlobs);
+  for (auto& blob : this->Blobs)
+  {
+    vtkTypeUInt64 numChunks;
+    table >> blob.Offset >> blob.Size >> blob.ElementSize >> blob.Codec >> numChunks;
+    vtkTypeUInt64 storedSize = blob.Size;
+    if (blob.Codec != vtkPVDataObjectSerializer::NO_COMPRESSION)
+    {
+      if (numChunks != NumberOfChunks(blob.Size))
+      {
+        return false;
+      }
+      storedSize = 0;
+      blob.ChunkOffsets.resize(numChunks);
+      blob.ChunkSizes.resize(numChunks);
+      for (vtkTypeUInt64 cc = 0; cc < numChunks; ++cc)
+      {
+        table >> blob.ChunkSizes[cc];
+        blob.ChunkOffsets[cc] = blob.Offset + storedSize;
+        storedSize += blob.ChunkSizes[cc];
+      }
+    }
+    if (blob.Offset > payloadSize || storedSize > payloadSize - blob.Offset)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Reader::ReadBlob(vtkTypeInt64 blobIdx, vtkDataArray* array, vtkIdType numValues)
+{
+  if (blobIdx < 0 || blobIdx >= static_cast<vtkTypeInt64>(this->Blobs.size()))
+  {
+    return false;
+  }
+  const InputBlob& blob = this->Blobs[blobIdx];
+  const int elementSize = array->GetDataTypeSize();
+  if (blob.ElementSize != elementSize ||
+    blob.Size != static_cast<vtkTypeUInt64>(numValues) * elementSize)
+  {
+    return false;
+  }
+  if (numValues == 0)
+  {
+    array->SetNumberOfValues(0);
+    return true;
+  }
+
+  const char* source = this->Payload + blob.Offset;
+  if (blob.Codec == vtkPVDataObjectSerializer::NO_COMPRESSION && this->Storage &&
+    !this->SwapBytes && reinterpret_cast<std::uintptr_t>(source) % elementSize == 0)
+  {
+    // share the memory of the received buffer.
+    AdoptStorage(source, this->Storage);
+    array->SetVoidArray(
+      const_cast<char*>(source), numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+    array->SetArrayFreeFunction(&ReleaseAdoptedStorage);
+    return true;
+  }
+
+  array->SetNumberOfValues(numValues);
+  char* target = static_cast<char*>(array->GetVoidPointer(0));
+  const vtkIdType numChunks = static_cast<vtkIdType>(NumberOfChunks(blob.Size));
+  std::atomic<bool> valid(true);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkTypeUInt64 offset = cc * ChunkSize;
+      const vtkTypeUInt64 size = std::min(ChunkSize, blob.Size - offset);
+      if (blob.Codec == vtkPVDataObjectSerializer::NO_COMPRESSION)
+      {
+        std::memcpy(target + offset, source + offset, size);
+      }
+      else if (!DecompressChunk(blob.Codec, this->Payload + blob.ChunkOffsets[cc],
+                 blob.ChunkSizes[cc], target + offset, size))
+      {
+        valid = false;
+      }
+    }
+  });
+  if (this->SwapBytes && elementSize > 1)
+  {
+    vtkByteSwap::SwapVoidRange(target, numValues, elementSize);
+  }
+  return valid;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkAbstractArray> Reader::ReadArray(bool cellArrayStorage)
+{
+  int kind;
+  int hasName;
+  std::string name;
+  int numComps;
+  vtkTypeInt64 numTuples;
+  this->Structure >> kind >> hasName >> name >> numComps >> numTuples;
+  if (numComps < 1 || numTuples < 0)
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+
+  if (kind == STRING_ARRAY)
+  {
+    auto strings = vtkSmartPointer<vtkStringArray>::New();
+    strings->SetNumberOfComponents(numComps);
+    strings->SetNumberOfTuples(numTuples);
+    for (vtkIdType cc = 0; cc < strings->GetNumberOfValues(); ++cc)
+    {
+      std::string value;
+      this->Structure >> value;
+      strings->SetValue(cc, value);
+    }
+    if (hasName)
+    {
+      strings->SetName(name.c_str());
+    }
+    return strings;
+  }
+
+  int dataType;
+  int hasComponentNames;
+  this->Structure >> dataType >> hasComponentNames;
+  std::vector<std::string> componentNames(hasComponentNames ? numComps : 0);
+  for (auto& componentName : componentNames)
+  {
+    this->Structure >> componentName;
+  }
+  vtkTypeInt64 blobIdx;
+  this->Structure >> blobIdx;
+
+  vtkSmartPointer<vtkDataArray> array;
+  if (cellArrayStorage)
+  {
+    // vtkCellArray only adopts these array types without copying them.
+    const int size = vtkAbstractArray::GetDataTypeSize(dataType);
+    if (size == 4)
+    {
+      array = vtkSmartPointer<vtkTypeInt32Array>::New();
+    }
+    else if (size == 8)
+    {
+      array = vtkSmartPointer<vtkTypeInt64Array>::New();
+    }
+  }
+  else if (kind == DATA_ARRAY)
+  {
+    array = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(dataType));
+  }
+  if (!array)
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  array->SetNumberOfComponents(numComps);
+  if (!this->ReadBlob(blobIdx, array, static_cast<vtkIdType>(numTuples * numComps)))
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  for (int cc = 0; cc < static_cast<int>(componentNames.size()); ++cc)
+  {
+    array->SetComponentName(cc, componentNames[cc].c_str());
+  }
+  if (hasName)
+  {
+    array->SetName(name.c_str());
+  }
+  return array;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> Reader::ReadOptionalArray()
+{
+  int present;
+  this->Structure >> present;
+  return present ? vtkDataArray::SafeDownCast(this->ReadArray()) : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> Reader::ReadPoints()
+{
+  vtkSmartPointer<vtkDataArray> data = this->ReadOptionalArray();
+  if (!data)
+  {
+    return nullptr;
+  }
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetData(data);
+  return points;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> Reader::ReadCellArray()
+{
+  int present;
+  this->Structure >> present;
+  if (!present)
+  {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkAbstractArray> offsets = this->ReadArray(true);
+  vtkSmartPointer<vtkAbstractArray> connectivity = this->ReadArray(true);
+  auto cells = vtkSmartPointer<vtkCellArray>::New();
+  auto offsets32 = vtkTypeInt32Array::SafeDownCast(offsets);
+  auto connectivity32 = vtkTypeInt32Array::SafeDownCast(connectivity);
+  auto offsets64 = vtkTypeInt64Array::SafeDownCast(offsets);
+  auto connectivity64 = vtkTypeInt64Array::SafeDownCast(connectivity);
+  if (offsets32 && connectivity32)
+  {
+    cells->SetData(offsets32, connectivity32);
+  }
+  else if (offsets64 && connectivity64)
+  {
+    cells->SetData(offsets64, connectivity64);
+  }
+  else
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  return cells;
+}
+
+//-----------------------------------------------------------------------------
+void Reader::ReadFieldData(vtkFieldData* fieldData)
+{
+  int numArrays;
+  this->Structure >> numArrays;
+  for (int cc = 0; cc < numArrays && !this->Failed; ++cc)
+  {
+    vtkSmartPointer<vtkAbstractArray> array = this->ReadArray();
+    if (array)
+    {
+      fieldData->AddArray(array);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void Reader::ReadAttributes(vtkDataSetAttributes* attributes)
+{
+  this->ReadFieldData(attributes);
+  for (int cc = 0; cc < vtkDataSetAttributes::NUM_ATTRIBUTES && !this->Failed; ++cc)
+  {
+    int index;
+    this->Structure >> index;
+    if (index >= 0)
+    {
+      attributes->SetActiveAttribute(index, cc);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void Reader::ReadDataSetAttributes(vtkDataSet* dataSet)
+{
+  this->ReadAttributes(dataSet->GetPointData());
+  if (!this->Failed)
+  {
+    this->ReadAttributes(dataSet->GetCellData());
+  }
+}
+
+//-----------------------------------------------------------------------------
+void Reader::ReadExtent(int extent[6])
+{
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    this->Structure >> extent[cc];
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> Reader::ReadDataObject()
+{
+  int type;
+  this->Structure >> type;
+  vtkSmartPointer<vtkDataObject> result;
+  switch (type)
+  {
+    case -1:
+      return nullptr;
+
+    case VTK_MULTIBLOCK_DATA_SET:
+    {
+      auto mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+      unsigned int numBlocks;
+      this->Structure >> numBlocks;
+      mb->SetNumberOfBlocks(numBlocks);
+      for (unsigned int cc = 0; cc < numBlocks && !this->Failed; ++cc)
+      {
+        int hasName;
+        std::string name;
+        this->Structure >> hasName >> name;
+        mb->SetBlock(cc, this->ReadDataObject());
+        if (hasName)
+        {
+          mb->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+        }
+      }
+      result = mb;
+      break;
+    }
+
+    case VTK_MULTIPIECE_DATA_SET:
+    {
+      auto mp = vtkSmartPointer<vtkMultiPieceDataSet>::New();
+      unsigned int numPieces;
+      this->Structure >> numPieces;
+      mp->SetNumberOfPieces(numPieces);
+      for (unsigned int cc = 0; cc < numPieces && !this->Failed; ++cc)
+      {
+        mp->SetPiece(cc, this->ReadDataObject());
+      }
+      result = mp;
+      break;
+    }
+
+    case VTK_PARTITIONED_DATA_SET:
+    {
+      auto pds = vtkSmartPointer<vtkPartitionedDataSet>::New();
+      unsigned int numPartitions;
+      this->Structure >> numPartitions;
+      pds->SetNumberOfPartitions(numPartitions);
+      for (unsigned int cc = 0; cc < numPartitions && !this->Failed; ++cc)
+      {
+        pds->SetPartition(cc, this->ReadDataObject());
+      }
+      result = pds;
+      break;
+    }
+
+    case VTK_POLY_DATA:
+    {
+      auto pd = vtkSmartPointer<vtkPolyData>::New();
+      pd->SetPoints(this->ReadPoints());
+      pd->SetVerts(this->ReadCellArray());
+      pd->SetLines(this->ReadCellArray());
+      pd->SetPolys(this->ReadCellArray());
+      pd->SetStrips(this->ReadCellArray());
+      this->ReadDataSetAttributes(pd);
+      result = pd;
+      break;
+    }
+
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      ug->SetPoints(this->ReadPoints());
+      vtkSmartPointer<vtkDataArray> types = this->ReadOptionalArray();
+      vtkSmartPointer<vtkCellArray> cells = this->ReadCellArray();
+      if (vtkUnsignedCharArray::SafeDownCast(types) && cells)
+      {
+        ug->SetCells(vtkUnsignedCharArray::SafeDownCast(types), cells);
+      }
+      this->ReadDataSetAttributes(ug);
+      result = ug;
+      break;
+    }
+
+    case VTK_IMAGE_DATA:
+    {
+      auto image = vtkSmartPointer<vtkImageData>::New();
+      int extent[6];
+      this->ReadExtent(extent);
+      double origin[3];
+      double spacing[3];
+      double direction[9];
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        this->Structure >> origin[cc] >> spacing[cc];
+      }
+      for (int cc = 0; cc < 9; ++cc)
+      {
+        this->Structure >> direction[cc];
+      }
+      image->SetExtent(extent);
+      image->SetOrigin(origin);
+      image->SetSpacing(spacing);
+      image->SetDirectionMatrix(direction);
+      this->ReadDataSetAttributes(image);
+      result = image;
+      break;
+    }
+
+    case VTK_STRUCTURED_GRID:
+    {
+      auto sg = vtkSmartPointer<vtkStructuredGrid>::New();
+      int extent[6];
+      this->ReadExtent(extent);
+      sg->SetExtent(extent);
+      sg->SetPoints(this->ReadPoints());
+      this->ReadDataSetAttributes(sg);
+      result = sg;
+      break;
+    }
+
+    case VTK_RECTILINEAR_GRID:
+    {
+      auto rg = vtkSmartPointer<vtkRectilinearGrid>::New();
+      int extent[6];
+      this->ReadExtent(extent);
+      rg->SetExtent(extent);
+      rg->SetXCoordinates(this->ReadOptionalArray());
+      rg->SetYCoordinates(this->ReadOptionalArray());
+      rg->SetZCoordinates(this->ReadOptionalArray());
+      this->ReadDataSetAttributes(rg);
+      result = rg;
+      break;
+    }
+
+    case VTK_TABLE:
+    {
+      auto table = vtkSmartPointer<vtkTable>::New();
+      this->ReadAttributes(table->GetRowData());
+      result = table;
+      break;
+    }
+
+    default:
+      this->Failed = true;
+      return nullptr;
+  }
+
+  if (!this->Failed)
+  {
+    this->ReadFieldData(result->GetFieldData());
+  }
+  return this->Failed ? nullptr : result;
+}
+}
+
+vtkStandardNewMacro(vtkPVDataObjectSerializer);
+//----------------------------------------------------------------------------
+vtkPVDataObjectSerializer::vtkPVDataObjectSerializer()
+  : Compression(vtkPVDataObjectSerializer::NO_COMPRESSION)
+  , CompressionThreshold(64 * 1024)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataObjectSerializer::~vtkPVDataObjectSerializer() = default;
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectSerializer::Serialize(vtkDataObject* data, char*& buffer, vtkIdType& length)
+{
+  buffer = nullptr;
+  length = 0;
+
+  Writer writer;
+  if (!data || !writer.WriteDataObject(data))
+  {
+    vtkDebugMacro("Unsupported data object, it cannot be serialized.");
+    return false;
+  }
+  writer.Compress(this->Compression, this->CompressionThreshold);
+  writer.Finish(buffer, length);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectSerializer::IsSerializedBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer && length >= static_cast<vtkIdType>(sizeof(Header)) &&
+    std::memcmp(buffer, SerializerMagic, sizeof(SerializerMagic)) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVDataObjectSerializer::Deserialize(
+  const char* buffer, vtkIdType length, const std::shared_ptr<const char>& storage)
+{
+  if (!vtkPVDataObjectSerializer::IsSerializedBuffer(buffer, length))
+  {
+    vtkGenericWarningMacro("Not a serialized data object.");
+    return nullptr;
+  }
+
+  Header header;
+  std::memcpy(&header, buffer, sizeof(header));
+  const bool swapBytes = header.ByteOrder != ByteOrderMark;
+  if (swapBytes)
+  {
+    SwapBytes(header.Version);
+    SwapBytes(header.ByteOrder);
+    SwapBytes(header.TableSize);
+    SwapBytes(header.StructureSize);
+    SwapBytes(header.PayloadOffset);
+    SwapBytes(header.PayloadSize);
+  }
+  if (header.ByteOrder != ByteOrderMark || header.Version != SerializerVersion)
+  {
+    vtkGenericWarningMacro("Unsupported serialized data object version " << header.Version);
+    return nullptr;
+  }
+  const vtkTypeUInt64 bufferLength = static_cast<vtkTypeUInt64>(length);
+  if (header.TableSize + header.StructureSize > header.PayloadOffset - sizeof(Header) ||
+    header.PayloadOffset > bufferLength || header.PayloadSize > bufferLength - header.PayloadOffset)
+  {
+    vtkGenericWarningMacro("Truncated serialized data object.");
+    return nullptr;
+  }
+
+  const auto* metaData = reinterpret_cast<const unsigned char*>(buffer) + sizeof(Header);
+  Reader reader(buffer + header.PayloadOffset, swapBytes, storage);
+  if (!reader.ReadTable(metaData, header.TableSize, header.PayloadSize))
+  {
+    vtkGenericWarningMacro("Invalid serialized data object.");
+    return nullptr;
+  }
+  reader.Structure.SetRawData(
+    metaData + header.TableSize, static_cast<unsigned int>(header.StructureSize));
+  vtkSmartPointer<vtkDataObject> result = reader.ReadDataObject();
+  if (reader.Failed || !result)
+  {
+    vtkGenericWarningMacro("Invalid serialized data object.");
+    return nullptr;
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectSerializer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Compression: " << this->Compression << endl;
+  os << indent << "CompressionThreshold: " << this->CompressionThreshold << endl;
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVDataObjectSerializer
+ * @brief   binary "raw arrays + metadata" encoding used to move data objects
+ *
+ * vtkPVDataObjectSerializer encodes a data object into a single binary buffer
+ * made of a fixed size header, a description of the data object structure and
+ * the raw bytes of every array. Array payloads are 64-byte aligned relative to
+ * the start of the buffer so that, when decoding, arrays can directly adopt
+ * the memory of the received buffer instead of copying and parsing it as the
+ * legacy VTK format requires.
+ *
+ * Large arrays can optionally be compressed using zlib or LZ4. They are split
+ * in chunks that are compressed and decompressed in parallel using
+ * vtkSMPTools.
+ *
+ * The buffer starts with a magic string and a format version. Use
+ * IsSerializedBuffer() to distinguish it from other encodings.
+ *
+ * Supported data objects are vtkPolyData, vtkUnstructuredGrid (without
+ * polyhedra), vtkImageData, vtkStructuredGrid, vtkRectilinearGrid, vtkTable
+ * and vtkMultiBlockDataSet, vtkMultiPieceDataSet or vtkPartitionedDataSet
+ * made of these. Arrays must be numeric data arrays or vtkStringArray.
+ * Serialize() returns false for anything else so that callers can fall back
+ * to another encoding.
+ */
+
+#ifndef vtkPVDataObjectSerializer_h
+#define vtkPVDataObjectSerializer_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+#include "vtkSmartPointer.h"                          // needed for vtkSmartPointer
+
+#include <memory> // for std::shared_ptr
+
+class vtkDataObject;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkPVDataObjectSerializer : public vtkObject
+{
+public:
+  static vtkPVDataObjectSerializer* New();
+  vtkTypeMacro(vtkPVDataObjectSerializer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum CompressionMethods
+  {
+    NO_COMPRESSION = 0,
+    ZLIB = 1,
+    LZ4 = 2
+  };
+
+  ///@{
+  /**
+   * Compression applied to arrays larger than CompressionThreshold bytes.
+   * Arrays that do not compress well are stored uncompressed.
+   * Default is NO_COMPRESSION.
+   */
+  vtkSetClampMacro(Compression, int, NO_COMPRESSION, LZ4);
+  vtkGetMacro(Compression, int);
+  ///@}
+
+  ///@{
+  /**
+   * Arrays smaller than this number of bytes are never compressed.
+   * Default is 64 KiB.
+   */
+  vtkSetMacro(CompressionThreshold, vtkIdType);
+  vtkGetMacro(CompressionThreshold, vtkIdType);
+  ///@}
+
+  /**
+   * Encodes `data`. On success, `buffer` is allocated with `new[]` and must be
+   * released with `delete[]` by the caller. Returns false if the data object
+   * or one of its arrays is not supported.
+   */
+  bool Serialize(vtkDataObject* data, char*& buffer, vtkIdType& length);
+
+  /**
+   * Decodes a buffer produced by Serialize(). When `storage` is not null, it
+   * must own the memory `buffer` points to. Uncompressed arrays then share
+   * that memory instead of copying it, and keep `storage` alive for as long as
+   * they need it. Returns nullptr if the buffer is invalid.
+   */
+  static vtkSmartPointer<vtkDataObject> Deserialize(
+    const char* buffer, vtkIdType length, const std::shared_ptr<const char>& storage = nullptr);
+
+  /**
+   * Returns true if `buffer` starts with the header of an encoding produced by
+   * Serialize().
+   */
+  static bool IsSerializedBuffer(const char* buffer, vtkIdType length);
+
+protected:
+  vtkPVDataObjectSerializer();
+  ~vtkPVDataObjectSerializer() override;
+
+  int Compression;
+  vtkIdType CompressionThreshold;
+
+private:
+  vtkPVDataObjectSerializer(const vtkPVDataObjectSerializer&) = delete;
+  void operator=(const vtkPVDataObjectSerializer&) = delete;
+};
+
+#endif
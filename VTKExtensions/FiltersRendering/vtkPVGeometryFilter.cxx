@@ -27,12 +27,15 @@
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridFeatureEdges.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix3x3.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -49,6 +52,8 @@
 #include "vtkRecoverGeometryWireframe.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -56,16 +61,26 @@
 #include "vtkTimerLog.h"
 #include "vtkTriangleFilter.h"
 #include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridGeometryFilter.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace details
@@ -145,6 +160,145 @@ void CleanupTemporaryOriginalIds(vtkDataObject* object)
   }
 }
 
+//----------------------------------------------------------------------------
+// Cheap, non-cryptographic 64-bit hash used to fingerprint meshes.
+vtkTypeUInt64 HashBytes(const void* data, size_t length, vtkTypeUInt64 seed)
+{
+  constexpr vtkTypeUInt64 prime1 = 0x9E3779B185EBCA87ULL;
+  constexpr vtkTypeUInt64 prime2 = 0xC2B2AE3D27D4EB4FULL;
+  const auto bytes = static_cast<const unsigned char*>(data);
+  vtkTypeUInt64 hash = seed ^ (static_cast<vtkTypeUInt64>(length) * prime1);
+  const size_t numWords = length / sizeof(vtkTypeUInt64);
+  for (size_t cc = 0; cc < numWords; ++cc)
+  {
+    vtkTypeUInt64 word;
+    std::memcpy(&word, bytes + cc * sizeof(word), sizeof(word));
+    hash ^= word * prime2;
+    hash = ((hash << 31) | (hash >> 33)) * prime1;
+  }
+  for (size_t cc = numWords * sizeof(vtkTypeUInt64); cc < length; ++cc)
+  {
+    hash ^= bytes[cc] * prime1;
+    hash = ((hash << 11) | (hash >> 53)) * prime2;
+  }
+  hash ^= hash >> 33;
+  hash *= prime2;
+  hash ^= hash >> 29;
+  return hash;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 HashArray(vtkAbstractArray* array, vtkTypeUInt64 seed)
+{
+  if (!array)
+  {
+    return HashBytes(nullptr, 0, seed);
+  }
+  if (array->HasStandardMemoryLayout())
+  {
+    const size_t length =
+      static_cast<size_t>(array->GetDataSize()) * static_cast<size_t>(array->GetDataTypeSize());
+    return HashBytes(length > 0 ? array->GetVoidPointer(0) : nullptr, length, seed);
+  }
+  // arrays without a contiguous buffer are identified by instance and MTime.
+  const vtkTypeUInt64 identity[2] = {
+    static_cast<vtkTypeUInt64>(reinterpret_cast<std::uintptr_t>(array)),
+    static_cast<vtkTypeUInt64>(array->GetMTime()),
+  };
+  return HashBytes(identity, sizeof(identity), seed);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Copies attributes of `input` onto a cached surface, using the
+ * TEMP_ORIGINAL_IDS array of `cached` to map output elements to input ones.
+ * Arrays of `cached` that did not come from the input (normals, original ids,
+ * process ids...) are kept as-is. `inputNames` are the names of the input
+ * arrays when the surface was cached and `forwardedNames` those among them
+ * that made it to the output.
+ */
+void RemapAttributes(vtkDataSetAttributes* cached, vtkDataSetAttributes* input,
+  const std::set<std::string>& inputNames, const std::set<std::string>& forwardedNames,
+  vtkDataSetAttributes* output)
+{
+  auto originalIds = cached->GetArray(details::TEMP_ORIGINAL_IDS);
+  if (!originalIds)
+  {
+    return;
+  }
+
+  const vtkIdType numIds = originalIds->GetNumberOfTuples();
+  vtkNew<vtkIdList> ids;
+  ids->SetNumberOfIds(numIds);
+  if (auto idsArray = vtkIdTypeArray::SafeDownCast(originalIds))
+  {
+    std::copy_n(idsArray->GetPointer(0), numIds, ids->GetPointer(0));
+  }
+  else
+  {
+    for (vtkIdType cc = 0; cc < numIds; ++cc)
+    {
+      ids->SetId(cc, static_cast<vtkIdType>(originalIds->GetComponent(cc, 0)));
+    }
+  }
+
+  for (int cc = 0, max = cached->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    auto array = cached->GetAbstractArray(cc);
+    const char* name = array->GetName();
+    if (!name || forwardedNames.find(name) == forwardedNames.end())
+    {
+      output->AddArray(array);
+    }
+  }
+
+  for (int cc = 0, max = input->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    auto array = input->GetAbstractArray(cc);
+    const char* name = array->GetName();
+    if (!name || strcmp(name, details::TEMP_ORIGINAL_IDS) == 0 ||
+      (inputNames.find(name) != inputNames.end() &&
+        forwardedNames.find(name) == forwardedNames.end()))
+    {
+      // arrays not forwarded by the filter stay that way.
+      continue;
+    }
+
+    auto remapped = vtk::TakeSmartPointer(vtkAbstractArray::CreateArray(array->GetDataType()));
+    remapped->SetName(name);
+    remapped->SetNumberOfComponents(array->GetNumberOfComponents());
+    remapped->CopyComponentNames(array);
+    remapped->SetNumberOfTuples(numIds);
+    array->GetTuples(ids, remapped);
+    output->AddArray(remapped);
+  }
+
+  for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+  {
+    for (auto source : { cached, input })
+    {
+      auto active = source->GetAbstractAttribute(attr);
+      if (active && active->GetName() && output->GetAbstractArray(active->GetName()))
+      {
+        output->SetActiveAttribute(active->GetName(), attr);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void CollectArrayNames(vtkDataSetAttributes* attributes, std::set<std::string>& names)
+{
+  for (int cc = 0, max = attributes->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    const char* name = attributes->GetArrayName(cc);
+    if (name && strcmp(name, details::TEMP_ORIGINAL_IDS) != 0)
+    {
+      names.insert(name);
+    }
+  }
+}
+
 };
 
 template <typename T>
@@ -160,6 +314,221 @@ void GetValidWholeExtent(T* ds, const int wholeExt[6], int validWholeExt[6])
   }
 }
 
+//----------------------------------------------------------------------------
+// Bounded LRU cache of extracted surfaces, keyed on (block id, mesh
+// fingerprint). Lookups and insertions may happen concurrently when blocks are
+// executed in parallel.
+class vtkPVGeometryFilter::SurfaceCache
+{
+public:
+  using KeyT = std::pair<unsigned int, vtkTypeUInt64>;
+
+  struct Entry
+  {
+    KeyT Key;
+    vtkSmartPointer<vtkPolyData> Surface;
+    std::set<std::string> InputPointArrays;
+    std::set<std::string> ForwardedPointArrays;
+    std::set<std::string> InputCellArrays;
+    std::set<std::string> ForwardedCellArrays;
+    vtkIdType MemorySize = 0; // in KiB
+    vtkMTimeType FilterMTime = 0;
+  };
+
+  // Called before each execution. Entries cached before the filter was last
+  // modified are dropped when they are looked up, see CopyTo(). Array hashes
+  // not used by the previous execution are released.
+  void BeginExecution(vtkMTimeType filterMTime)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->FilterMTime = filterMTime;
+    this->PreviousArrayHashes = std::move(this->ArrayHashes);
+    this->ArrayHashes.clear();
+  }
+
+  // Combines the content hash of `array` with `seed`. The content hash is only
+  // computed when the array is new or was modified since it was last hashed.
+  vtkTypeUInt64 HashArray(vtkAbstractArray* array, vtkTypeUInt64 seed)
+  {
+    if (!array)
+    {
+      return details::HashArray(nullptr, seed);
+    }
+    const vtkMTimeType mtime = array->GetMTime();
+    vtkTypeUInt64 value = 0;
+    bool found = false;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto iter = this->ArrayHashes.find(array);
+      if (iter != this->ArrayHashes.end() && iter->second.first == mtime)
+      {
+        value = iter->second.second;
+        found = true;
+      }
+      else if ((iter = this->PreviousArrayHashes.find(array)) != this->PreviousArrayHashes.end() &&
+        iter->second.first == mtime)
+      {
+        value = iter->second.second;
+        this->ArrayHashes[array] = iter->second;
+        found = true;
+      }
+    }
+    if (!found)
+    {
+      value = details::HashArray(array, 0);
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->ArrayHashes[array] = std::make_pair(mtime, value);
+    }
+    return details::HashBytes(&value, sizeof(value), seed);
+  }
+
+  bool CopyTo(const KeyT& key, vtkDataSet* input, vtkPolyData* output)
+  {
+    // copy the entry so that it can be used without holding the lock while
+    // other threads insert, and possibly evict, entries.
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto found = this->Index.find(key);
+      if (found != this->Index.end() && found->second->FilterMTime != this->FilterMTime)
+      {
+        // extracted with other settings, it will not be valid again.
+        this->MemorySize -= found->second->MemorySize;
+        this->Entries.erase(found->second);
+        this->Index.erase(found);
+        found = this->Index.end();
+      }
+      if (found == this->Index.end())
+      {
+        ++this->Misses;
+        return false;
+      }
+      ++this->Hits;
+      this->Entries.splice(this->Entries.begin(), this->Entries, found->second);
+      entry = *found->second;
+    }
+
+    vtkPolyData* surface = entry.Surface;
+    output->CopyStructure(surface);
+    output->GetFieldData()->PassData(input->GetFieldData());
+    details::RemapAttributes(surface->GetPointData(), input->GetPointData(),
+      entry.InputPointArrays, entry.ForwardedPointArrays, output->GetPointData());
+    details::RemapAttributes(surface->GetCellData(), input->GetCellData(), entry.InputCellArrays,
+      entry.ForwardedCellArrays, output->GetCellData());
+    return true;
+  }
+
+  void Insert(const KeyT& key, vtkDataSet* input, vtkPolyData* output, vtkIdType limit)
+  {
+    // the cached surface must be able to map its elements back to the input.
+    if ((output->GetNumberOfPoints() > 0 &&
+          !output->GetPointData()->GetArray(details::TEMP_ORIGINAL_IDS)) ||
+      (output->GetNumberOfCells() > 0 &&
+        !output->GetCellData()->GetArray(details::TEMP_ORIGINAL_IDS)))
+    {
+      return;
+    }
+
+    Entry entry;
+    entry.Key = key;
+    entry.Surface = vtkSmartPointer<vtkPolyData>::New();
+    entry.Surface->ShallowCopy(output);
+    entry.MemorySize = static_cast<vtkIdType>(entry.Surface->GetActualMemorySize());
+    if (entry.MemorySize > limit)
+    {
+      return;
+    }
+
+    details::CollectArrayNames(input->GetPointData(), entry.InputPointArrays);
+    details::CollectArrayNames(input->GetCellData(), entry.InputCellArrays);
+    for (const auto& name : entry.InputPointArrays)
+    {
+      if (output->GetPointData()->GetAbstractArray(name.c_str()))
+      {
+        entry.ForwardedPointArrays.insert(name);
+      }
+    }
+    for (const auto& name : entry.InputCellArrays)
+    {
+      if (output->GetCellData()->GetAbstractArray(name.c_str()))
+      {
+        entry.ForwardedCellArrays.insert(name);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    entry.FilterMTime = this->FilterMTime;
+    auto found = this->Index.find(key);
+    if (found != this->Index.end())
+    {
+      this->MemorySize -= found->second->MemorySize;
+      this->Entries.erase(found->second);
+      this->Index.erase(found);
+    }
+    this->MemorySize += entry.MemorySize;
+    this->Entries.push_front(std::move(entry));
+    this->Index[key] = this->Entries.begin();
+
+    while (this->MemorySize > limit && !this->Entries.empty())
+    {
+      auto& last = this->Entries.back();
+      this->MemorySize -= last.MemorySize;
+      this->Index.erase(last.Key);
+      this->Entries.pop_back();
+    }
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->ClearInternal();
+    this->Hits = 0;
+    this->Misses = 0;
+  }
+
+  int GetHits()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Hits;
+  }
+
+  int GetMisses()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Misses;
+  }
+
+  int GetMemorySize()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return static_cast<int>(this->MemorySize);
+  }
+
+private:
+  void ClearInternal()
+  {
+    this->Entries.clear();
+    this->Index.clear();
+    this->MemorySize = 0;
+    this->ArrayHashes.clear();
+    this->PreviousArrayHashes.clear();
+  }
+
+  std::mutex Mutex;
+  std::list<Entry> Entries; // most recently used first.
+  std::map<KeyT, std::list<Entry>::iterator> Index;
+  vtkIdType MemorySize = 0;
+  vtkMTimeType FilterMTime = 0;
+  // (MTime, content hash) of the arrays hashed by the current and the previous
+  // execution. Arrays are only compared by address, never dereferenced.
+  using ArrayHashMap =
+    std::unordered_map<const vtkAbstractArray*, std::pair<vtkMTimeType, vtkTypeUInt64>>;
+  ArrayHashMap ArrayHashes;
+  ArrayHashMap PreviousArrayHashes;
+  int Hits = 0;
+  int Misses = 0;
+};
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkPVGeometryFilter);
 //----------------------------------------------------------------------------
@@ -174,6 +543,7 @@ vtkInformationKeyMacro(vtkPVGeometryFilter, STRIPS_OFFSETS, IntegerVector);
 
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
+  : SurfaceCacheStore(new SurfaceCache())
 {
   this->OutlineFlag = 0;
   this->UseOutline = 1;
@@ -505,6 +875,7 @@ int vtkPVGeometryFilter::RequestData(
   {
     return 1;
   }
+  this->SurfaceCacheStore->BeginExecution(this->GetMTime());
 
   if (input->IsA("vtkCompositeDataSet"))
   {
@@ -545,8 +916,20 @@ int vtkPVGeometryFilter::RequestData(
     }
     else
     {
-      this->ExecuteBlock(modifiedInput, output, 1, procid, numProcs, 0, wholeExtent);
-      this->CleanupOutputData(output);
+      // `modifiedInput` already has the original ids arrays needed by the
+      // surface cache. Block id 0 is never used by leaves of composite datasets.
+      const SurfaceCache::KeyT key(0, this->GetSurfaceCacheFingerprint(modifiedInput));
+      auto inputDS = vtkDataSet::SafeDownCast(modifiedInput);
+      if (key.second == 0 || !this->SurfaceCacheStore->CopyTo(key, inputDS, output))
+      {
+        this->ExecuteBlock(modifiedInput, output, 1, procid, numProcs, 0, wholeExtent);
+        this->CleanupOutputData(output);
+        if (key.second != 0)
+        {
+          this->SurfaceCacheStore->Insert(
+            key, inputDS, output, static_cast<vtkIdType>(this->SurfaceCacheLimit) * 1024);
+        }
+      }
     }
   }
 
@@ -860,33 +1243,47 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
 
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
+
+  std::vector<vtkDataObject*> blocks;
+  std::vector<unsigned int> blockIds;
+  blocks.reserve(totalNumberOfBlocks);
+  blockIds.reserve(totalNumberOfBlocks);
   for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
-    {
-      continue;
-    }
+    blocks.push_back(inIter->GetCurrentDataObject());
+    blockIds.push_back(inIter->GetCurrentFlatIndex());
+  }
 
-    vtkNew<vtkPolyData> tmpOut;
-    auto blockHTG = vtkHyperTreeGrid::SafeDownCast(block);
-    if (this->GenerateFeatureEdges && blockHTG)
-    {
-      this->GenerateFeatureEdgesHTG(blockHTG, tmpOut);
-    }
-    else
+  std::vector<vtkSmartPointer<vtkPolyData>> outputs(blocks.size());
+  if (this->ThreadedBlockExecution && blocks.size() > 1)
+  {
+    this->ExecuteLeafBlocksInParallel(blocks, blockIds, outputs, wholeExtent);
+  }
+  else
+  {
+    for (size_t cc = 0; cc < blocks.size(); ++cc)
     {
-      this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-      this->CleanupOutputData(tmpOut);
+      if (blocks[cc])
+      {
+        outputs[cc] = vtkSmartPointer<vtkPolyData>::New();
+        this->ExecuteLeafBlockWithCache(this, blocks[cc], blockIds[cc], outputs[cc], wholeExtent);
+      }
+      this->UpdateProgress(static_cast<float>(cc + 1) / totalNumberOfBlocks);
     }
+  }
+
+  // assemble the output tree in traversal order; this is done serially so the
+  // result does not depend on how blocks were executed.
+  size_t blockIdx = 0;
+  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem(), ++blockIdx)
+  {
+    auto& tmpOut = outputs[blockIdx];
     // skip empty nodes.
-    if (tmpOut->GetNumberOfPoints() > 0)
+    if (tmpOut && tmpOut->GetNumberOfPoints() > 0)
     {
       output->SetDataSet(inIter, tmpOut);
       this->AddCompositeIndex(tmpOut, inIter->GetCurrentFlatIndex());
     }
-    this->UpdateProgress(static_cast<float>(++numInputs) / totalNumberOfBlocks);
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
@@ -996,6 +1393,226 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::ExecuteLeafBlock(
+  vtkDataObject* block, vtkPolyData* output, const int* wholeExtent)
+{
+  auto blockHTG = vtkHyperTreeGrid::SafeDownCast(block);
+  if (this->GenerateFeatureEdges && blockHTG)
+  {
+    this->GenerateFeatureEdgesHTG(blockHTG, output);
+  }
+  else
+  {
+    this->ExecuteBlock(block, output, 0, 0, 1, 0, wholeExtent);
+    this->CleanupOutputData(output);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Functor executing leaf blocks concurrently. The internal filters of
+// vtkPVGeometryFilter are stateful, so each thread gets its own clone of the
+// filter configured like the one being executed.
+class vtkPVGeometryFilter::BlockExecutor
+{
+public:
+  BlockExecutor(vtkPVGeometryFilter* self, const std::vector<vtkDataObject*>& blocks,
+    const std::vector<unsigned int>& blockIds, std::vector<vtkSmartPointer<vtkPolyData>>& outputs,
+    const int* wholeExtent)
+    : Self(self)
+    , Blocks(blocks)
+    , BlockIds(blockIds)
+    , Outputs(outputs)
+    , WholeExtent(wholeExtent)
+    , OutlineFlags(blocks.size(), -1)
+  {
+  }
+
+  void Initialize()
+  {
+    auto self = this->Self;
+    vtkSmartPointer<vtkPVGeometryFilter> worker;
+    worker.TakeReference(self->NewInstance());
+    worker->CopySettings(self);
+    this->Workers.Local() = worker;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& worker = this->Workers.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      if (this->Self->GetAbortExecute())
+      {
+        break;
+      }
+      if (auto block = this->Blocks[cc])
+      {
+        vtkNew<vtkPolyData> tmpOut;
+        worker->OutlineFlag = -1;
+        this->Self->ExecuteLeafBlockWithCache(
+          worker, block, this->BlockIds[cc], tmpOut, this->WholeExtent);
+        this->Outputs[cc] = tmpOut;
+        this->OutlineFlags[cc] = worker->OutlineFlag;
+      }
+      const auto done = ++this->NumberOfExecutedBlocks;
+      // progress events may only be fired from the thread that called For.
+      if (isFirst)
+      {
+        this->Self->UpdateProgress(static_cast<double>(done) / this->Blocks.size());
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    // like the serial execution, the last block that sets the flag wins;
+    // blocks that did not set it (e.g. reused from the cache) are -1.
+    for (const int flag : this->OutlineFlags)
+    {
+      if (flag != -1)
+      {
+        this->Self->OutlineFlag = flag;
+      }
+    }
+  }
+
+private:
+  vtkPVGeometryFilter* Self;
+  const std::vector<vtkDataObject*>& Blocks;
+  const std::vector<unsigned int>& BlockIds;
+  std::vector<vtkSmartPointer<vtkPolyData>>& Outputs;
+  const int* WholeExtent;
+  std::vector<int> OutlineFlags;
+  std::atomic<vtkIdType> NumberOfExecutedBlocks{ 0 };
+  vtkSMPThreadLocal<vtkSmartPointer<vtkPVGeometryFilter>> Workers;
+};
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::ExecuteLeafBlocksInParallel(const std::vector<vtkDataObject*>& blocks,
+  const std::vector<unsigned int>& blockIds, std::vector<vtkSmartPointer<vtkPolyData>>& outputs,
+  const int* wholeExtent)
+{
+  assert(blocks.size() == outputs.size() && blocks.size() == blockIds.size());
+  vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::ExecuteLeafBlocksInParallel");
+  BlockExecutor executor(this, blocks, blockIds, outputs, wholeExtent);
+  // blocks vary a lot in size, hand them out one at a time.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), 1, executor);
+  vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteLeafBlocksInParallel");
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::ExecuteLeafBlockWithCache(vtkPVGeometryFilter* executor,
+  vtkDataObject* block, unsigned int blockId, vtkPolyData* output, const int* wholeExtent)
+{
+  const SurfaceCache::KeyT key(blockId, this->GetSurfaceCacheFingerprint(block));
+  if (key.second == 0)
+  {
+    executor->ExecuteLeafBlock(block, output, wholeExtent);
+    return;
+  }
+
+  auto dataSet = vtkDataSet::SafeDownCast(block);
+  if (!this->SurfaceCacheStore->CopyTo(key, dataSet, output))
+  {
+    // leaves are shared with the input, add the original ids arrays to a copy.
+    auto dataSetCopy = vtk::TakeSmartPointer(dataSet->NewInstance());
+    dataSetCopy->ShallowCopy(dataSet);
+    details::AddTemporaryOriginalIdsArrays(dataSetCopy);
+    executor->ExecuteLeafBlock(dataSetCopy, output, wholeExtent);
+    this->SurfaceCacheStore->Insert(
+      key, dataSetCopy, output, static_cast<vtkIdType>(this->SurfaceCacheLimit) * 1024);
+  }
+  details::CleanupTemporaryOriginalIds(output);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVGeometryFilter::GetSurfaceCacheFingerprint(vtkDataObject* dobj)
+{
+  auto ds = vtkDataSet::SafeDownCast(dobj);
+  if (this->SurfaceCacheLimit <= 0 || this->UseOutline || !ds || ds->GetNumberOfCells() == 0 ||
+    vtkPolyData::SafeDownCast(ds))
+  {
+    return 0;
+  }
+
+  const vtkTypeInt64 header[3] = { ds->GetDataObjectType(), ds->GetNumberOfPoints(),
+    ds->GetNumberOfCells() };
+  vtkTypeUInt64 hash = details::HashBytes(header, sizeof(header), 0);
+  // the content of the arrays is only hashed again when they are modified.
+  auto cache = this->SurfaceCacheStore.get();
+
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    auto distinctTypes = ug->GetDistinctCellTypesArray();
+    for (vtkIdType cc = 0; distinctTypes && cc < distinctTypes->GetNumberOfValues(); ++cc)
+    {
+      if (distinctTypes->GetValue(cc) == VTK_POLYHEDRON)
+      {
+        return 0;
+      }
+    }
+    hash = cache->HashArray(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr, hash);
+    auto cells = ug->GetCells();
+    hash = cache->HashArray(cells ? cells->GetOffsetsArray() : nullptr, hash);
+    hash = cache->HashArray(cells ? cells->GetConnectivityArray() : nullptr, hash);
+    hash = cache->HashArray(ug->GetCellTypesArray(), hash);
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    hash = details::HashBytes(sg->GetExtent(), 6 * sizeof(int), hash);
+    hash = cache->HashArray(sg->GetPoints() ? sg->GetPoints()->GetData() : nullptr, hash);
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    hash = details::HashBytes(rg->GetExtent(), 6 * sizeof(int), hash);
+    hash = cache->HashArray(rg->GetXCoordinates(), hash);
+    hash = cache->HashArray(rg->GetYCoordinates(), hash);
+    hash = cache->HashArray(rg->GetZCoordinates(), hash);
+  }
+  else if (auto img = vtkImageData::SafeDownCast(ds))
+  {
+    hash = details::HashBytes(img->GetExtent(), 6 * sizeof(int), hash);
+    hash = details::HashBytes(img->GetOrigin(), 3 * sizeof(double), hash);
+    hash = details::HashBytes(img->GetSpacing(), 3 * sizeof(double), hash);
+    hash = details::HashBytes(img->GetDirectionMatrix()->GetData(), 9 * sizeof(double), hash);
+  }
+  else
+  {
+    return 0;
+  }
+
+  // ghost arrays (and blanking) change which faces are extracted.
+  hash = cache->HashArray(ds->GetPointData()->GetGhostArray(), hash);
+  hash = cache->HashArray(ds->GetCellData()->GetGhostArray(), hash);
+  return hash != 0 ? hash : 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeometryFilter::GetSurfaceCacheHits()
+{
+  return this->SurfaceCacheStore->GetHits();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeometryFilter::GetSurfaceCacheMisses()
+{
+  return this->SurfaceCacheStore->GetMisses();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeometryFilter::GetSurfaceCacheMemorySize()
+{
+  return this->SurfaceCacheStore->GetMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::ClearSurfaceCache()
+{
+  this->SurfaceCacheStore->Clear();
+}
+
 //----------------------------------------------------------------------------
 // We need to change the mapper.  Now it always flat shades when cell normals
 // are available.
@@ -1707,6 +2324,37 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "HideInternalAMRFaces: " << (this->HideInternalAMRFaces ? "on" : "off") << endl;
   os << indent << "UseNonOverlappingAMRMetaDataForOutlines: "
      << (this->UseNonOverlappingAMRMetaDataForOutlines ? "on" : "off") << endl;
+  os << indent << "ThreadedBlockExecution: " << (this->ThreadedBlockExecution ? "on" : "off")
+     << endl;
+  os << indent << "SurfaceCacheLimit: " << this->SurfaceCacheLimit << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::CopySettings(vtkPVGeometryFilter* source)
+{
+  if (!source || source == this)
+  {
+    return;
+  }
+  // the setters also configure the internal filters.
+  this->SetController(source->Controller);
+  this->SetUseOutline(source->UseOutline);
+  this->SetGenerateFeatureEdges(source->GenerateFeatureEdges);
+  this->SetBlockColorsDistinctValues(source->BlockColorsDistinctValues);
+  this->SetGenerateCellNormals(source->GenerateCellNormals);
+  this->SetGeneratePointNormals(source->GeneratePointNormals);
+  this->SetSplitting(source->Splitting);
+  this->SetFeatureAngle(source->FeatureAngle);
+  this->SetTriangulate(source->Triangulate);
+  this->SetNonlinearSubdivisionLevel(source->NonlinearSubdivisionLevel);
+  this->SetMatchBoundariesIgnoringCellOrder(source->MatchBoundariesIgnoringCellOrder);
+  this->SetPassThroughCellIds(source->PassThroughCellIds);
+  this->SetPassThroughPointIds(source->PassThroughPointIds);
+  this->SetGenerateProcessIds(source->GenerateProcessIds);
+  this->SetHideInternalAMRFaces(source->HideInternalAMRFaces);
+  this->SetUseNonOverlappingAMRMetaDataForOutlines(source->UseNonOverlappingAMRMetaDataForOutlines);
+  this->SetThreadedBlockExecution(source->ThreadedBlockExecution);
+  this->SetSurfaceCacheLimit(source->SurfaceCacheLimit);
 }
 
 //----------------------------------------------------------------------------
@@ -18,6 +18,9 @@
 
 #include "vtkNew.h" // for vtkNew
 
+#include <memory> // for std::unique_ptr
+#include <vector> // for std::vector
+
 class vtkCallbackCommand;
 class vtkCellGrid;
 class vtkDataSet;
@@ -231,6 +234,62 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, the surfaces of the leaf blocks of a composite dataset
+   * (other than AMR) are extracted concurrently using vtkSMPTools, each thread
+   * working with its own set of internal filters. The output tree is then
+   * assembled in the same order as the serial execution, so the result does
+   * not depend on this flag. Default is false.
+   */
+  vtkSetMacro(ThreadedBlockExecution, bool);
+  vtkGetMacro(ThreadedBlockExecution, bool);
+  vtkBooleanMacro(ThreadedBlockExecution, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum amount of memory, in MiB, used to keep the surfaces extracted by
+   * previous executions. When non-zero, extracted surfaces are cached per block,
+   * keyed on a fingerprint of the block's mesh (points, cells and ghost
+   * arrays) rather than on its MTime. When a block with a known mesh comes
+   * back, e.g. when going back and forth through the timesteps of a dataset
+   * with a static mesh and time-varying fields, its cached surface is reused
+   * and only the point and cell attributes are copied onto it through the
+   * original point and cell ids. Least recently used surfaces are evicted first.
+   * The content of the mesh arrays is only hashed again when their MTime
+   * changes. Surfaces cached before this filter was last modified are not
+   * reused and are released when looked up. Outlines, polydata
+   * and polyhedral grids are never cached. Default is 0 i.e. disabled.
+   */
+  vtkSetClampMacro(SurfaceCacheLimit, int, 0, VTK_INT_MAX);
+  vtkGetMacro(SurfaceCacheLimit, int);
+  ///@}
+
+  ///@{
+  /**
+   * Statistics about the surface cache: number of lookups that reused a cached
+   * surface, number of lookups that had to extract the surface and memory
+   * currently used by cached surfaces, in KiB.
+   */
+  int GetSurfaceCacheHits();
+  int GetSurfaceCacheMisses();
+  int GetSurfaceCacheMemorySize();
+  ///@}
+
+  /**
+   * Release all the surfaces kept by the surface cache and reset statistics.
+   */
+  void ClearSurfaceCache();
+
+  /**
+   * Copy all the settings of `source`, i.e. everything but its execution
+   * state and caches, into this filter. This is how the per-thread clones used
+   * by ThreadedBlockExecution are configured; subclasses adding settings
+   * must override it.
+   */
+  virtual void CopySettings(vtkPVGeometryFilter* source);
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   PARAVIEW_DEPRECATED_IN_5_13_0("They are not used anymore.")
@@ -357,6 +416,8 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool ThreadedBlockExecution = false;
+  int SurfaceCacheLimit = 0;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
@@ -375,6 +436,39 @@ private:
   class BoundsReductionOperation;
   ///@}
 
+  /**
+   * Extract the surface of a single non-composite block of a data object tree
+   * into `output`.
+   */
+  void ExecuteLeafBlock(vtkDataObject* block, vtkPolyData* output, const int* wholeExtent);
+
+  /**
+   * Execute `ExecuteLeafBlock` for all `blocks` concurrently, using one clone
+   * of this filter per thread. `outputs` must have the same size as `blocks`.
+   * OutlineFlag is then set as the serial execution would have set it.
+   */
+  void ExecuteLeafBlocksInParallel(const std::vector<vtkDataObject*>& blocks,
+    const std::vector<unsigned int>& blockIds, std::vector<vtkSmartPointer<vtkPolyData>>& outputs,
+    const int* wholeExtent);
+  class BlockExecutor;
+
+  /**
+   * Fill `output` with the surface of `block` using the surface cache when
+   * possible, otherwise execute `executor->ExecuteLeafBlock` and cache the
+   * result. `executor` is either this filter or one of its per-thread clones.
+   */
+  void ExecuteLeafBlockWithCache(vtkPVGeometryFilter* executor, vtkDataObject* block,
+    unsigned int blockId, vtkPolyData* output, const int* wholeExtent);
+
+  /**
+   * Returns the fingerprint of the mesh of `dobj` used as surface cache key,
+   * or 0 if the surface of `dobj` must not be cached.
+   */
+  vtkTypeUInt64 GetSurfaceCacheFingerprint(vtkDataObject* dobj);
+
+  class SurfaceCache;
+  std::unique_ptr<SurfaceCache> SurfaceCacheStore;
+
   /**
    * Generate feature edges for the input hyper tree grid.
    * We need this dedicated function because generating feature edges
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkSortedTableStreamer.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCommunicator.h"
 #include "vtkCompositeDataSet.h"
@@ -20,12 +21,14 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkUnsignedIntArray.h"
 
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -34,6 +37,13 @@
 
 using std::ostringstream;
 
+namespace
+{
+// Number of previously sorted columns whose sorted index is kept, so that
+// sorting by one of them again does not sort it again.
+const size_t MaximumNumberOfRecentInternals = 3;
+}
+
 //****************************************************************************
 class vtkSortedTableStreamer::InternalsBase
 {
@@ -41,13 +51,19 @@ public:
   InternalsBase() = default;
   virtual ~InternalsBase() = default;
 
+  // Name of the column sorted by these internals.
+  std::string Column;
+  // Whether the last call to Compute() built the sorted index.
+  bool IndexBuilt = false;
+
   virtual void SetSelectedComponent(int newValue) = 0;
+  virtual void SetDataToSort(vtkDataArray* dataToSort) = 0;
   virtual void InvalidateCache() = 0;
   virtual int Extract(
     vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
   virtual int Compute(
     vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
-  virtual bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) = 0;
+  virtual bool IsInvalid(vtkMTimeType inputMTime, vtkMTimeType dataMTime) = 0;
   virtual bool IsSortable() = 0;
   virtual bool TestInternalClasses() = 0;
 
@@ -588,27 +604,55 @@ public:
     }
   };
 
+  // Sort key of a row. Rows are ordered by value, then by process and index,
+  // which makes the order total and identical on all processes.
+  struct SortKey
+  {
+    T Value;
+    int Process;
+    vtkIdType Index;
+
+    static bool ValueLess(T a, T b)
+    {
+      // NaN values go last, they would break the ordering otherwise.
+      if (vtkMath::IsNan(static_cast<double>(a)))
+      {
+        return false;
+      }
+      return vtkMath::IsNan(static_cast<double>(b)) || a < b;
+    }
+
+    static bool Less(const SortKey& a, const SortKey& b)
+    {
+      if (ValueLess(a.Value, b.Value))
+      {
+        return true;
+      }
+      if (ValueLess(b.Value, a.Value))
+      {
+        return false;
+      }
+      return a.Process < b.Process || (a.Process == b.Process && a.Index < b.Index);
+    }
+  };
+
   Internals()
   {
     // Only used for testing
     this->LocalSorter = nullptr;
-    this->GlobalHistogram = nullptr;
     this->Debug = false;
   }
 
-  Internals(vtkTable* input, vtkDataArray* dataToSort, vtkMultiProcessController* controller)
+  Internals(vtkMTimeType inputMTime, vtkMTimeType dataMTime, vtkDataArray* dataToSort,
+    vtkMultiProcessController* controller)
   {
     // Default values
     this->SelectedComponent = 0;
     this->NeedToBuildCache = true;
+    this->NeedToBuildIndex = true;
     this->DataToSort = dataToSort;
-
-    this->InputMTime = input->GetMTime();
-
-    if (dataToSort) // Might be nullptr
-    {
-      this->DataMTime = dataToSort->GetMTime();
-    }
+    this->InputMTime = inputMTime;
+    this->DataMTime = dataMTime;
 
     // Get MPI objects
     this->MPI = controller->GetCommunicator();
@@ -617,14 +661,9 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
-  ~Internals() override
-  {
-    delete this->LocalSorter;
-    delete this->GlobalHistogram;
-  }
+  ~Internals() override { delete this->LocalSorter; }
 
   // --------------------------------------------------------------------------
   bool IsSortable() override
@@ -694,61 +733,182 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  int BuildCache(bool sortableArray, bool invertOrder)
+  // Keep the local order, used when all the values are equal or when sorting
+  // by process id.
+  int BuildCache()
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
+    if (this->DataToSort)
+    {
+      this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
+    }
+    return 1;
+  }
 
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+  // --------------------------------------------------------------------------
+  // Fill the keys of the local rows with the selected component, or the
+  // magnitude scaled as in ArraySorter::Update().
+  void FillLocalKeys(std::vector<SortKey>& keys)
+  {
+    vtkDataArray* data = this->DataToSort;
+    const vtkIdType numTuples = data ? data->GetNumberOfTuples() : 0;
+    keys.resize(numTuples);
+    if (numTuples == 0)
+    {
+      return;
+    }
+
+    const int numComponents = data->GetNumberOfComponents();
+    const int component =
+      (numComponents == 1 && this->SelectedComponent < 0) ? 0 : this->SelectedComponent;
+    auto aos = vtkArrayDownCast<vtkAOSDataArrayTemplate<T>>(data);
+    const int me = this->Me;
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        SortKey& key = keys[i];
+        key.Process = me;
+        key.Index = i;
+        if (component < 0)
+        {
+          double value = 0;
+          for (int k = 0; k < numComponents; ++k)
+          {
+            const double tmp = aos ? static_cast<double>(aos->GetValue(i * numComponents + k))
+                                   : data->GetComponent(i, k);
+            value += tmp * tmp;
+          }
+          key.Value = static_cast<T>(std::sqrt(value) / std::sqrt(numComponents));
+        }
+        else
+        {
+          key.Value = aos ? aos->GetValue(i * numComponents + component)
+                          : static_cast<T>(data->GetComponent(i, component));
+        }
+      }
+    });
+  }
 
-    // Is there something to sort ???
-    if (!sortableArray)
+  // --------------------------------------------------------------------------
+  // Sort the keys of all processes with a sample sort, so that this process
+  // ends up with the keys at the global positions
+  // [SortedOffset, SortedOffset + SortedKeys.size()) of the ascending order:
+  //  1. the local keys are sorted in parallel,
+  //  2. every process picks NumProcs - 1 regularly spaced samples, the first
+  //     process sorts them all and broadcasts NumProcs - 1 splitters,
+  //  3. the keys between consecutive splitters are sent to the matching
+  //     process, which merges the runs it receives with a parallel sort.
+  // Only the keys are exchanged, rows stay where they are until requested.
+  void BuildSortedIndex()
+  {
+    this->NeedToBuildIndex = false;
+
+    std::vector<SortKey> local;
+    this->FillLocalKeys(local);
+    vtkSMPTools::Sort(local.begin(), local.end(), SortKey::Less);
+
+    if (this->NumProcs == 1)
+    {
+      this->SortedKeys.swap(local);
+      this->SortedOffset = 0;
+      this->SortedTotal = static_cast<vtkIdType>(this->SortedKeys.size());
+      return;
+    }
+
+    const vtkIdType keySize = static_cast<vtkIdType>(sizeof(SortKey));
+    const vtkIdType numLocal = static_cast<vtkIdType>(local.size());
+
+    // Regular samples of the local keys, gathered on the first process.
+    std::vector<SortKey> samples;
+    if (numLocal > 0)
     {
-      // Keep the same order as the local one because all the values are equals
-      if (this->DataToSort)
+      for (int k = 1; k < this->NumProcs; ++k)
       {
-        this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
+        samples.push_back(local[(k * numLocal) / this->NumProcs]);
       }
     }
-    else
+    std::vector<vtkIdType> lengths(this->NumProcs, 0);
+    std::vector<vtkIdType> offsets(this->NumProcs, 0);
+    const vtkIdType sampleLength = static_cast<vtkIdType>(samples.size()) * keySize;
+    this->MPI->Gather(&sampleLength, lengths.data(), 1, 0);
+    vtkIdType allSamplesLength = 0;
+    for (int i = 0; i < this->NumProcs; ++i)
     {
-      if (this->DataToSort)
+      offsets[i] = allSamplesLength;
+      allSamplesLength += lengths[i];
+    }
+    std::vector<SortKey> allSamples(this->Me == 0 ? allSamplesLength / keySize : 0);
+    this->MPI->GatherV(reinterpret_cast<const char*>(samples.data()),
+      reinterpret_cast<char*>(allSamples.data()), sampleLength, lengths.data(), offsets.data(), 0);
+
+    // Splitters, picked by the first process from the sorted samples.
+    std::vector<SortKey> splitters;
+    if (this->Me == 0 && !allSamples.empty())
+    {
+      std::sort(allSamples.begin(), allSamples.end(), SortKey::Less);
+      const vtkIdType numSamples = static_cast<vtkIdType>(allSamples.size());
+      for (int k = 1; k < this->NumProcs; ++k)
       {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
+        splitters.push_back(allSamples[(k * numSamples) / this->NumProcs]);
       }
-      else
+    }
+    vtkIdType numSplitters = static_cast<vtkIdType>(splitters.size());
+    this->MPI->Broadcast(&numSplitters, 1, 0);
+    splitters.resize(numSplitters);
+    if (numSplitters > 0)
+    {
+      this->MPI->Broadcast(reinterpret_cast<char*>(splitters.data()), numSplitters * keySize, 0);
+    }
+
+    // Process `p` receives the local keys in (splitters[p - 1], splitters[p]].
+    std::vector<vtkIdType> sendLengths(this->NumProcs, 0);
+    std::vector<vtkIdType> sendOffsets(this->NumProcs, 0);
+    vtkIdType begin = 0;
+    for (int p = 0; p < this->NumProcs; ++p)
+    {
+      vtkIdType end = numLocal;
+      if (p < numSplitters)
       {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
+        end = std::upper_bound(local.begin() + begin, local.end(), splitters[p], SortKey::Less) -
+          local.begin();
       }
+      sendOffsets[p] = begin * keySize;
+      sendLengths[p] = (end - begin) * keySize;
+      begin = end;
+    }
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
-
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
-
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    // All-to-all exchange, one scatter per process since vtkCommunicator has
+    // no all-to-all.
+    std::vector<SortKey> received;
+    for (int root = 0; root < this->NumProcs; ++root)
+    {
+      vtkIdType length = 0;
+      this->MPI->Scatter(sendLengths.data(), &length, 1, root);
+      const size_t first = received.size();
+      received.resize(first + length / keySize);
+      this->MPI->ScatterV(reinterpret_cast<const char*>(local.data()),
+        reinterpret_cast<char*>(received.data() + first), sendLengths.data(), sendOffsets.data(),
+        length, root);
+    }
+    std::vector<SortKey>().swap(local);
+    vtkSMPTools::Sort(received.begin(), received.end(), SortKey::Less);
+    this->SortedKeys.swap(received);
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+    // Global position of the keys held by this process.
+    const vtkIdType numSorted = static_cast<vtkIdType>(this->SortedKeys.size());
+    std::vector<vtkIdType> numSortedPerProcess(this->NumProcs, 0);
+    this->MPI->AllGather(&numSorted, numSortedPerProcess.data(), 1);
+    this->SortedOffset = 0;
+    this->SortedTotal = 0;
+    for (int p = 0; p < this->NumProcs; ++p)
+    {
+      if (p < this->Me)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        this->SortedOffset += numSortedPerProcess[p];
       }
+      this->SortedTotal += numSortedPerProcess[p];
     }
-
-    delete[] bufferHistogramValues;
-    return 1;
   }
 
   // --------------------------------------------------------------------------
@@ -763,7 +923,7 @@ public:
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
-      this->BuildCache(false, revertOrder);
+      this->BuildCache();
     }
 
     // Build empty local table with empty arrays so they stay in the same order
@@ -886,199 +1046,163 @@ public:
     return 1;
   }
   // --------------------------------------------------------------------------
+  // The rows of the block are looked up in the sorted index, then fetched from
+  // the processes holding them and merged in order on the first process.
   int Compute(vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize,
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
-    // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    // Make sure that the sorted index is built
+    //    All processes must agree since building it is collective. Requesting
+    //    another block or inverting the order reuses it.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    int needToBuildIndex = this->NeedToBuildIndex ? 1 : 0;
+    if (this->NumProcs > 1)
     {
-      this->BuildCache(true, revertOrder);
+      int globalNeedToBuildIndex = 0;
+      this->MPI->AllReduce(&needToBuildIndex, &globalNeedToBuildIndex, 1, vtkCommunicator::MAX_OP);
+      needToBuildIndex = globalNeedToBuildIndex;
+    }
+    this->IndexBuilt = needToBuildIndex != 0;
+    if (needToBuildIndex)
+    {
+      this->BuildSortedIndex();
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
-    // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
-    // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
-
-    // ------------------------------------------------------------------------
-    // Build local subset table
-    // ------------------------------------------------------------------------
-    vtkSmartPointer<vtkTable> localSubset;
-    localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
-
-    // ------------------------------------------------------------------------
-    // Find the process that will merge all subset table
+    // Find the rows of the block in the local part of the index, as
+    // (process, index, row in block) triplets
     // ------------------------------------------------------------------------
-    int mergePid = GetMergingProcessId(localSubset.GetPointer());
+    const vtkIdType first = std::min(block * blockSize, this->SortedTotal);
+    const vtkIdType last = std::min(first + blockSize, this->SortedTotal);
+    // The inverted order is the ascending order read backward.
+    const vtkIdType ascendingFirst = revertOrder ? this->SortedTotal - last : first;
+    const vtkIdType ascendingLast = revertOrder ? this->SortedTotal - first : last;
+    const vtkIdType localFirst = std::max(ascendingFirst, this->SortedOffset);
+    const vtkIdType localLast = std::min(
+      ascendingLast, this->SortedOffset + static_cast<vtkIdType>(this->SortedKeys.size()));
 
-    // ------------------------------------------------------------------------
-    // Add local meta-data in case of merge process
-    // ------------------------------------------------------------------------
-    if (this->NumProcs > 1 && this->Me == mergePid)
+    std::vector<vtkIdType> requests;
+    for (vtkIdType position = localFirst; position < localLast; ++position)
     {
-      vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
-      processIdArray->SetName("vtkOriginalProcessIds");
-      processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
-      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
-      {
-        processIdArray->InsertNextTuple1(mergePid);
-      }
-      localSubset->GetRowData()->AddArray(processIdArray);
+      const SortKey& key = this->SortedKeys[position - this->SortedOffset];
+      requests.push_back(key.Process);
+      requests.push_back(key.Index);
+      requests.push_back(revertOrder ? ascendingLast - 1 - position : position - ascendingFirst);
     }
 
     // ------------------------------------------------------------------------
-    // Send local subset array to process mergePid
+    // Gather the requests on the first process, then send each process the
+    // indices of the rows it must provide
     // ------------------------------------------------------------------------
-    if (this->Me != mergePid)
+    std::vector<std::vector<vtkIdType>> indices(this->NumProcs);
+    std::vector<std::vector<vtkIdType>> rowsInBlock(this->NumProcs);
+    std::vector<vtkIdType> localIndices;
+    if (this->NumProcs == 1)
     {
-      this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+      for (size_t cc = 0; cc < requests.size(); cc += 3)
+      {
+        indices[0].push_back(requests[cc + 1]);
+        rowsInBlock[0].push_back(requests[cc + 2]);
+      }
+      localIndices = indices[0];
     }
-
-    // ------------------------------------------------------------------------
-    // Merging procedure only on process mergePid
-    // ------------------------------------------------------------------------
-    if (this->Me == mergePid)
+    else
     {
-      vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
-      for (int i = 0; i < this->NumProcs; i++)
+      std::vector<vtkIdType> lengths(this->NumProcs, 0);
+      std::vector<vtkIdType> offsets(this->NumProcs, 0);
+      const vtkIdType requestLength = static_cast<vtkIdType>(requests.size());
+      this->MPI->Gather(&requestLength, lengths.data(), 1, 0);
+      vtkIdType allRequestsLength = 0;
+      for (int p = 0; p < this->NumProcs; ++p)
       {
-        if (i == mergePid)
-          continue;
-
-        this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+        offsets[p] = allRequestsLength;
+        allRequestsLength += lengths[p];
       }
+      std::vector<vtkIdType> allRequests(this->Me == 0 ? allRequestsLength : 0);
+      this->MPI->GatherV(requests.data(), allRequests.data(), requestLength, lengths.data(),
+        offsets.data(), 0);
 
-      // Sort new table/array
-      if (!this->DataToSort)
+      std::vector<vtkIdType> allIndices;
+      if (this->Me == 0)
       {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
+        for (size_t cc = 0; cc < allRequests.size(); cc += 3)
+        {
+          indices[allRequests[cc]].push_back(allRequests[cc + 1]);
+          rowsInBlock[allRequests[cc]].push_back(allRequests[cc + 2]);
+        }
+        vtkIdType offset = 0;
+        for (int p = 0; p < this->NumProcs; ++p)
+        {
+          allIndices.insert(allIndices.end(), indices[p].begin(), indices[p].end());
+          lengths[p] = static_cast<vtkIdType>(indices[p].size());
+          offsets[p] = offset;
+          offset += lengths[p];
+        }
       }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
+      vtkIdType numLocalIndices = 0;
+      this->MPI->Scatter(lengths.data(), &numLocalIndices, 1, 0);
+      localIndices.resize(numLocalIndices);
+      this->MPI->ScatterV(allIndices.data(), localIndices.data(), lengths.data(), offsets.data(),
+        numLocalIndices, 0);
+    }
 
-      if (!subsetArray)
+    // ------------------------------------------------------------------------
+    // Send the requested rows to the first process, which merges them
+    // ------------------------------------------------------------------------
+    vtkSmartPointer<vtkTable> localSubset;
+    localSubset.TakeReference(NewSubsetTable(input, localIndices));
+    if (this->Me != 0)
+    {
+      if (!localIndices.empty())
       {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
+        this->MPI->Send(localSubset.GetPointer(), 0, VTK_TABLE_EXCHANGE_TAG);
       }
 
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
-
-      // Add extra information such as structured indices, block number...
-      this->DecorateTable(input, localSubset.GetPointer(), mergePid);
-
-      // ShallowCopy it to the output
-      output->ShallowCopy(localSubset.GetPointer());
-    }
-    else
-    {
       // Ask other processes to provide metadata for table decoration
-      this->DecorateTable(input, nullptr, mergePid);
+      this->DecorateTable(input, nullptr, 0);
+      return 1;
     }
 
-    return 1;
-  }
-
-  // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
-  {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
+    if (this->NumProcs > 1)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
-
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
+      vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
+      processIdArray->SetName("vtkOriginalProcessIds");
+      processIdArray->SetNumberOfComponents(1);
+      processIdArray->Allocate(blockSize);
+      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
+        processIdArray->InsertNextTuple1(0);
       }
+      localSubset->GetRowData()->AddArray(processIdArray);
+    }
 
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
-
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
+    std::vector<vtkIdType> rowInBlock = rowsInBlock[0];
+    vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
+    for (int p = 1; p < this->NumProcs; ++p)
+    {
+      if (!indices[p].empty())
       {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        this->MPI->Receive(tmp.GetPointer(), p, VTK_TABLE_EXCHANGE_TAG);
+        this->MergeTable(p, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+        rowInBlock.insert(rowInBlock.end(), rowsInBlock[p].begin(), rowsInBlock[p].end());
       }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
+    }
+
+    // Put the merged rows in the order of the block
+    std::vector<vtkIdType> order(rowInBlock.size());
+    for (size_t row = 0; row < rowInBlock.size(); ++row)
+    {
+      order[rowInBlock[row]] = static_cast<vtkIdType>(row);
+    }
+    localSubset.TakeReference(NewSubsetTable(localSubset.GetPointer(), order));
 
-    delete[] bufferHistogramValues;
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, localSubset.GetPointer(), 0);
+
+    // ShallowCopy it to the output
+    output->ShallowCopy(localSubset.GetPointer());
+    return 1;
   }
 
   // --------------------------------------------------------------------------
@@ -1133,6 +1257,36 @@ public:
     return subTable;
   }
 
+  // --------------------------------------------------------------------------
+  static vtkTable* NewSubsetTable(vtkTable* srcTable, const std::vector<vtkIdType>& rows)
+  {
+    vtkTable* subTable = vtkTable::New();
+    const vtkIdType size = static_cast<vtkIdType>(rows.size());
+
+    // Loop on all column of the table
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
+    {
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
+
+      vtkAbstractArray* subArray = srcArray->NewInstance();
+      subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      subArray->SetName(srcArray->GetName());
+      subArray->SetNumberOfTuples(size);
+      if (auto sinfo = srcArray->GetInformation())
+      {
+        subArray->CopyInformation(sinfo);
+      }
+      for (vtkIdType idx = 0; idx < size; ++idx)
+      {
+        subArray->SetTuple(idx, rows[idx], srcArray);
+      }
+      subTable->GetRowData()->AddArray(subArray);
+      subArray->FastDelete();
+    }
+
+    return subTable;
+  }
+
   // --------------------------------------------------------------------------
   void SetSelectedComponent(int newValue) override
   {
@@ -1144,13 +1298,21 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  void InvalidateCache() override { this->NeedToBuildCache = true; }
+  // The array may be a new instance for every request, e.g. when the input has
+  // several partitions, but its values only change with the input.
+  void SetDataToSort(vtkDataArray* dataToSort) override { this->DataToSort = dataToSort; }
 
   // --------------------------------------------------------------------------
-  bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
+  void InvalidateCache() override
   {
-    return !dataToProcess || input->GetMTime() != this->InputMTime ||
-      dataToProcess->GetMTime() != this->DataMTime;
+    this->NeedToBuildCache = true;
+    this->NeedToBuildIndex = true;
+  }
+
+  // --------------------------------------------------------------------------
+  bool IsInvalid(vtkMTimeType inputMTime, vtkMTimeType dataMTime) override
+  {
+    return inputMTime != this->InputMTime || dataMTime != this->DataMTime;
   }
 
   // --------------------------------------------------------------------------
@@ -1352,17 +1514,20 @@ public:
   }
   // --------------------------------------------------------------------------
 private:
-  vtkMTimeType InputMTime;    // Keep the original input MTime
-  vtkMTimeType DataMTime;     // Keep the original data MTime
-  vtkDataArray* DataToSort;   // DataArray to sort
-  ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
-  double CommonRange[2];      // Scalar range used across processes
-  int Me;                     // Current process ID
-  int NumProcs;               // Number of processes involved
-  vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
-  int SelectedComponent;      // Component used to sort array
+  vtkMTimeType InputMTime;         // Keep the original input MTime
+  vtkMTimeType DataMTime;          // Keep the original data MTime
+  vtkDataArray* DataToSort;        // DataArray to sort
+  ArraySorter* LocalSorter;        // Local order used by Extract()
+  std::vector<SortKey> SortedKeys; // Local part of the globally sorted index
+  vtkIdType SortedOffset = 0;      // Global position of SortedKeys[0]
+  vtkIdType SortedTotal = 0;       // Number of keys on all processes
+  double CommonRange[2];           // Scalar range used across processes
+  int Me;                          // Current process ID
+  int NumProcs;                    // Number of processes involved
+  vtkCommunicator* MPI;            // MPI communicator to send/receive/gather
+  int SelectedComponent;           // Component used to sort array
   bool NeedToBuildCache;
+  bool NeedToBuildIndex;
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
@@ -1402,6 +1567,10 @@ vtkSortedTableStreamer::~vtkSortedTableStreamer()
     delete this->Internal;
     this->Internal = nullptr;
   }
+  for (auto recent : this->RecentInternals)
+  {
+    delete recent;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1666,6 +1835,32 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkDataArray* arrayToProcess = this->GetDataArrayToProcess(input);
 
+  // Processes without the array must sort with the same type as the others.
+  int dataType = arrayToProcess ? arrayToProcess->GetDataType() : -1;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int globalDataType;
+    this->Controller->AllReduce(&dataType, &globalDataType, 1, vtkCommunicator::MAX_OP);
+    dataType = globalDataType;
+  }
+
+  // The merged input table is new whenever it has several partitions, hence the
+  // input partitioned dataset and the arrays of its partitions tell whether the
+  // values to sort changed.
+  const vtkMTimeType inputMTime = inputPTD->GetMTime();
+  vtkMTimeType dataMTime = 0;
+  if (this->GetColumnToSort())
+  {
+    for (unsigned int cc = 0, max = inputPTD->GetNumberOfPartitions(); cc < max; ++cc)
+    {
+      auto partition = vtkTable::SafeDownCast(inputPTD->GetPartitionAsDataObject(cc));
+      if (auto array = partition ? partition->GetColumnByName(this->GetColumnToSort()) : nullptr)
+      {
+        dataMTime = std::max(dataMTime, array->GetMTime());
+      }
+    }
+  }
+
   const bool orderInverted = this->InvertOrder > 0;
 
   // --------------------------------------------------------------------------
@@ -1675,15 +1870,20 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   // single point/cell.
   // --------------------------------------------------------------------------
 
-  // Delete internal object if the input has change (table or array to sort)
-  if (this->Internal && this->Internal->IsInvalid(input, arrayToProcess))
+  // Delete internal object if the input has change
+  if (this->Internal && this->Internal->IsInvalid(inputMTime, dataMTime))
   {
     delete this->Internal;
     this->Internal = nullptr;
   }
 
   // Make sure that an internal object is available
-  this->CreateInternalIfNeeded(input, arrayToProcess);
+  this->CreateInternalIfNeeded(inputMTime, dataMTime, arrayToProcess, dataType);
+  if (!this->Internal)
+  {
+    return 0;
+  }
+  this->Internal->SetDataToSort(arrayToProcess);
   int realComponent =
     (!arrayToProcess) ? 0 : this->GetSelectedComponent() % arrayToProcess->GetNumberOfComponents();
   this->Internal->SetSelectedComponent(realComponent);
@@ -1697,6 +1897,10 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   else
   {
     this->Internal->Compute(input, output, this->Block, this->BlockSize, orderInverted);
+    if (this->Internal->IndexBuilt)
+    {
+      ++this->NumberOfIndexBuilds;
+    }
   }
 
   if (auto names = input->GetFieldData()->GetAbstractArray("vtkBlockNames"))
@@ -1723,28 +1927,24 @@ const char* vtkSortedTableStreamer::GetColumnNameToSort()
 void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 {
   this->SetColumnToSort(columnName);
-  if (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0)
+  if (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0 && this->Internal &&
+    this->Internal->Column != this->GetColumnToSort())
   {
-    if (this->Internal)
+    // Keep the sorted index of the previous column in case it is sorted again.
+    this->RecentInternals.insert(this->RecentInternals.begin(), this->Internal);
+    this->Internal = nullptr;
+    while (this->RecentInternals.size() > MaximumNumberOfRecentInternals)
     {
-      delete this->Internal;
-      this->Internal = nullptr;
+      delete this->RecentInternals.back();
+      this->RecentInternals.pop_back();
     }
   }
 }
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetInvertOrder(int newValue)
 {
-  bool changed = this->InvertOrder != newValue;
-  bool removeInternal = changed && strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0;
-
-  if (removeInternal && this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = nullptr;
-  }
-
-  if (changed)
+  // The sorted index serves both orders, no need to sort again.
+  if (this->InvertOrder != newValue)
   {
     this->InvertOrder = newValue;
     this->Modified();
@@ -1764,24 +1964,48 @@ vtkDataArray* vtkSortedTableStreamer::GetDataArrayToProcess(vtkTable* input)
 }
 
 //----------------------------------------------------------------------------
-void vtkSortedTableStreamer::CreateInternalIfNeeded(vtkTable* input, vtkDataArray* data)
+void vtkSortedTableStreamer::CreateInternalIfNeeded(
+  vtkMTimeType inputMTime, vtkMTimeType dataMTime, vtkDataArray* data, int dataType)
 {
+  const std::string column = this->GetColumnToSort() ? this->GetColumnToSort() : "";
   if (!this->Internal)
   {
-    if (data)
+    // Reuse the internals of a recently sorted column, if still valid.
+    for (auto iter = this->RecentInternals.begin(); iter != this->RecentInternals.end(); ++iter)
     {
-      switch (data->GetDataType())
+      if ((*iter)->Column == column)
       {
-        vtkTemplateMacro(
-          this->Internal = new Internals<VTK_TT>(input, data, this->GetController()););
-        default:
-          vtkErrorMacro("Array type not supported: " << data->GetClassName());
+        if (!(*iter)->IsInvalid(inputMTime, dataMTime))
+        {
+          this->Internal = *iter;
+        }
+        else
+        {
+          delete *iter;
+        }
+        this->RecentInternals.erase(iter);
+        break;
       }
     }
-    else
+  }
+
+  if (!this->Internal)
+  {
+    switch (dataType)
+    {
+      vtkTemplateMacro(this->Internal =
+                         new Internals<VTK_TT>(inputMTime, dataMTime, data, this->GetController()););
+      case -1:
+        // Provide an empty data
+        this->Internal =
+          new Internals<double>(inputMTime, dataMTime, nullptr, this->GetController());
+        break;
+      default:
+        vtkErrorMacro("Array type not supported: " << (data ? data->GetClassName() : ""));
+    }
+    if (this->Internal)
     {
-      // Provide an empty data
-      this->Internal = new Internals<double>(input, nullptr, this->GetController());
+      this->Internal->Column = column;
     }
   }
 }
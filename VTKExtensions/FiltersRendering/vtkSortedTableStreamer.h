@@ -18,6 +18,7 @@
 #include "vtkSmartPointer.h"                          // for vtkSmartPointer
 #include "vtkTableAlgorithm.h"
 #include <utility> // for std::pair
+#include <vector>  // for std::vector
 
 class vtkDataArray;
 class vtkIdTypeArray;
@@ -107,13 +108,20 @@ public:
   void SetInvertOrder(int newValue);
   vtkGetMacro(InvertOrder, int);
 
+  /**
+   * Number of times the globally sorted index was built, i.e. the number of
+   * requests that had to sort the data again.
+   */
+  vtkGetMacro(NumberOfIndexBuilds, int);
+
 protected:
   vtkSortedTableStreamer();
   ~vtkSortedTableStreamer() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
-  void CreateInternalIfNeeded(vtkTable* input, vtkDataArray* data);
+  void CreateInternalIfNeeded(
+    vtkMTimeType inputMTime, vtkMTimeType dataMTime, vtkDataArray* data, int dataType);
   vtkDataArray* GetDataArrayToProcess(vtkTable* input);
 
   ///@{
@@ -132,8 +140,12 @@ protected:
   bool ShowFieldData = false;
   int SelectedComponent;
   int InvertOrder;
+  int NumberOfIndexBuilds = 0;
 
 private:
+  // Internals of the columns sorted before the current one, most recent first.
+  std::vector<InternalsBase*> RecentInternals;
+
   vtkSortedTableStreamer(const vtkSortedTableStreamer&) = delete;
   void operator=(const vtkSortedTableStreamer&) = delete;
 
@@ -5,21 +5,197 @@
 #include "vtkSquirtCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::vtkSquirtCompressor()
   : SquirtLevel(3)
+  , NumberOfBands(1)
+  , NumberOfThreads(0)
 {
 }
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::~vtkSquirtCompressor() = default;
 
+namespace
+{
+// Banded streams start with this word, followed by the number of bands and,
+// for each band, the number of encoded words and the number of pixels it
+// decodes to. The encoded bands follow the index back to back.
+constexpr unsigned int SQUIRT_BANDED_MAGIC = 0x54525153; // "SQRT"
+
+// Bands smaller than this are not worth handing off to another thread.
+constexpr vtkIdType SQUIRT_MIN_PIXELS_PER_BAND = 64 * 1024;
+
+// Maximum run length for RGBA, the upper 4 bits of the count are used for opacity.
+constexpr unsigned int SQUIRT_MAX_RGBA_RUN = 0x0F;
+
+//-----------------------------------------------------------------------------
+// Encode `numPixels` RGBA pixels from `src` into `dst`, returns the number of
+// words written (never more than `numPixels`).
+vtkIdType EncodeRGBA(
+  const unsigned int* src, vtkIdType numPixels, unsigned int compressMask, unsigned int* dst)
+{
+  vtkIdType index = 0;
+  vtkIdType compIndex = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int currentColor = src[index];
+    const unsigned int maskedColor = currentColor & compressMask;
+    unsigned char opacity = reinterpret_cast<const unsigned char*>(&currentColor)[3];
+    index++;
+
+    // Compute Run. When a full window is available the comparison has a fixed
+    // trip count and no early exit so that the compiler can vectorize the
+    // masked compares; `alive` drops to 0 at the first mismatch.
+    unsigned int count = 0;
+    if (numPixels - index >= static_cast<vtkIdType>(SQUIRT_MAX_RGBA_RUN))
+    {
+      const unsigned int* window = src + index;
+      unsigned int alive = 1;
+      for (unsigned int cc = 0; cc < SQUIRT_MAX_RGBA_RUN; ++cc)
+      {
+        alive &= static_cast<unsigned int>((window[cc] & compressMask) == maskedColor);
+        count += alive;
+      }
+      index += count;
+    }
+    else
+    {
+      while ((index < numPixels) && ((src[index] & compressMask) == maskedColor))
+      {
+        index++;
+        count++;
+      }
+    }
+
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    dst[compIndex] = currentColor;
+    reinterpret_cast<unsigned char*>(dst + compIndex)[3] = static_cast<unsigned char>(count);
+    compIndex++;
+  }
+  return compIndex;
+}
+
+//-----------------------------------------------------------------------------
+// Encode `numPixels` RGB pixels from `src` into `dst`, returns the number of
+// words written (never more than `numPixels`).
+vtkIdType EncodeRGB(
+  const unsigned char* src, vtkIdType numPixels, unsigned int compressMask, unsigned int* dst)
+{
+  auto loadColor = [src](vtkIdType pixel) {
+    unsigned int color = 0;
+    unsigned char* p = reinterpret_cast<unsigned char*>(&color);
+    p[0] = src[3 * pixel];
+    p[1] = src[3 * pixel + 1];
+    p[2] = src[3 * pixel + 2];
+    return color;
+  };
+
+  vtkIdType index = 0;
+  vtkIdType compIndex = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int currentColor = loadColor(index);
+    const unsigned int maskedColor = currentColor & compressMask;
+    index++;
+
+    // Compute Run
+    unsigned int count = 0;
+    while ((index < numPixels) && (count < 255) &&
+      ((loadColor(index) & compressMask) == maskedColor))
+    {
+      index++;
+      count++;
+    }
+
+    // Record Run length
+    dst[compIndex] = currentColor;
+    reinterpret_cast<unsigned char*>(dst + compIndex)[3] = static_cast<unsigned char>(count);
+    compIndex++;
+  }
+  return compIndex;
+}
+
+//-----------------------------------------------------------------------------
+// Decode `numWords` words from `src` into at most `maxPixels` RGBA pixels in
+// `dst`. Returns the number of pixels written or -1 if the input overflows
+// the destination.
+vtkIdType DecodeRGBA(
+  const unsigned int* src, vtkIdType numWords, unsigned int* dst, vtkIdType maxPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numWords; i++)
+  {
+    // Get color and count
+    unsigned int currentColor = src[i];
+    unsigned char* colorBytes = reinterpret_cast<unsigned char*>(&currentColor);
+    const unsigned char count = colorBytes[3];
+
+    // The upper 4 bits of the count carry the opacity.
+    colorBytes[3] = static_cast<unsigned char>(((count & 0xF0) >> 4) * 16);
+
+    const vtkIdType runLength = 1 + (count & 0x0F);
+    if (index + runLength > maxPixels)
+    {
+      return -1;
+    }
+
+    // Blast color into color buffer
+    std::fill_n(dst + index, runLength, currentColor);
+    index += runLength;
+  }
+  return index;
+}
+
+//-----------------------------------------------------------------------------
+// Decode `numWords` words from `src` into at most `maxPixels` RGB pixels in
+// `dst`. Returns the number of pixels written or -1 if the input overflows
+// the destination.
+vtkIdType DecodeRGB(
+  const unsigned int* src, vtkIdType numWords, unsigned char* dst, vtkIdType maxPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numWords; i++)
+  {
+    // Get color and count
+    const unsigned int currentColor = src[i];
+    const unsigned char* colorBytes = reinterpret_cast<const unsigned char*>(&currentColor);
+    const vtkIdType runLength = 1 + colorBytes[3];
+    if (index + runLength > maxPixels)
+    {
+      return -1;
+    }
+
+    for (vtkIdType j = 0; j < runLength; j++)
+    {
+      std::copy(colorBytes, colorBytes + 3, dst + 3 * (index + j));
+    }
+    index += runLength;
+  }
+  return index;
+}
+}
+
 //-----------------------------------------------------------------------------
 int vtkSquirtCompressor::Compress()
 {
@@ -37,12 +213,7 @@ int vtkSquirtCompressor::Compress()
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -58,105 +229,99 @@ int vtkSquirtCompressor::Compress()
   // I shifted the level by one so that 0 means no compression.
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
+  if (this->NumberOfBands != 1)
+  {
+    int status = VTK_ERROR;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->NumberOfThreads }, [&]() {
+      const vtkIdType numPixels = input->GetNumberOfTuples();
+      vtkIdType numberOfBands = this->NumberOfBands;
+      if (numberOfBands == 0)
+      {
+        numberOfBands = std::min<vtkIdType>(
+          vtkSMPTools::GetEstimatedNumberOfThreads(), numPixels / SQUIRT_MIN_PIXELS_PER_BAND);
+      }
+      numberOfBands = std::max<vtkIdType>(1, std::min(numberOfBands, numPixels));
+      status = this->CompressBanded(static_cast<int>(numberOfBands), compress_mask);
+    });
+    return status;
+  }
+
   // Access raw arrays directly
+  vtkIdType numPixels = input->GetNumberOfTuples();
+  unsigned int* _rawCompressedBuffer =
+    reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, numPixels * 4));
+  vtkIdType comp_index = 0;
   if (input->GetNumberOfComponents() == 4)
   {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
-    {
+    comp_index = ::EncodeRGBA(reinterpret_cast<unsigned int*>(input->GetPointer(0)), numPixels,
+      compress_mask, _rawCompressedBuffer);
+  }
+  else
+  {
+    comp_index = ::EncodeRGB(input->GetPointer(0), numPixels, compress_mask, _rawCompressedBuffer);
+  }
 
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
+  // Back to vtk arrays :)
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(4 * comp_index);
 
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::CompressBanded(int numberOfBands, unsigned int compressMask)
+{
+  vtkUnsignedCharArray* input = this->GetInput();
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const vtkIdType bandSize = (numPixels + numberOfBands - 1) / numberOfBands;
+  const vtkIdType headerSize = 2 + 2 * static_cast<vtkIdType>(numberOfBands);
+
+  // Each band is encoded in place at its worst-case offset (its first pixel)
+  // and the bands are packed together afterwards.
+  unsigned int* buffer =
+    reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, 4 * (headerSize + numPixels)));
+  unsigned int* header = buffer;
+  unsigned int* data = buffer + headerSize;
+  std::vector<vtkIdType> bandWords(numberOfBands, 0);
+
+  const unsigned char* src = input->GetPointer(0);
+  vtkSMPTools::For(0, numberOfBands, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType band = first; band < last; ++band)
+    {
+      const vtkIdType begin = std::min(band * bandSize, numPixels);
+      const vtkIdType end = std::min(begin + bandSize, numPixels);
+      if (numComps == 4)
       {
-        index++;
-        count++;
+        bandWords[band] = ::EncodeRGBA(reinterpret_cast<const unsigned int*>(src) + begin,
+          end - begin, compressMask, data + begin);
       }
-      if (opacity > 0)
+      else
       {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
+        bandWords[band] =
+          ::EncodeRGB(src + 3 * begin, end - begin, compressMask, data + begin);
       }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
     }
-  }
-  else if (input->GetNumberOfComponents() == 3)
+  });
+
+  header[0] = SQUIRT_BANDED_MAGIC;
+  header[1] = static_cast<unsigned int>(numberOfBands);
+  vtkIdType offset = 0;
+  for (int band = 0; band < numberOfBands; ++band)
   {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
+    const vtkIdType begin = std::min(band * bandSize, numPixels);
+    const vtkIdType end = std::min(begin + bandSize, numPixels);
+    if (offset != begin)
     {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
+      std::memmove(data + offset, data + begin, bandWords[band] * sizeof(unsigned int));
     }
+    header[2 + 2 * band] = static_cast<unsigned int>(bandWords[band]);
+    header[3 + 2 * band] = static_cast<unsigned int>(end - begin);
+    offset += bandWords[band];
   }
 
-  // Back to vtk arrays :)
   this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
-
+  this->Output->SetNumberOfTuples(4 * (headerSize + offset));
   return VTK_OK;
 }
 
@@ -173,114 +338,127 @@ int vtkSquirtCompressor::Decompress()
 
   // We assume that 'out' has exactly the same number of component set as the
   // input before compression.
-  switch (out->GetNumberOfComponents())
+  if (out->GetNumberOfComponents() != 3 && out->GetNumberOfComponents() != 4)
   {
-    case 3:
-      return this->DecompressRGB();
-    case 4:
-      return this->DecompressRGBA();
-
-    default:
-      vtkErrorMacro("SQUIRT only support 3 or 4 component arrays.");
-      return VTK_ERROR;
+    vtkErrorMacro("SQUIRT only support 3 or 4 component arrays.");
+    return VTK_ERROR;
   }
+
+  // Streams without a band index are decoded as the legacy format, whatever
+  // the configuration.
+  vtkUnsignedCharArray* in = this->GetInput();
+  if (this->NumberOfBands != 1 && in->GetNumberOfTuples() >= 8 &&
+    *reinterpret_cast<const unsigned int*>(in->GetPointer(0)) == SQUIRT_BANDED_MAGIC)
+  {
+    int status = VTK_ERROR;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->NumberOfThreads },
+      [&]() { status = this->DecompressBanded(); });
+    return status;
+  }
+  return out->GetNumberOfComponents() == 3 ? this->DecompressRGB() : this->DecompressRGBA();
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGBA()
+int vtkSquirtCompressor::DecompressBanded()
 {
   vtkUnsignedCharArray* in = this->GetInput();
   vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 4);
+  const int numComps = out->GetNumberOfComponents();
 
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
+  const vtkIdType numWords = in->GetNumberOfTuples() / 4;
+  const unsigned int* buffer = reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  if (numWords < 2 || buffer[0] != SQUIRT_BANDED_MAGIC)
+  {
+    vtkErrorMacro("Invalid banded SQUIRT stream.");
+    return VTK_ERROR;
+  }
 
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  const vtkIdType numberOfBands = buffer[1];
+  const vtkIdType headerSize = 2 + 2 * numberOfBands;
+  if (headerSize > numWords)
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
+    vtkErrorMacro("Truncated banded SQUIRT stream.");
+    return VTK_ERROR;
+  }
 
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
+  // Locate every band in both the encoded and the decoded buffers.
+  std::vector<vtkIdType> wordOffsets(numberOfBands + 1, 0);
+  std::vector<vtkIdType> pixelOffsets(numberOfBands + 1, 0);
+  for (vtkIdType band = 0; band < numberOfBands; ++band)
+  {
+    wordOffsets[band + 1] = wordOffsets[band] + buffer[2 + 2 * band];
+    pixelOffsets[band + 1] = pixelOffsets[band] + buffer[3 + 2 * band];
+  }
+  if (headerSize + wordOffsets[numberOfBands] > numWords ||
+    pixelOffsets[numberOfBands] > out->GetNumberOfTuples())
+  {
+    vtkErrorMacro("Banded SQUIRT stream does not match the output size.");
+    return VTK_ERROR;
+  }
 
-    if (count > 0x0f)
+  const unsigned int* data = buffer + headerSize;
+  unsigned char* dst = out->GetPointer(0);
+  std::atomic<bool> valid(true);
+  vtkSMPTools::For(0, numberOfBands, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType band = first; band < last; ++band)
     {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
-    {
-      *((unsigned char*)&current_color + 3) = 0;
+      const vtkIdType maxPixels = pixelOffsets[band + 1] - pixelOffsets[band];
+      const vtkIdType bandWords = wordOffsets[band + 1] - wordOffsets[band];
+      const vtkIdType decoded = numComps == 4
+        ? ::DecodeRGBA(data + wordOffsets[band], bandWords,
+            reinterpret_cast<unsigned int*>(dst) + pixelOffsets[band], maxPixels)
+        : ::DecodeRGB(data + wordOffsets[band], bandWords, dst + 3 * pixelOffsets[band], maxPixels);
+      if (decoded != maxPixels)
+      {
+        valid = false;
+      }
     }
-    count &= 0x0F;
-
-    // Set color
-    _rawColorBuffer[index++] = current_color;
+  });
 
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
-    {
-      _rawColorBuffer[index++] = current_color;
-    }
+  if (!valid)
+  {
+    vtkErrorMacro("Corrupted banded SQUIRT stream.");
+    return VTK_ERROR;
   }
   return VTK_OK;
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGB()
+int vtkSquirtCompressor::DecompressRGBA()
 {
   vtkUnsignedCharArray* in = this->GetInput();
   vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 3);
-
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
+  assert(out->GetNumberOfComponents() == 4);
 
   // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  vtkIdType CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
 
   // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  if (::DecodeRGBA(reinterpret_cast<unsigned int*>(in->GetPointer(0)), CompSize,
+        reinterpret_cast<unsigned int*>(out->GetPointer(0)), out->GetNumberOfTuples()) < 0)
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
+    vtkErrorMacro("SQUIRT stream does not match the output size.");
+    return VTK_ERROR;
+  }
+  return VTK_OK;
+}
 
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::DecompressRGB()
+{
+  vtkUnsignedCharArray* in = this->GetInput();
+  vtkUnsignedCharArray* out = this->GetOutput();
+  assert(out->GetNumberOfComponents() == 3);
 
-    *((unsigned char*)&current_color + 3) = 0xff;
+  // Get compressed buffer size
+  vtkIdType CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
 
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
-    {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
-    }
+  // Access raw arrays directly
+  if (::DecodeRGB(reinterpret_cast<unsigned int*>(in->GetPointer(0)), CompSize,
+        out->GetPointer(0), out->GetNumberOfTuples()) < 0)
+  {
+    vtkErrorMacro("SQUIRT stream does not match the output size.");
+    return VTK_ERROR;
   }
   return VTK_OK;
 }
@@ -289,7 +467,7 @@ int vtkSquirtCompressor::DecompressRGB()
 void vtkSquirtCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
   vtkImageCompressor::SaveConfiguration(stream);
-  *stream << this->SquirtLevel;
+  *stream << this->SquirtLevel << this->NumberOfBands << this->NumberOfThreads;
 }
 
 //-----------------------------------------------------------------------------
@@ -297,7 +475,7 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 {
   if (vtkImageCompressor::RestoreConfiguration(stream))
   {
-    *stream >> this->SquirtLevel;
+    *stream >> this->SquirtLevel >> this->NumberOfBands >> this->NumberOfThreads;
     return true;
   }
   return false;
@@ -307,7 +485,8 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 const char* vtkSquirtCompressor::SaveConfiguration()
 {
   std::ostringstream oss;
-  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel;
+  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel << " "
+      << this->NumberOfBands << " " << this->NumberOfThreads;
 
   this->SetConfiguration(oss.str().c_str());
 
@@ -322,7 +501,27 @@ const char* vtkSquirtCompressor::RestoreConfiguration(const char* stream)
   {
     std::istringstream iss(stream);
     iss >> this->SquirtLevel;
-    return stream + iss.tellg();
+    std::streamoff offset = iss.tellg();
+    // The number of bands and threads are optional for compatibility with
+    // configurations written as "vtkSquirtCompressor <losslessmode> <level>",
+    // which use the legacy single-stream format.
+    // A failed extraction stores 0, so only read into the fields on success.
+    int numberOfBands = 1;
+    int numberOfThreads = 0;
+    int value;
+    if (iss >> value)
+    {
+      numberOfBands = value;
+      offset = iss.tellg();
+      if (iss >> value)
+      {
+        numberOfThreads = value;
+        offset = iss.tellg();
+      }
+    }
+    this->NumberOfBands = std::max(0, numberOfBands);
+    this->NumberOfThreads = std::max(0, numberOfThreads);
+    return offset < 0 ? stream + strlen(stream) : stream + offset;
   }
   return nullptr;
 }
@@ -332,4 +531,6 @@ void vtkSquirtCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "SquirtLevel: " << this->SquirtLevel << endl;
+  os << indent << "NumberOfBands: " << this->NumberOfBands << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 }
@@ -29,6 +29,13 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * To make use of multiple cores, the image can be split into contiguous bands
+ * of pixels (i.e. groups of rows) that are encoded and decoded independently
+ * using vtkSMPTools. Banded streams start with a small index giving the
+ * encoded size and pixel count of every band, so the receiving end can decode
+ * the bands concurrently as well. Banding is off by default, see
+ * SetNumberOfBands().
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
  */
@@ -58,6 +65,29 @@ public:
   vtkGetMacro(SquirtLevel, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of independently encoded bands the image is split into.
+   * 1 (default) produces the legacy, single-stream format without a band
+   * index. 0 picks the number of bands based on the image size and the
+   * number of threads available to vtkSMPTools. The actual number of bands is
+   * read from the stream; streams without a band index are always decoded as
+   * the legacy format.
+   */
+  vtkSetClampMacro(NumberOfBands, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfBands, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the maximum number of threads used to encode and decode the bands.
+   * 0 (default) uses the number of threads vtkSMPTools is configured with.
+   * This has no effect on the legacy, single-stream format.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
   ///@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -83,8 +113,12 @@ protected:
   ~vtkSquirtCompressor() override;
   int DecompressRGB();
   int DecompressRGBA();
+  int CompressBanded(int numberOfBands, unsigned int compressMask);
+  int DecompressBanded();
 
   int SquirtLevel;
+  int NumberOfBands;
+  int NumberOfThreads;
 
 private:
   vtkSquirtCompressor(const vtkSquirtCompressor&) = delete;
@@ -0,0 +1,76 @@
+from paraview.simple import *
+from paraview import smtesting
+import json
+import os
+import shutil
+import sys
+
+from vtkmodules.vtkCommonCore import vtkDoubleArray, vtkPoints
+from vtkmodules.vtkCommonDataModel import vtkPolyData
+from vtkmodules.vtkIOXML import vtkXMLPolyDataWriter
+
+smtesting.ProcessCommandLineArguments()
+
+path = smtesting.TempDir + '/FileSeriesMetaDataCache/'
+if os.path.exists(path):
+    shutil.rmtree(path)
+os.makedirs(path)
+
+def write_file(fileName, time, numberOfPoints=1):
+    points = vtkPoints()
+    for i in range(numberOfPoints):
+        points.InsertNextPoint(i, 0, 0)
+    timeValue = vtkDoubleArray()
+    timeValue.SetName('TimeValue')
+    timeValue.InsertNextValue(time)
+    polyData = vtkPolyData()
+    polyData.SetPoints(points)
+    polyData.GetFieldData().AddArray(timeValue)
+    writer = vtkXMLPolyDataWriter()
+    writer.SetFileName(fileName)
+    writer.SetInputData(polyData)
+    writer.Write()
+
+fileNames = [path + 'series_%d.vtp' % i for i in range(5)]
+for i, fileName in enumerate(fileNames):
+    write_file(fileName, 0.5 * i)
+
+settings = GetSettingsProxy('GeneralSettings')
+settings.CacheFileSeriesTimeInformation = 1
+settings.FileSeriesPrefetchMemoryLimit = 16
+
+def check_times(expected):
+    reader = XMLPolyDataReader(FileName=fileNames)
+    reader.UpdatePipelineInformation()
+    if list(reader.TimestepValues) != expected:
+        print("Unexpected time steps %s, expected %s" % (list(reader.TimestepValues), expected))
+        sys.exit(1)
+    # step through the series to exercise prefetching.
+    for time in expected:
+        reader.UpdatePipeline(time)
+    Delete(reader)
+
+check_times([0.0, 0.5, 1.0, 1.5, 2.0])
+if not os.path.exists(fileNames[0] + '.pvcache'):
+    print("The metadata cache was not written.")
+    sys.exit(1)
+
+# time values are read from the cache: tamper with the cached time of an
+# unmodified file, it must be reported instead of the one in the file.
+with open(fileNames[0] + '.pvcache') as f:
+    cache = json.load(f)
+for entry in cache['files']:
+    if entry['name'] == fileNames[2]:
+        entry['time-steps'] = [0.75]
+        entry['time-range'] = [0.75, 0.75]
+with open(fileNames[0] + '.pvcache', 'w') as f:
+    json.dump(cache, f)
+check_times([0.0, 0.5, 0.75, 1.5, 2.0])
+
+# a modified file must be queried again.
+write_file(fileNames[4], 10.0, numberOfPoints=3)
+check_times([0.0, 0.5, 0.75, 1.5, 10.0])
+
+settings.CacheFileSeriesTimeInformation = 0
+settings.FileSeriesPrefetchMemoryLimit = 0
+print("success")
@@ -15,6 +15,8 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -26,10 +28,17 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
 #include <cctype> // for isprint().
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
 #include <map>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -360,6 +369,94 @@ private:
 };
 }
 
+//=============================================================================
+// Time information reported by the reader for a file, along with a hash of
+// the reader settings and of the file size and modification time it was
+// obtained for.
+struct vtkFileSeriesReaderMetaData
+{
+  std::string Hash;
+  std::vector<double> TimeSteps;
+  std::vector<double> TimeRange;
+};
+
+//=============================================================================
+// Reads files ahead in a background thread so that they are in the operating
+// system's file cache when the reader needs them.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  ~vtkFileSeriesReaderPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Terminate = true;
+      ++this->Generation;
+    }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  // Replaces any pending request with `files`.
+  void Prefetch(std::vector<std::string> files)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      if (files.empty() && !this->Thread.joinable())
+      {
+        return;
+      }
+      this->Pending.assign(files.begin(), files.end());
+      ++this->Generation;
+      if (!this->Thread.joinable())
+      {
+        this->Thread = std::thread(&vtkFileSeriesReaderPrefetcher::Run, this);
+      }
+    }
+    this->Condition.notify_all();
+  }
+
+private:
+  void Run()
+  {
+    std::vector<char> buffer(1 << 20);
+    while (true)
+    {
+      std::string fileName;
+      unsigned int generation;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(lock, [this] { return this->Terminate || !this->Pending.empty(); });
+        if (this->Terminate)
+        {
+          return;
+        }
+        fileName = std::move(this->Pending.front());
+        this->Pending.pop_front();
+        generation = this->Generation;
+      }
+
+      vtkLogF(TRACE, "prefetching '%s'", fileName.c_str());
+      vtksys::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+      // stop as soon as a newer request, or termination, comes in.
+      while (file.good() && generation == this->Generation)
+      {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      }
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<std::string> Pending;
+  std::atomic<unsigned int> Generation{ 0 };
+  bool Terminate = false;
+  std::thread Thread;
+};
+
 //=============================================================================
 struct vtkFileSeriesReaderInternals
 {
@@ -368,8 +465,64 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  // Persistent cache of per-file time information, keyed on file name.
+  std::map<std::string, vtkFileSeriesReaderMetaData> MetaDataCache;
+  std::string MetaDataCacheFileName;
+  // Hash of the internal reader settings, see ComputeReaderHash().
+  std::string ReaderHash;
+  bool MetaDataCacheModified = false;
+  // Cached time information found valid for the current files, keyed on file
+  // index. Identical on all ranks, see LoadMetaDataCache().
+  std::map<int, vtkFileSeriesReaderMetaData> ValidMetaData;
+
+  vtkFileSeriesReaderPrefetcher Prefetcher;
 };
 
+namespace
+{
+bool GlobalUseMetaDataCache = false;
+int GlobalPrefetchMemoryLimit = 0;
+const char* const META_DATA_CACHE_VERSION = "2.0";
+
+void HashString(vtkTypeUInt64& hash, const std::string& value)
+{
+  // FNV-1a, including the terminating null so that boundaries matter.
+  for (size_t cc = 0; cc <= value.size(); ++cc)
+  {
+    hash = (hash ^ static_cast<unsigned char>(value.c_str()[cc])) * 1099511628211ull;
+  }
+}
+
+std::string FormatHash(vtkTypeUInt64 hash)
+{
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return stream.str();
+}
+
+// Hash of the internal reader class and of its settings, see
+// vtkFileSeriesReader::SetReaderSettings().
+std::string ComputeReaderHash(vtkAlgorithm* reader, const char* settings)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  HashString(hash, reader->GetClassName());
+  HashString(hash, settings);
+  return FormatHash(hash);
+}
+
+// Hash identifying the time information of a file read with the given reader
+// settings, see ComputeReaderHash().
+std::string ComputeFileHash(const std::string& readerHash, const std::string& fileName)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  HashString(hash, readerHash);
+  HashString(hash, std::to_string(vtksys::SystemTools::ModifiedTime(fileName)));
+  HashString(hash, std::to_string(vtksys::SystemTools::FileLength(fileName)));
+  return FormatHash(hash);
+}
+}
+
 //=============================================================================
 vtkFileSeriesReader::vtkFileSeriesReader()
 {
@@ -384,15 +537,41 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+  this->ReaderSettings = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  this->SetReaderSettings(nullptr);
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
 
+//----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetGlobalUseMetaDataCache(bool use)
+{
+  GlobalUseMetaDataCache = use;
+}
+
+//----------------------------------------------------------------------------
+bool vtkFileSeriesReader::GetGlobalUseMetaDataCache()
+{
+  return GlobalUseMetaDataCache;
+}
+
+//----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetGlobalPrefetchMemoryLimit(int limit)
+{
+  GlobalPrefetchMemoryLimit = std::max(limit, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkFileSeriesReader::GetGlobalPrefetchMemoryLimit()
+{
+  return GlobalPrefetchMemoryLimit;
+}
+
 //----------------------------------------------------------------------------
 void vtkFileSeriesReader::AddFileName(const char* name)
 {
@@ -627,17 +806,24 @@ int vtkFileSeriesReader::RequestInformation(vtkInformation* request,
   else
   {
     // Record the reported file time info.
+    this->LoadMetaDataCache();
+    this->CacheTimeInformation(0, outInfo);
     this->Internal->TimeRanges->AddTimeRange(0, outInfo);
 
-    // Query all the other files for time info.
+    // Query all the other files for time info, unless it is cached.
     for (unsigned int i = 1; i < numFiles; i++)
     {
-      // Expose current file number as information key for potential use in the internal reader
-      outputVector->GetInformationObject(requestFromPort)
-        ->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), static_cast<int>(i));
-      this->RequestInformationForInput(static_cast<int>(i), request, outputVector);
+      if (!this->GetCachedTimeInformation(static_cast<int>(i), outInfo))
+      {
+        // Expose current file number as information key for potential use in the internal reader
+        outputVector->GetInformationObject(requestFromPort)
+          ->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), static_cast<int>(i));
+        this->RequestInformationForInput(static_cast<int>(i), request, outputVector);
+        this->CacheTimeInformation(static_cast<int>(i), outInfo);
+      }
       this->Internal->TimeRanges->AddTimeRange(static_cast<int>(i), outInfo);
     }
+    this->SaveMetaDataCache();
   }
 
   // Now that we have collected all of the time information, set the aggregate
@@ -718,6 +904,7 @@ int vtkFileSeriesReader::RequestData(
   {
     // Now restore the information.
     this->Internal->TimeRanges->GetAggregateTimeInfo(outInfo);
+    this->PrefetchNextFiles();
   }
 
   return retVal;
@@ -975,6 +1162,9 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "ReaderSettings: " << (this->ReaderSettings ? "(set)" : "(none)") << endl;
+  os << indent << "GlobalUseMetaDataCache: " << GlobalUseMetaDataCache << endl;
+  os << indent << "GlobalPrefetchMemoryLimit: " << GlobalPrefetchMemoryLimit << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -982,3 +1172,275 @@ int vtkFileSeriesReader::ChooseInput(vtkInformation* outInfo)
 {
   return this->Internal->TimeRanges->ChooseInput(outInfo);
 }
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::LoadMetaDataCache()
+{
+  this->Internal->ValidMetaData.clear();
+  if (!GlobalUseMetaDataCache || !this->ReaderSettings || this->GetNumberOfFileNames() == 0)
+  {
+    return;
+  }
+
+  // only the first rank reads and validates the cache, so that all ranks
+  // agree on which files need to be opened.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const bool isRoot = !controller || controller->GetLocalProcessId() == 0;
+  if (isRoot)
+  {
+    this->ReadMetaDataCache();
+    for (unsigned int cc = 1; cc < this->GetNumberOfFileNames(); ++cc)
+    {
+      const std::string fileName = this->GetFileName(cc);
+      auto iter = this->Internal->MetaDataCache.find(fileName);
+      if (iter != this->Internal->MetaDataCache.end() &&
+        iter->second.Hash == ::ComputeFileHash(this->Internal->ReaderHash, fileName))
+      {
+        this->Internal->ValidMetaData[static_cast<int>(cc)] = iter->second;
+      }
+    }
+  }
+
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  if (isRoot)
+  {
+    stream << static_cast<unsigned int>(this->Internal->ValidMetaData.size());
+    for (const auto& item : this->Internal->ValidMetaData)
+    {
+      stream << item.first << static_cast<unsigned int>(item.second.TimeSteps.size());
+      for (double value : item.second.TimeSteps)
+      {
+        stream << value;
+      }
+      stream << static_cast<unsigned int>(item.second.TimeRange.size());
+      for (double value : item.second.TimeRange)
+      {
+        stream << value;
+      }
+    }
+  }
+  controller->Broadcast(stream, 0);
+  if (!isRoot)
+  {
+    unsigned int count;
+    stream >> count;
+    for (unsigned int cc = 0; cc < count; ++cc)
+    {
+      int index;
+      unsigned int size;
+      stream >> index >> size;
+      vtkFileSeriesReaderMetaData& metaData = this->Internal->ValidMetaData[index];
+      metaData.TimeSteps.resize(size);
+      for (double& value : metaData.TimeSteps)
+      {
+        stream >> value;
+      }
+      stream >> size;
+      metaData.TimeRange.resize(size);
+      for (double& value : metaData.TimeRange)
+      {
+        stream >> value;
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ReadMetaDataCache()
+{
+  // the reader settings may have changed since the cache was read.
+  this->Internal->ReaderHash = ::ComputeReaderHash(this->Reader, this->ReaderSettings);
+
+  const bool useMetaFile = (this->UseMetaFile || this->UseJsonMetaFile) && this->_MetaFileName;
+  const std::string cacheFileName =
+    std::string(useMetaFile ? this->_MetaFileName : this->GetFileName(0)) + ".pvcache";
+  if (cacheFileName == this->Internal->MetaDataCacheFileName)
+  {
+    return;
+  }
+  this->Internal->MetaDataCacheFileName = cacheFileName;
+  this->Internal->MetaDataCache.clear();
+  this->Internal->MetaDataCacheModified = false;
+
+  vtksys::ifstream cacheFile(cacheFileName.c_str());
+  if (!cacheFile.good())
+  {
+    return;
+  }
+
+  Json::Value root;
+  Json::CharReaderBuilder builder;
+  builder["collectComments"] = false;
+  if (!Json::parseFromStream(builder, cacheFile, &root, nullptr) || !root.isObject() ||
+    root.get("file-series-cache-version", "").asString() != META_DATA_CACHE_VERSION ||
+    root.get("reader", "").asString() != this->Reader->GetClassName() ||
+    !root["files"].isArray())
+  {
+    vtkDebugMacro("Ignoring incompatible metadata cache " << cacheFileName);
+    return;
+  }
+
+  for (const Json::Value& file : root["files"])
+  {
+    if (!file.isObject() || !file["name"].isString())
+    {
+      continue;
+    }
+    vtkFileSeriesReaderMetaData& metaData = this->Internal->MetaDataCache[file["name"].asString()];
+    metaData.Hash = file.get("hash", "").asString();
+    for (const Json::Value& value : file["time-steps"])
+    {
+      metaData.TimeSteps.push_back(value.asDouble());
+    }
+    for (const Json::Value& value : file["time-range"])
+    {
+      metaData.TimeRange.push_back(value.asDouble());
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::GetCachedTimeInformation(int index, vtkInformation* outInfo)
+{
+  auto iter = this->Internal->ValidMetaData.find(index);
+  if (iter == this->Internal->ValidMetaData.end())
+  {
+    return false;
+  }
+
+  const vtkFileSeriesReaderMetaData& metaData = iter->second;
+  outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  if (!metaData.TimeSteps.empty())
+  {
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), metaData.TimeSteps.data(),
+      static_cast<int>(metaData.TimeSteps.size()));
+  }
+  if (metaData.TimeRange.size() == 2)
+  {
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), metaData.TimeRange.data(), 2);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::CacheTimeInformation(int index, vtkInformation* outInfo)
+{
+  // only the first rank keeps, and writes, the cache.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (!GlobalUseMetaDataCache || !this->ReaderSettings ||
+    (controller && controller->GetLocalProcessId() > 0))
+  {
+    return;
+  }
+
+  const std::string fileName = this->GetFileName(static_cast<unsigned int>(index));
+  vtkFileSeriesReaderMetaData metaData;
+  metaData.Hash = ::ComputeFileHash(this->Internal->ReaderHash, fileName);
+  if (double* timeSteps = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    metaData.TimeSteps.assign(
+      timeSteps, timeSteps + outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()));
+  }
+  if (double* timeRange = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE()))
+  {
+    metaData.TimeRange.assign(timeRange, timeRange + 2);
+  }
+  this->Internal->MetaDataCache[fileName] = std::move(metaData);
+  this->Internal->MetaDataCacheModified = true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SaveMetaDataCache()
+{
+  if (!GlobalUseMetaDataCache || !this->Internal->MetaDataCacheModified ||
+    this->Internal->MetaDataCacheFileName.empty())
+  {
+    return;
+  }
+  this->Internal->MetaDataCacheModified = false;
+
+  Json::Value root(Json::objectValue);
+  root["file-series-cache-version"] = META_DATA_CACHE_VERSION;
+  root["reader"] = this->Reader->GetClassName();
+  Json::Value& files = root["files"] = Json::Value(Json::arrayValue);
+  for (const auto& item : this->Internal->MetaDataCache)
+  {
+    Json::Value file(Json::objectValue);
+    file["name"] = item.first;
+    file["hash"] = item.second.Hash;
+    Json::Value& timeSteps = file["time-steps"] = Json::Value(Json::arrayValue);
+    for (double value : item.second.TimeSteps)
+    {
+      timeSteps.append(value);
+    }
+    Json::Value& timeRange = file["time-range"] = Json::Value(Json::arrayValue);
+    for (double value : item.second.TimeRange)
+    {
+      timeRange.append(value);
+    }
+    files.append(file);
+  }
+
+  // write to a temporary file first so that concurrent readers never see a
+  // partially written cache.
+  const std::string& cacheFileName = this->Internal->MetaDataCacheFileName;
+  const std::string tempFileName = cacheFileName + ".tmp";
+  {
+    vtksys::ofstream cacheFile(tempFileName.c_str());
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    cacheFile << Json::writeString(builder, root);
+    if (!cacheFile.good())
+    {
+      vtkDebugMacro("Could not write metadata cache " << cacheFileName);
+      cacheFile.close();
+      vtksys::SystemTools::RemoveFile(tempFileName);
+      return;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tempFileName, cacheFileName))
+  {
+    vtkDebugMacro("Could not write metadata cache " << cacheFileName);
+    vtksys::SystemTools::RemoveFile(tempFileName);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchNextFiles()
+{
+  if (GlobalPrefetchMemoryLimit <= 0)
+  {
+    return;
+  }
+
+  // all ranks open the same files, reading them ahead from every rank would
+  // multiply the load on a shared file system. Only the first one does it.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetLocalProcessId() > 0)
+  {
+    return;
+  }
+
+  const unsigned long long budget = static_cast<unsigned long long>(GlobalPrefetchMemoryLimit)
+    << 20;
+  unsigned long long total = 0;
+  std::vector<std::string> files;
+  for (unsigned int index = static_cast<unsigned int>(this->_FileIndex) + 1;
+       index < this->GetNumberOfFileNames(); ++index)
+  {
+    const std::string fileName = this->GetFileName(index);
+    total += vtksys::SystemTools::FileLength(fileName);
+    if (total > budget)
+    {
+      break;
+    }
+    files.push_back(fileName);
+  }
+  this->Internal->Prefetcher.Prefetch(std::move(files));
+}
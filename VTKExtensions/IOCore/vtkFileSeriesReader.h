@@ -55,6 +55,19 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When the internal reader reports time, every file of the series has to be
+ * opened to collect its time values. With GlobalUseMetaDataCache on, the
+ * collected values are saved in a sidecar file (`<first file>.pvcache`, or
+ * `<meta file>.pvcache` when using a meta file) and reused as long as the
+ * size and modification time of each file, and the ReaderSettings, are
+ * unchanged. In parallel, only the first rank reads, validates and writes the
+ * cache; the other ranks receive the validated entries from it.
+ *
+ * With a non-zero GlobalPrefetchMemoryLimit, the files following the one
+ * that was just read are read ahead by a background thread so that they are
+ * in the operating system's file cache when the next time step is requested.
+ * In parallel, only the first rank reads files ahead.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -133,6 +146,35 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   ///@}
 
+  ///@{
+  /**
+   * Enable or disable the persistent cache of per-file time information for
+   * all file series readers. Off by default.
+   */
+  static void SetGlobalUseMetaDataCache(bool use);
+  static bool GetGlobalUseMetaDataCache();
+  ///@}
+
+  ///@{
+  /**
+   * Maximum amount of data, in MiB, read ahead of the current file for all
+   * file series readers. 0 (the default) disables prefetching.
+   */
+  static void SetGlobalPrefetchMemoryLimit(int limit);
+  static int GetGlobalPrefetchMemoryLimit();
+  ///@}
+
+  ///@{
+  /**
+   * Description of the property values of the internal reader, e.g. as set by
+   * the server manager. It is part of the hash that cached time information
+   * is validated against, so that it is not reused once a setting that may
+   * affect it changes. The metadata cache is not used while this is not set.
+   */
+  vtkSetStringMacro(ReaderSettings);
+  vtkGetStringMacro(ReaderSettings);
+  ///@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -213,8 +255,34 @@ protected:
 
   bool IgnoreReaderTime;
 
+  char* ReaderSettings;
+
   int ChooseInput(vtkInformation*);
 
+  ///@{
+  /**
+   * Load, query, update and save the persistent cache of per-file time
+   * information. These do nothing unless GlobalUseMetaDataCache is on and
+   * ReaderSettings is set. LoadMetaDataCache() is collective.
+   */
+  void LoadMetaDataCache();
+  bool GetCachedTimeInformation(int index, vtkInformation* outInfo);
+  void CacheTimeInformation(int index, vtkInformation* outInfo);
+  void SaveMetaDataCache();
+  ///@}
+
+  /**
+   * Read the cache file for the current files, unless already read, on this
+   * rank only. Called by LoadMetaDataCache() on the first rank.
+   */
+  void ReadMetaDataCache();
+
+  /**
+   * Schedule reading ahead the files following the current one, within
+   * GlobalPrefetchMemoryLimit.
+   */
+  void PrefetchNextFiles();
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkByteSwap.h"
+#include "vtkDataArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericEnSightReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtksys/FStream.hxx"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Writes a synthetic EnSight Gold big-endian binary case with a single
+// hexahedral part of `size`^3 cells and a nodal scalar, then reads it with and
+// without memory mapping. The default size keeps the test quick, set
+// PARAVIEW_ENSIGHT_BENCHMARK_SIZE to benchmark bigger cases (a size of 600
+// produces a ~10 GB case).
+namespace
+{
+class BigEndianWriter
+{
+public:
+  BigEndianWriter(const std::string& filename)
+    : Stream(filename.c_str(), std::ios::out | std::ios::binary)
+  {
+  }
+
+  bool IsValid() const { return this->Stream.good(); }
+
+  void WriteLine(const char* line)
+  {
+    char buffer[80] = {};
+    std::strncpy(buffer, line, 79);
+    this->Stream.write(buffer, 80);
+  }
+
+  template <typename T>
+  void WriteValues(std::vector<T>& values)
+  {
+    vtkByteSwap::Swap4BERange(values.data(), values.size());
+    this->Stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+  }
+
+  void WriteInt(int value)
+  {
+    std::vector<int> values(1, value);
+    this->WriteValues(values);
+  }
+
+private:
+  vtksys::ofstream Stream;
+};
+
+float PointValue(int i, int j, int k)
+{
+  return static_cast<float>(i + 2 * j + 3 * k);
+}
+
+bool WriteCase(const std::string& directory, int size)
+{
+  const int numPts1D = size + 1;
+  const int numPts = numPts1D * numPts1D * numPts1D;
+  const int numCells = size * size * size;
+  {
+    vtksys::ofstream caseFile((directory + "/synthetic.case").c_str());
+    caseFile << "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: synthetic.geo\n\n"
+             << "VARIABLE\nscalar per node: values synthetic.values\n";
+    if (!caseFile.good())
+    {
+      return false;
+    }
+  }
+
+  BigEndianWriter geometry(directory + "/synthetic.geo");
+  geometry.WriteLine("C Binary");
+  geometry.WriteLine("synthetic case");
+  geometry.WriteLine("for TestPEnSightGoldBinaryReaderMappedIO");
+  geometry.WriteLine("node id off");
+  geometry.WriteLine("element id off");
+  geometry.WriteLine("part");
+  geometry.WriteInt(1);
+  geometry.WriteLine("synthetic part");
+  geometry.WriteLine("coordinates");
+  geometry.WriteInt(numPts);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    std::vector<float> coordinates(numPts);
+    for (int k = 0, cc = 0; k < numPts1D; ++k)
+    {
+      for (int j = 0; j < numPts1D; ++j)
+      {
+        for (int i = 0; i < numPts1D; ++i, ++cc)
+        {
+          coordinates[cc] = static_cast<float>(axis == 0 ? i : (axis == 1 ? j : k));
+        }
+      }
+    }
+    geometry.WriteValues(coordinates);
+  }
+  geometry.WriteLine("hexa8");
+  geometry.WriteInt(numCells);
+  std::vector<int> connectivity;
+  connectivity.reserve(8 * static_cast<size_t>(numCells));
+  for (int k = 0; k < size; ++k)
+  {
+    for (int j = 0; j < size; ++j)
+    {
+      for (int i = 0; i < size; ++i)
+      {
+        // EnSight ids start at 1.
+        const int p0 = 1 + i + numPts1D * (j + numPts1D * k);
+        const int slice = numPts1D * numPts1D;
+        const int corners[8] = { p0, p0 + 1, p0 + 1 + numPts1D, p0 + numPts1D, p0 + slice,
+          p0 + 1 + slice, p0 + 1 + numPts1D + slice, p0 + numPts1D + slice };
+        connectivity.insert(connectivity.end(), corners, corners + 8);
+      }
+    }
+  }
+  geometry.WriteValues(connectivity);
+
+  BigEndianWriter variable(directory + "/synthetic.values");
+  variable.WriteLine("values");
+  variable.WriteLine("part");
+  variable.WriteInt(1);
+  variable.WriteLine("coordinates");
+  std::vector<float> values(numPts);
+  for (int k = 0, cc = 0; k < numPts1D; ++k)
+  {
+    for (int j = 0; j < numPts1D; ++j)
+    {
+      for (int i = 0; i < numPts1D; ++i, ++cc)
+      {
+        values[cc] = PointValue(i, j, k);
+      }
+    }
+  }
+  variable.WriteValues(values);
+  return geometry.IsValid() && variable.IsValid();
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Read(const std::string& caseFile, bool mapped)
+{
+  vtkNew<vtkPGenericEnSightReader> reader;
+  reader->SetCaseFileName(caseFile.c_str());
+  reader->SetUseMemoryMappedIO(mapped);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  vtkLogF(INFO, "%s read: %g s", mapped ? "memory-mapped" : "file stream", timer->GetElapsedTime());
+  return vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+}
+
+bool Check(vtkUnstructuredGrid* grid, int size)
+{
+  const int numPts1D = size + 1;
+  if (!grid || grid->GetNumberOfPoints() != numPts1D * numPts1D * numPts1D ||
+    grid->GetNumberOfCells() != size * size * size)
+  {
+    vtkLogF(ERROR, "Unexpected number of points or cells.");
+    return false;
+  }
+  vtkDataArray* values = grid->GetPointData()->GetArray("values");
+  if (!values)
+  {
+    vtkLogF(ERROR, "Missing point array.");
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfPoints(); ++cc)
+  {
+    double point[3];
+    grid->GetPoint(cc, point);
+    const float expected = PointValue(static_cast<int>(point[0]), static_cast<int>(point[1]),
+      static_cast<int>(point[2]));
+    if (values->GetComponent(cc, 0) != expected)
+    {
+      vtkLogF(ERROR, "Wrong value for point %lld: %g instead of %g.", static_cast<long long>(cc),
+        values->GetComponent(cc, 0), static_cast<double>(expected));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPEnSightGoldBinaryReaderMappedIO(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string directory = tempDir;
+  delete[] tempDir;
+
+  // large enough for the bigger blocks to be read in chunks by several threads.
+  int size = 40;
+  if (const char* benchmarkSize = std::getenv("PARAVIEW_ENSIGHT_BENCHMARK_SIZE"))
+  {
+    size = std::atoi(benchmarkSize);
+  }
+  if (size <= 0 || !WriteCase(directory, size))
+  {
+    vtkLogF(ERROR, "Could not write the synthetic case in '%s'.", directory.c_str());
+    return EXIT_FAILURE;
+  }
+
+  const std::string caseFile = directory + "/synthetic.case";
+  if (!Check(Read(caseFile, false), size) || !Check(Read(caseFile, true), size))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -10,9 +10,11 @@
 #include "vtkImageData.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVMappedFile.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -21,6 +23,9 @@
 #include "vtksys/SystemTools.hxx"
 
 #include <cctype>
+#include <cstring>
+#include <istream>
+#include <streambuf>
 #include <string>
 
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
@@ -28,6 +33,204 @@ vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+namespace
+{
+//----------------------------------------------------------------------------
+/**
+ * Read-only stream buffer over a memory-mapped file. Reads and seeks are plain
+ * pointer arithmetic and copies, without going through the system.
+ */
+class vtkPEnSightMappedFileBuffer : public std::streambuf
+{
+public:
+  bool Map(const char* filename)
+  {
+    this->Data = nullptr;
+    this->setg(nullptr, nullptr, nullptr);
+    if (!this->File.Map(filename, vtkPVMappedFile::SEQUENTIAL_ACCESS))
+    {
+      return false;
+    }
+    // the get area is never written to, std::streambuf just wants char*.
+    this->Data = const_cast<char*>(reinterpret_cast<const char*>(this->File.GetData()));
+    this->setg(this->Data, this->Data, this->Data + this->File.GetSize());
+    return true;
+  }
+
+  /**
+   * Returns the mapped bytes at the current position and moves past them, or
+   * nullptr if fewer than `length` bytes are left. The bytes can then be read
+   * from any thread.
+   */
+  const char* Consume(std::streamsize length)
+  {
+    if (length < 0 || this->egptr() - this->gptr() < length)
+    {
+      return nullptr;
+    }
+    const char* data = this->gptr();
+    this->setg(this->eback(), this->gptr() + length, this->egptr());
+    return data;
+  }
+
+protected:
+  std::streamsize xsgetn(char* s, std::streamsize count) override
+  {
+    const std::streamsize available = this->egptr() - this->gptr();
+    const std::streamsize length = count < available ? count : available;
+    if (length > 0)
+    {
+      std::memcpy(s, this->gptr(), static_cast<size_t>(length));
+      // gbump() takes an int, reads of 2 GB or more would overflow it.
+      this->setg(this->eback(), this->gptr() + length, this->egptr());
+    }
+    return length;
+  }
+
+  std::streamsize showmanyc() override
+  {
+    const std::streamsize available = this->egptr() - this->gptr();
+    return available > 0 ? available : -1;
+  }
+
+  pos_type seekoff(
+    off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+  {
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+    {
+      base = this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      base = static_cast<off_type>(this->File.GetSize());
+    }
+    return this->seekpos(pos_type(base + offset), which);
+  }
+
+  pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    const off_type offset = position;
+    const size_t size = this->File.GetSize();
+    if (!this->Data || !(which & std::ios_base::in) || offset < 0 ||
+      offset > static_cast<off_type>(size))
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->Data, this->Data + offset, this->Data + size);
+    return position;
+  }
+
+private:
+  vtkPVMappedFile File;
+  char* Data = nullptr;
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Input stream owning a vtkPEnSightMappedFileBuffer, usable wherever the
+ * reader expects an `istream`.
+ */
+class vtkPEnSightMappedFileStream : public std::istream
+{
+public:
+  vtkPEnSightMappedFileStream()
+    : std::istream(nullptr)
+  {
+    this->rdbuf(&this->Buffer);
+  }
+
+  bool Open(const char* filename)
+  {
+    if (!this->Buffer.Map(filename))
+    {
+      this->setstate(std::ios_base::failbit);
+      return false;
+    }
+    this->clear();
+    return true;
+  }
+
+private:
+  vtkPEnSightMappedFileBuffer Buffer;
+};
+
+//----------------------------------------------------------------------------
+bool IsHostLittleEndian()
+{
+  const vtkTypeUInt32 one = 1;
+  unsigned char firstByte;
+  std::memcpy(&firstByte, &one, 1);
+  return firstByte == 1;
+}
+
+//----------------------------------------------------------------------------
+// Reverses the bytes of 4-byte words in [begin, end). This is written as a
+// plain loop on integers so that compilers turn it into vector shuffles.
+void SwapWords(unsigned char* data, vtkIdType begin, vtkIdType end)
+{
+  for (vtkIdType cc = begin; cc < end; ++cc)
+  {
+    vtkTypeUInt32 word;
+    std::memcpy(&word, data + 4 * cc, 4);
+    word = (word >> 24) | ((word >> 8) & 0x0000ff00u) | ((word << 8) & 0x00ff0000u) | (word << 24);
+    std::memcpy(data + 4 * cc, &word, 4);
+  }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Reads `count` 4-byte values stored with the given byte order from `file`
+ * and converts them to the native byte order. Large blocks of memory-mapped
+ * files are split in chunks that threads copy out of the mapping and swap
+ * concurrently, so the pages of a block are also loaded from disk in
+ * parallel. Other streams are read sequentially. Returns false, with the
+ * stream failbit set, if the file is too short.
+ */
+bool Read4Range(std::istream* file, void* values, vtkIdType count, bool fileIsLittleEndian)
+{
+  static const bool hostIsLittleEndian = IsHostLittleEndian();
+  const bool swap = fileIsLittleEndian != hostIsLittleEndian;
+  constexpr vtkIdType grain = 1 << 16;
+  auto data = static_cast<unsigned char*>(values);
+
+  auto mapped = dynamic_cast<vtkPEnSightMappedFileBuffer*>(file->rdbuf());
+  if (mapped && count > grain && file->good())
+  {
+    auto source = reinterpret_cast<const unsigned char*>(
+      mapped->Consume(static_cast<std::streamsize>(4 * count)));
+    if (!source)
+    {
+      file->setstate(std::ios_base::eofbit | std::ios_base::failbit);
+      return false;
+    }
+    vtkSMPTools::For(0, count, grain, [data, source, swap](vtkIdType begin, vtkIdType end) {
+      std::memcpy(data + 4 * begin, source + 4 * begin, static_cast<size_t>(4 * (end - begin)));
+      if (swap)
+      {
+        SwapWords(data, begin, end);
+      }
+    });
+    return true;
+  }
+
+  if (!file->read(reinterpret_cast<char*>(values), 4 * count).good())
+  {
+    return false;
+  }
+  if (swap && count <= grain)
+  {
+    SwapWords(data, 0, count);
+  }
+  else if (swap)
+  {
+    vtkSMPTools::For(
+      0, count, grain, [data](vtkIdType begin, vtkIdType end) { SwapWords(data, begin, end); });
+  }
+  return true;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
@@ -79,11 +282,27 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    if (this->UseMemoryMappedIO)
+    {
+      auto mappedFile = new vtkPEnSightMappedFileStream();
+      if (mappedFile->Open(filename))
+      {
+        this->IFile = mappedFile;
+      }
+      else
+      {
+        vtkDebugMacro(<< "Could not map " << filename << ", using a file stream.");
+        delete mappedFile;
+      }
+    }
+    if (!this->IFile)
+    {
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -4225,21 +4444,12 @@ int vtkPEnSightGoldBinaryReader::ReadIntArray(int* result, int numInts)
     }
   }
 
-  if (!this->IFile->read((char*)result, sizeof(int) * numInts).good())
+  if (!::Read4Range(this->IFile, result, numInts, this->ByteOrder == FILE_LITTLE_ENDIAN))
   {
     vtkErrorMacro("Read failed.");
     return 0;
   }
 
-  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-  {
-    vtkByteSwap::Swap4LERange(result, numInts);
-  }
-  else
-  {
-    vtkByteSwap::Swap4BERange(result, numInts);
-  }
-
   if (this->Fortran)
   {
     if (!this->IFile->read(dummy, 4).good())
@@ -4271,21 +4481,12 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
     }
   }
 
-  if (!this->IFile->read((char*)result, sizeof(float) * numFloats).good())
+  if (!::Read4Range(this->IFile, result, numFloats, this->ByteOrder == FILE_LITTLE_ENDIAN))
   {
     vtkErrorMacro("Read failed");
     return 0;
   }
 
-  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-  {
-    vtkByteSwap::Swap4LERange(result, numFloats);
-  }
-  else
-  {
-    vtkByteSwap::Swap4BERange(result, numFloats);
-  }
-
   if (this->Fortran)
   {
     if (!this->IFile->read(dummy, 4).good())
@@ -4492,19 +4693,11 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
         vtkErrorMacro("File seek failed");
       }
     }
-    if (!this->IFile->read((char*)this->FloatBuffer[i], sizeof(float) * sizeToRead).good())
+    if (!::Read4Range(
+          this->IFile, this->FloatBuffer[i], sizeToRead, this->ByteOrder == FILE_LITTLE_ENDIAN))
     {
       vtkErrorMacro("Read failed");
     }
-
-    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-    {
-      vtkByteSwap::Swap4LERange(this->FloatBuffer[i], sizeToRead);
-    }
-    else
-    {
-      vtkByteSwap::Swap4BERange(this->FloatBuffer[i], sizeToRead);
-    }
   }
 
   this->IFile->seekg(currentPosition);
@@ -4514,4 +4707,5 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMappedIO: " << (this->UseMemoryMappedIO ? "on" : "off") << endl;
 }
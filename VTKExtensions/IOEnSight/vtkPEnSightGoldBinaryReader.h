@@ -7,6 +7,11 @@
  *
  * Parallel vtkEnSightGoldBinaryReader.
  *
+ * By default, files are memory-mapped rather than read through a file stream.
+ * Large coordinate, connectivity and variable blocks of a mapped file are then
+ * read in chunks by multiple threads, each converting its chunk to the native
+ * byte order. Parts are still read one after the other.
+ *
  * \verbatim
  * This file has been developed as part of the CARRIOCAS (Distributed
  * computation over ultra high optical internet network ) project (
@@ -35,6 +40,17 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * When on, files are memory-mapped instead of being read through a file
+   * stream, which avoids a system call for every read and seek. The reader
+   * falls back to a file stream when a file cannot be mapped. Default is on.
+   */
+  vtkSetMacro(UseMemoryMappedIO, bool);
+  vtkGetMacro(UseMemoryMappedIO, bool);
+  vtkBooleanMacro(UseMemoryMappedIO, bool);
+  ///@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -192,6 +208,7 @@ protected:
   int NodeIdsListed;
   int ElementIdsListed;
   int Fortran;
+  bool UseMemoryMappedIO = true;
 
   istream* IFile;
   // The size of the file could be used to choose byte order.
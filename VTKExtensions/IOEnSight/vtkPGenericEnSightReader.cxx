@@ -122,6 +122,10 @@ int vtkPGenericEnSightReader::RequestInformation(
   this->ByteOrder = FILE_UNKNOWN_ENDIAN;
 
   this->Reader->SetByteOrder(this->ByteOrder);
+  if (auto binaryReader = vtkPEnSightGoldBinaryReader::SafeDownCast(this->Reader))
+  {
+    binaryReader->SetUseMemoryMappedIO(this->UseMemoryMappedIO);
+  }
   vtkPGenericEnSightReader* reader = dynamic_cast<vtkPGenericEnSightReader*>(this->Reader);
   if (reader)
   {
@@ -190,4 +194,5 @@ void vtkPGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "MultiProcessLocalProcessId: " << this->MultiProcessLocalProcessId << endl;
   os << indent << "MultiProcessNumberOfProcesses: " << this->MultiProcessNumberOfProcesses << endl;
+  os << indent << "UseMemoryMappedIO: " << (this->UseMemoryMappedIO ? "on" : "off") << endl;
 }
@@ -27,6 +27,16 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * Forwarded to vtkPEnSightGoldBinaryReader::SetUseMemoryMappedIO when
+   * reading EnSight Gold binary files. Default is on.
+   */
+  vtkSetMacro(UseMemoryMappedIO, bool);
+  vtkGetMacro(UseMemoryMappedIO, bool);
+  vtkBooleanMacro(UseMemoryMappedIO, bool);
+  ///@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
@@ -44,6 +54,7 @@ protected:
 
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
+  bool UseMemoryMappedIO = true;
 
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
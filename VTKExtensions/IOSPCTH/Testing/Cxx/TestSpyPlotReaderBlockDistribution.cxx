@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Reads a SpyPlot file series with its blocks split across ranks and compares
+// the blocks each rank reads with a full serial read of the series.
+
+namespace
+{
+// Summary of a block of the output: bounds, number of cells and the sum of
+// each cell array, in the order of the cell data.
+struct BlockSummary
+{
+  double Bounds[6];
+  vtkIdType NumberOfCells;
+  std::vector<double> Sums;
+};
+
+std::vector<BlockSummary> Read(const std::string& fname, vtkMultiProcessController* controller)
+{
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetGlobalController(controller);
+  reader->SetFileName(fname.c_str());
+  reader->DistributeFilesOff();
+  reader->UpdateInformation();
+  for (int cc = 0; cc < reader->GetNumberOfCellArrays(); ++cc)
+  {
+    reader->SetCellArrayStatus(reader->GetCellArrayName(cc), 1);
+  }
+  reader->Update();
+
+  std::vector<BlockSummary> summaries;
+  const auto blocks = vtkCompositeDataSet::GetDataSets<vtkDataSet>(reader->GetOutputDataObject(0));
+  for (vtkDataSet* ds : blocks)
+  {
+    BlockSummary summary;
+    ds->GetBounds(summary.Bounds);
+    summary.NumberOfCells = ds->GetNumberOfCells();
+    vtkCellData* cd = ds->GetCellData();
+    for (int array = 0; array < cd->GetNumberOfArrays(); ++array)
+    {
+      double sum = 0;
+      if (vtkDataArray* values = cd->GetArray(array))
+      {
+        for (vtkIdType cc = 0; cc < values->GetNumberOfValues(); ++cc)
+        {
+          sum += values->GetComponent(cc / values->GetNumberOfComponents(),
+            static_cast<int>(cc % values->GetNumberOfComponents()));
+        }
+      }
+      summary.Sums.push_back(sum);
+    }
+    summaries.push_back(summary);
+  }
+  return summaries;
+}
+
+bool Matches(const BlockSummary& expected, const BlockSummary& actual)
+{
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    if (expected.Bounds[cc] != actual.Bounds[cc])
+    {
+      return false;
+    }
+  }
+  if (expected.NumberOfCells != actual.NumberOfCells || expected.Sums.size() != actual.Sums.size())
+  {
+    return false;
+  }
+  for (size_t cc = 0; cc < expected.Sums.size(); ++cc)
+  {
+    const double tolerance = 1e-6 * std::max(1.0, std::abs(expected.Sums[cc]));
+    if (std::abs(expected.Sums[cc] - actual.Sums[cc]) > tolerance)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSpyPlotReaderBlockDistribution(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth_a.0");
+  const std::string filename = fname;
+  delete[] fname;
+
+  // Reference: the whole series read by this rank alone.
+  vtkNew<vtkDummyController> serialController;
+  const std::vector<BlockSummary> expected = Read(filename, serialController);
+
+  // Each rank reads the blocks it owns.
+  const std::vector<BlockSummary> actual = Read(filename, contr);
+
+  int success = 1;
+  std::vector<bool> matched(expected.size(), false);
+  for (const BlockSummary& block : actual)
+  {
+    bool found = false;
+    for (size_t cc = 0; cc < expected.size() && !found; ++cc)
+    {
+      if (!matched[cc] && Matches(expected[cc], block))
+      {
+        matched[cc] = found = true;
+      }
+    }
+    if (!found)
+    {
+      vtkLogF(ERROR, "A block with %lld cells does not match any block of the serial read.",
+        static_cast<long long>(block.NumberOfCells));
+      success = 0;
+    }
+  }
+
+  // Together, the ranks read every block exactly once.
+  vtkIdType numberOfBlocks = static_cast<vtkIdType>(actual.size());
+  vtkIdType totalNumberOfBlocks = 0;
+  contr->AllReduce(&numberOfBlocks, &totalNumberOfBlocks, 1, vtkCommunicator::SUM_OP);
+  if (totalNumberOfBlocks != static_cast<vtkIdType>(expected.size()))
+  {
+    vtkLogF(ERROR, "Ranks read %lld blocks, the serial read has %lld.",
+      static_cast<long long>(totalNumberOfBlocks), static_cast<long long>(expected.size()));
+    success = 0;
+  }
+  if (numRanks > 1 && numberOfBlocks == totalNumberOfBlocks)
+  {
+    vtkLogF(ERROR, "All the blocks were read by a single rank.");
+    success = 0;
+  }
+
+  int allSuccess = 0;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
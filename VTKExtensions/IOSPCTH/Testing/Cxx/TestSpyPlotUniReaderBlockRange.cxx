@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotUniReader.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <string>
+
+// Reads subsets of the blocks of a SpyPlot file with
+// vtkSpyPlotUniReader::SetBlockRange() and compares them with a full read
+// decoded on a single thread.
+
+namespace
+{
+vtkSmartPointer<vtkSpyPlotUniReader> NewReader(
+  const std::string& fname, vtkDataArraySelection* selection, int timeStep)
+{
+  auto reader = vtkSmartPointer<vtkSpyPlotUniReader>::New();
+  reader->SetFileName(fname.c_str());
+  reader->SetCellArraySelection(selection);
+  if (!reader->ReadInformation())
+  {
+    vtkLogF(ERROR, "Failed to read information from '%s'.", fname.c_str());
+    return nullptr;
+  }
+  selection->EnableAllArrays();
+  reader->SetCurrentTimeStep(timeStep);
+  return reader;
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (expected->GetDataType() != actual->GetDataType() ||
+    expected->GetNumberOfTuples() != actual->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfTuples(); ++cc)
+  {
+    if (expected->GetTuple1(cc) != actual->GetTuple1(cc))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks that `reader` decoded the blocks first to last only, with the same
+// values as `full`.
+bool CompareBlocks(vtkSpyPlotUniReader* full, vtkSpyPlotUniReader* reader, int first, int last)
+{
+  if (!reader->MakeCurrent())
+  {
+    vtkLogF(ERROR, "Failed to read blocks %d to %d.", first, last);
+    return false;
+  }
+  for (int field = 0; field < full->GetNumberOfCellFields(); ++field)
+  {
+    for (int block = 0; block < full->GetNumberOfDataBlocks(); ++block)
+    {
+      int fixed;
+      vtkDataArray* expected = full->GetCellFieldData(block, field, &fixed);
+      vtkDataArray* actual = reader->GetCellFieldData(block, field, &fixed);
+      if (!expected)
+      {
+        continue;
+      }
+      if (block < first || block > last)
+      {
+        if (actual)
+        {
+          vtkLogF(ERROR, "Block %d of '%s' is out of range [%d, %d] but was decoded.", block,
+            full->GetCellFieldName(field), first, last);
+          return false;
+        }
+      }
+      else if (!actual || !CompareArrays(expected, actual))
+      {
+        vtkLogF(ERROR, "Block %d of '%s' does not match the full read.", block,
+          full->GetCellFieldName(field));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestSpyPlotUniReaderBlockRange(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth_a.0");
+  const std::string filename = fname;
+  delete[] fname;
+
+  vtkNew<vtkDataArraySelection> selection;
+  auto full = NewReader(filename, selection, 0);
+  if (!full)
+  {
+    return EXIT_FAILURE;
+  }
+  // the last dump is read so that the offsets of the blocks do not start at
+  // the first variable in the file.
+  const int timeStep = full->GetTimeStepRange()[1];
+  full->SetCurrentTimeStep(timeStep);
+
+  // Reference: all blocks, decoded on a single thread.
+  bool fullRead = false;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1, "Sequential", false },
+    [&]() { fullRead = full->MakeCurrent() != 0; });
+  const int numberOfBlocks = full->GetNumberOfDataBlocks();
+  if (!fullRead || full->GetNumberOfCellFields() == 0 || numberOfBlocks < 3)
+  {
+    vtkLogF(ERROR, "Expected at least 3 blocks and a cell field, got %d blocks and %d fields.",
+      numberOfBlocks, full->GetNumberOfCellFields());
+    return EXIT_FAILURE;
+  }
+
+  // A subset of the blocks, away from both ends of the file.
+  auto reader = NewReader(filename, selection, timeStep);
+  if (!reader)
+  {
+    return EXIT_FAILURE;
+  }
+  const int first = 1;
+  const int middle = numberOfBlocks / 2;
+  reader->SetBlockRange(first, middle);
+  if (!CompareBlocks(full, reader, first, middle))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Moving the range releases the blocks left and decodes the new ones with
+  // the offsets already indexed.
+  reader->SetBlockRange(middle, -1);
+  if (!CompareBlocks(full, reader, middle, numberOfBlocks - 1))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The whole range matches the full read.
+  reader->SetBlockRange(0, -1);
+  if (!CompareBlocks(full, reader, 0, numberOfBlocks - 1))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -121,6 +121,8 @@ void vtkSpyPlotBlockDistributionBlockIterator::FindFirstBlockOfCurrentOrNextFile
         this->Block = blockStart;
         if (this->Block <= this->BlockEnd)
         {
+          // only decode the blocks of this process.
+          this->UniReader->SetBlockRange(blockStart, this->BlockEnd);
           break; // Done
         }
       }
@@ -248,6 +250,7 @@ void vtkSpyPlotFileDistributionBlockIterator::FindFirstBlockOfCurrentOrNextFile(
       this->Block = 0;
       if (this->Block <= this->BlockEnd)
       {
+        this->UniReader->SetBlockRange(0, -1);
         break;
       }
     }
@@ -1,12 +1,13 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkSpyPlotUniReader.h"
-#include "vtkByteSwap.h"
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVMappedFile.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -14,6 +15,9 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
 #include <vector>
 
@@ -43,6 +47,101 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+namespace
+{
+//-----------------------------------------------------------------------------
+inline vtkTypeUInt32 ReadUInt32BE(const unsigned char* in)
+{
+  vtkTypeUInt32 word;
+  std::memcpy(&word, in, 4);
+#ifndef VTK_WORDS_BIGENDIAN
+  word = (word >> 24) | ((word >> 8) & 0x0000ff00u) | ((word << 8) & 0x00ff0000u) | (word << 24);
+#endif
+  return word;
+}
+
+//-----------------------------------------------------------------------------
+inline float ReadFloatBE(const unsigned char* in)
+{
+  const vtkTypeUInt32 word = ReadUInt32BE(in);
+  float value;
+  std::memcpy(&value, &word, 4);
+  return value;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Run-length decodes `inSize` bytes of `in` into `outSize` values of `out`.
+ * A run starts with a byte n: below 128, the big-endian float that follows is
+ * repeated n times, otherwise n - 128 big-endian floats follow. Bounds are
+ * checked once per run, so that repeated runs are plain fills and literal runs
+ * are byte-swap loops the compiler can vectorize. Returns false when the runs
+ * overflow `out` or are truncated.
+ */
+template <class T>
+bool RunLengthDecode(const unsigned char* in, int inSize, T* out, int outSize, float scale)
+{
+  const unsigned char* inEnd = in + inSize;
+  T* outEnd = out + outSize;
+  while (out < outEnd && in < inEnd)
+  {
+    const int runLength = *in++;
+    if (runLength < 128)
+    {
+      if (inEnd - in < 4 || outEnd - out < runLength)
+      {
+        return false;
+      }
+      std::fill(out, out + runLength, static_cast<T>(ReadFloatBE(in) * scale));
+      in += 4;
+      out += runLength;
+    }
+    else
+    {
+      const int count = runLength - 128;
+      if (inEnd - in < 4 * count || outEnd - out < count)
+      {
+        return false;
+      }
+      for (int k = 0; k < count; ++k)
+      {
+        out[k] = static_cast<T>(ReadFloatBE(in + 4 * k) * scale);
+      }
+      in += 4 * count;
+      out += count;
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Decodes the planes of one block stored at `in`, each a big-endian byte count
+// followed by the run-length encoded values.
+template <class T>
+bool DecodeBlock(const unsigned char* in, const unsigned char* inEnd, const int dims[3], T* out,
+  float scale)
+{
+  const int planeSize = dims[0] * dims[1];
+  for (int zax = 0; zax < dims[2]; ++zax)
+  {
+    if (inEnd - in < 4)
+    {
+      return false;
+    }
+    const int numBytes = static_cast<int>(ReadUInt32BE(in));
+    in += 4;
+    if (numBytes < 0 || inEnd - in < numBytes ||
+      !RunLengthDecode(in, numBytes, out + static_cast<vtkIdType>(zax) * planeSize, planeSize,
+        scale))
+    {
+      return false;
+    }
+    in += numBytes;
+  }
+  return true;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -72,6 +171,10 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 
   this->DataDumps = nullptr;
   this->Blocks = nullptr;
+  this->AllocatedBlockIds = nullptr;
+  this->NumberOfAllocatedBlockIds = 0;
+  this->BlockRange[0] = 0;
+  this->BlockRange[1] = -1;
 
   this->CellArraySelection = nullptr;
 
@@ -136,11 +239,13 @@ vtkSpyPlotUniReader::~vtkSpyPlotUniReader()
         delete[] cv->DataBlocks;
         delete[] cv->GhostCellsFixed;
       }
+      delete[] cv->BlockOffsets;
     }
     delete[] dp->Variables;
   }
   delete[] this->DataDumps;
   delete[] this->Blocks;
+  delete[] this->AllocatedBlockIds;
   this->SetFileName(nullptr);
   this->SetCellArraySelection(nullptr);
 
@@ -197,6 +302,100 @@ void vtkSpyPlotUniReader::SetDownConvertVolumeFraction(int vf)
   this->DataTypeChanged = 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkSpyPlotUniReader::SetBlockRange(int first, int last)
+{
+  first = std::max(first, 0);
+  last = std::max(last, -1);
+  if (this->BlockRange[0] == first && this->BlockRange[1] == last)
+  {
+    return;
+  }
+  this->BlockRange[0] = first;
+  this->BlockRange[1] = last;
+  this->NeedToCheck = 1;
+  this->Modified();
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotUniReader::UpdateAllocatedBlockIds()
+{
+  delete[] this->AllocatedBlockIds;
+  this->AllocatedBlockIds = new int[this->NumberOfBlocks];
+  this->NumberOfAllocatedBlockIds = 0;
+  for (int block = 0; block < this->NumberOfBlocks; ++block)
+  {
+    if (this->Blocks[block].IsAllocated())
+    {
+      this->AllocatedBlockIds[this->NumberOfAllocatedBlockIds++] = block;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::ReadBlockOffsets(vtkSpyPlotIStream* spis, const unsigned char* data,
+  vtkTypeInt64 size, vtkSpyPlotUniReader::DataDump* dp, int field)
+{
+  vtkSpyPlotUniReader::Variable* var = dp->Variables + field;
+  if (var->BlockOffsets)
+  {
+    return 1;
+  }
+
+  // Walk the plane headers of every allocated block without decoding them.
+  std::vector<vtkTypeInt64> offsets;
+  offsets.reserve(this->NumberOfAllocatedBlockIds + 1);
+  vtkTypeInt64 offset = dp->SavedVariableOffsets[field];
+  if (!data)
+  {
+    spis->Seek(offset);
+  }
+  for (int cc = 0; cc < this->NumberOfAllocatedBlockIds; ++cc)
+  {
+    offsets.push_back(offset);
+    int bdims[3];
+    this->Blocks[this->AllocatedBlockIds[cc]].GetDimensions(bdims);
+    for (int zax = 0; zax < bdims[2]; ++zax)
+    {
+      int numBytes;
+      if (data)
+      {
+        if (offset < 0 || size - offset < 4)
+        {
+          vtkErrorMacro("Problem reading the number of bytes");
+          return 0;
+        }
+        numBytes = static_cast<int>(::ReadUInt32BE(data + offset));
+      }
+      else if (!spis->ReadInt32s(&numBytes, 1))
+      {
+        vtkErrorMacro("Problem reading the number of bytes");
+        return 0;
+      }
+      if (numBytes < 0)
+      {
+        vtkErrorMacro("Invalid number of bytes: " << numBytes);
+        return 0;
+      }
+      offset += 4 + numBytes;
+      if (!data)
+      {
+        spis->Seek(numBytes, true);
+      }
+    }
+  }
+  offsets.push_back(offset);
+  if (data && offset > size)
+  {
+    vtkErrorMacro("Variable " << var->Name << " extends past the end of the file");
+    return 0;
+  }
+
+  var->BlockOffsets = new vtkTypeInt64[offsets.size()];
+  std::copy(offsets.begin(), offsets.end(), var->BlockOffsets);
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::MakeCurrent()
 {
@@ -288,6 +487,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
         }
       }
     }
+    this->UpdateAllocatedBlockIds();
   }
 
   if (!this->NeedToCheck)
@@ -306,6 +506,8 @@ int vtkSpyPlotUniReader::MakeCurrent()
       for (var = 0; var < dp->NumVars; ++var)
       {
         vtkSpyPlotUniReader::Variable* cv = dp->Variables + var;
+        delete[] cv->BlockOffsets;
+        cv->BlockOffsets = nullptr;
         if (cv->DataBlocks)
         {
           int ca;
@@ -329,6 +531,37 @@ int vtkSpyPlotUniReader::MakeCurrent()
 
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
+  if (this->NumberOfAllocatedBlockIds != dp->ActualNumberOfBlocks)
+  {
+    vtkErrorMacro("Expected " << dp->ActualNumberOfBlocks << " allocated blocks, found "
+                              << this->NumberOfAllocatedBlockIds);
+    return 0;
+  }
+
+  // Only the allocated blocks in BlockRange are decoded.
+  const int firstBlock = std::min(this->BlockRange[0], dp->ActualNumberOfBlocks);
+  const int lastBlock = this->BlockRange[1] < 0
+    ? dp->ActualNumberOfBlocks - 1
+    : std::min(this->BlockRange[1], dp->ActualNumberOfBlocks - 1);
+
+  // Variables are decoded straight from a mapping of the file when possible,
+  // else the bytes of the blocks in range are read into arrayBuffer.
+  vtkPVMappedFile mappedFile;
+  if (!mappedFile.Map(this->FileName))
+  {
+    vtkDebugMacro("Could not map " << this->FileName << ", reading it instead.");
+  }
+  const unsigned char* mappedData = mappedFile.GetData();
+  const vtkTypeInt64 mappedSize = static_cast<vtkTypeInt64>(mappedFile.GetSize());
+
+  struct BlockToDecode
+  {
+    int Dimensions[3];
+    vtkTypeInt64 Offset;
+    vtkTypeInt64 End;
+    void* Output;
+  };
+  std::vector<BlockToDecode> blocksToDecode;
 
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
@@ -336,16 +569,9 @@ int vtkSpyPlotUniReader::MakeCurrent()
     vtkDebugMacro("Variable: " << var << " (" << var->Name << ") - " << fieldCnt
                                << " (file: " << this->FileName << ") ");
 
-    // Do we need to create new data blocks
-    int blocksExists = 0;
-    if (var->DataBlocks)
-    {
-      vtkDebugMacro(" *** Looks like variable: " << var->Name << " is already loaded");
-      blocksExists = 1;
-    }
     // Did we create data blocks that we do not need any more
-    if ((!this->CellArraySelection->ArrayIsEnabled(var->Name)) ||
-      (this->DataTypeChanged && this->IsVolumeFraction(var)))
+    const bool enabled = this->CellArraySelection->ArrayIsEnabled(var->Name) != 0;
+    if (!enabled || (this->DataTypeChanged && this->IsVolumeFraction(var)))
     {
       if (var->DataBlocks)
       {
@@ -353,8 +579,10 @@ int vtkSpyPlotUniReader::MakeCurrent()
         int dataBlock;
         for (dataBlock = 0; dataBlock < dp->ActualNumberOfBlocks; ++dataBlock)
         {
-          var->DataBlocks[dataBlock]->Delete();
-          var->DataBlocks[dataBlock] = nullptr;
+          if (var->DataBlocks[dataBlock])
+          {
+            var->DataBlocks[dataBlock]->Delete();
+          }
         }
         delete[] var->DataBlocks;
         var->DataBlocks = nullptr;
@@ -363,13 +591,13 @@ int vtkSpyPlotUniReader::MakeCurrent()
         vtkDebugMacro("* Delete Data blocks for variable: " << var->Name);
       }
       vtkDebugMacro(" *** Ignore variable: " << var->Name);
-      if (!this->CellArraySelection->ArrayIsEnabled(var->Name))
+      if (!enabled)
       {
         continue;
       }
     }
 
-    if ((needMarkers || this->CellArraySelection->ArrayIsEnabled(var->Name)) && !var->DataBlocks)
+    if (!var->DataBlocks)
     {
       vtkDebugMacro(
         " ** Allocate new space for variable: " << var->Name << " - " << this->FileName);
@@ -378,98 +606,118 @@ int vtkSpyPlotUniReader::MakeCurrent()
       var->GhostCellsFixed = new int[dp->ActualNumberOfBlocks];
       memset(var->GhostCellsFixed, 0, dp->ActualNumberOfBlocks * sizeof(int));
       vtkDebugMacro(" Allocate DataBlocks: " << var->DataBlocks);
-      blocksExists = 0;
     }
 
-    if (blocksExists)
+    // Release the blocks that are out of range and find the missing ones.
+    std::vector<int> missingBlocks;
+    for (int block = 0; block < dp->ActualNumberOfBlocks; ++block)
+    {
+      if (block < firstBlock || block > lastBlock)
+      {
+        if (var->DataBlocks[block])
+        {
+          var->DataBlocks[block]->Delete();
+          var->DataBlocks[block] = nullptr;
+          var->GhostCellsFixed[block] = 0;
+        }
+      }
+      else if (!var->DataBlocks[block])
+      {
+        missingBlocks.push_back(block);
+      }
+    }
+    if (missingBlocks.empty())
     {
       vtkDebugMacro(<< var << " Skip reading of variable: " << var->Name << " / "
                     << this->FileName);
       continue;
     }
 
-    // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
-    // << " [" << var->Name << "]" );
-    // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
-    spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
-    int numBytes;
-    int block;
-    int actualBlockId = 0;
-    for (block = 0; block < dp->NumberOfBlocks; ++block)
+    if (!this->ReadBlockOffsets(&spis, mappedData, mappedSize, dp, fieldCnt))
     {
-      vtkSpyPlotBlock* bk = this->Blocks + block;
-      if (bk->IsAllocated())
+      return 0;
+    }
+
+    // Create the arrays up front, only the decoding runs in parallel.
+    const bool downConvert = this->DownConvertVolumeFraction && this->IsVolumeFraction(var);
+    blocksToDecode.clear();
+    for (const int block : missingBlocks)
+    {
+      BlockToDecode toDecode;
+      this->Blocks[this->AllocatedBlockIds[block]].GetDimensions(toDecode.Dimensions);
+      toDecode.Offset = var->BlockOffsets[block];
+      toDecode.End = var->BlockOffsets[block + 1];
+
+      vtkDataArray* dataArray;
+      if (downConvert)
       {
-        vtkFloatArray* floatArray = nullptr;
-        vtkUnsignedCharArray* unsignedCharArray = nullptr;
-        vtkDataArray* dataArray = nullptr;
-        if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
-        {
-          if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
-          {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
-          }
-          else
-          {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
-          }
-          dataArray->SetNumberOfComponents(1);
-          dataArray->SetNumberOfTuples(
-            bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
-          dataArray->SetName(var->Name);
-          // vtkDebugMacro( "*** Create data array: "
-          // << dataArray->GetNumberOfTuples() );
-        }
-        int zax;
-        int bdims[3];
-        bk->GetDimensions(bdims);
-        for (zax = 0; zax < bdims[2]; ++zax)
+        dataArray = vtkUnsignedCharArray::New();
+      }
+      else
+      {
+        dataArray = vtkFloatArray::New();
+      }
+      dataArray->SetNumberOfComponents(1);
+      dataArray->SetNumberOfTuples(static_cast<vtkIdType>(toDecode.Dimensions[0]) *
+        toDecode.Dimensions[1] * toDecode.Dimensions[2]);
+      dataArray->SetName(var->Name);
+      toDecode.Output = dataArray->GetVoidPointer(0);
+      var->DataBlocks[block] = dataArray;
+      var->GhostCellsFixed[block] = 0;
+      blocksToDecode.push_back(toDecode);
+    }
+
+    const unsigned char* data = mappedData;
+    vtkTypeInt64 dataOffset = 0;
+    if (!data)
+    {
+      dataOffset = var->BlockOffsets[missingBlocks.front()];
+      const vtkTypeInt64 numBytes = var->BlockOffsets[missingBlocks.back() + 1] - dataOffset;
+      arrayBuffer.resize(static_cast<size_t>(numBytes));
+      spis.Seek(dataOffset);
+      if (numBytes > 0 && !spis.ReadString(arrayBuffer.data(), static_cast<size_t>(numBytes)))
+      {
+        vtkErrorMacro("Problem reading the bytes");
+        return 0;
+      }
+      data = arrayBuffer.data();
+    }
+
+    std::atomic<bool> failed(false);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocksToDecode.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end && !failed; ++cc)
         {
-          int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
-          {
-            vtkErrorMacro("Problem reading the number of bytes");
-            return 0;
-          }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
+          const BlockToDecode& toDecode = blocksToDecode[cc];
+          const unsigned char* in = data + (toDecode.Offset - dataOffset);
+          const unsigned char* inEnd = data + (toDecode.End - dataOffset);
+          const bool decoded = downConvert
+            ? ::DecodeBlock(in, inEnd, toDecode.Dimensions,
+                static_cast<unsigned char*>(toDecode.Output), 255.0f)
+            : ::DecodeBlock(
+                in, inEnd, toDecode.Dimensions, static_cast<float*>(toDecode.Output), 1.0f);
+          if (!decoded)
           {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
-          }
-          if (unsignedCharArray)
-          {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
+            failed = true;
           }
         }
-        if (dataArray)
-        {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
-          actualBlockId++;
-        }
-      }
+      });
+    if (failed)
+    {
+      vtkErrorMacro("Problem RLD decoding data array " << var->Name);
+      return 0;
+    }
+    vtkDebugMacro(" " << blocksToDecode.size() << " blocks initialized: " << var->Name);
+  }
+
+  if (blocksUpdated && needMarkers && dp->NumVars > 0)
+  {
+    // Marker data follows the last variable.
+    if (!this->ReadBlockOffsets(&spis, mappedData, mappedSize, dp, dp->NumVars - 1))
+    {
+      return 0;
     }
+    spis.Seek(dp->Variables[dp->NumVars - 1].BlockOffsets[this->NumberOfAllocatedBlockIds]);
   }
 
   if (blocksUpdated && needMarkers)
@@ -671,59 +919,12 @@ template <class t>
 int vtkSpyPlotUniReaderRunLengthDataDecode(
   vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
 {
-  int outIndex = 0, inIndex = 0;
-
-  const unsigned char* ptmp = in;
-
-  /* Run-length decode */
-  while ((outIndex < outSize) && (inIndex < inSize))
+  if (!::RunLengthDecode(in, inSize, out, outSize, static_cast<float>(scale)))
   {
-    // Okay get the run length
-    unsigned char runLength = *ptmp;
-    ptmp++;
-    if (runLength < 128)
-    {
-      float val;
-      memcpy(&val, ptmp, sizeof(float));
-      vtkByteSwap::SwapBE(&val);
-      ptmp += 4;
-      // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(
-            self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-      }
-      inIndex += 5;
-    }
-    else // runLength >= 128
-    {
-      int k;
-      for (k = 0; k < runLength - 128; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(
-            self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        float val;
-        memcpy(&val, ptmp, sizeof(float));
-        vtkByteSwap::SwapBE(&val);
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-        ptmp += 4;
-      }
-      inIndex += 4 * (runLength - 128) + 1;
-    }
-  } // while
-
+    vtkErrorWithObjectMacro(
+      self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
+    return 0;
+  }
   return 1;
 }
 
@@ -866,6 +1067,12 @@ vtkSpyPlotBlock* vtkSpyPlotUniReader::GetBlock(int block)
     if (!this->ReadInformation())
       return nullptr;
   }
+  if (this->AllocatedBlockIds)
+  {
+    return block >= 0 && block < this->NumberOfAllocatedBlockIds
+      ? this->Blocks + this->AllocatedBlockIds[block]
+      : nullptr;
+  }
   int cb = 0;
   int blockId;
   for (blockId = 0; blockId < this->NumberOfBlocks; ++blockId)
@@ -914,12 +1121,12 @@ const char* vtkSpyPlotUniReader::GetCellFieldName(int field)
 vtkDataArray* vtkSpyPlotUniReader::GetCellFieldData(int block, int field, int* fixed)
 {
   vtkSpyPlotUniReader::DataDump* dp = this->DataDumps + this->CurrentTimeStep;
-  if (block < 0 || block > dp->ActualNumberOfBlocks)
+  if (block < 0 || block >= dp->ActualNumberOfBlocks)
   {
     return nullptr;
   }
   vtkSpyPlotUniReader::Variable* var = this->GetCellField(field);
-  if (!var)
+  if (!var || !var->DataBlocks)
   {
     return nullptr;
   }
@@ -942,7 +1149,8 @@ vtkDataArray* vtkSpyPlotUniReader::GetMaterialField(
     var = &dp->Variables[v];
     if (strcmp(var->MaterialField->Id, id) == 0)
     {
-      if (var->Index == materialIndex && var->DataBlocks != nullptr)
+      if (var->Index == materialIndex && var->DataBlocks != nullptr && block >= 0 &&
+        block < dp->ActualNumberOfBlocks)
       {
         return var->DataBlocks[block];
       }
@@ -967,12 +1175,12 @@ vtkDataArray* vtkSpyPlotUniReader::GetMaterialVolumeFractionField(
 int vtkSpyPlotUniReader::MarkCellFieldDataFixed(int block, int field)
 {
   vtkSpyPlotUniReader::DataDump* dp = this->DataDumps + this->CurrentTimeStep;
-  if (block < 0 || block > dp->ActualNumberOfBlocks)
+  if (block < 0 || block >= dp->ActualNumberOfBlocks)
   {
     return 0;
   }
   vtkSpyPlotUniReader::Variable* var = this->GetCellField(field);
-  if (!var)
+  if (!var || !var->DataBlocks || !var->DataBlocks[block])
   {
     return 0;
   }
@@ -1341,6 +1549,8 @@ void vtkSpyPlotUniReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CurrentTime: " << this->CurrentTime << endl;
   os << indent << "DataTypeChanged: " << this->DataTypeChanged << endl;
   os << indent << "NumberOfCellFields: " << this->NumberOfCellFields << endl;
+  os << indent << "BlockRange: [" << this->BlockRange[0] << ", " << this->BlockRange[1] << "]"
+     << endl;
   os << indent << "NeedToCheck: " << this->NeedToCheck << endl;
 }
 
@@ -1552,6 +1762,8 @@ int vtkSpyPlotUniReader::ReadDataDumps(vtkSpyPlotIStream* spis)
       variable->Material = -1;
       variable->Index = -1;
       variable->DataBlocks = nullptr;
+      variable->GhostCellsFixed = nullptr;
+      variable->BlockOffsets = nullptr;
       int var = dh->SavedVariables[fieldCnt];
       if (var >= this->NumberOfPossibleCellFields)
       {
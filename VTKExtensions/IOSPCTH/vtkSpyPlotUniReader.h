@@ -61,6 +61,17 @@ public:
    */
   int MakeCurrent();
 
+  ///@{
+  /**
+   * Restrict the data arrays decoded by MakeCurrent() to the allocated blocks
+   * first to last (inclusive). Arrays of the other blocks are neither read nor
+   * kept, and GetCellFieldData() returns nullptr for them. A negative last
+   * block means up to the last allocated block, which is the default.
+   */
+  void SetBlockRange(int first, int last);
+  vtkGetVector2Macro(BlockRange, int);
+  ///@}
+
   void PrintInformation();
   void PrintMemoryUsage();
 
@@ -172,6 +183,9 @@ public:
     CellMaterialField* MaterialField;
     vtkDataArray** DataBlocks;
     int* GhostCellsFixed;
+    // File offsets of the data of each allocated block, plus the offset past
+    // the last one. Built on first use and kept while the dump is current.
+    vtkTypeInt64* BlockOffsets;
   };
   struct DataDump
   {
@@ -240,6 +254,9 @@ private:
   int ReadGroupHeaderInformation(vtkSpyPlotIStream* spis);
   int ReadDataDumps(vtkSpyPlotIStream* spis);
   int ReadMarkerDumps(vtkSpyPlotIStream* spis);
+  int ReadBlockOffsets(vtkSpyPlotIStream* spis, const unsigned char* data, vtkTypeInt64 size,
+    DataDump* dp, int field);
+  void UpdateAllocatedBlockIds();
 
   vtkDataArray* GetMaterialField(const int& block, const int& materialIndex, const char* Id);
 
@@ -301,6 +318,13 @@ private:
 
   int NumberOfCellFields;
 
+  // Allocated blocks decoded by MakeCurrent()
+  int BlockRange[2];
+
+  // Index in Blocks of each allocated block of the geometry time step
+  int* AllocatedBlockIds;
+  int NumberOfAllocatedBlockIds;
+
   vtkDataArraySelection* CellArraySelection;
 
   Variable* GetCellField(int field);
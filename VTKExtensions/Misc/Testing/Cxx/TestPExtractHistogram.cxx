@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkSphereSource.h"
+#include "vtkTable.h"
+
+#include <cmath>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+double GetTotal(vtkDataArray* values)
+{
+  double total = 0;
+  for (vtkIdType cc = 0; cc < values->GetNumberOfTuples(); ++cc)
+  {
+    total += values->GetTuple1(cc);
+  }
+  return total;
+}
+}
+
+int TestPExtractHistogram(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(100);
+  sphere->SetPhiResolution(100);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0, 0, -1);
+  elevation->SetHighPoint(0, 0, 1);
+  elevation->Update();
+  const double numberOfPoints = elevation->GetOutput()->GetNumberOfPoints();
+  double range[2];
+  elevation->GetOutput()->GetPointData()->GetArray("Elevation")->GetRange(range);
+
+  vtkNew<vtkPExtractHistogram> histogram;
+  histogram->SetInputConnection(elevation->GetOutputPort());
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Elevation");
+  histogram->SetBinCount(10);
+  histogram->Update();
+  vtkNew<vtkTable> serial;
+  serial->DeepCopy(histogram->GetOutput());
+
+  histogram->EnableSMPOn();
+  histogram->Update();
+  vtkNew<vtkTable> threaded;
+  threaded->DeepCopy(histogram->GetOutput());
+  vtkDataArray* extents = threaded->GetRowData()->GetArray("bin_extents");
+  vtkDataArray* values = threaded->GetRowData()->GetArray("bin_values");
+  expect(extents && values && values->GetNumberOfTuples() == 10, "missing bins");
+  expect(GetTotal(values) == numberOfPoints, "unexpected number of binned values");
+  for (vtkIdType cc = 0; cc < 10; ++cc)
+  {
+    const double expected = serial->GetRowData()->GetArray("bin_extents")->GetTuple1(cc);
+    expect(std::abs(extents->GetTuple1(cc) - expected) < 1e-12, "unexpected bin extents");
+    expect(values->GetTuple1(cc) == serial->GetRowData()->GetArray("bin_values")->GetTuple1(cc),
+      "threaded bins do not match serial bins");
+  }
+
+  // the 5 bins are computed from the cached bins and must match the 10 bins.
+  histogram->SetBinCount(5);
+  histogram->Update();
+  vtkDataArray* coarse = histogram->GetOutput()->GetRowData()->GetArray("bin_values");
+  expect(coarse && coarse->GetNumberOfTuples() == 5, "missing coarse bins");
+  for (vtkIdType cc = 0; cc < 5; ++cc)
+  {
+    expect(coarse->GetTuple1(cc) == values->GetTuple1(2 * cc) + values->GetTuple1(2 * cc + 1),
+      "coarse bins do not match");
+  }
+
+  // centered bins extend beyond the range by half a bin, by how much depends
+  // on the bin count but the cached bins still do not.
+  histogram->SetCenterBinsAroundMinAndMax(true);
+  vtkNew<vtkTable> centered;
+  for (int binCount : { 10, 5 })
+  {
+    histogram->EnableSMPOff();
+    histogram->SetBinCount(binCount);
+    histogram->Update();
+    serial->DeepCopy(histogram->GetOutput());
+    histogram->EnableSMPOn();
+    histogram->Update();
+    if (binCount == 10)
+    {
+      centered->DeepCopy(histogram->GetOutput());
+    }
+    extents = histogram->GetOutput()->GetRowData()->GetArray("bin_extents");
+    values = histogram->GetOutput()->GetRowData()->GetArray("bin_values");
+    expect(extents && values && values->GetNumberOfTuples() == binCount, "missing centered bins");
+    for (vtkIdType cc = 0; cc < binCount; ++cc)
+    {
+      const double expected = serial->GetRowData()->GetArray("bin_extents")->GetTuple1(cc);
+      expect(
+        std::abs(extents->GetTuple1(cc) - expected) < 1e-12, "unexpected centered bin extents");
+      expect(values->GetTuple1(cc) == serial->GetRowData()->GetArray("bin_values")->GetTuple1(cc),
+        "threaded centered bins do not match serial bins");
+    }
+  }
+  histogram->SetCenterBinsAroundMinAndMax(false);
+
+  histogram->SetBinCount(16);
+  histogram->SinglePassOn();
+  histogram->Update();
+  extents = histogram->GetOutput()->GetRowData()->GetArray("bin_extents");
+  values = histogram->GetOutput()->GetRowData()->GetArray("bin_values");
+  expect(values && values->GetNumberOfTuples() <= 16 && values->GetNumberOfTuples() > 8,
+    "unexpected number of single pass bins");
+  expect(GetTotal(values) == numberOfPoints, "unexpected number of single pass binned values");
+  const double width = extents->GetTuple1(1) - extents->GetTuple1(0);
+  int exponent = 0;
+  expect(std::frexp(width, &exponent) == 0.5, "single pass bin width is not a power of two");
+  expect(extents->GetTuple1(0) - 0.5 * width <= range[0] &&
+      extents->GetTuple1(values->GetNumberOfTuples() - 1) + 0.5 * width > range[1],
+    "single pass bins do not cover the range");
+
+  // the cached bins are reused as long as the input array is not modified:
+  // change its values without marking it modified, the bins must not change.
+  histogram->SinglePassOff();
+  histogram->SetCenterBinsAroundMinAndMax(true);
+  histogram->SetBinCount(5);
+  histogram->Update();
+  vtkDataArray* elevations = elevation->GetOutput()->GetPointData()->GetArray("Elevation");
+  for (vtkIdType cc = 0; cc < elevations->GetNumberOfTuples(); ++cc)
+  {
+    elevations->SetTuple1(cc, range[0]);
+  }
+  histogram->SetBinCount(10);
+  histogram->Update();
+  values = histogram->GetOutput()->GetRowData()->GetArray("bin_values");
+  expect(values && values->GetNumberOfTuples() == 10, "missing cached bins");
+  for (vtkIdType cc = 0; cc < 10; ++cc)
+  {
+    expect(values->GetTuple1(cc) == centered->GetRowData()->GetArray("bin_values")->GetTuple1(cc),
+      "cached bins were not reused");
+  }
+
+  // once modified, the input is binned again.
+  elevations->Modified();
+  histogram->Modified();
+  histogram->Update();
+  values = histogram->GetOutput()->GetRowData()->GetArray("bin_values");
+  expect(values && values->GetRange()[1] == numberOfPoints, "modified input was not binned again");
+
+  return EXIT_SUCCESS;
+}
@@ -3,30 +3,514 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkAttributeDataReductionFilter.h"
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
+#include "vtkMath.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+// Number of cached bins for `binCount` bins: the smallest common multiple of
+// `binCount` and 720, so that most round bin counts can later be computed
+// from the cache, or `binCount` itself if that would make too many bins.
+int GetFineBinCount(int binCount)
+{
+  int a = 720, b = binCount;
+  while (b != 0)
+  {
+    const int r = a % b;
+    a = b;
+    b = r;
+  }
+  const vtkTypeInt64 lcm = static_cast<vtkTypeInt64>(720 / a) * binCount;
+  return lcm <= 65536 ? static_cast<int>(lcm) : binCount;
+}
+
+// Component of `array` to bin for the filter's `component`, -1 for the
+// magnitude.
+int GetComponentToBin(vtkDataArray* array, int component)
+{
+  const int numComps = array->GetNumberOfComponents();
+  if (numComps == 1)
+  {
+    return 0;
+  }
+  return (component >= 0 && component < numComps) ? component : -1;
+}
+
+// Calls `op` with the `component` value, or the L2 norm if `component` is
+// negative, of each tuple of `array` in [begin, end). Tuples flagged in
+// `ghosts` with any of the `ghostsToSkip` bits are skipped.
+template <typename ArrayT, typename OpT>
+void ForEachValue(ArrayT* array, int component, const unsigned char* ghosts,
+  unsigned char ghostsToSkip, vtkIdType begin, vtkIdType end, OpT& op)
+{
+  const int numComps = array->GetNumberOfComponents();
+  const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+  vtkIdType tupleIdx = begin;
+  for (const auto tuple : tuples)
+  {
+    if (ghosts && (ghosts[tupleIdx++] & ghostsToSkip))
+    {
+      continue;
+    }
+    if (component >= 0)
+    {
+      op(static_cast<double>(tuple[component]));
+    }
+    else
+    {
+      double squaredNorm = 0.0;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        const double value = static_cast<double>(tuple[comp]);
+        squaredNorm += value * value;
+      }
+      op(std::sqrt(squaredNorm));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Adds the number of values falling in each of `Bins.size()` bins of equal
+// width over `Range` to `Bins`. Values equal to the upper bound of the range
+// go to the last bin; values outside of the range and NaNs are ignored.
+template <typename ArrayT>
+class BinValuesFunctor
+{
+public:
+  BinValuesFunctor(ArrayT* array, int component, const unsigned char* ghosts,
+    unsigned char ghostsToSkip, const double range[2], std::vector<vtkTypeInt64>& bins)
+    : Array(array)
+    , Component(component)
+    , Ghosts(ghosts)
+    , GhostsToSkip(ghostsToSkip)
+    , Min(range[0])
+    , Max(range[1])
+    , Scale(bins.size() / (range[1] - range[0]))
+    , Bins(bins)
+  {
+  }
+
+  void Initialize() { this->LocalBins.Local().assign(this->Bins.size(), 0); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& bins = this->LocalBins.Local();
+    const int lastBin = static_cast<int>(bins.size()) - 1;
+    const double min = this->Min;
+    const double max = this->Max;
+    const double scale = this->Scale;
+    auto binValue = [&](double value) {
+      if (value >= min && value <= max)
+      {
+        ++bins[std::min(static_cast<int>((value - min) * scale), lastBin)];
+      }
+    };
+    ::ForEachValue(
+      this->Array, this->Component, this->Ghosts, this->GhostsToSkip, begin, end, binValue);
+  }
+
+  void Reduce()
+  {
+    for (const auto& local : this->LocalBins)
+    {
+      std::transform(local.begin(), local.end(), this->Bins.begin(), this->Bins.begin(),
+        std::plus<vtkTypeInt64>());
+    }
+  }
+
+private:
+  ArrayT* Array;
+  const int Component;
+  const unsigned char* Ghosts;
+  const unsigned char GhostsToSkip;
+  const double Min;
+  const double Max;
+  const double Scale;
+  std::vector<vtkTypeInt64>& Bins;
+  vtkSMPThreadLocal<std::vector<vtkTypeInt64>> LocalBins;
+};
+
+struct BinValuesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int component, const unsigned char* ghosts,
+    unsigned char ghostsToSkip, const double* range, std::vector<vtkTypeInt64>& bins)
+  {
+    BinValuesFunctor<ArrayT> functor(array, component, ghosts, ghostsToSkip, range, bins);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Histogram of at most `Size` consecutive bins of width 2^Exponent, aligned on
+// multiples of the width. Whenever the values do not fit any longer, pairs of
+// bins are merged by doubling the width. The exponent is kept as small as
+// allowed by the values, and never smaller than needed to give each value an
+// exact bin index, so the bins only depend on the values inserted and not on
+// the order in which they were inserted or merged.
+class AdaptiveHistogram
+{
+public:
+  void SetSize(int size) { this->Size = size; }
+
+  bool IsEmpty() const { return this->Counts.empty(); }
+
+  int GetExponent() const { return this->Exponent; }
+
+  // Bin indices of the first and the last bins once coarsened to `exponent`.
+  void GetBounds(int exponent, vtkTypeInt64& first, vtkTypeInt64& last) const
+  {
+    const int shift = exponent - this->Exponent;
+    first = FloorShift(this->First, shift);
+    last = FloorShift(this->First + static_cast<vtkTypeInt64>(this->Counts.size()) - 1, shift);
+  }
+
+  const std::vector<vtkTypeInt64>& GetCounts() const { return this->Counts; }
+
+  void Insert(double value)
+  {
+    if (!vtkMath::IsFinite(value))
+    {
+      return;
+    }
+    if (this->Counts.empty())
+    {
+      this->SetExponent(GetExactExponent(value));
+      this->First = this->GetBin(value);
+      this->Counts.assign(1, 1);
+      return;
+    }
+
+    const double scaled =
+      this->Scale > 0.0 ? value * this->Scale : std::ldexp(value, -this->Exponent);
+    if (std::abs(scaled) < 9007199254740992.0) // 2^53
+    {
+      const vtkTypeInt64 offset = GetBin(scaled, value) - this->First;
+      if (offset >= 0 && offset < static_cast<vtkTypeInt64>(this->Counts.size()))
+      {
+        ++this->Counts[offset];
+        return;
+      }
+    }
+
+    int exponent = std::max(this->Exponent, GetExactExponent(value));
+    vtkTypeInt64 first, last;
+    this->GetBounds(exponent, first, last);
+    const vtkTypeInt64 bin = GetBin(std::ldexp(value, -exponent), value);
+    first = std::min(first, bin);
+    last = std::max(last, bin);
+    this->Fit(exponent, first, last);
+    this->Rebin(exponent, first, last);
+    ++this->Counts[this->GetBin(value) - this->First];
+  }
+
+  void Merge(const AdaptiveHistogram& other)
+  {
+    if (other.IsEmpty())
+    {
+      return;
+    }
+    if (this->IsEmpty())
+    {
+      this->SetExponent(other.Exponent);
+      this->First = other.First;
+      this->Counts = other.Counts;
+      return;
+    }
+
+    int exponent = std::max(this->Exponent, other.Exponent);
+    vtkTypeInt64 first, last, otherFirst, otherLast;
+    this->GetBounds(exponent, first, last);
+    other.GetBounds(exponent, otherFirst, otherLast);
+    first = std::min(first, otherFirst);
+    last = std::max(last, otherLast);
+    this->Fit(exponent, first, last);
+    this->Rebin(exponent, first, last);
+
+    const int shift = this->Exponent - other.Exponent;
+    for (size_t cc = 0; cc < other.Counts.size(); ++cc)
+    {
+      const vtkTypeInt64 bin = static_cast<vtkTypeInt64>(cc) + other.First;
+      this->Counts[FloorShift(bin, shift) - this->First] += other.Counts[cc];
+    }
+  }
+
+  // Increases `exponent` until bins `first` to `last` fit in `Size` bins.
+  void Fit(int& exponent, vtkTypeInt64& first, vtkTypeInt64& last) const
+  {
+    while (last - first >= this->Size)
+    {
+      ++exponent;
+      first = FloorShift(first, 1);
+      last = FloorShift(last, 1);
+    }
+  }
+
+  // Coarsens the bins to `exponent`, which may not be smaller than the
+  // current one, and pads them to span bins `first` to `last`.
+  void Rebin(int exponent, vtkTypeInt64 first, vtkTypeInt64 last)
+  {
+    std::vector<vtkTypeInt64> counts(static_cast<size_t>(last - first + 1), 0);
+    const int shift = exponent - this->Exponent;
+    for (size_t cc = 0; cc < this->Counts.size(); ++cc)
+    {
+      const vtkTypeInt64 bin = static_cast<vtkTypeInt64>(cc) + this->First;
+      counts[FloorShift(bin, shift) - first] += this->Counts[cc];
+    }
+    this->Counts.swap(counts);
+    this->First = first;
+    this->SetExponent(exponent);
+  }
+
+private:
+  static constexpr int MinimumExponent =
+    std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits;
+
+  // Smallest exponent for which `value` is a multiple of the bin width.
+  static int GetExactExponent(double value)
+  {
+    return value == 0.0 ? MinimumExponent
+                        : std::max(std::ilogb(value) - 52, static_cast<int>(MinimumExponent));
+  }
+
+  // floor(bin / 2^shift)
+  static vtkTypeInt64 FloorShift(vtkTypeInt64 bin, int shift)
+  {
+    if (shift >= 63)
+    {
+      return bin < 0 ? -1 : 0;
+    }
+    return bin >= 0 ? (bin >> shift) : ~((~bin) >> shift);
+  }
+
+  // Index of the bin of `value` given `scaled` = value / 2^Exponent. Scaling
+  // values much smaller than the bin width may have underflowed to zero.
+  static vtkTypeInt64 GetBin(double scaled, double value)
+  {
+    if (scaled == 0.0)
+    {
+      return value < 0.0 ? -1 : 0;
+    }
+    return static_cast<vtkTypeInt64>(std::floor(scaled));
+  }
+
+  vtkTypeInt64 GetBin(double value) const
+  {
+    return GetBin(std::ldexp(value, -this->Exponent), value);
+  }
+
+  void SetExponent(int exponent)
+  {
+    this->Exponent = exponent;
+    // 2^-exponent is used as a factor only while it is a normal number.
+    this->Scale = (exponent >= -1022 && exponent <= 1022) ? std::ldexp(1.0, -exponent) : 0.0;
+  }
+
+  int Size = 2;
+  int Exponent = 0;
+  double Scale = 1.0;
+  vtkTypeInt64 First = 0;
+  std::vector<vtkTypeInt64> Counts;
+};
+
+template <typename ArrayT>
+class AdaptiveBinValuesFunctor
+{
+public:
+  AdaptiveBinValuesFunctor(ArrayT* array, int component, const unsigned char* ghosts,
+    unsigned char ghostsToSkip, AdaptiveHistogram& histogram, int size)
+    : Array(array)
+    , Component(component)
+    , Ghosts(ghosts)
+    , GhostsToSkip(ghostsToSkip)
+    , Histogram(histogram)
+    , Size(size)
+  {
+  }
+
+  void Initialize() { this->LocalHistograms.Local().SetSize(this->Size); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& histogram = this->LocalHistograms.Local();
+    auto insert = [&histogram](double value) { histogram.Insert(value); };
+    ::ForEachValue(
+      this->Array, this->Component, this->Ghosts, this->GhostsToSkip, begin, end, insert);
+  }
+
+  void Reduce()
+  {
+    for (const auto& local : this->LocalHistograms)
+    {
+      this->Histogram.Merge(local);
+    }
+  }
+
+private:
+  ArrayT* Array;
+  const int Component;
+  const unsigned char* Ghosts;
+  const unsigned char GhostsToSkip;
+  AdaptiveHistogram& Histogram;
+  const int Size;
+  vtkSMPThreadLocal<AdaptiveHistogram> LocalHistograms;
+};
+
+struct AdaptiveBinValuesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int component, const unsigned char* ghosts,
+    unsigned char ghostsToSkip, AdaptiveHistogram& histogram, int size)
+  {
+    AdaptiveBinValuesFunctor<ArrayT> functor(
+      array, component, ghosts, ghostsToSkip, histogram, size);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+  }
+};
+}
+
+//-----------------------------------------------------------------------------
+class vtkPExtractHistogram::vtkInternals
+{
+public:
+  // An array to bin, as found in a leaf of the input.
+  struct ArrayToBin
+  {
+    vtkDataArray* Array;
+    vtkMTimeType ArrayMTime;
+    vtkUnsignedCharArray* Ghosts;
+    vtkMTimeType GhostsMTime;
+    unsigned char GhostsToSkip;
+
+    bool operator==(const ArrayToBin& other) const
+    {
+      return this->Array == other.Array && this->ArrayMTime == other.ArrayMTime &&
+        this->Ghosts == other.Ghosts && this->GhostsMTime == other.GhostsMTime &&
+        this->GhostsToSkip == other.GhostsToSkip;
+    }
+  };
+
+  void CollectArrays(vtkPExtractHistogram* self, vtkDataObject* input)
+  {
+    this->Arrays.clear();
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(input))
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        this->CollectArray(self, iter->GetCurrentDataObject());
+      }
+    }
+    else if (input)
+    {
+      this->CollectArray(self, input);
+    }
+  }
+
+  void Bin(int component, const double range[2], std::vector<vtkTypeInt64>& bins)
+  {
+    for (const auto& entry : this->Arrays)
+    {
+      const int comp = ::GetComponentToBin(entry.Array, component);
+      const unsigned char* ghosts = entry.Ghosts ? entry.Ghosts->GetPointer(0) : nullptr;
+      BinValuesWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(
+            entry.Array, worker, comp, ghosts, entry.GhostsToSkip, range, bins))
+      {
+        worker(entry.Array, comp, ghosts, entry.GhostsToSkip, range, bins);
+      }
+    }
+  }
+
+  void BinAdaptive(int component, AdaptiveHistogram& histogram, int size)
+  {
+    for (const auto& entry : this->Arrays)
+    {
+      const int comp = ::GetComponentToBin(entry.Array, component);
+      const unsigned char* ghosts = entry.Ghosts ? entry.Ghosts->GetPointer(0) : nullptr;
+      AdaptiveBinValuesWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(
+            entry.Array, worker, comp, ghosts, entry.GhostsToSkip, histogram, size))
+      {
+        worker(entry.Array, comp, ghosts, entry.GhostsToSkip, histogram, size);
+      }
+    }
+  }
+
+  // Arrays to bin in the current input.
+  std::vector<ArrayToBin> Arrays;
+
+  // Arrays and component the cached range and bins were computed for.
+  std::vector<ArrayToBin> CachedArrays;
+  int CachedComponent = 0;
+  bool HasDataRange = false;
+  double DataRange[2] = { 0.0, 0.0 };
+  double BinRange[2] = { 0.0, 0.0 };
+  std::vector<vtkTypeInt64> Bins;
+
+private:
+  void CollectArray(vtkPExtractHistogram* self, vtkDataObject* dobj)
+  {
+    int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+    vtkDataArray* array = dobj ? self->GetInputArrayToProcess(0, dobj, association) : nullptr;
+    if (!array)
+    {
+      return;
+    }
+
+    ArrayToBin entry = { array, array->GetMTime(), nullptr, 0, 0 };
+    vtkFieldData* fd = dobj->GetAttributesAsFieldData(association);
+    vtkUnsignedCharArray* ghosts = fd ? fd->GetGhostArray() : nullptr;
+    if (ghosts && fd->GetGhostsToSkip() && ghosts != array &&
+      ghosts->GetNumberOfTuples() >= array->GetNumberOfTuples())
+    {
+      entry.Ghosts = ghosts;
+      entry.GhostsMTime = ghosts->GetMTime();
+      entry.GhostsToSkip = fd->GetGhostsToSkip();
+    }
+    this->Arrays.push_back(entry);
+  }
+};
+
 vtkStandardNewMacro(vtkPExtractHistogram);
 vtkCxxSetObjectMacro(vtkPExtractHistogram, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
 vtkPExtractHistogram::vtkPExtractHistogram()
+  : Internals(new vtkPExtractHistogram::vtkInternals())
 {
   this->Controller = nullptr;
+  this->EnableSMP = false;
+  this->SinglePass = false;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -72,7 +556,9 @@ int vtkPExtractHistogram::RequestData(
   bool tempAccumulation = this->Accumulation;
   this->Accumulation = false;
 
-  int superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+  int superRequestData = (this->EnableSMP && !this->CalculateAverages)
+    ? this->ComputeBins(inputVector, vtkTable::GetData(outputVector, 0))
+    : this->Superclass::RequestData(request, inputVector, outputVector);
 
   this->Normalize = tempNormalize;
   this->Accumulation = tempAccumulation;
@@ -170,9 +656,192 @@ int vtkPExtractHistogram::RequestData(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ComputeBins(vtkInformationVector** inputVector, vtkTable* output)
+{
+  output->Initialize();
+  auto& internals = *this->Internals;
+  internals.CollectArrays(this, vtkDataObject::GetData(inputVector[0], 0));
+
+  const int binCount = std::max(this->BinCount, 1);
+  if (this->SinglePass && !this->GetUseCustomBinRanges() && binCount > 1)
+  {
+    return this->ComputeAdaptiveBins(output);
+  }
+
+  // The cached range and bins may only be used if no rank has to traverse its
+  // input again, since computing the range is collective.
+  int reuse = 0;
+  if (internals.Arrays == internals.CachedArrays &&
+    internals.CachedComponent == this->GetComponent())
+  {
+    reuse = 1;
+  }
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int globalReuse = 0;
+    this->Controller->AllReduce(&reuse, &globalReuse, 1, vtkCommunicator::MIN_OP);
+    reuse = globalReuse;
+  }
+  if (!reuse)
+  {
+    internals.CachedArrays = internals.Arrays;
+    internals.CachedComponent = this->GetComponent();
+    internals.HasDataRange = false;
+    internals.Bins.clear();
+  }
+
+  double range[2];
+  if (this->GetUseCustomBinRanges())
+  {
+    this->GetCustomBinRanges(range);
+  }
+  else
+  {
+    if (!internals.HasDataRange)
+    {
+      if (!this->GetInputArrayRange(inputVector, internals.DataRange))
+      {
+        internals.DataRange[0] = VTK_DOUBLE_MAX;
+        internals.DataRange[1] = VTK_DOUBLE_MIN;
+      }
+      internals.HasDataRange = true;
+    }
+    range[0] = internals.DataRange[0];
+    range[1] = internals.DataRange[1];
+  }
+  if (!(range[0] <= range[1]))
+  {
+    // no values to bin on any rank, output empty bins.
+    range[0] = 0.0;
+    range[1] = 1.0;
+  }
+
+  double binRange[2] = { range[0], range[1] };
+  if (range[0] == range[1])
+  {
+    binRange[0] -= 0.5;
+    binRange[1] += 0.5;
+  }
+
+  // Centered bins extend half a bin beyond the range on either side. The
+  // cached bins still cover the range only, so that it does not depend on
+  // the bin count: the first and last bins are made of half as many of them.
+  const bool centered = this->GetCenterBinsAroundMinAndMax() && !this->GetUseCustomBinRanges() &&
+    binCount > 1 && range[0] != range[1];
+  const int fineDivisor = centered ? 2 * (binCount - 1) : binCount;
+  if (internals.Bins.empty() || internals.Bins.size() % fineDivisor != 0 ||
+    internals.BinRange[0] != binRange[0] || internals.BinRange[1] != binRange[1])
+  {
+    internals.Bins.assign(::GetFineBinCount(fineDivisor), 0);
+    internals.BinRange[0] = binRange[0];
+    internals.BinRange[1] = binRange[1];
+    internals.Bin(this->GetComponent(), binRange, internals.Bins);
+  }
+
+  vtkNew<vtkDoubleArray> extents;
+  extents->SetName(this->BinExtentsArrayName);
+  extents->SetNumberOfTuples(binCount);
+  vtkNew<vtkIntArray> values;
+  values->SetName(this->BinValuesArrayName);
+  values->SetNumberOfTuples(binCount);
+  const size_t ratio = internals.Bins.size() / fineDivisor;
+  for (int cc = 0; cc < binCount; ++cc)
+  {
+    size_t first = cc * ratio, last = (cc + 1) * ratio;
+    double center = binRange[0] + (cc + 0.5) * (binRange[1] - binRange[0]) / binCount;
+    if (centered)
+    {
+      first = cc == 0 ? 0 : (2 * cc - 1) * ratio;
+      last = cc == binCount - 1 ? internals.Bins.size() : (2 * cc + 1) * ratio;
+      center = binRange[0] + cc * (binRange[1] - binRange[0]) / (binCount - 1);
+    }
+    extents->SetValue(cc, center);
+    values->SetValue(cc,
+      static_cast<int>(std::accumulate(internals.Bins.begin() + first,
+        internals.Bins.begin() + last, static_cast<vtkTypeInt64>(0))));
+  }
+  output->GetRowData()->AddArray(extents);
+  output->GetRowData()->AddArray(values);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ComputeAdaptiveBins(vtkTable* output)
+{
+  auto& internals = *this->Internals;
+  AdaptiveHistogram histogram;
+  histogram.SetSize(this->BinCount);
+  internals.BinAdaptive(this->GetComponent(), histogram, this->BinCount);
+
+  // Agree on the bins with the other ranks: the smallest exponent for which
+  // the values of all ranks fit.
+  const bool parallel = this->Controller && this->Controller->GetNumberOfProcesses() > 1;
+  int exponent = histogram.IsEmpty() ? VTK_INT_MIN : histogram.GetExponent();
+  if (parallel)
+  {
+    int globalExponent = VTK_INT_MIN;
+    this->Controller->AllReduce(&exponent, &globalExponent, 1, vtkCommunicator::MAX_OP);
+    exponent = globalExponent;
+  }
+  vtkTypeInt64 first = 0, last = -1;
+  if (exponent == VTK_INT_MIN)
+  {
+    // no values to bin on any rank, output no bins.
+    exponent = 0;
+  }
+  else
+  {
+    for (;; ++exponent)
+    {
+      // The upper bound is negated so that a single MIN reduction gives both.
+      vtkTypeInt64 bounds[2] = { std::numeric_limits<vtkTypeInt64>::max(),
+        std::numeric_limits<vtkTypeInt64>::max() };
+      if (!histogram.IsEmpty())
+      {
+        histogram.GetBounds(exponent, bounds[0], bounds[1]);
+        bounds[1] = -bounds[1];
+      }
+      if (parallel)
+      {
+        vtkTypeInt64 globalBounds[2];
+        this->Controller->AllReduce(bounds, globalBounds, 2, vtkCommunicator::MIN_OP);
+        bounds[0] = globalBounds[0];
+        bounds[1] = globalBounds[1];
+      }
+      first = bounds[0];
+      last = -bounds[1];
+      if (last - first < this->BinCount)
+      {
+        break;
+      }
+    }
+  }
+  histogram.Rebin(exponent, first, last);
+
+  const auto& counts = histogram.GetCounts();
+  const vtkIdType binCount = static_cast<vtkIdType>(counts.size());
+  vtkNew<vtkDoubleArray> extents;
+  extents->SetName(this->BinExtentsArrayName);
+  extents->SetNumberOfTuples(binCount);
+  vtkNew<vtkIntArray> values;
+  values->SetName(this->BinValuesArrayName);
+  values->SetNumberOfTuples(binCount);
+  for (vtkIdType cc = 0; cc < binCount; ++cc)
+  {
+    extents->SetValue(cc, std::ldexp(static_cast<double>(first + cc) + 0.5, exponent));
+    values->SetValue(cc, static_cast<int>(counts[cc]));
+  }
+  output->GetRowData()->AddArray(extents);
+  output->GetRowData()->AddArray(values);
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "EnableSMP: " << this->EnableSMP << endl;
+  os << indent << "SinglePass: " << this->SinglePass << endl;
 }
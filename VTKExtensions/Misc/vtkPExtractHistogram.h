@@ -7,6 +7,13 @@
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
  * It gathers the histogram data on the root node.
+ *
+ * When EnableSMP is set, the bin counts of each rank are computed with
+ * vtkSMPTools into thread-local bins. The counts are kept at a finer
+ * resolution than BinCount, so that changing only BinCount, to one that
+ * divides the cached resolution, re-bins the cached counts instead of
+ * traversing the input again. SinglePass further fuses the range computation
+ * with the binning, see SetSinglePass().
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -15,7 +22,10 @@
 #include "vtkExtractHistogram.h"
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
+#include <memory> // for std::unique_ptr
+
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -33,6 +43,34 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * When set, values are binned with vtkSMPTools into thread-local bins and
+   * the bin counts are cached for re-binning when only BinCount changes.
+   * Values are assigned to the finer cached bins first, so a value lying on
+   * the boundary between two bins may fall in another bin than without
+   * EnableSMP. Ignored when CalculateAverages is set. Default is false.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When set along with EnableSMP, the range and the bin counts are computed
+   * in a single traversal of the input. Bins have a power of two width and
+   * are aligned on multiples of it; pairs of bins are merged each time the
+   * values seen do not fit in BinCount bins any longer. The output then
+   * covers the data range with at most BinCount bins, and usually more than
+   * BinCount / 2. CenterBinsAroundMinAndMax is ignored. Ignored when
+   * UseCustomBinRanges is set or BinCount is 1. Default is false.
+   */
+  vtkSetMacro(SinglePass, bool);
+  vtkGetMacro(SinglePass, bool);
+  vtkBooleanMacro(SinglePass, bool);
+  ///@}
+
 protected:
   vtkPExtractHistogram();
   ~vtkPExtractHistogram() override;
@@ -46,11 +84,24 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Fills `output` with the bin extents and the local bin counts using
+   * vtkSMPTools. Used instead of the superclass when EnableSMP is set.
+   */
+  bool ComputeBins(vtkInformationVector** inputVector, vtkTable* output);
+
   vtkMultiProcessController* Controller;
+  bool EnableSMP;
+  bool SinglePass;
 
 private:
   vtkPExtractHistogram(const vtkPExtractHistogram&) = delete;
   void operator=(const vtkPExtractHistogram&) = delete;
+
+  bool ComputeAdaptiveBins(vtkTable* output);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif
@@ -5,12 +5,18 @@ logbase contains core routines for collecting and gathering timing logs from
 all nodes.
 logparser contains additional routines for parsing the raw logs and
 calculating statistics across ranks and frames.
+profiler records structured events on all nodes and exports them as a Chrome
+trace.
 
 manyspheres is a geometry rendering benchmark that generates a large number
 of spheres and moves the camera around the scene.  To run the benchmark,
 either explicitly import manyspheres from paraview.benchmark and call it's
 run method, or call the manyspheres.py module directly via pvbatch or pvpython.
 
+startup times loading the core proxy definitions, with and without the proxy
+definition cache, across ranks. Run it with pvpython or pvbatch, e.g.
+``mpiexec -n 64 pvbatch -m paraview.benchmark.startup``.
+
 ::
 
     TODO: this doesn't handle split render/data server mode
@@ -21,5 +27,6 @@ from __future__ import absolute_import
 
 from . import logbase
 from . import logparser
+from . import profiler
 
-__all__ = ['logbase', 'logparser']
+__all__ = ['logbase', 'logparser', 'profiler']
@@ -0,0 +1,74 @@
+"""
+This module records structured profiling events on all processes and exports
+them as a Chrome trace.
+
+Unlike the timer logs used by logbase, events are recorded with the thread,
+proxy, bytes moved and memory change of each algorithm execution, data
+delivery, compositing pass and client-server stream, so that all ranks can be
+inspected on a single timeline (chrome://tracing or https://ui.perfetto.dev).
+Do that like so:
+
+1. Call enable()
+2. Setup and run your visualization pipeline (via GUI or script as you prefer)
+3. Call write_chrome_trace('trace.json')
+"""
+
+from paraview import servermanager
+
+
+def _set(**properties):
+    pxm = servermanager.ProxyManager()
+    proxy = pxm.NewProxy("misc", "Profiler")
+    for name, value in properties.items():
+        proxy.GetProperty(name).SetElement(0, value)
+    proxy.UpdateVTKObjects()
+    return proxy
+
+
+def enable(maximum_number_of_events=1000000, record_memory=False):
+    """Enables recording of profiling events on all processes. If
+    record_memory is True, the change in process memory is sampled for each
+    event, which adds overhead to short events."""
+    _set(MaximumNumberOfEvents=maximum_number_of_events,
+         RecordMemory=1 if record_memory else 0, Enabled=1)
+
+
+def disable():
+    """Disables recording of profiling events on all processes."""
+    _set(Enabled=0)
+
+
+def clear():
+    """Clears the events recorded so far on all processes."""
+    proxy = _set()
+    proxy.InvokeCommand("ClearEvents")
+
+
+def _components(session):
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    if pm.GetProcessTypeAsInt() == pm.PROCESS_BATCH or not session.IsA("vtkSMSessionClient"):
+        return [session.CLIENT_AND_SERVERS]
+    if session.GetRenderClientMode() == session.RENDERING_UNIFIED:
+        return [session.CLIENT, session.SERVERS]
+    return [session.CLIENT, session.DATA_SERVER, session.RENDER_SERVER]
+
+
+def gather(clear_events=False):
+    """Gathers the events recorded on all processes and returns a
+    vtkPVProfilerInformation. If clear_events is True, the events are cleared
+    on each process once gathered."""
+    session = servermanager.ProxyManager().GetSessionProxyManager().GetSession()
+    result = servermanager.vtkPVProfilerInformation()
+    for component in _components(session):
+        info = servermanager.vtkPVProfilerInformation()
+        info.SetClearEvents(clear_events)
+        session.GatherInformation(component, info, 0)
+        result.AddInformation(info)
+    return result
+
+
+def write_chrome_trace(filename, clear_events=False):
+    """Gathers the events recorded on all processes and writes them to
+    filename as a Chrome trace."""
+    if not gather(clear_events).WriteChromeTrace(filename):
+        raise RuntimeError("Failed to write '%s'" % filename)
@@ -0,0 +1,154 @@
+"""
+This module benchmarks the part of pvpython and pvbatch startup spent loading
+the core proxy definitions, with and without the proxy definition cache (see
+vtkSIProxyDefinitionManager.SetDefinitionCacheDirectory).
+
+Each phase creates a new proxy definition manager on every rank and reports
+the largest time across ranks:
+
+* parse: the core XMLs are parsed, as when the cache is disabled.
+* build: the core XMLs are parsed and the first rank saves the cache.
+* mapped: the cache is mapped instead of parsing the XMLs.
+
+For the parse and mapped phases, the time to then look up every filter
+definition is reported too, since mapped definitions are only decoded on
+first use. On Linux, the time from process start to the start of the script
+is also reported.
+
+Run it with pvpython or pvbatch at the rank counts of interest, e.g.::
+
+    pvpython -m paraview.benchmark.startup
+    mpiexec -n 64 pvbatch -m paraview.benchmark.startup --cache-directory /shared/cache
+    mpiexec -n 1024 pvbatch -m paraview.benchmark.startup --cache-directory /shared/cache
+
+When ranks run on several nodes, the cache directory must be on a file system
+shared by all of them, otherwise ranks that cannot see the cache parse the
+XMLs in the mapped phase too.
+"""
+
+import glob
+import os
+import tempfile
+import time
+
+from paraview.modules.vtkRemotingServerManager import vtkSIProxyDefinitionManager
+from vtkmodules.vtkCommonCore import vtkDoubleArray
+from vtkmodules.vtkParallelCore import vtkCommunicator, vtkMultiProcessController
+
+
+def _process_age():
+    """Returns the seconds elapsed since this process started, or None if
+    unknown."""
+    try:
+        with open('/proc/self/stat') as f:
+            # the process name may contain spaces, skip past it.
+            fields = f.read().rsplit(')', 1)[1].split()
+        with open('/proc/uptime') as f:
+            uptime = float(f.read().split()[0])
+        return uptime - float(fields[19]) / os.sysconf('SC_CLK_TCK')
+    except (OSError, IndexError, ValueError, AttributeError):
+        return None
+
+
+def _maximum(controller, values):
+    """Returns the largest of each of values across ranks."""
+    local = vtkDoubleArray()
+    for value in values:
+        local.InsertNextValue(value)
+    result = vtkDoubleArray()
+    controller.AllReduce(local, result, vtkCommunicator.MAX_OP)
+    return [result.GetValue(i) for i in range(result.GetNumberOfTuples())]
+
+
+def _load(controller):
+    controller.Barrier()
+    start = time.perf_counter()
+    manager = vtkSIProxyDefinitionManager()
+    return manager, time.perf_counter() - start
+
+
+def _lookup_filters(manager):
+    start = time.perf_counter()
+    iterator = manager.NewSingleGroupIterator('filters', manager.CORE_DEFINITIONS)
+    iterator.GoToFirstItem()
+    while not iterator.IsDoneWithTraversal():
+        iterator.GetProxyDefinition()
+        iterator.GoToNextItem()
+    return time.perf_counter() - start
+
+
+def run(cache_directory=None, repeat=3):
+    """Runs the benchmark and returns a dictionary of the best time of each
+    phase, in seconds, on the first rank. Other ranks return None."""
+    controller = vtkMultiProcessController.GetGlobalController()
+    age = _process_age()
+    age = _maximum(controller, [age])[0] if age is not None else None
+
+    if cache_directory is None:
+        cache_directory = os.path.join(tempfile.gettempdir(), 'paraview-startup-benchmark')
+    cache_files = os.path.join(cache_directory, 'ProxyDefinitions-*.pvdb')
+    previous_directory = vtkSIProxyDefinitionManager.GetDefinitionCacheDirectory()
+
+    timings = {}
+
+    def record(name, value):
+        timings[name] = min(timings.get(name, value), value)
+
+    for _ in range(repeat):
+        vtkSIProxyDefinitionManager.SetDefinitionCacheDirectory('')
+        manager, load = _load(controller)
+        lookup = _lookup_filters(manager)
+        load, lookup = _maximum(controller, [load, lookup])
+        record('parse', load)
+        record('parse lookup', lookup)
+        del manager
+
+        if controller.GetLocalProcessId() == 0:
+            for cache_file in glob.glob(cache_files):
+                os.remove(cache_file)
+        vtkSIProxyDefinitionManager.SetDefinitionCacheDirectory(cache_directory)
+        manager, load = _load(controller)
+        record('build', _maximum(controller, [load])[0])
+        del manager
+
+        manager, load = _load(controller)
+        lookup = _lookup_filters(manager)
+        load, lookup = _maximum(controller, [load, lookup])
+        record('mapped', load)
+        record('mapped lookup', lookup)
+        del manager
+
+    vtkSIProxyDefinitionManager.SetDefinitionCacheDirectory(previous_directory)
+    controller.Barrier()
+    if controller.GetLocalProcessId() != 0:
+        return None
+    if age is not None:
+        timings['process start'] = age
+    return timings
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark loading the core proxy definitions at startup')
+    parser.add_argument('--cache-directory', type=str,
+                        help='Directory of the proxy definition cache, '
+                             'shared by all ranks')
+    parser.add_argument('--repeat', default=3, type=int,
+                        help='Number of times each phase is run, the best time is reported')
+    args = parser.parse_args(argv)
+
+    timings = run(args.cache_directory, args.repeat)
+    if timings:
+        ranks = vtkMultiProcessController.GetGlobalController().GetNumberOfProcesses()
+        print('Startup timings on %d rank(s), largest across ranks:' % ranks)
+        for name in ['process start', 'parse', 'parse lookup', 'build', 'mapped',
+                     'mapped lookup']:
+            if name in timings:
+                print('  %-16s %10.3f ms' % (name, 1000 * timings[name]))
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])